@@ -0,0 +1,300 @@
+/***********************************************************************
+ * Header:
+ *    B-HEAP
+ * Summary:
+ *    A binary heap laid out so that whole subtrees share a page, after
+ *    Kamp's B-heap. In the usual layout the children of i are at 2i+1
+ *    and 2i+2, so once the heap outgrows the TLB every level of a sift
+ *    lands on a different page. Here each page of P slots holds a
+ *    little heap of P - 1 nodes, about log2 P levels, and a sift only
+ *    changes page once per log2 P levels.
+ *
+ *    Within page q, slot 0 is left empty and slot l in [1, P) holds a
+ *    node. Its children are:
+ *        l <  P/2    slots 2l and 2l+1 of the same page
+ *        l >= P/2    slot 1 of pages qP+1+c and qP+2+c, c = 2(l - P/2)
+ *    so the pages form a P-ary heap of their own. Nodes are filled in
+ *    address order, which keeps every parent ahead of its children and
+ *    the last node a leaf.
+ *
+ *    The storage comes from page_allocator, so when sizeof(T) is a
+ *    power of two a block of P slots is exactly one page. T must be
+ *    default constructible to fill the empty slots.
+ *
+ *    This will contain the class definitions of:
+ *        page_allocator          : Allocates on page boundaries
+ *        b_heap                  : A priority queue with a paged layout
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <new>         // for std::align_val_t
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::swap and std::move
+#include "vector.h"
+
+class TestBHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * PAGE ALLOCATOR
+ * A std::allocator that starts every block on an
+ * Alignment boundary
+ *************************************************/
+template <class T, size_t Alignment = 4096>
+class page_allocator
+{
+public:
+   typedef T value_type;
+   template <class U>
+   struct rebind { typedef page_allocator<U, Alignment> other; };
+
+   page_allocator() {}
+   template <class U>
+   page_allocator(const page_allocator<U, Alignment> &) {}
+
+   T * allocate(size_t n)
+   {
+      return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+   }
+   void deallocate(T * p, size_t)
+   {
+      ::operator delete(p, std::align_val_t(Alignment));
+   }
+
+   template <class U>
+   bool operator == (const page_allocator<U, Alignment> &) const { return true; }
+   template <class U>
+   bool operator != (const page_allocator<U, Alignment> &) const { return false; }
+};
+
+/*************************************************
+ * B-HEAP
+ * PageBytes is the page size to lay the heap out
+ * for: 4096 for ordinary pages, or 2 MiB for
+ * transparent huge pages.
+ *************************************************/
+template <class T, class Compare = std::less<T>, size_t PageBytes = 4096>
+class b_heap
+{
+   friend class ::TestBHeap; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   explicit b_heap(const Compare & compare = Compare()) : numElements(0), compare(compare)
+   {
+   }
+
+   //
+   // Access
+   //
+   const T & top() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+   void reserve(size_t n)
+   {
+      if (n > 0)
+         container.reserve(position(n - 1) + 1);
+   }
+
+   //
+   // Remove
+   //
+   void pop();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   // slots per page: the largest power of two that fits
+   static constexpr size_t pageSlots()
+   {
+      size_t slots = 1;
+      while (slots * 2 * sizeof(T) <= PageBytes)
+         slots *= 2;
+      return slots;
+   }
+   static constexpr size_t P = pageSlots();
+   static_assert(P >= 4, "b_heap needs at least four items to a page");
+
+   // where the i-th node lives
+   static size_t position(size_t i) { return i / (P - 1) * P + i % (P - 1) + 1; }
+   static size_t parent(size_t p);
+   static size_t firstChild(size_t p);
+   static size_t secondChild(size_t p) { return p % P < P / 2 ? firstChild(p) + 1 : firstChild(p) + P; }
+
+   void siftUp(size_t p);
+   void siftDown(size_t p);
+   void afterPush();
+
+   custom::vector<T, page_allocator<T, PageBytes>> container;
+   size_t  numElements;
+   Compare compare;
+};
+
+/************************************************
+ * B-HEAP :: PARENT
+ * Inside the page, or the leaf of the parent page
+ * that this page hangs from
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+size_t b_heap <T, Compare, PageBytes> :: parent(size_t p)
+{
+   size_t q = p / P;
+   size_t l = p % P;
+   assert(p > 1 && l != 0);
+   if (l > 1)
+      return q * P + l / 2;
+
+   size_t c = (q - 1) % P;
+   return (q - 1) / P * P + P / 2 + c / 2;
+}
+
+/************************************************
+ * B-HEAP :: FIRST CHILD
+ * Inside the page, or the root of a child page
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+size_t b_heap <T, Compare, PageBytes> :: firstChild(size_t p)
+{
+   size_t q = p / P;
+   size_t l = p % P;
+   if (l < P / 2)
+      return p + l;
+
+   size_t c = 2 * (l - P / 2);
+   return (q * P + 1 + c) * P + 1;
+}
+
+/************************************************
+ * B-HEAP :: TOP
+ * The root, in slot 1 of the first page
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+const T & b_heap <T, Compare, PageBytes> :: top() const
+{
+   if (numElements == 0)
+      throw std::out_of_range("std:out_of_range");
+   return container[1];
+}
+
+/************************************************
+ * B-HEAP :: PUSH
+ * The next node starts a new page on a slot 0
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+void b_heap <T, Compare, PageBytes> :: push(const T & t)
+{
+   if (container.size() % P == 0)
+      container.push_back(T());
+   container.push_back(t);
+   afterPush();
+}
+
+template <class T, class Compare, size_t PageBytes>
+void b_heap <T, Compare, PageBytes> :: push(T && t)
+{
+   if (container.size() % P == 0)
+      container.push_back(T());
+   container.push_back(std::move(t));
+   afterPush();
+}
+
+template <class T, class Compare, size_t PageBytes>
+void b_heap <T, Compare, PageBytes> :: afterPush()
+{
+   assert(container.size() == position(numElements) + 1);
+   siftUp(container.size() - 1);
+   numElements++;
+}
+
+/************************************************
+ * B-HEAP :: POP
+ * Move the last node to the root and sift it down.
+ * A page left with only its empty slot goes too.
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+void b_heap <T, Compare, PageBytes> :: pop()
+{
+   if (numElements == 0)
+      return;
+
+   size_t last = container.size() - 1;
+   if (last != 1)
+   {
+      using std::swap;
+      swap(container[1], container[last]);
+   }
+   container.pop_back();
+   if (container.size() % P == 1)
+      container.pop_back();
+   numElements--;
+
+   if (numElements > 1)
+      siftDown(1);
+}
+
+/************************************************
+ * B-HEAP :: SIFT UP
+ * Swap p with its parent while it is larger
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+void b_heap <T, Compare, PageBytes> :: siftUp(size_t p)
+{
+   using std::swap;
+   while (p != 1)
+   {
+      size_t up = parent(p);
+      if (!compare(container[up], container[p]))
+         return;
+      swap(container[up], container[p]);
+      p = up;
+   }
+}
+
+/************************************************
+ * B-HEAP :: SIFT DOWN
+ * Swap p with its larger child while that child
+ * is larger. A child exists if it is below the end:
+ * only empty slots are skipped in address order.
+ ***********************************************/
+template <class T, class Compare, size_t PageBytes>
+void b_heap <T, Compare, PageBytes> :: siftDown(size_t p)
+{
+   using std::swap;
+   size_t end = container.size();
+   for (;;)
+   {
+      size_t left = firstChild(p);
+      if (left >= end)
+         return;
+      size_t right = secondChild(p);
+      size_t largest = p;
+      if (compare(container[largest], container[left]))
+         largest = left;
+      if (right < end && compare(container[largest], container[right]))
+         largest = right;
+      if (largest == p)
+         return;
+      swap(container[p], container[largest]);
+      p = largest;
+   }
+}
+
+} // namespace custom
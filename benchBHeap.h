@@ -0,0 +1,76 @@
+/***********************************************************************
+ * Header:
+ *    BENCH B-HEAP
+ * Summary:
+ *    Benchmarks for heaps larger than the TLB reaches: fill a heap of
+ *    ints to a given size, then time a million pop-and-push steps, on
+ *    the paged B-heap and on the plain binary heap. Every pop sifts
+ *    from the root to the bottom, so this is where the layout shows.
+ *    The default stops at 256 MB; pass 1 << 30 or more to measure a
+ *    gigabyte heap on a machine with room for it.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "b_heap.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <string>
+
+/*************************************************
+ * BENCH B-HEAP
+ *************************************************/
+class BenchBHeap : public Benchmark
+{
+public:
+   explicit BenchBHeap(size_t maxBytes = (size_t)256 << 20) : maxBytes(maxBytes) {}
+
+   void run()
+   {
+      for (size_t bytes = (size_t)16 << 20; bytes <= maxBytes; bytes *= 4)
+      {
+         // a little under the size, so neither one doubles its buffer
+         size_t n = bytes / sizeof(int) / 1024 * 1020;
+         section("B-heap: 1,000,000 pop + push on " + std::to_string(bytes >> 20) + " MB of ints");
+         {
+            custom::b_heap<int> heap;
+            heap.reserve(n);
+            report("b_heap (4 KB pages)", steady(heap, n), numSteps);
+         }
+         {
+            custom::priority_queue<int> heap;
+            heap.reserve(n);
+            report("priority_queue", steady(heap, n), numSteps);
+         }
+      }
+   }
+
+private:
+   static const size_t numSteps = 1000000;
+
+   // fill to n, then time the pop-and-push steps
+   template <class Heap>
+   static double steady(Heap & heap, size_t n)
+   {
+      unsigned int seed = 2718;
+      for (size_t i = 0; i < n; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         heap.push((int)(seed >> 1));
+      }
+
+      Timer timer;
+      for (size_t i = 0; i < numSteps; i++)
+      {
+         heap.pop();
+         seed = seed * 1103515245 + 12345;
+         heap.push((int)(seed >> 1));
+      }
+      return timer.seconds();
+   }
+
+   size_t maxBytes;
+};
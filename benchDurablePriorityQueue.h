@@ -0,0 +1,105 @@
+/***********************************************************************
+ * Header:
+ *    BENCH DURABLE PRIORITY QUEUE
+ * Summary:
+ *    Benchmarks for the priority queue with a write-ahead log: what a
+ *    synced push costs as more threads share each fdatasync, and how
+ *    long recovery takes from a checkpoint of 5,000,000 items and a
+ *    log of 100,000 pushes and 100,000 pops, against loading the same
+ *    checkpoint and replaying the records one at a time.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include "durable_priority_queue.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <cstdio>       // for std::remove
+#include <filesystem>   // for std::filesystem::temp_directory_path
+#include <string>
+#include <thread>
+#include <vector>
+
+/*************************************************
+ * BENCH DURABLE PRIORITY QUEUE
+ *************************************************/
+class BenchDurablePriorityQueue : public Benchmark
+{
+public:
+   void run()
+   {
+      std::string path = (std::filesystem::temp_directory_path() / "bench-durable").string();
+
+      section("Durable priority queue: 4,000 synced pushes, group commit");
+      for (size_t numThreads : { 1, 4, 16, 64 })
+      {
+         cleanup(path);
+         custom::durable_priority_queue<int> queue(path);
+         size_t numEach = 4000 / numThreads;
+         Timer timer;
+         std::vector<std::thread> threads;
+         for (size_t t = 0; t < numThreads; t++)
+            threads.push_back(std::thread([&queue, t, numEach]()
+            {
+               for (size_t i = 0; i < numEach; i++)
+                  queue.push((int)(t * numEach + i));
+            }));
+         for (std::thread & thread : threads)
+            thread.join();
+         report(std::to_string(numThreads) + " threads", timer.seconds(), 4000);
+      }
+
+      section("Durable priority queue: recover 5,000,000 items + 200,000 records");
+      cleanup(path);
+      custom::vector<int> initial;
+      custom::vector<int> later;
+      unsigned int seed = 3;
+      for (size_t i = 0; i < numItems + numPushes; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         (i < numItems ? initial : later).push_back((int)(seed >> 1));
+      }
+      {
+         custom::durable_priority_queue<int> queue(path, 1 << 30);
+         queue.push(initial.begin(), initial.end());
+         queue.checkpoint();
+         queue.push(later.begin(), later.end());
+         int item;
+         for (size_t i = 0; i < numPops; i++)
+            queue.pop(item);
+      }
+      {
+         Timer timer;
+         custom::durable_priority_queue<int> queue(path);
+         report("checkpoint + log, one heapify", timer.seconds());
+      }
+      {
+         Timer timer;
+         custom::priority_queue<int> queue(std::move(initial));
+         for (size_t i = 0; i < numPushes; i++)
+            queue.push(later[i]);
+         for (size_t i = 0; i < numPops; i++)
+            queue.pop();
+         report("checkpoint, then replay each record", timer.seconds());
+      }
+      cleanup(path);
+   }
+
+private:
+   static const size_t numItems  = 5000000;
+   static const size_t numPushes = 100000;
+   static const size_t numPops   = 100000;
+
+   static void cleanup(const std::string & path)
+   {
+      std::remove((path + ".wal").c_str());
+      std::remove((path + ".ckpt").c_str());
+   }
+};
+
+#endif // __linux__
@@ -0,0 +1,60 @@
+/***********************************************************************
+ * Header:
+ *    BENCH EXTERNAL PRIORITY QUEUE
+ * Summary:
+ *    Benchmarks for the priority queue that spills to disk: push 20
+ *    million ints, 80 MB, then pop them all, with budgets of 8 MB and
+ *    32 MB, next to priority_queue holding everything in memory.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "external_priority_queue.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <string>
+
+/*************************************************
+ * BENCH EXTERNAL PRIORITY QUEUE
+ *************************************************/
+class BenchExternalPriorityQueue : public Benchmark
+{
+public:
+   void run()
+   {
+      section("External priority queue: push then pop 20,000,000 ints");
+      {
+         custom::external_priority_queue<int> queue((size_t)8 << 20);
+         report("external, 8 MB budget", pushPop(queue), 2 * numItems);
+      }
+      {
+         custom::external_priority_queue<int> queue((size_t)32 << 20);
+         report("external, 32 MB budget", pushPop(queue), 2 * numItems);
+      }
+      {
+         custom::priority_queue<int> queue;
+         report("priority_queue, all in memory", pushPop(queue), 2 * numItems);
+      }
+   }
+
+private:
+   static const size_t numItems = 20000000;
+
+   template <class Queue>
+   static double pushPop(Queue & queue)
+   {
+      Timer timer;
+      unsigned int seed = 1618;
+      for (size_t i = 0; i < numItems; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         queue.push((int)(seed >> 1));
+      }
+      while (!queue.empty())
+         queue.pop();
+      return timer.seconds();
+   }
+};
@@ -0,0 +1,149 @@
+/***********************************************************************
+ * Header:
+ *    BENCH FIBONACCI HEAP
+ * Summary:
+ *    Benchmarks for Dijkstra on dense random graphs: the Fibonacci
+ *    heap with decrease-key against a priority_queue that pushes a
+ *    duplicate for every improvement and skips stale entries.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "fibonacci_heap.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*************************************************
+ * BENCH FIBONACCI HEAP
+ *************************************************/
+class BenchFibonacciHeap : public Benchmark
+{
+public:
+   void run()
+   {
+      dijkstra(2000, 0.5);
+      dijkstra(5000, 0.1);
+   }
+
+private:
+   struct Edge
+   {
+      size_t to;
+      int weight;
+   };
+   typedef std::vector<std::vector<Edge>> Graph;
+   typedef std::pair<long long, size_t> Item;   // {distance, vertex}
+
+   static unsigned int next(unsigned int & seed)
+   {
+      seed = seed * 1103515245 + 12345;
+      return seed >> 8;
+   }
+
+   // compare the two queues on one random graph
+   void dijkstra(size_t numVertices, double density)
+   {
+      Graph graph(numVertices);
+      unsigned int seed = 4242;
+      size_t numEdges = 0;
+      unsigned int cutoff = (unsigned int)(density * (1 << 24));
+      for (size_t a = 0; a < numVertices; a++)
+         for (size_t b = a + 1; b < numVertices; b++)
+            if (next(seed) < cutoff)
+            {
+               int weight = 1 + (int)(next(seed) % 1000);
+               graph[a].push_back(Edge{ b, weight });
+               graph[b].push_back(Edge{ a, weight });
+               numEdges++;
+            }
+
+      section("Dijkstra: " + std::to_string(numVertices) + " vertices, " +
+              std::to_string(numEdges) + " edges");
+
+      size_t numDecreases = 0;
+      Timer timer;
+      std::vector<long long> byFibonacci = withFibonacci(graph, numDecreases);
+      report("fibonacci_heap decrease_key", timer.seconds(), numEdges);
+
+      size_t numPushes = 0;
+      timer.reset();
+      std::vector<long long> byQueue = withQueue(graph, numPushes);
+      report("priority_queue lazy duplicates", timer.seconds(), numEdges);
+
+      report("(" + std::to_string(numDecreases) + " decrease-keys, " +
+             std::to_string(numPushes) + " pushes)", 0.0);
+      if (byFibonacci != byQueue)
+         report("(the two searches disagree)", 0.0);
+   }
+
+   static std::vector<long long> withFibonacci(const Graph & graph, size_t & numDecreases)
+   {
+      size_t numVertices = graph.size();
+      std::vector<long long> distance(numVertices, -1);
+      std::vector<custom::fibonacci_heap<Item>::handle> handles(numVertices);
+      custom::fibonacci_heap<Item> heap;
+      heap.reserve(numVertices);
+
+      distance[0] = 0;
+      handles[0] = heap.push(Item(0, 0));
+      while (!heap.empty())
+      {
+         size_t u = heap.top().second;
+         heap.pop();
+         for (const Edge & edge : graph[u])
+         {
+            long long through = distance[u] + edge.weight;
+            if (distance[edge.to] < 0)
+            {
+               distance[edge.to] = through;
+               handles[edge.to] = heap.push(Item(through, edge.to));
+            }
+            else if (through < distance[edge.to] && heap.contains(handles[edge.to]))
+            {
+               distance[edge.to] = through;
+               heap.decrease_key(handles[edge.to], Item(through, edge.to));
+               numDecreases++;
+            }
+         }
+      }
+      return distance;
+   }
+
+   static std::vector<long long> withQueue(const Graph & graph, size_t & numPushes)
+   {
+      size_t numVertices = graph.size();
+      std::vector<long long> distance(numVertices, -1);
+      std::vector<bool> done(numVertices, false);
+      custom::priority_queue<Item, custom::vector<Item>, std::greater<Item>> queue;
+
+      distance[0] = 0;
+      queue.push(Item(0, 0));
+      numPushes++;
+      while (!queue.empty())
+      {
+         size_t u = queue.top().second;
+         queue.pop();
+         if (done[u])
+            continue;
+         done[u] = true;
+         for (const Edge & edge : graph[u])
+         {
+            long long through = distance[u] + edge.weight;
+            if (distance[edge.to] < 0 || through < distance[edge.to])
+            {
+               distance[edge.to] = through;
+               queue.push(Item(through, edge.to));
+               numPushes++;
+            }
+         }
+      }
+      return distance;
+   }
+};
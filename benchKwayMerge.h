@@ -0,0 +1,107 @@
+/***********************************************************************
+ * Header:
+ *    BENCH K-WAY MERGE
+ * Summary:
+ *    Benchmarks for merging 256 sorted runs: the loser tree against
+ *    a priority_queue holding every run's head. Cheap int keys show
+ *    the bookkeeping; strings with a long shared prefix show what
+ *    halving the comparisons is worth.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "kway_merge.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*************************************************
+ * BENCH K-WAY MERGE
+ *************************************************/
+class BenchKwayMerge : public Benchmark
+{
+public:
+   void run()
+   {
+      section("K-way merge: 256 runs of 40,000 ints");
+      std::vector<std::vector<int>> ints(256);
+      unsigned int seed = 2024;
+      for (std::vector<int> & run : ints)
+      {
+         for (size_t i = 0; i < 40000; i++)
+            run.push_back((int)(next(seed) >> 1));
+         std::sort(run.begin(), run.end());
+      }
+      compare(ints);
+
+      section("K-way merge: 256 runs of 4,000 strings with a 48-byte shared prefix");
+      std::vector<std::vector<std::string>> strings(256);
+      std::string prefix(48, 'k');
+      for (std::vector<std::string> & run : strings)
+      {
+         for (size_t i = 0; i < 4000; i++)
+            run.push_back(prefix + std::to_string(next(seed) % 100000000));
+         std::sort(run.begin(), run.end());
+      }
+      compare(strings);
+   }
+
+private:
+   static unsigned int next(unsigned int & seed)
+   {
+      seed = seed * 1103515245 + 12345;
+      return seed;
+   }
+
+   // merge the same runs both ways and check they agree
+   template <class T>
+   void compare(const std::vector<std::vector<T>> & runs)
+   {
+      size_t numRuns = runs.size();
+      size_t numKeys = 0;
+      for (const std::vector<T> & run : runs)
+         numKeys += run.size();
+
+      // the loser tree
+      size_t hashLoser = 0;
+      Timer timer;
+      custom::vector<std::pair<const T *, const T *>> ranges;
+      for (const std::vector<T> & run : runs)
+         ranges.push_back(std::make_pair(run.data(), run.data() + run.size()));
+      custom::kway_merge<const T *> merge(ranges);
+      for (typename custom::kway_merge<const T *>::iterator it = merge.begin(); it != merge.end(); ++it)
+         hashLoser = hashLoser * 31 + std::hash<T>()(*it);
+      report("kway_merge loser tree", timer.seconds(), numKeys);
+
+      // a min-queue of {head, run}
+      size_t hashHeap = 0;
+      timer.reset();
+      typedef std::pair<T, size_t> head;
+      custom::priority_queue<head, custom::vector<head>, std::greater<head>> heads;
+      custom::vector<size_t> next(numRuns);
+      for (size_t i = 0; i < numRuns; i++)
+      {
+         heads.push(head(runs[i][0], i));
+         next[i] = 1;
+      }
+      while (!heads.empty())
+      {
+         size_t run = heads.top().second;
+         hashHeap = hashHeap * 31 + std::hash<T>()(heads.top().first);
+         heads.pop();
+         if (next[run] < runs[run].size())
+            heads.push(head(runs[run][next[run]++], run));
+      }
+      report("priority_queue of run heads", timer.seconds(), numKeys);
+
+      if (hashLoser != hashHeap)
+         report("(the two merges disagree)", 0.0);
+   }
+};
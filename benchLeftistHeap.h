@@ -0,0 +1,111 @@
+/***********************************************************************
+ * Header:
+ *    BENCH LEFTIST HEAP
+ * Summary:
+ *    Benchmarks for merging 64 worker queues of 16,384 items into
+ *    one: pushing every item across, rebuilding with one heapify,
+ *    and melding leftist heaps with and without a shared pool.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "leftist_heap.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <memory>
+#include <vector>
+
+/*************************************************
+ * BENCH LEFTIST HEAP
+ *************************************************/
+class BenchLeftistHeap : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numQueues = 64;
+      const size_t perQueue  = 16384;
+      const size_t numItems  = numQueues * perQueue;
+
+      section("Merge 64 queues of 16,384 into one");
+
+      std::vector<std::vector<int>> items(numQueues);
+      unsigned int seed = 8080;
+      for (std::vector<int> & queue : items)
+         for (size_t i = 0; i < perQueue; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            queue.push_back((int)(seed >> 1));
+         }
+      long long checksum = 0;
+
+      // priority_queue: pop each worker's queue into the first
+      {
+         std::vector<custom::priority_queue<int>> queues(numQueues);
+         for (size_t q = 0; q < numQueues; q++)
+            for (int item : items[q])
+               queues[q].push(item);
+         Timer timer;
+         for (size_t q = 1; q < numQueues; q++)
+            while (!queues[q].empty())
+            {
+               queues[0].push(queues[q].top());
+               queues[q].pop();
+            }
+         report("priority_queue push each item", timer.seconds(), numItems);
+         checksum += queues[0].top();
+      }
+
+      // priority_queue: gather the items and heapify once
+      {
+         Timer timer;
+         custom::vector<int> all;
+         all.reserve(numItems);
+         for (size_t q = 0; q < numQueues; q++)
+            for (int item : items[q])
+               all.push_back(item);
+         custom::priority_queue<int> merged(std::move(all));
+         report("priority_queue one heapify", timer.seconds(), numItems);
+         checksum -= merged.top();
+      }
+
+      // leftist heaps on one pool: 63 melds
+      {
+         std::shared_ptr<custom::leftist_heap<int>::pool> nodes =
+            std::make_shared<custom::leftist_heap<int>::pool>();
+         nodes->reserve(numItems);
+         std::vector<custom::leftist_heap<int>> heaps;
+         for (size_t q = 0; q < numQueues; q++)
+         {
+            heaps.push_back(custom::leftist_heap<int>(nodes));
+            for (int item : items[q])
+               heaps.back().push(item);
+         }
+         Timer timer;
+         for (size_t q = 1; q < numQueues; q++)
+            heaps[0].meld(heaps[q]);
+         report("leftist_heap meld, shared pool", timer.seconds(), numQueues - 1);
+         checksum += heaps[0].top();
+      }
+
+      // leftist heaps, one pool each: the nodes move
+      {
+         std::vector<custom::leftist_heap<int>> heaps(numQueues);
+         heaps[0].get_pool()->reserve(numItems);
+         for (size_t q = 0; q < numQueues; q++)
+            for (int item : items[q])
+               heaps[q].push(item);
+         Timer timer;
+         for (size_t q = 1; q < numQueues; q++)
+            heaps[0].meld(heaps[q]);
+         report("leftist_heap meld, separate pools", timer.seconds(), numItems);
+         checksum -= heaps[0].top();
+      }
+
+      if (checksum != 0)
+         report("(the merges disagree)", 0.0);
+   }
+};
@@ -0,0 +1,96 @@
+/***********************************************************************
+ * Header:
+ *    BENCH MAPPED PRIORITY QUEUE
+ * Summary:
+ *    Benchmarks for the priority queue in a mapped file: how long a
+ *    restart takes with ten million items, reopening the file against
+ *    heapifying them again in memory, and what each msync policy adds
+ *    to a push and pop.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include "mapped_priority_queue.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <cstdio>       // for std::remove
+#include <filesystem>   // for std::filesystem::temp_directory_path
+#include <string>
+
+/*************************************************
+ * BENCH MAPPED PRIORITY QUEUE
+ *************************************************/
+class BenchMappedPriorityQueue : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numItems = 10000000;
+      std::string path = (std::filesystem::temp_directory_path() / "bench-mapped.heap").string();
+      std::remove(path.c_str());
+
+      section("Mapped priority queue: restart with 10,000,000 ints");
+      {
+         Timer timer;
+         custom::mapped_priority_queue<int> queue(path);
+         queue.reserve(numItems);
+         unsigned int seed = 1414;
+         for (size_t i = 0; i < numItems; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            queue.push((int)(seed >> 1));
+         }
+         report("fill the file (once)", timer.seconds(), numItems);
+      }
+      {
+         Timer timer;
+         custom::mapped_priority_queue<int> queue(path);
+         volatile int top = queue.top();
+         (void)top;
+         report("reopen the file", timer.seconds());
+      }
+      {
+         Timer timer;
+         custom::vector<int> items;
+         items.reserve(numItems);
+         unsigned int seed = 1414;
+         for (size_t i = 0; i < numItems; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            items.push_back((int)(seed >> 1));
+         }
+         custom::priority_queue<int> queue(std::move(items));
+         report("rebuild a priority_queue", timer.seconds());
+      }
+
+      section("Mapped priority queue: pop + push on 10,000,000 ints");
+      policy("msync none", path, custom::msync_policy::none, 1000000);
+      policy("msync async", path, custom::msync_policy::async, 1000);
+      policy("msync sync", path, custom::msync_policy::sync, 100);
+
+      std::remove(path.c_str());
+   }
+
+private:
+   void policy(const std::string & label, const std::string & path,
+               custom::msync_policy policy, size_t numSteps)
+   {
+      custom::mapped_priority_queue<int> queue(path, policy);
+      unsigned int seed = 99;
+      Timer timer;
+      for (size_t i = 0; i < numSteps; i++)
+      {
+         queue.pop();
+         seed = seed * 1103515245 + 12345;
+         queue.push((int)(seed >> 1));
+      }
+      report(label, timer.seconds(), numSteps);
+   }
+};
+
+#endif // __linux__
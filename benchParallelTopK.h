@@ -0,0 +1,94 @@
+/***********************************************************************
+ * Header:
+ *    BENCH PARALLEL TOP K
+ * Summary:
+ *    Benchmarks for the parallel top-K search: the best 100 of
+ *    twenty million scores on 1, 2, 4... threads up to one per core,
+ *    against every thread pushing into one shared priority_queue.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "parallel_top_k.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*************************************************
+ * BENCH PARALLEL TOP K
+ *************************************************/
+class BenchParallelTopK : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numKeys = 20000000;
+      size_t numCores = std::thread::hardware_concurrency();
+      if (numCores == 0)
+         numCores = 1;
+
+      section("Parallel top 100 of 20,000,000 scores");
+
+      std::vector<int> keys(numKeys);
+      unsigned int seed = 2024;
+      for (size_t i = 0; i < numKeys; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         keys[i] = (int)(seed >> 1);
+      }
+
+      double oneThread = 0.0;
+      for (size_t numThreads = 1; ; numThreads *= 2)
+      {
+         if (numThreads > numCores)
+            numThreads = numCores;
+
+         Timer timer;
+         custom::vector<int> best = custom::parallel_top_k<100>(keys.begin(), keys.end(), numThreads);
+         double seconds = timer.seconds();
+         if (numThreads == 1)
+            oneThread = seconds;
+         report("parallel_top_k " + std::to_string(numThreads) + " threads, " +
+                std::to_string(oneThread / seconds).substr(0, 4) + "x",
+                seconds, numKeys);
+
+         if (numThreads == numCores)
+            break;
+      }
+
+      sharedQueue(keys, numCores);
+   }
+
+private:
+   // the baseline: one locked queue holding everything, popped K times
+   void sharedQueue(const std::vector<int> & keys, size_t numThreads)
+   {
+      Timer timer;
+      custom::priority_queue<int> queue;
+      std::mutex lock;
+      custom::vector<std::thread> threads;
+      for (size_t t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&, t]()
+         {
+            size_t begin = keys.size() *  t      / numThreads;
+            size_t end   = keys.size() * (t + 1) / numThreads;
+            for (size_t i = begin; i < end; i++)
+            {
+               std::lock_guard<std::mutex> guard(lock);
+               queue.push(keys[i]);
+            }
+         }));
+      for (size_t t = 0; t < numThreads; t++)
+         threads[t].join();
+      for (int i = 0; i < 100 && !queue.empty(); i++)
+         queue.pop();
+      report("shared priority_queue " + std::to_string(numThreads) + " threads",
+             timer.seconds(), keys.size());
+   }
+};
@@ -0,0 +1,105 @@
+/***********************************************************************
+ * Header:
+ *    BENCH PERSISTENT HEAP
+ * Summary:
+ *    Benchmarks for forking a queue of 100,000 items, the way a planner
+ *    tries out what-ifs: every fork copies the queue, does a few pushes
+ *    and pops, and is thrown away. A priority_queue copies its vector
+ *    each time; a persistent_heap shares its nodes. Then plain push and
+ *    pop on one queue, where the persistent heap pays for its copies.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "persistent_heap.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+/*************************************************
+ * BENCH PERSISTENT HEAP
+ *************************************************/
+class BenchPersistentHeap : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numItems = 100000;   // in the queue being forked
+      const size_t numForks = 10000;
+      const size_t perFork  = 8;        // push + pop pairs in each fork
+      const size_t numSteps = 1000000;  // push + pop pairs on one queue
+
+      custom::priority_queue<int> queue;
+      custom::persistent_heap<int> heap;
+      heap.get_pool()->reserve(numItems + numItems / 4);
+      for (size_t i = 0; i < numItems; i++)
+      {
+         int value = (int)(i * 2654435761u >> 1);
+         queue.push(value);
+         heap = heap.push(value);
+      }
+      long long checksum = 0;
+
+      section("Fork a queue of 100,000 items 10,000 times, 8 push + pop each");
+      {
+         Timer timer;
+         unsigned int seed = 1;
+         for (size_t f = 0; f < numForks; f++)
+         {
+            custom::priority_queue<int> fork(queue);
+            for (size_t i = 0; i < perFork; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               fork.push((int)(seed >> 1));
+               fork.pop();
+            }
+            checksum += fork.top();
+         }
+         report("priority_queue copy", timer.seconds(), numForks);
+      }
+      {
+         Timer timer;
+         unsigned int seed = 1;
+         for (size_t f = 0; f < numForks; f++)
+         {
+            custom::persistent_heap<int> fork(heap);
+            for (size_t i = 0; i < perFork; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               fork = fork.push((int)(seed >> 1)).pop();
+            }
+            checksum -= fork.top();
+         }
+         report("persistent_heap snapshot", timer.seconds(), numForks);
+      }
+
+      section("1,000,000 push + pop on one queue of 100,000 items");
+      {
+         Timer timer;
+         unsigned int seed = 2;
+         for (size_t i = 0; i < numSteps; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            queue.push((int)(seed >> 1));
+            queue.pop();
+         }
+         report("priority_queue", timer.seconds(), numSteps);
+         checksum += queue.top();
+      }
+      {
+         Timer timer;
+         unsigned int seed = 2;
+         for (size_t i = 0; i < numSteps; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            heap = heap.push((int)(seed >> 1)).pop();
+         }
+         report("persistent_heap", timer.seconds(), numSteps);
+         checksum -= heap.top();
+      }
+
+      if (checksum != 0)
+         report("(the queues disagree)", 0.0);
+   }
+};
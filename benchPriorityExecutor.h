@@ -0,0 +1,166 @@
+/***********************************************************************
+ * Header:
+ *    BENCH PRIORITY EXECUTOR
+ * Summary:
+ *    Benchmarks for the priority executor: task throughput and
+ *    how long an urgent task waits behind a backlog, compared to a
+ *    pool of threads sharing a single locked priority queue.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "priority_executor.h"
+#include "benchmark.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*************************************************
+ * SHARED QUEUE EXECUTOR
+ * The baseline: every worker pulls from the same
+ * priority queue behind the same mutex
+ *************************************************/
+class SharedQueueExecutor
+{
+public:
+   explicit SharedQueueExecutor(size_t numThreads) : sequence(0), done(false)
+   {
+      for (size_t i = 0; i < numThreads; i++)
+         threads.push_back(std::thread(&SharedQueueExecutor::workerLoop, this));
+   }
+   ~SharedQueueExecutor()
+   {
+      {
+         std::lock_guard<std::mutex> guard(lock);
+         done = true;
+      }
+      wake.notify_all();
+      for (size_t i = 0; i < threads.size(); i++)
+         threads[i].join();
+   }
+
+   template <class F>
+   void submit(int priority, F && fn)
+   {
+      {
+         std::lock_guard<std::mutex> guard(lock);
+         heap.push(Task{ priority, sequence++, std::function<void()>(std::forward<F>(fn)) });
+      }
+      wake.notify_one();
+   }
+
+private:
+   struct Task
+   {
+      int priority;
+      size_t sequence;
+      std::function<void()> fn;
+      bool operator < (const Task & rhs) const
+      {
+         if (priority != rhs.priority)
+            return priority < rhs.priority;
+         return sequence > rhs.sequence;
+      }
+   };
+
+   void workerLoop()
+   {
+      for (;;)
+      {
+         Task task;
+         {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this]() { return done || !heap.empty(); });
+            if (heap.empty())
+               return;
+            task = heap.top();
+            heap.pop();
+         }
+         task.fn();
+      }
+   }
+
+   custom::priority_queue<Task> heap;
+   custom::vector<std::thread> threads;
+   size_t sequence;
+   std::mutex lock;
+   std::condition_variable wake;
+   bool done;
+};
+
+/*************************************************
+ * BENCH PRIORITY EXECUTOR
+ *************************************************/
+class BenchPriorityExecutor : public Benchmark
+{
+public:
+   void run()
+   {
+      size_t numThreads = std::thread::hardware_concurrency();
+      if (numThreads == 0)
+         numThreads = 4;
+
+      section("PriorityExecutor: throughput, 1,000,000 empty tasks");
+      for (size_t threads = 1; threads <= numThreads; threads *= 2)
+      {
+         report("work stealing, threads=" + std::to_string(threads),
+                throughput<custom::priority_executor>(threads, 1000000), 1000000);
+         report("shared queue,  threads=" + std::to_string(threads),
+                throughput<SharedQueueExecutor>(threads, 1000000), 1000000);
+      }
+
+      section("PriorityExecutor: urgent task latency behind 100,000 queued tasks");
+      for (size_t threads = 1; threads <= numThreads; threads *= 2)
+      {
+         report("work stealing, threads=" + std::to_string(threads),
+                inversion<custom::priority_executor>(threads, 100000));
+         report("shared queue,  threads=" + std::to_string(threads),
+                inversion<SharedQueueExecutor>(threads, 100000));
+      }
+   }
+
+private:
+   // seconds to submit and drain numTasks empty tasks
+   template <class Executor>
+   double throughput(size_t numThreads, size_t numTasks)
+   {
+      std::atomic<size_t> count(0);
+      Timer timer;
+      {
+         Executor executor(numThreads);
+         for (size_t i = 0; i < numTasks; i++)
+            executor.submit((int)(i % 16), [&count]() { count++; });
+      }  // the destructor drains
+      return timer.seconds();
+   }
+
+   // seconds between submitting an urgent task and it starting
+   template <class Executor>
+   double inversion(size_t numThreads, size_t backlog)
+   {
+      std::atomic<bool> ran(false);
+      Timer timer;
+      {
+         Executor executor(numThreads);
+         for (size_t i = 0; i < backlog; i++)
+            executor.submit(0, []() { spin(1000); });
+         timer.reset();
+         executor.submit(1, [&]()
+         {
+            if (!ran)
+               timer.stop();
+            ran = true;
+         });
+         while (!ran)
+            std::this_thread::yield();
+      }
+      return timer.seconds();
+   }
+};
@@ -0,0 +1,59 @@
+/***********************************************************************
+ * Source:
+ *    Benchmark
+ * Summary:
+ *    Driver for the performance benchmarks. This has its own main()
+ *    so it is excluded from the unit test build. Build it optimized:
+ *       g++ -O2 -std=c++17 -pthread benchPriorityQueue.cpp -o bench
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#include "benchPriorityExecutor.h"   // for the priority executor benchmarks
+#include "benchTimer.h"              // for the timer engine benchmarks
+#include "benchTopK.h"               // for the top-K collector benchmarks
+#include "benchParallelTopK.h"       // for the parallel top-K benchmarks
+#include "benchSlidingWindow.h"      // for the sliding window benchmarks
+#include "benchKwayMerge.h"          // for the k-way merge benchmarks
+#include "benchFibonacciHeap.h"      // for the Fibonacci heap benchmarks
+#include "benchLeftistHeap.h"        // for the leftist heap benchmarks
+#include "benchPersistentHeap.h"     // for the persistent heap benchmarks
+#include "benchWeakHeap.h"           // for the weak heap benchmarks
+#include "benchSequenceHeap.h"       // for the sequence heap benchmarks
+#include "benchBHeap.h"              // for the B-heap benchmarks
+#include "benchExternalPriorityQueue.h" // for the external priority queue benchmarks
+#include "benchMappedPriorityQueue.h"   // for the mapped priority queue benchmarks
+#include "benchDurablePriorityQueue.h"  // for the durable priority queue benchmarks
+#include "benchVectorView.h"         // for the vector file and view benchmarks
+#include "benchSharedPriorityQueue.h" // for the shared-memory priority queue benchmarks
+#include "benchQueueServer.h"        // for the queue server benchmarks
+
+/**********************************************************************
+ * MAIN
+ * Run every benchmark in turn
+ ***********************************************************************/
+int main()
+{
+   BenchPriorityExecutor().run();
+   BenchTimer().run();
+   BenchTopK().run();
+   BenchParallelTopK().run();
+   BenchSlidingWindow().run();
+   BenchKwayMerge().run();
+   BenchFibonacciHeap().run();
+   BenchLeftistHeap().run();
+   BenchPersistentHeap().run();
+   BenchWeakHeap().run();
+   BenchSequenceHeap().run();
+   BenchBHeap().run();
+   BenchExternalPriorityQueue().run();
+   BenchVectorView().run();
+#ifdef __linux__
+   BenchMappedPriorityQueue().run();
+   BenchDurablePriorityQueue().run();
+   BenchSharedPriorityQueue().run();
+   BenchQueueServer().run();
+#endif
+
+   return 0;
+}
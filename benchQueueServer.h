@@ -0,0 +1,126 @@
+/***********************************************************************
+ * Header:
+ *    BENCH QUEUE SERVER
+ * Summary:
+ *    Load generation for the priority queue server, all on localhost.
+ *    Clients on their own threads push and pop against one server
+ *    thread, each waiting for every answer; then one client sends its
+ *    requests in runs, without waiting. Each result also shows how
+ *    many requests the server applied per tick: the batch it got to
+ *    put into the heap in a single pass.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include "queue_server.h"
+#include "benchmark.h"
+
+#include <cstdio>       // for std::snprintf
+#include <filesystem>   // for std::filesystem::temp_directory_path
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>     // for getpid
+
+/*************************************************
+ * BENCH QUEUE SERVER
+ *************************************************/
+class BenchQueueServer : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numSteps = 100000;    // push + pop pairs in all
+      std::string path = (std::filesystem::temp_directory_path() /
+                          ("bench-queue-" + std::to_string(getpid()) + ".sock")).string();
+
+      section("Queue server: 100,000 push + pop, each waiting for its answer");
+      for (int numClients : { 1, 4, 16, 64 })
+         blocking(path, numClients, numSteps);
+
+      section("Queue server: 100,000 push + pop, sent in runs without waiting");
+      for (size_t run : { 10, 100, 1000 })
+         pipelined(path, run, numSteps);
+   }
+
+private:
+   typedef custom::queue_server<int> server_type;
+   typedef custom::queue_client<int> client_type;
+
+   // every client does its share of push, then pop, each a round trip
+   void blocking(const std::string & path, int numClients, size_t numSteps)
+   {
+      server_type server(path);
+      std::thread serving([&server]() { server.run(); });
+
+      Timer timer;
+      std::vector<std::thread> clients;
+      for (int c = 0; c < numClients; c++)
+         clients.push_back(std::thread([&path, c, numClients, numSteps]()
+         {
+            client_type client(path);
+            unsigned int seed = c + 1;
+            int item;
+            for (size_t i = 0; i < numSteps / numClients; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               client.push((int)(seed >> 1));
+               client.pop(item);
+            }
+         }));
+      for (std::thread & client : clients)
+         client.join();
+      double seconds = timer.seconds();
+
+      server.stop();
+      serving.join();
+      report(std::to_string(numClients) + (numClients == 1 ? " client" : " clients") +
+             perTick(server), seconds, numSteps);
+   }
+
+   // one client sends run pushes and run pops at a time, then reads the answers
+   void pipelined(const std::string & path, size_t run, size_t numSteps)
+   {
+      server_type server(path);
+      std::thread serving([&server]() { server.run(); });
+
+      Timer timer;
+      {
+         client_type client(path);
+         unsigned int seed = 7;
+         int item;
+         for (size_t done = 0; done < numSteps; done += run)
+         {
+            for (size_t i = 0; i < run; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               client.send_push((int)(seed >> 1));
+            }
+            for (size_t i = 0; i < run; i++)
+               client.send_pop();
+            client.flush();
+            for (size_t i = 0; i < 2 * run; i++)
+               client.receive(item);
+         }
+      }
+      double seconds = timer.seconds();
+
+      server.stop();
+      serving.join();
+      report("runs of " + std::to_string(run) + perTick(server), seconds, numSteps);
+   }
+
+   static std::string perTick(const server_type & server)
+   {
+      char text[48];
+      std::snprintf(text, sizeof(text), " (%.1f per tick)",
+                    server.numTicks() ? (double)server.numRequests() / (double)server.numTicks() : 0.0);
+      return text;
+   }
+};
+
+#endif // __linux__
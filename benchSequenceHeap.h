@@ -0,0 +1,76 @@
+/***********************************************************************
+ * Header:
+ *    BENCH SEQUENCE HEAP
+ * Summary:
+ *    Benchmarks for very large queues: push n random ints, then pop
+ *    them all, on the sequence heap and on the binary heap. n starts
+ *    at a million and grows tenfold up to maxSize. The default stops
+ *    at ten million; pass 10^8 or 10^9 on a machine with the memory
+ *    for it (about 3 x 4n bytes for the sequence heap at its peak).
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "sequence_heap.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <string>
+
+/*************************************************
+ * BENCH SEQUENCE HEAP
+ *************************************************/
+class BenchSequenceHeap : public Benchmark
+{
+public:
+   explicit BenchSequenceHeap(size_t maxSize = 10000000) : maxSize(maxSize) {}
+
+   void run()
+   {
+      for (size_t n = 1000000; n <= maxSize; n *= 10)
+      {
+         section("Sequence heap: push then pop " + std::to_string(n) + " ints");
+         unsigned long long sumSequence = 0;
+         unsigned long long sumBinary = 0;
+         {
+            Timer timer;
+            custom::sequence_heap<int> heap;
+            unsigned int seed = 4242;
+            for (size_t i = 0; i < n; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               heap.push((int)(seed >> 1));
+            }
+            while (!heap.empty())
+            {
+               sumSequence = sumSequence * 31 + (unsigned int)heap.top();
+               heap.pop();
+            }
+            report("sequence_heap (m=256, k=64)", timer.seconds(), 2 * n);
+         }
+         {
+            Timer timer;
+            custom::priority_queue<int> heap;
+            unsigned int seed = 4242;
+            for (size_t i = 0; i < n; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               heap.push((int)(seed >> 1));
+            }
+            while (!heap.empty())
+            {
+               sumBinary = sumBinary * 31 + (unsigned int)heap.top();
+               heap.pop();
+            }
+            report("priority_queue", timer.seconds(), 2 * n);
+         }
+         if (sumSequence != sumBinary)
+            report("(the two queues disagree)", 0.0);
+      }
+   }
+
+private:
+   size_t maxSize;
+};
@@ -0,0 +1,141 @@
+/***********************************************************************
+ * Header:
+ *    BENCH SHARED PRIORITY QUEUE
+ * Summary:
+ *    Benchmarks for the priority queue in shared memory: a push and a
+ *    pop done in place, against the same pair sent to a broker process
+ *    that owns a priority_queue and answers over a socket, and the
+ *    shared queue again with several worker processes at once.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include "shared_priority_queue.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <cstdint>
+#include <string>
+#include <sys/socket.h>   // for socketpair
+#include <sys/wait.h>     // for waitpid
+#include <unistd.h>       // for fork, read and write
+
+/*************************************************
+ * BENCH SHARED PRIORITY QUEUE
+ *************************************************/
+class BenchSharedPriorityQueue : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numItems = 100000;   // in the queue throughout
+      const size_t numSteps = 200000;   // push + pop pairs
+      std::string name = "/bench-shared-" + std::to_string(getpid());
+      custom::shared_priority_queue<int>::remove(name);
+
+      section("Shared priority queue: push + pop with 100,000 ints queued");
+      {
+         custom::shared_priority_queue<int> queue(name, 1 << 20);
+         for (size_t i = 0; i < numItems; i++)
+            queue.push((int)(i * 2654435761u >> 1));
+         Timer timer;
+         steps(queue, numSteps, 1);
+         report("shared queue, in place", timer.seconds(), numSteps);
+      }
+      {
+         Timer timer;
+         broker(numItems, numSteps / 10);
+         report("broker over a socket", timer.seconds(), numSteps / 10);
+      }
+
+      section("Shared priority queue: 200,000 push + pop in all, split across processes");
+      for (int numWorkers : { 1, 2, 4, 8 })
+      {
+         custom::shared_priority_queue<int> queue(name, 1 << 20);
+         Timer timer;
+         pid_t children[8];
+         for (int w = 0; w < numWorkers; w++)
+         {
+            children[w] = fork();
+            if (children[w] == 0)
+            {
+               custom::shared_priority_queue<int> worker(name, 1);
+               steps(worker, numSteps / numWorkers, w + 2);
+               _exit(0);
+            }
+         }
+         for (int w = 0; w < numWorkers; w++)
+            waitpid(children[w], nullptr, 0);
+         report(std::to_string(numWorkers) + (numWorkers == 1 ? " worker" : " workers"),
+                timer.seconds(), numSteps);
+      }
+
+      custom::shared_priority_queue<int>::remove(name);
+   }
+
+private:
+   static void steps(custom::shared_priority_queue<int> & queue, size_t numSteps, unsigned int seed)
+   {
+      int item;
+      for (size_t i = 0; i < numSteps; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         queue.push((int)(seed >> 1));
+         queue.pop(item);
+      }
+   }
+
+   // the broker reads {op, value} and answers every request with a value
+   static void broker(size_t numItems, size_t numSteps)
+   {
+      int ends[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends) != 0)
+         return;
+      pid_t child = fork();
+      if (child == 0)
+      {
+         ::close(ends[0]);
+         custom::priority_queue<int> queue;
+         for (size_t i = 0; i < numItems; i++)
+            queue.push((int)(i * 2654435761u >> 1));
+         int32_t request[2];
+         while (read(ends[1], request, sizeof(request)) == sizeof(request))
+         {
+            int32_t answer = 0;
+            if (request[0] == 0)
+               queue.push(request[1]);
+            else if (!queue.empty())
+            {
+               answer = queue.top();
+               queue.pop();
+            }
+            if (write(ends[1], &answer, sizeof(answer)) != sizeof(answer))
+               break;
+         }
+         _exit(0);
+      }
+      ::close(ends[1]);
+
+      unsigned int seed = 1;
+      bool ok = true;
+      for (size_t i = 0; ok && i < numSteps; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int32_t push[2] = { 0, (int32_t)(seed >> 1) };
+         int32_t pop[2] = { 1, 0 };
+         int32_t answer;
+         ok = write(ends[0], push, sizeof(push)) == sizeof(push) &&
+              read(ends[0], &answer, sizeof(answer)) == sizeof(answer) &&
+              write(ends[0], pop, sizeof(pop)) == sizeof(pop) &&
+              read(ends[0], &answer, sizeof(answer)) == sizeof(answer);
+      }
+      ::close(ends[0]);
+      waitpid(child, nullptr, 0);
+   }
+};
+
+#endif // __linux__
@@ -0,0 +1,87 @@
+/***********************************************************************
+ * Header:
+ *    BENCH SLIDING WINDOW
+ * Summary:
+ *    Benchmarks for the sliding windows: ten million latencies, a
+ *    window of the last 10,000 events, and a query after every 1,000.
+ *    The baseline rebuilds a priority_queue from the window each time.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "sliding_window.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <string>
+#include <vector>
+
+/*************************************************
+ * BENCH SLIDING WINDOW
+ *************************************************/
+class BenchSlidingWindow : public Benchmark
+{
+public:
+   void run()
+   {
+      const int numEvents  = 10000000;
+      const int windowSize = 10000;
+      const int queryEvery = 1000;
+
+      section("Sliding window: 10,000,000 events, last 10,000, query every 1,000");
+
+      std::vector<int> latencies(numEvents);
+      unsigned int seed = 2024;
+      for (int i = 0; i < numEvents; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         latencies[i] = (int)((seed >> 8) % 100000);
+      }
+
+      long long checksum = 0;
+      Timer timer;
+      custom::sliding_max<int, int> window;
+      for (int i = 0; i < numEvents; i++)
+      {
+         window.push(i, latencies[i]);
+         window.expire(i - windowSize + 1);
+         if (i % queryEvery == 0)
+            checksum += window.max();
+      }
+      report("sliding_max", timer.seconds(), numEvents);
+
+      timer.reset();
+      custom::sliding_top_k<int, 10, int> top;
+      for (int i = 0; i < numEvents; i++)
+      {
+         top.push(i, latencies[i]);
+         top.expire(i - windowSize + 1);
+         if (i % queryEvery == 0)
+            checksum += top.top()[0];
+      }
+      report("sliding_top_k<10>", timer.seconds(), numEvents);
+
+      // the baseline only rebuilds a tenth as often: it is that slow
+      timer.reset();
+      int numRebuilds = 0;
+      for (int i = windowSize; i < numEvents; i += queryEvery * 10)
+      {
+         custom::vector<int> recent;
+         recent.reserve(windowSize);
+         for (int j = i - windowSize + 1; j <= i; j++)
+            recent.push_back(latencies[j]);
+         custom::priority_queue<int> queue(std::move(recent));
+         for (int k = 0; k < 10; k++)
+         {
+            checksum += queue.top();
+            queue.pop();
+         }
+         numRebuilds++;
+      }
+      report("priority_queue rebuild, per query", timer.seconds() / numRebuilds);
+      if (checksum == 0)
+         report("(no events)", 0.0);
+   }
+};
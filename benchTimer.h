@@ -0,0 +1,82 @@
+/***********************************************************************
+ * Header:
+ *    BENCH TIMER
+ * Summary:
+ *    Benchmarks for the two timer engines, heap_timer and
+ *    timing_wheel, replaying the same connection-timeout trace:
+ *    a million timers over 30 seconds, most cancelled before they
+ *    fire, with the clock advanced one millisecond at a time.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "heap_timer.h"
+#include "timing_wheel.h"
+#include "benchmark.h"
+
+#include <chrono>
+#include <string>
+
+/*************************************************
+ * BENCH TIMER
+ *************************************************/
+class BenchTimer : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numTimers = 1000000;
+      const int    horizonMs = 30000;
+
+      section("Timers: 1,000,000 timeouts over 30 s, 90% cancelled, 1 ms steps");
+
+      custom::heap_timer heap;
+      replay(heap, "heap_timer  ", numTimers, horizonMs);
+
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      replay(wheel, "timing_wheel", numTimers, horizonMs);
+   }
+
+private:
+   // a fixed point in time, ms milliseconds after the epoch
+   static std::chrono::steady_clock::time_point at(int ms)
+   {
+      return std::chrono::steady_clock::time_point(std::chrono::milliseconds(ms));
+   }
+
+   // schedule, cancel most, then step the clock to the horizon
+   template <class Engine>
+   void replay(Engine & engine, const std::string & name, size_t numTimers, int horizonMs)
+   {
+      custom::vector<typename Engine::handle> handles;
+      handles.reserve(numTimers);
+      size_t numFired = 0;
+      unsigned int seed = 2024;
+
+      Timer timer;
+      for (size_t i = 0; i < numTimers; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int deadline = (int)((seed >> 4) % (unsigned int)horizonMs);
+         handles.push_back(engine.schedule(at(deadline), [&numFired]() { numFired++; }));
+      }
+      report(name + " schedule", timer.seconds(), numTimers);
+
+      timer.reset();
+      size_t numCancelled = 0;
+      for (size_t i = 0; i < numTimers; i++)
+         if (i % 10 != 0)
+         {
+            engine.cancel(handles[i]);
+            numCancelled++;
+         }
+      report(name + " cancel", timer.seconds(), numCancelled);
+
+      timer.reset();
+      for (int now = 0; now <= horizonMs; now++)
+         engine.expire(at(now));
+      report(name + " expire " + std::to_string(numFired), timer.seconds(), numFired);
+   }
+};
@@ -0,0 +1,83 @@
+/***********************************************************************
+ * Header:
+ *    BENCH TOP K
+ * Summary:
+ *    Benchmarks for the top-K collector: keeping the best 100 of
+ *    ten million scores, one push() at a time against push_batch()
+ *    with each SIMD level the processor supports.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "top_k.h"
+#include "benchmark.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*************************************************
+ * BENCH TOP K
+ *************************************************/
+class BenchTopK : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numKeys = 10000000;
+
+      section("Top 100 of 10,000,000 scores");
+
+      std::vector<float>   floats(numKeys);
+      std::vector<int32_t> ints(numKeys);
+      std::vector<int64_t> longs(numKeys);
+      unsigned int seed = 2024;
+      for (size_t i = 0; i < numKeys; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         ints[i]   = (int32_t)(seed >> 1);
+         floats[i] = (float)ints[i] / 3.0f;
+         longs[i]  = (int64_t)ints[i] << 20;
+      }
+
+      ingest(floats, "float  ");
+      ingest(ints,   "int32  ");
+      ingest(longs,  "int64  ");
+   }
+
+private:
+   template <class T>
+   void ingest(const std::vector<T> & keys, const std::string & name)
+   {
+      Timer timer;
+      custom::top_k<T, 100> single;
+      for (size_t i = 0; i < keys.size(); i++)
+         single.push(keys[i]);
+      report(name + " push()", timer.seconds(), keys.size());
+
+      // the same path push_batch() takes, pinned to each level in turn
+      static const char * names[] = { "scalar", "sse2", "avx2" };
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+      {
+         timer.reset();
+         custom::top_k<T, 100> batched;
+         batched.push_batch(keys.data(), 100);
+         size_t i = 100;
+         while (i < keys.size())
+         {
+            i += custom::simd::skip<true>(keys.data() + i, keys.size() - i,
+                                          batched.threshold(), (custom::simd::level)use);
+            if (i < keys.size())
+               batched.push(keys[i++]);
+         }
+         report(name + " skip " + names[use], timer.seconds(), keys.size());
+      }
+
+      timer.reset();
+      custom::top_k<T, 100> batched;
+      batched.push_batch(keys.data(), keys.size());
+      report(name + " push_batch()", timer.seconds(), keys.size());
+   }
+};
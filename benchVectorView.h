@@ -0,0 +1,122 @@
+/***********************************************************************
+ * Header:
+ *    BENCH VECTOR VIEW
+ * Summary:
+ *    Benchmarks for handing a vector of records from one stage to the
+ *    next through a file: one item at a time with fwrite and push_back,
+ *    against save_vector and load_vector, against mapping the file with
+ *    vector_view. The view is timed to open and, separately, to read
+ *    every item once.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "vector_view.h"
+#include "vector.h"
+#include "benchmark.h"
+
+#include <cstdint>
+#include <cstdio>       // for std::fopen and std::remove
+#include <filesystem>   // for std::filesystem::temp_directory_path
+#include <string>
+
+/*************************************************
+ * BENCH VECTOR VIEW
+ *************************************************/
+class BenchVectorView : public Benchmark
+{
+public:
+   BenchVectorView(size_t numItems = 10000000) : numItems(numItems) {}
+
+   void run()
+   {
+      std::string path = (std::filesystem::temp_directory_path() / "bench-vector.bin").string();
+      custom::vector<record> items;
+      items.reserve(numItems);
+      for (size_t i = 0; i < numItems; i++)
+         items.push_back(record{ i * 2654435761u, (double)i, (int32_t)i, 0 });
+
+      section("Vector files: " + std::to_string(numItems) + " records of 24 bytes");
+      uint64_t expected = sum(&items.front(), numItems);
+
+      // today: one fwrite and one push_back per item
+      {
+         Timer timer;
+         std::FILE * file = std::fopen(path.c_str(), "wb");
+         uint64_t count = numItems;
+         std::fwrite(&count, sizeof(count), 1, file);
+         for (size_t i = 0; i < numItems; i++)
+            std::fwrite(&items[i], sizeof(record), 1, file);
+         std::fclose(file);
+         report("save one item at a time", timer.seconds(), numItems);
+      }
+      {
+         Timer timer;
+         std::FILE * file = std::fopen(path.c_str(), "rb");
+         uint64_t count = 0;
+         std::fread(&count, sizeof(count), 1, file);
+         custom::vector<record> loaded;
+         record item;
+         for (uint64_t i = 0; i < count; i++)
+         {
+            std::fread(&item, sizeof(record), 1, file);
+            loaded.push_back(item);
+         }
+         std::fclose(file);
+         report("load one item at a time", timer.seconds(), numItems);
+         if (sum(&loaded.front(), loaded.size()) != expected)
+            report("(the loaded items disagree)", 0.0);
+      }
+
+      // one write, one read
+      {
+         Timer timer;
+         custom::save_vector(items, path);
+         report("save_vector", timer.seconds(), numItems);
+      }
+      {
+         Timer timer;
+         custom::vector<record> loaded = custom::load_vector<record>(path);
+         report("load_vector", timer.seconds(), numItems);
+         if (sum(&loaded.front(), loaded.size()) != expected)
+            report("(the loaded items disagree)", 0.0);
+      }
+
+#ifdef __linux__
+      // no read at all until the pages are touched
+      {
+         Timer timer;
+         custom::vector_view<record> view(path);
+         report("open a vector_view", timer.seconds());
+         timer.reset();
+         uint64_t total = sum(view.data(), view.size());
+         report("   then read every item", timer.seconds(), numItems);
+         if (total != expected)
+            report("(the viewed items disagree)", 0.0);
+      }
+#endif // __linux__
+
+      std::remove(path.c_str());
+   }
+
+private:
+   struct record
+   {
+      uint64_t key;
+      double   value;
+      int32_t  id;
+      int32_t  flags;
+   };
+
+   static uint64_t sum(const record * items, size_t count)
+   {
+      uint64_t total = 0;
+      for (size_t i = 0; i < count; i++)
+         total += items[i].key ^ (uint64_t)items[i].id;
+      return total;
+   }
+
+   size_t numItems;
+};
@@ -0,0 +1,100 @@
+/***********************************************************************
+ * Header:
+ *    BENCH WEAK HEAP
+ * Summary:
+ *    Benchmarks for comparison-heavy keys: 200,000 strings with a
+ *    long shared prefix, compared with strcoll. The weak heap against
+ *    the binary heap, both as a queue and as a sort.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include "weak_heap.h"
+#include "heap.h"
+#include "priority_queue.h"
+#include "benchmark.h"
+
+#include <cstring>   // for std::strcoll
+#include <string>
+#include <vector>
+
+/*************************************************
+ * BENCH WEAK HEAP
+ *************************************************/
+class BenchWeakHeap : public Benchmark
+{
+public:
+   void run()
+   {
+      const size_t numKeys = 200000;
+
+      custom::vector<std::string> keys;
+      unsigned int seed = 1357;
+      std::string prefix = "/var/spool/queue/priority/";
+      for (size_t i = 0; i < numKeys; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         keys.push_back(prefix + std::to_string(seed >> 4));
+      }
+
+      // a queue: build, then pop everything
+      section("Weak heap: build and pop 200,000 strings, strcoll");
+      {
+         custom::vector<std::string> copy(keys);
+         collate::count = 0;
+         Timer timer;
+         custom::weak_heap<std::string, collate> heap(std::move(copy));
+         while (!heap.empty())
+            heap.pop();
+         report(label("weak_heap"), timer.seconds(), numKeys);
+      }
+      {
+         custom::vector<std::string> copy(keys);
+         collate::count = 0;
+         Timer timer;
+         custom::priority_queue<std::string, custom::vector<std::string>, collate> heap(collate(), std::move(copy));
+         while (!heap.empty())
+            heap.pop();
+         report(label("priority_queue"), timer.seconds(), numKeys);
+      }
+
+      // a sort in place
+      section("Weak heap: sort 200,000 strings in place, strcoll");
+      {
+         custom::vector<std::string> copy(keys);
+         collate::count = 0;
+         Timer timer;
+         custom::weak_heapsort(copy.begin(), copy.end(), collate());
+         report(label("weak_heapsort"), timer.seconds(), numKeys);
+      }
+      {
+         custom::vector<std::string> copy(keys);
+         collate::count = 0;
+         Timer timer;
+         custom::make_heap(copy.begin(), copy.end(), collate());
+         custom::sort_heap(copy.begin(), copy.end(), collate());
+         report(label("make_heap + sort_heap"), timer.seconds(), numKeys);
+      }
+   }
+
+private:
+   // a locale-aware less-than that counts how often it runs
+   struct collate
+   {
+      static size_t count;
+      bool operator () (const std::string & lhs, const std::string & rhs) const
+      {
+         count++;
+         return std::strcoll(lhs.c_str(), rhs.c_str()) < 0;
+      }
+   };
+
+   static std::string label(const std::string & name)
+   {
+      return name + " (" + std::to_string(collate::count / 1000) + "k cmp)";
+   }
+};
+
+inline size_t BenchWeakHeap::collate::count = 0;
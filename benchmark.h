@@ -0,0 +1,93 @@
+/***********************************************************************
+ * Header:
+ *    BENCHMARK
+ * Summary:
+ *    The base class to all the benchmark classes: a stopwatch and
+ *    a consistent way to print the results
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <chrono>    // for std::chrono::steady_clock
+#include <iostream>  // for std::cout
+#include <iomanip>   // for std::setw
+#include <string>    // for std::string
+
+/*************************************************
+ * TIMER
+ * A stopwatch. It runs from construction or
+ * reset() until stop() or until it is read.
+ *************************************************/
+class Timer
+{
+public:
+   Timer() { reset(); }
+
+   void reset()
+   {
+      start = std::chrono::steady_clock::now();
+      stopped = false;
+   }
+   void stop()
+   {
+      finish = std::chrono::steady_clock::now();
+      stopped = true;
+   }
+   double seconds() const
+   {
+      std::chrono::steady_clock::time_point end =
+         stopped ? finish : std::chrono::steady_clock::now();
+      return std::chrono::duration<double>(end - start).count();
+   }
+
+private:
+   std::chrono::steady_clock::time_point start;
+   std::chrono::steady_clock::time_point finish;
+   bool stopped;
+};
+
+/*************************************************
+ * BENCHMARK
+ *************************************************/
+class Benchmark
+{
+protected:
+   /*************************************************************
+    * SECTION
+    * Print a heading for a group of results
+    *************************************************************/
+   void section(const std::string & title)
+   {
+      std::cout << "\n" << title << "\n";
+   }
+
+   /*************************************************************
+    * REPORT
+    * Print one result: the wall time and, when given,
+    * the time per operation
+    *************************************************************/
+   void report(const std::string & label, double seconds, size_t numOps = 0)
+   {
+      std::cout << "   " << std::left << std::setw(36) << label << std::right
+                << std::fixed << std::setprecision(6)
+                << std::setw(12) << seconds << " s";
+      if (numOps)
+         std::cout << std::setprecision(1)
+                   << std::setw(10) << seconds * 1e9 / (double)numOps << " ns/op";
+      std::cout << "\n";
+   }
+
+   /*************************************************************
+    * SPIN
+    * Burn roughly the given number of iterations of CPU so a
+    * task has some cost the optimizer cannot remove
+    *************************************************************/
+   static void spin(int iterations)
+   {
+      volatile int sink = 0;
+      for (int i = 0; i < iterations; i++)
+         sink = sink + i;
+   }
+};
@@ -0,0 +1,378 @@
+/***********************************************************************
+ * Header:
+ *    COROUTINE SCHEDULER
+ * Summary:
+ *    A C++20 coroutine scheduler whose ready queue is a priority
+ *    queue rather than a FIFO. A coroutine suspends with
+ *        co_await scheduler.yield(priority);
+ *        co_await scheduler.sleep_until(deadline, priority);
+ *    and is resumed highest priority first, earliest deadline first.
+ *
+ *    The queues hold plain coroutine handles and keys, so once their
+ *    containers have grown to the working set a resume allocates nothing.
+ *
+ *    This will contain the class definition of:
+ *        coroutine_task          : A fire-and-forget coroutine
+ *        coroutine_scheduler     : Runs coroutine_tasks by priority
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <cassert>
+#include <chrono>              // for std::chrono::steady_clock
+#include <condition_variable>  // for std::condition_variable
+#include <coroutine>           // for std::coroutine_handle
+#include <exception>           // for std::terminate
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include "priority_queue.h"
+
+class TestCoroutineScheduler;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * COROUTINE TASK
+ * The return type of a coroutine the scheduler can
+ * run. It starts suspended and frees its own frame
+ * when it finishes.
+ *************************************************/
+class coroutine_task
+{
+public:
+   struct promise_type
+   {
+      coroutine_task get_return_object()
+      {
+         return coroutine_task(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      std::suspend_never  final_suspend()   noexcept { return {}; }
+      void return_void() {}
+      void unhandled_exception() { std::terminate(); }
+   };
+
+   explicit coroutine_task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+   std::coroutine_handle<promise_type> handle;
+};
+
+/*************************************************
+ * COROUTINE SCHEDULER
+ * Resume suspended coroutines by priority. Sleepers
+ * join the ready queue once their deadline passes.
+ *************************************************/
+class coroutine_scheduler
+{
+   friend class ::TestCoroutineScheduler; // give the unit test class access to the privates
+public:
+   typedef std::chrono::steady_clock clock;
+
+   //
+   // construct
+   //
+   coroutine_scheduler() : sequence(0), numRunning(0), stopping(false) {}
+   coroutine_scheduler(const coroutine_scheduler & rhs) = delete;
+   coroutine_scheduler & operator = (const coroutine_scheduler & rhs) = delete;
+  ~coroutine_scheduler();
+
+   //
+   // Awaitables
+   //
+   class yield_awaiter;
+   class sleep_awaiter;
+   yield_awaiter yield(int priority);
+   sleep_awaiter sleep_until(clock::time_point deadline, int priority = 0);
+
+   //
+   // Insert
+   //
+   void spawn(coroutine_task task, int priority = 0)
+   {
+      pushReady(task.handle, priority);
+   }
+   void reserve(size_t numCoroutines);
+
+   //
+   // Run
+   //
+   void run(size_t numThreads = 1);
+   void stop();
+
+   //
+   // Status
+   //
+   size_t size() const
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      return ready.size() + sleeping.size();
+   }
+
+private:
+
+   // a coroutine waiting for a thread; a larger priority runs first
+   struct Ready
+   {
+      int priority;
+      size_t sequence;
+      void * address;    // std::coroutine_handle<>::address()
+
+      bool operator < (const Ready & rhs) const
+      {
+         if (priority != rhs.priority)
+            return priority < rhs.priority;
+         return sequence > rhs.sequence;   // FIFO within a priority
+      }
+   };
+
+   // a coroutine waiting for its deadline; the earliest is on top
+   struct Sleeper
+   {
+      clock::time_point deadline;
+      int priority;
+      size_t sequence;
+      void * address;
+
+      bool operator < (const Sleeper & rhs) const
+      {
+         if (deadline != rhs.deadline)
+            return deadline > rhs.deadline;
+         return sequence > rhs.sequence;
+      }
+   };
+
+   void pushReady(std::coroutine_handle<> handle, int priority);
+   void pushSleeper(std::coroutine_handle<> handle, clock::time_point deadline, int priority);
+   void wakeSleepers(clock::time_point now);
+   void workerLoop();
+
+   custom::priority_queue<Ready>   ready;
+   custom::priority_queue<Sleeper> sleeping;
+   size_t sequence;
+   size_t numRunning;             // coroutines currently being resumed
+   bool stopping;
+   mutable std::mutex lock;
+   std::condition_variable wake;
+};
+
+/************************************************
+ * COROUTINE SCHEDULER :: DESTRUCTOR
+ * Coroutines still queued, after stop() or never
+ * run, belong to us: destroy their frames, and so
+ * their locals. run() must have returned.
+ ***********************************************/
+inline coroutine_scheduler::~coroutine_scheduler()
+{
+   while (!ready.empty())
+   {
+      std::coroutine_handle<>::from_address(ready.top().address).destroy();
+      ready.pop();
+   }
+   while (!sleeping.empty())
+   {
+      std::coroutine_handle<>::from_address(sleeping.top().address).destroy();
+      sleeping.pop();
+   }
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: YIELD AWAITER
+ * Give up the thread; come back at this priority
+ ***********************************************/
+class coroutine_scheduler::yield_awaiter
+{
+public:
+   yield_awaiter(coroutine_scheduler & scheduler, int priority) :
+      scheduler(scheduler), priority(priority) {}
+
+   bool await_ready() const noexcept { return false; }
+   void await_suspend(std::coroutine_handle<> handle)
+   {
+      scheduler.pushReady(handle, priority);
+   }
+   void await_resume() const noexcept {}
+
+private:
+   coroutine_scheduler & scheduler;
+   int priority;
+};
+
+/************************************************
+ * COROUTINE SCHEDULER :: SLEEP AWAITER
+ * Give up the thread until the deadline
+ ***********************************************/
+class coroutine_scheduler::sleep_awaiter
+{
+public:
+   sleep_awaiter(coroutine_scheduler & scheduler, clock::time_point deadline, int priority) :
+      scheduler(scheduler), deadline(deadline), priority(priority) {}
+
+   bool await_ready() const { return deadline <= clock::now(); }
+   void await_suspend(std::coroutine_handle<> handle)
+   {
+      scheduler.pushSleeper(handle, deadline, priority);
+   }
+   void await_resume() const noexcept {}
+
+private:
+   coroutine_scheduler & scheduler;
+   clock::time_point deadline;
+   int priority;
+};
+
+/************************************************
+ * COROUTINE SCHEDULER :: YIELD and SLEEP UNTIL
+ ***********************************************/
+inline coroutine_scheduler::yield_awaiter coroutine_scheduler::yield(int priority)
+{
+   return yield_awaiter(*this, priority);
+}
+
+inline coroutine_scheduler::sleep_awaiter
+coroutine_scheduler::sleep_until(clock::time_point deadline, int priority)
+{
+   return sleep_awaiter(*this, deadline, priority);
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: RESERVE
+ * Size both queues up front so that suspending
+ * and resuming never reallocate
+ ***********************************************/
+inline void coroutine_scheduler::reserve(size_t numCoroutines)
+{
+   std::lock_guard<std::mutex> guard(lock);
+   ready.reserve(numCoroutines);
+   sleeping.reserve(numCoroutines);
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: PUSH READY
+ * Another thread may resume the handle before we
+ * even return, so touch nothing of it afterwards
+ ***********************************************/
+inline void coroutine_scheduler::pushReady(std::coroutine_handle<> handle, int priority)
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      ready.push(Ready{ priority, sequence++, handle.address() });
+   }
+   wake.notify_one();
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: PUSH SLEEPER
+ ***********************************************/
+inline void coroutine_scheduler::pushSleeper(std::coroutine_handle<> handle,
+                                             clock::time_point deadline, int priority)
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      sleeping.push(Sleeper{ deadline, priority, sequence++, handle.address() });
+   }
+   // the new sleeper may be earlier than what the idle threads wait for
+   wake.notify_all();
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: WAKE SLEEPERS
+ * Move every expired sleeper to the ready queue.
+ * The caller holds the lock.
+ ***********************************************/
+inline void coroutine_scheduler::wakeSleepers(clock::time_point now)
+{
+   while (!sleeping.empty() && sleeping.top().deadline <= now)
+   {
+      const Sleeper & sleeper = sleeping.top();
+      ready.push(Ready{ sleeper.priority, sleeper.sequence, sleeper.address });
+      sleeping.pop();
+   }
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: RUN
+ * Resume coroutines on this thread plus numThreads-1
+ * helpers until nothing is ready, sleeping, or
+ * running, or until stop() is called. A stop()
+ * that comes before run() makes it return at once;
+ * the request is cleared as run() returns.
+ ***********************************************/
+inline void coroutine_scheduler::run(size_t numThreads)
+{
+   custom::vector<std::thread> helpers;
+   if (numThreads > 1)
+      helpers.reserve(numThreads - 1);
+   for (size_t i = 1; i < numThreads; i++)
+      helpers.push_back(std::thread(&coroutine_scheduler::workerLoop, this));
+
+   workerLoop();
+
+   for (size_t i = 0; i < helpers.size(); i++)
+      helpers[i].join();
+
+   std::lock_guard<std::mutex> guard(lock);
+   stopping = false;
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: STOP
+ * Ask run() to return once the current resumes end
+ ***********************************************/
+inline void coroutine_scheduler::stop()
+{
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+   }
+   wake.notify_all();
+}
+
+/************************************************
+ * COROUTINE SCHEDULER :: WORKER LOOP
+ ***********************************************/
+inline void coroutine_scheduler::workerLoop()
+{
+   std::unique_lock<std::mutex> guard(lock);
+   for (;;)
+   {
+      if (stopping)
+         break;
+
+      wakeSleepers(clock::now());
+
+      if (!ready.empty())
+      {
+         void * address = ready.top().address;
+         ready.pop();
+         numRunning++;
+         guard.unlock();
+
+         std::coroutine_handle<>::from_address(address).resume();
+
+         guard.lock();
+         numRunning--;
+         if (numRunning == 0 && ready.empty() && sleeping.empty())
+            wake.notify_all();   // let the idle threads see we are done
+         continue;
+      }
+
+      // a running coroutine may still add more work
+      if (sleeping.empty() && numRunning == 0)
+         break;
+
+      if (!sleeping.empty())
+         wake.wait_until(guard, sleeping.top().deadline);
+      else
+         wake.wait(guard);
+   }
+   wake.notify_all();
+}
+
+} // namespace custom
+
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,733 @@
+/***********************************************************************
+ * Header:
+ *    DURABLE PRIORITY QUEUE
+ * Summary:
+ *    A priority_queue that survives a crash, built from a write-ahead
+ *    log and checkpoints of the heap array. Two files sit side by side:
+ *        path.wal    a header, then one record per push or pop:
+ *                    the type, the item's bytes, and a checksum
+ *        path.ckpt   a header, then the whole heap array
+ *    Both headers carry a generation. A checkpoint copies the heap
+ *    array under the lock, then writes the copy to a temporary file
+ *    while pushes and pops carry on into the old log. Once the
+ *    checkpoint is synced and renamed into place, the records that
+ *    came after the copy move to a fresh log of the checkpoint's
+ *    generation. The checkpoint remembers how many records of the old
+ *    log it holds, so until the new log replaces it, the old log is
+ *    still good: recovery skips that many and replays the rest. A log
+ *    of any other generation is ignored.
+ *
+ *    push and pop return once their record is on disk; pushing a range
+ *    costs one write for the lot. Callers that arrive while a write is
+ *    under way wait for the next one, which then carries all of their
+ *    records with a single fdatasync: group commit. After
+ *    checkpointEvery records, the caller that crossed the line also
+ *    writes a checkpoint once its own record is safe.
+ *
+ *    Recovery does not replay the operations one at a time. It takes
+ *    the checkpoint's items, adds every pushed item, takes away every
+ *    popped item (the log holds the popped item's bytes, so the right
+ *    one goes even among equals), and heapifies once. A torn record at
+ *    the end of the log is cut off, and the log carries on from there.
+ *
+ *    If a write or fdatasync of the log fails, the log is cut back to
+ *    its last durable record and the queue is marked failed: the heap
+ *    in memory holds changes that never reached the disk, so every
+ *    later call, and every caller still waiting, throws. Reopening
+ *    recovers what was acknowledged.
+ *
+ *    This will contain the class definition of:
+ *        durable_priority_queue  : A priority queue with a log
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include <algorithm>           // for std::sort and std::lower_bound
+#include <cassert>
+#include <cerrno>              // for errno
+#include <condition_variable>  // for std::condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t and uint32_t
+#include <cstdio>              // for std::rename
+#include <cstring>             // for std::memcpy and std::memcmp
+#include <functional>          // for std::less
+#include <mutex>               // for std::mutex
+#include <stdexcept>           // for std::out_of_range and std::runtime_error
+#include <string>
+#include <system_error>        // for std::system_error
+#include <type_traits>         // for std::is_trivially_copyable
+#include <fcntl.h>             // for open
+#include <sys/stat.h>          // for fstat
+#include <unistd.h>            // for write, pread, fdatasync, ftruncate, lseek and close
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestDurablePriorityQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * DURABLE PRIORITY QUEUE
+ * Safe to share between threads
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class durable_priority_queue
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "durable_priority_queue writes T as raw bytes");
+   friend class ::TestDurablePriorityQueue; // give the unit test class access to the privates
+public:
+
+   //
+   // construct: recover from the files at path, if there are any
+   //
+   explicit durable_priority_queue(const std::string & path,
+                                   size_t checkpointEvery = 1 << 20,
+                                   const Compare & compare = Compare());
+   durable_priority_queue(const durable_priority_queue &) = delete;
+   durable_priority_queue & operator = (const durable_priority_queue &) = delete;
+  ~durable_priority_queue();
+
+   //
+   // Access
+   //
+   T top() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   template <class Iterator>
+   void push(Iterator first, Iterator last);
+
+   //
+   // Remove: FALSE if there was nothing to pop
+   //
+   bool pop(T & t);
+
+   //
+   // Durability
+   //
+   void checkpoint();
+
+   //
+   // Status
+   //
+   size_t size()  const { std::lock_guard<std::mutex> guard(lock); check(); return queue.size(); }
+   bool   empty() const { std::lock_guard<std::mutex> guard(lock); check(); return queue.empty(); }
+
+private:
+   typedef custom::priority_queue<T, custom::vector<T>, Compare> queue_type;
+
+   static constexpr uint32_t VERSION     = 1;
+   static constexpr uint8_t  RECORD_PUSH = 1;
+   static constexpr uint8_t  RECORD_POP  = 2;
+   static constexpr size_t   RECORD_BYTES = 1 + sizeof(T) + 4;
+
+   struct header
+   {
+      char     magic[8];      // "CPQWAL" or "CPQCKPT", and zeros
+      uint32_t version;
+      uint32_t elementSize;
+      uint64_t generation;
+      uint64_t count;         // checkpoint only: the items that follow
+      uint64_t checksum;      // checkpoint only: of the items' bytes
+      uint64_t skip;          // checkpoint only: records of the last log it holds
+   };
+
+   static uint64_t fnv(const void * bytes, size_t size, uint64_t hash = 14695981039346656037ull);
+
+   void recover();
+   void check() const;
+   void append(uint8_t type, const T & t);
+   void waitDurable(std::unique_lock<std::mutex> & held, uint64_t sequence);
+   void maybeCheckpoint(std::unique_lock<std::mutex> & held);
+   void runCheckpoint(std::unique_lock<std::mutex> & held);
+   int  startLog(uint64_t newGeneration, const unsigned char * records, size_t size);
+   void writeAll(int fd, const void * bytes, size_t size, const std::string & name);
+   void syncDirectory();
+
+   std::string       path;
+   size_t            checkpointEvery;
+   queue_type        queue;
+   int               walFd;
+   uint64_t          generation;
+   custom::vector<unsigned char> pending;   // records not yet written
+   uint64_t          numAppended;           // records appended, ever
+   uint64_t          numDurable;            // records on disk, ever
+   uint64_t          durableBytes;          // length of the log through the last of them
+   size_t            numSinceCheckpoint;
+   size_t            numSyncs;              // fdatasyncs, for measuring group commit
+   bool              writing;               // a thread is writing the log
+   bool              checkpointing;         // a thread is writing a checkpoint
+   bool              failed;                // a log write failed; the heap is not on disk
+   Compare           compare;
+   mutable std::mutex      lock;
+   std::condition_variable written;
+};
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: CONSTRUCTOR
+ ***********************************************/
+template <class T, class Compare>
+durable_priority_queue <T, Compare> :: durable_priority_queue(const std::string & path,
+                                                               size_t checkpointEvery,
+                                                               const Compare & compare) :
+   path(path), checkpointEvery(checkpointEvery), queue(compare), walFd(-1), generation(0),
+   numAppended(0), numDurable(0), durableBytes(0), numSinceCheckpoint(0), numSyncs(0),
+   writing(false), checkpointing(false), failed(false), compare(compare)
+{
+   recover();
+}
+
+template <class T, class Compare>
+durable_priority_queue <T, Compare> :: ~durable_priority_queue()
+{
+   if (walFd >= 0)
+      ::close(walFd);
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: FNV
+ * FNV-1a, for the record and checkpoint checksums
+ ***********************************************/
+template <class T, class Compare>
+uint64_t durable_priority_queue <T, Compare> :: fnv(const void * bytes, size_t size, uint64_t hash)
+{
+   const unsigned char * p = static_cast<const unsigned char *>(bytes);
+   for (size_t i = 0; i < size; i++)
+      hash = (hash ^ p[i]) * 1099511628211ull;
+   return hash;
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: RECOVER
+ * Checkpoint + pushes - pops, then one heapify
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: recover()
+{
+   custom::vector<T> items;
+   uint64_t checkpointGeneration = 0;
+   uint64_t checkpointSkip = 0;
+
+   // the checkpoint, if there is one
+   int fd = ::open((path + ".ckpt").c_str(), O_RDONLY);
+   if (fd >= 0)
+   {
+      header h;
+      bool valid = ::read(fd, &h, sizeof(h)) == (ssize_t)sizeof(h) &&
+                   std::memcmp(h.magic, "CPQCKPT", 8) == 0 &&
+                   h.version == VERSION && h.elementSize == sizeof(T);
+      if (valid)
+      {
+         items.resize(h.count);
+         size_t bytes = h.count * sizeof(T);
+         size_t done = 0;
+         while (valid && done < bytes)
+         {
+            ssize_t n = ::read(fd, (char *)&items[0] + done, bytes - done);
+            valid = n > 0;
+            done += valid ? (size_t)n : 0;
+         }
+         valid = valid && fnv(h.count ? &items[0] : nullptr, bytes) == h.checksum;
+      }
+      ::close(fd);
+      if (!valid)
+         throw std::runtime_error(path + ".ckpt is damaged");
+      checkpointGeneration = h.generation;
+      checkpointSkip = h.skip;
+   }
+
+   // the log, if it is of the same generation or the one before, read whole
+   custom::vector<T> popped;
+   custom::vector<unsigned char> log;
+   fd = ::open((path + ".wal").c_str(), O_RDONLY);
+   if (fd >= 0)
+   {
+      struct stat status;
+      if (fstat(fd, &status) == 0 && status.st_size > 0)
+      {
+         log.resize((size_t)status.st_size);
+         size_t done = 0;
+         ssize_t n = 1;
+         while (done < log.size() && (n = ::read(fd, &log[done], log.size() - done)) > 0)
+            done += (size_t)n;
+         log.resize(done);
+      }
+      ::close(fd);
+   }
+   header h;
+   bool current = log.size() >= sizeof(h);
+   if (current)
+   {
+      std::memcpy(&h, &log[0], sizeof(h));
+      current = std::memcmp(h.magic, "CPQWAL", 7) == 0 &&
+                h.version == VERSION && h.elementSize == sizeof(T) &&
+                (h.generation == checkpointGeneration ||
+                 h.generation + 1 == checkpointGeneration);
+   }
+   // the checkpoint was written but the log it came from is still here
+   size_t skip = (current && h.generation != checkpointGeneration) ? (size_t)checkpointSkip : 0;
+   size_t good = sizeof(h);
+   size_t numRecords = 0;
+   while (current && good + RECORD_BYTES <= log.size())
+   {
+      const unsigned char * record = &log[good];
+      uint32_t check;
+      std::memcpy(&check, record + 1 + sizeof(T), 4);
+      if (check != (uint32_t)fnv(record, 1 + sizeof(T)) ||
+          (record[0] != RECORD_PUSH && record[0] != RECORD_POP))
+         break;   // torn or damaged: nothing after it was acknowledged
+      if (numRecords >= skip)
+      {
+         T t;
+         std::memcpy(static_cast<void *>(&t), record + 1, sizeof(T));
+         if (record[0] == RECORD_PUSH)
+            items.push_back(t);
+         else
+            popped.push_back(t);
+      }
+      good += RECORD_BYTES;
+      numRecords++;
+   }
+
+   // take the popped items away, matching bytes, not just Compare
+   if (!popped.empty())
+   {
+      auto byBytes = [](const T & lhs, const T & rhs)
+      {
+         return std::memcmp(&lhs, &rhs, sizeof(T)) < 0;
+      };
+      std::sort(popped.begin(), popped.end(), byBytes);
+
+      // an item below every popped one under Compare matches none of them
+      size_t lowest = 0;
+      for (size_t i = 1; i < popped.size(); i++)
+         if (compare(popped[i], popped[lowest]))
+            lowest = i;
+      T floor = popped[lowest];
+
+      custom::vector<size_t> used(popped.size(), 0);
+      custom::vector<T> kept;
+      kept.reserve(items.size());
+      for (size_t i = 0; i < items.size(); i++)
+      {
+         if (compare(items[i], floor))
+         {
+            kept.push_back(items[i]);
+            continue;
+         }
+         auto it = std::lower_bound(popped.begin(), popped.end(), items[i], byBytes);
+         size_t index = it - popped.begin();
+         while (index < popped.size() && used[index] &&
+                std::memcmp(&popped[index], &items[i], sizeof(T)) == 0)
+            index++;
+         if (index < popped.size() && std::memcmp(&popped[index], &items[i], sizeof(T)) == 0)
+            used[index] = 1;
+         else
+            kept.push_back(items[i]);
+      }
+      items = std::move(kept);
+   }
+
+   queue_type recovered(compare, std::move(items));
+   using std::swap;
+   swap(queue, recovered);
+   generation = checkpointGeneration;
+
+   // carry on with the log, less any torn tail; move the records past
+   // the checkpoint to a log of its own generation; or start one
+   if (current && skip == 0)
+   {
+      walFd = ::open((path + ".wal").c_str(), O_RDWR);
+      if (walFd < 0)
+         throw std::system_error(errno, std::system_category(), "open " + path + ".wal");
+      if (ftruncate(walFd, (off_t)good) != 0 || lseek(walFd, (off_t)good, SEEK_SET) < 0)
+         throw std::system_error(errno, std::system_category(), "truncate " + path + ".wal");
+      numSinceCheckpoint = numRecords;
+      durableBytes = good;
+   }
+   else
+   {
+      size_t tail = sizeof(h) + std::min(skip, numRecords) * RECORD_BYTES;
+      if (!current)
+         tail = good = 0;
+      walFd = startLog(generation, good > tail ? &log[tail] : nullptr, good - tail);
+      numSinceCheckpoint = (good - tail) / RECORD_BYTES;
+      durableBytes = sizeof(h) + (good - tail);
+   }
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: CHECK
+ * Nothing more once the log has failed. The caller
+ * holds the lock.
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: check() const
+{
+   if (failed)
+      throw std::runtime_error(path + ".wal could not be written; reopen the queue to recover");
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: TOP
+ ***********************************************/
+template <class T, class Compare>
+T durable_priority_queue <T, Compare> :: top() const
+{
+   std::lock_guard<std::mutex> guard(lock);
+   check();
+   return queue.top();
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: PUSH
+ * Into the heap and the log; back once it is on
+ * disk
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: push(const T & t)
+{
+   std::unique_lock<std::mutex> held(lock);
+   check();
+   queue.push(t);
+   append(RECORD_PUSH, t);
+   waitDurable(held, numAppended);
+   maybeCheckpoint(held);
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: PUSH RANGE
+ * Many items for the price of one commit
+ ***********************************************/
+template <class T, class Compare>
+template <class Iterator>
+void durable_priority_queue <T, Compare> :: push(Iterator first, Iterator last)
+{
+   std::unique_lock<std::mutex> held(lock);
+   check();
+   for (Iterator it = first; it != last; ++it)
+   {
+      queue.push(*it);
+      append(RECORD_PUSH, *it);
+   }
+   waitDurable(held, numAppended);
+   maybeCheckpoint(held);
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: POP
+ * The popped item's bytes go in the log, so
+ * recovery knows which one went
+ ***********************************************/
+template <class T, class Compare>
+bool durable_priority_queue <T, Compare> :: pop(T & t)
+{
+   std::unique_lock<std::mutex> held(lock);
+   check();
+   if (queue.empty())
+      return false;
+   t = queue.top();
+   queue.pop();
+   append(RECORD_POP, t);
+   waitDurable(held, numAppended);
+   maybeCheckpoint(held);
+   return true;
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: CHECKPOINT
+ * Save the heap now and start a new log, after
+ * any checkpoint already under way
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: checkpoint()
+{
+   std::unique_lock<std::mutex> held(lock);
+   while (checkpointing)
+      written.wait(held);
+   check();
+   runCheckpoint(held);
+}
+
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: maybeCheckpoint(std::unique_lock<std::mutex> & held)
+{
+   if (numSinceCheckpoint >= checkpointEvery && !checkpointing)
+      runCheckpoint(held);
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: APPEND
+ * type, the item's bytes, a 32-bit checksum
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: append(uint8_t type, const T & t)
+{
+   unsigned char record[RECORD_BYTES];
+   record[0] = type;
+   std::memcpy(record + 1, &t, sizeof(T));
+   uint32_t check = (uint32_t)fnv(record, 1 + sizeof(T));
+   std::memcpy(record + 1 + sizeof(T), &check, 4);
+   for (size_t i = 0; i < RECORD_BYTES; i++)
+      pending.push_back(record[i]);
+   numAppended++;
+   numSinceCheckpoint++;
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: WAIT DURABLE
+ * Return once record number sequence is on disk.
+ * If nobody is writing, become the writer and take
+ * every pending record along; if somebody is,
+ * wait for them, then look again. A failed write
+ * is cut off the log and fails the queue, so no
+ * one counts those records as durable.
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: waitDurable(std::unique_lock<std::mutex> & held,
+                                                        uint64_t sequence)
+{
+   while (numDurable < sequence)
+   {
+      check();
+      if (writing)
+      {
+         written.wait(held);
+         continue;
+      }
+
+      writing = true;
+      custom::vector<unsigned char> batch;
+      batch.swap(pending);
+      uint64_t target = numAppended;
+      held.unlock();
+      try
+      {
+         if (!batch.empty())
+            writeAll(walFd, &batch[0], batch.size(), path + ".wal");
+         if (fdatasync(walFd) != 0)
+            throw std::system_error(errno, std::system_category(), "fdatasync " + path + ".wal");
+      }
+      catch (...)
+      {
+         held.lock();
+         if (ftruncate(walFd, (off_t)durableBytes) == 0)
+            lseek(walFd, (off_t)durableBytes, SEEK_SET);
+         failed = true;
+         writing = false;
+         written.notify_all();
+         throw;
+      }
+      held.lock();
+      numSyncs++;
+      numDurable = target;
+      durableBytes += batch.size();
+      writing = false;
+      written.notify_all();
+   }
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: RUN CHECKPOINT
+ * Copy the heap array under the lock, and write
+ * and sync the copy without it. Once every record
+ * the copy holds is on disk, rename it into place,
+ * then move the records after it to a new log.
+ * Log writers are held off only for that move.
+ * The caller holds the lock.
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: runCheckpoint(std::unique_lock<std::mutex> & held)
+{
+   checkpointing = true;
+   custom::vector<T> items(queue.data());
+   uint64_t sequence = numAppended;
+   size_t   skip = numSinceCheckpoint;
+   uint64_t next = generation + 1;
+   std::string temporary = path + ".ckpt.tmp";
+   held.unlock();
+
+   int oldFd = -1;
+   uint64_t logBytes = 0;
+   try
+   {
+      header h = {};
+      std::memcpy(h.magic, "CPQCKPT", 8);
+      h.version     = VERSION;
+      h.elementSize = (uint32_t)sizeof(T);
+      h.generation  = next;
+      h.count       = items.size();
+      h.checksum    = fnv(items.empty() ? nullptr : &items[0], items.size() * sizeof(T));
+      h.skip        = skip;
+
+      int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0)
+         throw std::system_error(errno, std::system_category(), "open " + temporary);
+      try
+      {
+         writeAll(fd, &h, sizeof(h), temporary);
+         if (!items.empty())
+            writeAll(fd, &items[0], items.size() * sizeof(T), temporary);
+         if (fsync(fd) != 0)
+            throw std::system_error(errno, std::system_category(), "fsync " + temporary);
+      }
+      catch (...)
+      {
+         ::close(fd);
+         throw;
+      }
+      ::close(fd);
+
+      // the checkpoint may not get ahead of the log, nor the log change under a writer
+      held.lock();
+      waitDurable(held, sequence);
+      while (writing)
+         written.wait(held);
+      check();
+      writing = true;
+      oldFd = walFd;
+      logBytes = durableBytes;
+      held.unlock();
+   }
+   catch (...)
+   {
+      if (!held.owns_lock())
+         held.lock();
+      checkpointing = false;
+      written.notify_all();
+      throw;
+   }
+
+   // the old log is good until the new one replaces it
+   int newFd = -1;
+   try
+   {
+      if (std::rename(temporary.c_str(), (path + ".ckpt").c_str()) != 0)
+         throw std::system_error(errno, std::system_category(), "rename " + temporary);
+      syncDirectory();
+
+      custom::vector<unsigned char> tail;
+      uint64_t from = sizeof(header) + skip * RECORD_BYTES;
+      if (logBytes > from)
+      {
+         tail.resize((size_t)(logBytes - from));
+         size_t done = 0;
+         while (done < tail.size())
+         {
+            ssize_t n = ::pread(walFd, &tail[done], tail.size() - done, (off_t)(from + done));
+            if (n < 0 && errno == EINTR)
+               continue;
+            if (n <= 0)
+               throw std::system_error(errno, std::system_category(), "read " + path + ".wal");
+            done += (size_t)n;
+         }
+      }
+      newFd = startLog(next, tail.empty() ? nullptr : &tail[0], tail.size());
+      logBytes = sizeof(header) + tail.size();
+   }
+   catch (...)
+   {
+      held.lock();
+      writing = false;
+      checkpointing = false;
+      written.notify_all();
+      throw;
+   }
+
+   held.lock();
+   ::close(oldFd);
+   walFd = newFd;
+   durableBytes = logBytes;
+   generation = next;
+   numSinceCheckpoint -= skip;
+   writing = false;
+   checkpointing = false;
+   written.notify_all();
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: START LOG
+ * A header and the given records, swapped in by
+ * rename: the open log
+ ***********************************************/
+template <class T, class Compare>
+int durable_priority_queue <T, Compare> :: startLog(uint64_t newGeneration,
+                                                    const unsigned char * records, size_t size)
+{
+   header h = {};
+   std::memcpy(h.magic, "CPQWAL", 6);
+   h.version     = VERSION;
+   h.elementSize = (uint32_t)sizeof(T);
+   h.generation  = newGeneration;
+
+   std::string temporary = path + ".wal.tmp";
+   int fd = ::open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+   if (fd < 0)
+      throw std::system_error(errno, std::system_category(), "open " + temporary);
+   try
+   {
+      writeAll(fd, &h, sizeof(h), temporary);
+      if (size > 0)
+         writeAll(fd, records, size, temporary);
+      if (fsync(fd) != 0)
+         throw std::system_error(errno, std::system_category(), "fsync " + temporary);
+   }
+   catch (...)
+   {
+      ::close(fd);
+      throw;
+   }
+   if (std::rename(temporary.c_str(), (path + ".wal").c_str()) != 0)
+   {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::system_category(), "rename " + temporary);
+   }
+   syncDirectory();
+   return fd;
+}
+
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: writeAll(int fd, const void * bytes, size_t size,
+                                                     const std::string & name)
+{
+   const char * p = static_cast<const char *>(bytes);
+   while (size > 0)
+   {
+      ssize_t n = ::write(fd, p, size);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         throw std::system_error(errno, std::system_category(), "write " + name);
+      p += n;
+      size -= (size_t)n;
+   }
+}
+
+/************************************************
+ * DURABLE PRIORITY QUEUE :: SYNC DIRECTORY
+ * A rename is only durable once the directory is
+ ***********************************************/
+template <class T, class Compare>
+void durable_priority_queue <T, Compare> :: syncDirectory()
+{
+   size_t slash = path.find_last_of('/');
+   std::string directory = slash == std::string::npos ? "." : path.substr(0, slash + 1);
+   int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+   if (fd < 0)
+      return;
+   fsync(fd);
+   ::close(fd);
+}
+
+} // namespace custom
+
+#endif // __linux__
@@ -0,0 +1,501 @@
+/***********************************************************************
+ * Header:
+ *    EXTERNAL PRIORITY QUEUE
+ * Summary:
+ *    A priority queue that can hold more than fits in memory. New
+ *    items go to an in-memory heap of at most half the budget. When it
+ *    fills, it is sorted and written to a run file in one pass of large
+ *    sequential writes. Popping takes the larger of the heap's top and
+ *    the best run head; each run is read back a block at a time, and
+ *    on Linux the kernel is asked to fetch the next block while the
+ *    current one is consumed.
+ *
+ *    The other half of the budget is for the run blocks. When there
+ *    are more runs than blocks that fit, some of them are merged. Like
+ *    the groups of sequence_heap, every run has a level: a spill is
+ *    level 0, and merging the runs of one level makes a run of the
+ *    next. The level holding the most runs is the one merged, so runs
+ *    are only merged with others of about their size, and an item is
+ *    rewritten once per level rather than once per merge.
+ *
+ *    This will contain the class definition of:
+ *        external_priority_queue : A priority queue that spills to disk
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>   // for std::reverse and std::min
+#include <cassert>
+#include <cstddef>     // for size_t
+#include <cstdio>      // for std::FILE
+#include <filesystem>  // for std::filesystem::temp_directory_path
+#include <functional>  // for std::less
+#include <stdexcept>   // for std::out_of_range and std::runtime_error
+#include <string>
+#include <type_traits> // for std::is_trivially_copyable
+#include <utility>     // for std::move
+#include "heap.h"
+#include "vector.h"
+
+#ifdef __linux__
+#include <fcntl.h>     // for posix_fadvise
+#endif
+
+class TestExternalPriorityQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * EXTERNAL PRIORITY QUEUE
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class external_priority_queue
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "external_priority_queue writes T as raw bytes");
+   friend class ::TestExternalPriorityQueue; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   explicit external_priority_queue(size_t budgetBytes = (size_t)64 << 20,
+                                    const std::string & directory = std::filesystem::temp_directory_path().string(),
+                                    size_t blockBytes = (size_t)1 << 20,
+                                    const Compare & compare = Compare());
+   external_priority_queue(const external_priority_queue &) = delete;
+   external_priority_queue & operator = (const external_priority_queue &) = delete;
+  ~external_priority_queue() { clear(); }
+
+   //
+   // Access
+   //
+   const T & top() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+
+   //
+   // Remove
+   //
+   void pop();
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   // one sorted run on disk, largest first, read a block at a time
+   struct run
+   {
+      run() : file(nullptr), numUnread(0), next(0), level(0) {}
+      run(run && rhs) noexcept :
+         file(rhs.file), path(std::move(rhs.path)), numUnread(rhs.numUnread),
+         block(std::move(rhs.block)), next(rhs.next), level(rhs.level)
+      {
+         rhs.file = nullptr;
+      }
+      run(const run &) = delete;
+     ~run() { close(); }
+      run & operator = (run && rhs) noexcept
+      {
+         if (this != &rhs)
+         {
+            close();
+            file = rhs.file;
+            path = std::move(rhs.path);
+            numUnread = rhs.numUnread;
+            block = std::move(rhs.block);
+            next = rhs.next;
+            level = rhs.level;
+            rhs.file = nullptr;
+         }
+         return *this;
+      }
+
+      const T & head() const { return block[next]; }
+      bool empty() const { return next == block.size() && numUnread == 0; }
+      void close()
+      {
+         if (file != nullptr)
+         {
+            std::fclose(file);
+            std::remove(path.c_str());
+            file = nullptr;
+         }
+      }
+
+      std::FILE *       file;
+      std::string       path;
+      size_t            numUnread;   // on disk, not yet in the block
+      custom::vector<T> block;
+      size_t            next;        // the head's index in the block
+      size_t            level;       // merges its items have been through
+   };
+
+   // order run indices by their heads
+   struct byHead
+   {
+      const external_priority_queue * queue;
+      bool operator () (size_t lhs, size_t rhs) const
+      {
+         return queue->compare(queue->runs[lhs].head(), queue->runs[rhs].head());
+      }
+   };
+
+   bool heapOnTop() const;
+   size_t remaining(size_t index) const
+   {
+      return runs[index].numUnread + runs[index].block.size() - runs[index].next;
+   }
+   void spill();
+   void mergeRuns();
+   void openRun(run & r);
+   void writeRun(run & r, const T * data, size_t count);
+   void finishRun(run & r);
+   void load(run & r);
+   void advance(size_t index);
+   void dropRun(size_t index);
+
+   std::string       directory;
+   size_t            heapCapacity;    // items in the in-memory heap
+   size_t            blockItems;      // items per run block
+   size_t            maxRuns;         // run blocks that fit in the budget
+   size_t            numFiles;        // for unique run file names
+   size_t            numWritten;      // items written to runs, for measuring merges
+   custom::vector<T> heap;            // a binary heap under Compare
+   custom::vector<run>    runs;
+   custom::vector<size_t> runHeap;    // live runs, a heap by head
+   size_t            numElements;
+   Compare           compare;
+};
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: CONSTRUCTOR
+ * Half the budget for the heap, half for blocks
+ ***********************************************/
+template <class T, class Compare>
+external_priority_queue <T, Compare> :: external_priority_queue(size_t budgetBytes,
+                                                                 const std::string & directory,
+                                                                 size_t blockBytes,
+                                                                 const Compare & compare) :
+   directory(directory), numFiles(0), numWritten(0), numElements(0), compare(compare)
+{
+   heapCapacity = std::max((size_t)1, budgetBytes / 2 / sizeof(T));
+   blockItems   = std::max((size_t)1, blockBytes / sizeof(T));
+   maxRuns      = std::max((size_t)2, budgetBytes / 2 / (blockItems * sizeof(T)));
+   heap.reserve(heapCapacity);
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: TOP
+ * The larger of the heap's top and the best head
+ ***********************************************/
+template <class T, class Compare>
+const T & external_priority_queue <T, Compare> :: top() const
+{
+   if (numElements == 0)
+      throw std::out_of_range("std:out_of_range");
+   return heapOnTop() ? heap.front() : runs[runHeap.front()].head();
+}
+
+template <class T, class Compare>
+bool external_priority_queue <T, Compare> :: heapOnTop() const
+{
+   if (runHeap.empty())
+      return true;
+   if (heap.empty())
+      return false;
+   return !compare(heap.front(), runs[runHeap.front()].head());
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: PUSH
+ * Into the heap; a full heap goes to disk
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: push(const T & t)
+{
+   if (heap.size() >= heapCapacity)
+      spill();
+   heap.push_back(t);
+   custom::push_heap(heap.begin(), heap.end(), compare);
+   numElements++;
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: POP
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: pop()
+{
+   if (numElements == 0)
+      return;
+
+   if (heapOnTop())
+   {
+      custom::pop_heap(heap.begin(), heap.end(), compare);
+      heap.pop_back();
+   }
+   else
+   {
+      byHead order{ this };
+      custom::pop_heap(runHeap.begin(), runHeap.end(), order);
+      size_t index = runHeap.back();
+      runHeap.pop_back();
+      advance(index);
+      if (!runs[index].empty())
+      {
+         runHeap.push_back(index);
+         custom::push_heap(runHeap.begin(), runHeap.end(), order);
+      }
+      else
+         dropRun(index);
+   }
+   numElements--;
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: CLEAR
+ * Empty, with every run file removed
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: clear()
+{
+   heap.clear();
+   runHeap.clear();
+   runs.clear();
+   numElements = 0;
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: SPILL
+ * Sort the heap largest first and write it out as
+ * a new run
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: spill()
+{
+   custom::sort_heap(heap.begin(), heap.end(), compare);
+   std::reverse(heap.begin(), heap.end());
+
+   if (runHeap.size() >= maxRuns)
+      mergeRuns();
+
+   runs.push_back(run());
+   run & r = runs.back();
+   openRun(r);
+   writeRun(r, &heap[0], heap.size());
+   finishRun(r);
+   heap.clear();
+
+   runHeap.push_back(runs.size() - 1);
+   custom::push_heap(runHeap.begin(), runHeap.end(), byHead{ this });
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: MERGE RUNS
+ * Too many runs to keep a block of each: merge
+ * the runs of the fullest level, the lowest on a
+ * tie, into one run of the next level. If every
+ * level has just one run, merge the two smallest.
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: mergeRuns()
+{
+   custom::vector<size_t> perLevel;
+   for (size_t i = 0; i < runHeap.size(); i++)
+   {
+      size_t level = runs[runHeap[i]].level;
+      while (perLevel.size() <= level)
+         perLevel.push_back(0);
+      perLevel[level]++;
+   }
+   size_t level = 0;
+   for (size_t l = 1; l < perLevel.size(); l++)
+      if (perLevel[l] > perLevel[level])
+         level = l;
+
+   // with one run a level, the two smallest stand in for a level
+   size_t smallest[2] = { runs.size(), runs.size() };
+   if (perLevel[level] < 2)
+      for (size_t i = 0; i < runHeap.size(); i++)
+      {
+         size_t index = runHeap[i];
+         if (smallest[0] == runs.size() || remaining(index) < remaining(smallest[0]))
+         {
+            smallest[1] = smallest[0];
+            smallest[0] = index;
+         }
+         else if (smallest[1] == runs.size() || remaining(index) < remaining(smallest[1]))
+            smallest[1] = index;
+      }
+
+   // split the live runs into those to merge and those to keep
+   custom::vector<size_t> merging;
+   custom::vector<size_t> kept;
+   size_t top = 0;
+   for (size_t i = 0; i < runHeap.size(); i++)
+   {
+      size_t index = runHeap[i];
+      bool chosen = perLevel[level] < 2 ? (index == smallest[0] || index == smallest[1])
+                                        : runs[index].level == level;
+      if (chosen)
+      {
+         merging.push_back(index);
+         top = std::max(top, runs[index].level);
+      }
+      else
+         kept.push_back(index);
+   }
+
+   run merged;
+   merged.level = top + 1;
+   openRun(merged);
+   custom::vector<T> out;
+   out.reserve(blockItems);
+   byHead order{ this };
+   custom::make_heap(merging.begin(), merging.end(), order);
+   while (!merging.empty())
+   {
+      custom::pop_heap(merging.begin(), merging.end(), order);
+      size_t index = merging.back();
+      out.push_back(runs[index].head());
+      if (out.size() == blockItems)
+      {
+         writeRun(merged, &out[0], out.size());
+         out.clear();
+      }
+      advance(index);
+      if (runs[index].empty())
+         merging.pop_back();
+      else
+         custom::push_heap(merging.begin(), merging.end(), order);
+   }
+   if (!out.empty())
+      writeRun(merged, &out[0], out.size());
+   finishRun(merged);
+
+   // keep only the live runs: the merged one first, then the rest
+   custom::vector<run> live;
+   live.reserve(kept.size() + 1);
+   live.push_back(std::move(merged));
+   for (size_t i = 0; i < kept.size(); i++)
+      live.push_back(std::move(runs[kept[i]]));
+   runs.swap(live);
+   runHeap.clear();
+   for (size_t i = 0; i < runs.size(); i++)
+      runHeap.push_back(i);
+   custom::make_heap(runHeap.begin(), runHeap.end(), order);
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: OPEN RUN
+ * A new file of our own in the directory
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: openRun(run & r)
+{
+   for (int attempt = 0; attempt < 100 && r.file == nullptr; attempt++)
+   {
+      r.path = directory + "/epq-" + std::to_string((size_t)this) + "-" +
+               std::to_string(numFiles++) + ".run";
+      r.file = std::fopen(r.path.c_str(), "wb+x");
+   }
+   if (r.file == nullptr)
+      throw std::runtime_error("external_priority_queue cannot create a run in " + directory);
+   std::setvbuf(r.file, nullptr, _IONBF, 0);   // every read and write is a whole block
+}
+
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: writeRun(run & r, const T * data, size_t count)
+{
+   for (size_t done = 0; done < count; done += blockItems)
+   {
+      size_t n = std::min(blockItems, count - done);
+      if (std::fwrite(data + done, sizeof(T), n, r.file) != n)
+         throw std::runtime_error("external_priority_queue cannot write " + r.path);
+      r.numUnread += n;
+      numWritten += n;
+   }
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: FINISH RUN
+ * Rewind to read it back and load the first block
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: finishRun(run & r)
+{
+   if (std::fflush(r.file) != 0 || std::fseek(r.file, 0, SEEK_SET) != 0)
+      throw std::runtime_error("external_priority_queue cannot rewind " + r.path);
+#ifdef __linux__
+   posix_fadvise(fileno(r.file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+   r.block.reserve(std::min(blockItems, r.numUnread));
+   load(r);
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: LOAD
+ * The next block of a run, and a hint to start
+ * reading the one after it
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: load(run & r)
+{
+   size_t n = std::min(blockItems, r.numUnread);
+   r.block.resize(n);
+   r.next = 0;
+   if (n == 0)
+      return;
+   if (std::fread(&r.block[0], sizeof(T), n, r.file) != n)
+      throw std::runtime_error("external_priority_queue cannot read " + r.path);
+   r.numUnread -= n;
+#ifdef __linux__
+   if (r.numUnread > 0)
+      posix_fadvise(fileno(r.file), (off_t)std::ftell(r.file),
+                    (off_t)(std::min(blockItems, r.numUnread) * sizeof(T)), POSIX_FADV_WILLNEED);
+#endif
+}
+
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: advance(size_t index)
+{
+   run & r = runs[index];
+   if (++r.next == r.block.size())
+      load(r);
+}
+
+/************************************************
+ * EXTERNAL PRIORITY QUEUE :: DROP RUN
+ * A run read to the end gives up its file and its
+ * block: the last run moves into its slot, so runs
+ * only ever holds live runs
+ ***********************************************/
+template <class T, class Compare>
+void external_priority_queue <T, Compare> :: dropRun(size_t index)
+{
+   size_t last = runs.size() - 1;
+   if (index != last)
+   {
+      runs[index] = std::move(runs[last]);
+      for (size_t i = 0; i < runHeap.size(); i++)
+         if (runHeap[i] == last)
+         {
+            runHeap[i] = index;   // same head, so the heap order holds
+            break;
+         }
+   }
+   runs.pop_back();
+}
+
+} // namespace custom
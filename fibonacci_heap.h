@@ -0,0 +1,508 @@
+/***********************************************************************
+ * Header:
+ *    FIBONACCI HEAP
+ * Summary:
+ *    A min-ordered Fibonacci heap for workloads like Dijkstra and
+ *    Prim that lower many keys for every one they remove. Inserting
+ *    and lowering a key are O(1) amortized; removing the smallest is
+ *    O(log n) amortized.
+ *
+ *    The heap is a list of heap-ordered trees. push() only adds a
+ *    one-node tree to the root list. decrease_key() cuts the node
+ *    loose if it now beats its parent; a parent that loses a second
+ *    child is cut as well (the cascading cut), which keeps the trees
+ *    wide enough for the degree bound. pop() does the deferred work,
+ *    linking roots of equal degree until all degrees differ.
+ *
+ *    Nodes live in a slab, a custom::vector indexed by slot, and are
+ *    linked by index rather than by pointer. Freed slots go on a free
+ *    list, so after warm-up neither links nor cuts call the allocator.
+ *    reserve() warms it up front. Handles carry a generation, as in
+ *    heap_timer, so a handle to a popped node is detected.
+ *
+ *    Unlike priority_queue, the top is the SMALLEST item under
+ *    Compare, because decrease-key is defined for a min-heap.
+ *
+ *    This will contain the class definition of:
+ *        fibonacci_heap          : A Fibonacci heap in a node slab
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <stdexcept>   // for std::out_of_range and std::invalid_argument
+#include <utility>     // for std::move and std::forward
+#include "vector.h"
+
+class TestFibonacciHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * FIBONACCI HEAP
+ * top() is an item that no other item is less
+ * than under Compare.
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class fibonacci_heap
+{
+   friend class ::TestFibonacciHeap; // give the unit test class access to the privates
+public:
+
+   // identifies one pushed item; stale once it is popped
+   struct handle
+   {
+      size_t slot;
+      size_t generation;
+   };
+
+   //
+   // construct
+   //
+   explicit fibonacci_heap(const Compare & compare = Compare()) :
+      minimum(NIL), numElements(0), compare(compare)
+   {
+   }
+
+   //
+   // Access
+   //
+   const T & top() const;
+   const T & value(handle h) const;
+   bool contains(handle h) const;
+
+   //
+   // Insert
+   //
+   handle push(const T & t);
+   handle push(T && t);
+   void   reserve(size_t n);
+
+   //
+   // Update
+   //
+   bool decrease_key(handle h, const T & t);
+
+   //
+   // Remove
+   //
+   void pop();
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   static constexpr size_t NIL = (size_t)-1;
+
+   // one tree node; siblings form a circular list
+   struct Node
+   {
+      T      value;
+      size_t parent;
+      size_t child;        // any one of the children
+      size_t left;
+      size_t right;
+      size_t degree;       // number of children
+      size_t generation;   // bumped every time the slot is freed
+      bool   marked;       // lost a child since it last became a child
+      bool   active;
+   };
+
+   template <class U>
+   size_t allocate(U && value);
+   void   release(size_t slot);
+   handle insert(size_t slot);
+   void   splice(size_t list, size_t node);   // add node to the circle that list is in
+   void   unlink(size_t node);                // take node out of its circle
+   void   link(size_t child, size_t root);    // make child a child of root
+   void   consolidate();
+   void   cut(size_t node);
+   void   cascadingCut(size_t node);
+
+   custom::vector<Node>   nodes;        // the slab
+   custom::vector<size_t> freeSlots;
+   custom::vector<size_t> byDegree;     // reused by consolidate()
+   custom::vector<size_t> roots;        // reused by consolidate()
+   size_t  minimum;                     // a root, or NIL when empty
+   size_t  numElements;
+   Compare compare;
+};
+
+/************************************************
+ * FIBONACCI HEAP :: TOP
+ * The smallest item: always a root
+ ***********************************************/
+template <class T, class Compare>
+const T & fibonacci_heap <T, Compare> :: top() const
+{
+   if (minimum == NIL)
+      throw std::out_of_range("std:out_of_range");
+   return nodes[minimum].value;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: CONTAINS
+ * Is the handle's item still in the heap?
+ ***********************************************/
+template <class T, class Compare>
+bool fibonacci_heap <T, Compare> :: contains(handle h) const
+{
+   return h.slot < nodes.size() &&
+          nodes[h.slot].active &&
+          nodes[h.slot].generation == h.generation;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: VALUE
+ * The current key of a pushed item
+ ***********************************************/
+template <class T, class Compare>
+const T & fibonacci_heap <T, Compare> :: value(handle h) const
+{
+   if (!contains(h))
+      throw std::out_of_range("std:out_of_range");
+   return nodes[h.slot].value;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: PUSH
+ * A new one-node tree in the root list. O(1).
+ ***********************************************/
+template <class T, class Compare>
+typename fibonacci_heap <T, Compare> :: handle
+fibonacci_heap <T, Compare> :: push(const T & t)
+{
+   return insert(allocate(t));
+}
+
+template <class T, class Compare>
+typename fibonacci_heap <T, Compare> :: handle
+fibonacci_heap <T, Compare> :: push(T && t)
+{
+   return insert(allocate(std::move(t)));
+}
+
+/************************************************
+ * FIBONACCI HEAP :: RESERVE
+ * Make room for n items so pushes do not grow
+ * the slab
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: reserve(size_t n)
+{
+   nodes.reserve(n);
+   freeSlots.reserve(n);
+   roots.reserve(n);
+}
+
+/************************************************
+ * FIBONACCI HEAP :: DECREASE KEY
+ * Lower an item's key. If it now beats its parent,
+ * cut it to the root list. O(1) amortized.
+ * Returns false if the handle is stale.
+ ***********************************************/
+template <class T, class Compare>
+bool fibonacci_heap <T, Compare> :: decrease_key(handle h, const T & t)
+{
+   if (!contains(h))
+      return false;
+   if (compare(nodes[h.slot].value, t))
+      throw std::invalid_argument("decrease_key cannot raise a key");
+
+   size_t node = h.slot;
+   nodes[node].value = t;
+
+   size_t parent = nodes[node].parent;
+   if (parent != NIL && compare(nodes[node].value, nodes[parent].value))
+   {
+      cut(node);
+      cascadingCut(parent);
+   }
+   if (compare(nodes[node].value, nodes[minimum].value))
+      minimum = node;
+   return true;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: POP
+ * Remove the smallest: its children join the root
+ * list, then roots of equal degree are linked.
+ * O(log n) amortized.
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: pop()
+{
+   if (minimum == NIL)
+      return;
+
+   size_t old = minimum;
+
+   // every child becomes a root
+   size_t child = nodes[old].child;
+   if (child != NIL)
+   {
+      size_t next = child;
+      do
+      {
+         nodes[next].parent = NIL;
+         nodes[next].marked = false;
+         next = nodes[next].right;
+      }
+      while (next != child);
+
+      // join the two circles: old ... child ...
+      size_t oldRight  = nodes[old].right;
+      size_t childLeft = nodes[child].left;
+      nodes[old].right = child;
+      nodes[child].left = old;
+      nodes[childLeft].right = oldRight;
+      nodes[oldRight].left = childLeft;
+      nodes[old].child = NIL;
+   }
+
+   // take the old minimum out of the root list
+   size_t next = nodes[old].right;
+   unlink(old);
+   release(old);
+   numElements--;
+
+   if (next == old)
+      minimum = NIL;
+   else
+   {
+      minimum = next;
+      consolidate();
+   }
+}
+
+/************************************************
+ * FIBONACCI HEAP :: CLEAR
+ * Drop every item but keep the slab
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: clear()
+{
+   for (size_t slot = 0; slot < nodes.size(); slot++)
+      if (nodes[slot].active)
+         release(slot);
+   minimum = NIL;
+   numElements = 0;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: ALLOCATE
+ * A slot from the free list, or a new one at the
+ * end of the slab, holding value
+ ***********************************************/
+template <class T, class Compare>
+template <class U>
+size_t fibonacci_heap <T, Compare> :: allocate(U && value)
+{
+   size_t slot;
+   if (!freeSlots.empty())
+   {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+      nodes[slot].value = std::forward<U>(value);
+   }
+   else
+   {
+      slot = nodes.size();
+      nodes.push_back(Node{ std::forward<U>(value), NIL, NIL, NIL, NIL, 0, 0, false, false });
+   }
+
+   Node & node = nodes[slot];
+   node.parent = NIL;
+   node.child = NIL;
+   node.left = slot;
+   node.right = slot;
+   node.degree = 0;
+   node.marked = false;
+   node.active = true;
+   return slot;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: RELEASE
+ * Invalidate outstanding handles and recycle
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: release(size_t slot)
+{
+   nodes[slot].active = false;
+   nodes[slot].generation++;
+   freeSlots.push_back(slot);
+}
+
+/************************************************
+ * FIBONACCI HEAP :: INSERT
+ * Put an allocated, filled slot in the root list
+ ***********************************************/
+template <class T, class Compare>
+typename fibonacci_heap <T, Compare> :: handle
+fibonacci_heap <T, Compare> :: insert(size_t slot)
+{
+   if (minimum == NIL)
+      minimum = slot;
+   else
+   {
+      splice(minimum, slot);
+      if (compare(nodes[slot].value, nodes[minimum].value))
+         minimum = slot;
+   }
+   numElements++;
+   return handle{ slot, nodes[slot].generation };
+}
+
+/************************************************
+ * FIBONACCI HEAP :: SPLICE
+ * Put a lone node just left of list in its circle
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: splice(size_t list, size_t node)
+{
+   size_t left = nodes[list].left;
+   nodes[node].left = left;
+   nodes[node].right = list;
+   nodes[left].right = node;
+   nodes[list].left = node;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: UNLINK
+ * Take a node out of its circle, leaving it alone
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: unlink(size_t node)
+{
+   size_t left = nodes[node].left;
+   size_t right = nodes[node].right;
+   nodes[left].right = right;
+   nodes[right].left = left;
+   nodes[node].left = node;
+   nodes[node].right = node;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: LINK
+ * Two roots of the same degree: the larger becomes
+ * a child of the smaller
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: link(size_t child, size_t root)
+{
+   unlink(child);
+   if (nodes[root].child == NIL)
+      nodes[root].child = child;
+   else
+      splice(nodes[root].child, child);
+   nodes[child].parent = root;
+   nodes[child].marked = false;
+   nodes[root].degree++;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: CONSOLIDATE
+ * Link roots until no two share a degree, then find
+ * the new minimum. The degree of any node is
+ * O(log n), so the table stays tiny.
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: consolidate()
+{
+   // the root list changes as we link, so walk a copy of it
+   roots.clear();
+   size_t start = minimum;
+   size_t root = start;
+   do
+   {
+      roots.push_back(root);
+      root = nodes[root].right;
+   }
+   while (root != start);
+
+   for (size_t i = 0; i < byDegree.size(); i++)
+      byDegree[i] = NIL;
+
+   for (size_t i = 0; i < roots.size(); i++)
+   {
+      size_t tree = roots[i];
+      size_t degree = nodes[tree].degree;
+      while (degree < byDegree.size() && byDegree[degree] != NIL)
+      {
+         size_t other = byDegree[degree];
+         if (compare(nodes[other].value, nodes[tree].value))
+         {
+            size_t temp = tree;
+            tree = other;
+            other = temp;
+         }
+         link(other, tree);
+         byDegree[degree] = NIL;
+         degree++;
+      }
+      while (byDegree.size() <= degree)
+         byDegree.push_back(NIL);
+      byDegree[degree] = tree;
+   }
+
+   // the survivors are the new root list
+   minimum = NIL;
+   for (size_t degree = 0; degree < byDegree.size(); degree++)
+   {
+      size_t tree = byDegree[degree];
+      if (tree != NIL && (minimum == NIL || compare(nodes[tree].value, nodes[minimum].value)))
+         minimum = tree;
+   }
+}
+
+/************************************************
+ * FIBONACCI HEAP :: CUT
+ * Move a node from its parent's children to the
+ * root list
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: cut(size_t node)
+{
+   size_t parent = nodes[node].parent;
+   if (nodes[parent].child == node)
+      nodes[parent].child = (nodes[node].right == node) ? NIL : nodes[node].right;
+   unlink(node);
+   nodes[parent].degree--;
+
+   splice(minimum, node);
+   nodes[node].parent = NIL;
+   nodes[node].marked = false;
+}
+
+/************************************************
+ * FIBONACCI HEAP :: CASCADING CUT
+ * A node that has lost one child is marked; on
+ * losing a second it is cut too, and so on up
+ ***********************************************/
+template <class T, class Compare>
+void fibonacci_heap <T, Compare> :: cascadingCut(size_t node)
+{
+   while (nodes[node].parent != NIL)
+   {
+      if (!nodes[node].marked)
+      {
+         nodes[node].marked = true;
+         return;
+      }
+      size_t parent = nodes[node].parent;
+      cut(node);
+      node = parent;
+   }
+}
+
+} // namespace custom
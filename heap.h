@@ -0,0 +1,242 @@
+/***********************************************************************
+ * Header:
+ *    HEAP
+ * Summary:
+ *    The heap algorithms on their own, over any random-access range,
+ *    so a buffer we already own can be heaped or sorted in place with
+ *    no allocation. The top is the largest item under Compare, the
+ *    same as std::make_heap and our priority_queue.
+ *
+ *    siftDown and siftUp are the kernels priority_queue uses for
+ *    percolateDown and push, so both see the same comparisons and
+ *    the same swaps.
+ *
+ *    This will contain the definitions of:
+ *        siftDown / siftUp       : Restore heap order from one index
+ *        make_heap               : Turn a range into a heap
+ *        push_heap               : Add the last item of a range to the heap
+ *        append_heap             : Add the last several items in one pass
+ *        pop_heap                : Move the top to the end of the range
+ *        sort_heap               : Turn a heap into a sorted range
+ *        partial_sort            : Sort just the smallest part of a range
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <iterator>    // for std::iterator_traits
+#include <utility>     // for std::swap
+
+namespace custom
+{
+
+/************************************************
+ * SIFT DOWN
+ * The item at the 0-based index may be smaller
+ * than its children. Swap it with the larger child
+ * until it is not. Only [0, size) is the heap.
+ * Return TRUE if anything moved.
+ ***********************************************/
+template <class RandomIt, class Compare>
+bool siftDown(RandomIt first, size_t index, size_t size, Compare & compare)
+{
+   bool changed = false;
+   for (;;)
+   {
+      size_t left    = 2 * index + 1;
+      size_t right   = 2 * index + 2;
+      size_t largest = index;
+
+      if (left < size && compare(first[largest], first[left]))
+         largest = left;
+      if (right < size && compare(first[largest], first[right]))
+         largest = right;
+      if (largest == index)
+         return changed;
+
+      using std::swap;
+      swap(first[index], first[largest]);
+      index = largest;
+      changed = true;
+   }
+}
+
+/************************************************
+ * SIFT UP
+ * The item at the 0-based index may be larger than
+ * its parent. Swap it upward until it is not.
+ ***********************************************/
+template <class RandomIt, class Compare>
+void siftUp(RandomIt first, size_t index, Compare & compare)
+{
+   while (index > 0)
+   {
+      size_t parent = (index - 1) / 2;
+      if (!compare(first[parent], first[index]))
+         return;
+
+      using std::swap;
+      swap(first[parent], first[index]);
+      index = parent;
+   }
+}
+
+/************************************************
+ * MAKE HEAP
+ * Floyd's method: sift down every internal node,
+ * last first. O(n).
+ ***********************************************/
+template <class RandomIt, class Compare>
+void make_heap(RandomIt first, RandomIt last, Compare compare)
+{
+   size_t size = (size_t)(last - first);
+   for (size_t index = size / 2; index-- > 0; )
+      siftDown(first, index, size, compare);
+}
+
+template <class RandomIt>
+void make_heap(RandomIt first, RandomIt last)
+{
+   custom::make_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+/************************************************
+ * PUSH HEAP
+ * [first, last - 1) is a heap; bring the item at
+ * last - 1 into it
+ ***********************************************/
+template <class RandomIt, class Compare>
+void push_heap(RandomIt first, RandomIt last, Compare compare)
+{
+   size_t size = (size_t)(last - first);
+   if (size > 1)
+      siftUp(first, size - 1, compare);
+}
+
+template <class RandomIt>
+void push_heap(RandomIt first, RandomIt last)
+{
+   custom::push_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+/************************************************
+ * APPEND HEAP
+ * [first, middle) is a heap; bring all of
+ * [middle, last) into it in one bottom-up pass.
+ * Only the new items' ancestors can be out of
+ * order, and on each level they are one run of
+ * indices, so sift those down, deepest first. A
+ * few new items cost about what pushing them
+ * would; many cost no more than make_heap.
+ ***********************************************/
+template <class RandomIt, class Compare>
+void append_heap(RandomIt first, RandomIt middle, RandomIt last, Compare compare)
+{
+   size_t size = (size_t)(last - first);
+   size_t lo   = (size_t)(middle - first);
+   if (lo >= size || size < 2)
+      return;
+
+   // the parents of the new items, then their parents, and so on
+   size_t hi = (size - 2) / 2;
+   lo = lo == 0 ? 0 : (lo - 1) / 2;
+   for (;;)
+   {
+      for (size_t index = hi + 1; index-- > lo; )
+         siftDown(first, index, size, compare);
+      if (lo == 0)
+         return;
+      // a parent already done as part of this run need not be done again
+      size_t parentHi = (hi - 1) / 2;
+      hi = parentHi < lo ? parentHi : lo - 1;
+      lo = (lo - 1) / 2;
+   }
+}
+
+template <class RandomIt>
+void append_heap(RandomIt first, RandomIt middle, RandomIt last)
+{
+   custom::append_heap(first, middle, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+/************************************************
+ * POP HEAP
+ * Swap the top to last - 1 and restore the heap
+ * on what is left, [first, last - 1)
+ ***********************************************/
+template <class RandomIt, class Compare>
+void pop_heap(RandomIt first, RandomIt last, Compare compare)
+{
+   size_t size = (size_t)(last - first);
+   if (size < 2)
+      return;
+
+   using std::swap;
+   swap(first[0], first[size - 1]);
+   siftDown(first, 0, size - 1, compare);
+}
+
+template <class RandomIt>
+void pop_heap(RandomIt first, RandomIt last)
+{
+   custom::pop_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+/************************************************
+ * SORT HEAP
+ * Pop the top to the back over and over: the heap
+ * becomes ascending under Compare. O(n log n).
+ ***********************************************/
+template <class RandomIt, class Compare>
+void sort_heap(RandomIt first, RandomIt last, Compare compare)
+{
+   for (size_t size = (size_t)(last - first); size > 1; size--)
+   {
+      using std::swap;
+      swap(first[0], first[size - 1]);
+      siftDown(first, 0, size - 1, compare);
+   }
+}
+
+template <class RandomIt>
+void sort_heap(RandomIt first, RandomIt last)
+{
+   custom::sort_heap(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+/************************************************
+ * PARTIAL SORT
+ * Leave the smallest (middle - first) items of the
+ * range sorted in [first, middle); the rest end up
+ * in [middle, last) in no particular order. A heap
+ * over [first, middle) holds the best so far; its
+ * top is the one to beat. O(n log m).
+ ***********************************************/
+template <class RandomIt, class Compare>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare compare)
+{
+   size_t size = (size_t)(middle - first);
+   if (size == 0)
+      return;
+
+   custom::make_heap(first, middle, compare);
+   for (RandomIt it = middle; it != last; ++it)
+      if (compare(*it, first[0]))
+      {
+         using std::swap;
+         swap(*it, first[0]);
+         siftDown(first, 0, size, compare);
+      }
+   custom::sort_heap(first, middle, compare);
+}
+
+template <class RandomIt>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last)
+{
+   custom::partial_sort(first, middle, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+} // namespace custom
@@ -0,0 +1,245 @@
+/***********************************************************************
+ * Header:
+ *    HEAP TIMER
+ * Summary:
+ *    A set of pending deadlines kept in a priority_queue ordered so
+ *    the earliest is on top. Every timer gets a handle to a slot that
+ *    holds its callback. Cancelling frees the slot and leaves the heap
+ *    entry behind; a stale entry is dropped when it reaches the top,
+ *    and the heap is rebuilt once stale entries outnumber live ones.
+ *
+ *    This will contain the class definition of:
+ *        heap_timer              : Deadlines in a priority_queue with lazy cancellation
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <chrono>      // for std::chrono::steady_clock
+#include <functional>  // for std::function
+#include <stdexcept>   // for std::out_of_range
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestHeapTimer;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * HEAP TIMER
+ * Schedule callbacks for deadlines and fire every
+ * one that is due in a single batch.
+ *************************************************/
+class heap_timer
+{
+   friend class ::TestHeapTimer; // give the unit test class access to the privates
+public:
+   typedef std::chrono::steady_clock clock;
+   typedef std::function<void()> callback;
+
+   // identifies one scheduled timer; stale once it fires or is cancelled
+   struct handle
+   {
+      size_t slot;
+      size_t generation;
+   };
+
+   heap_timer() : numActive(0) {}
+
+   //
+   // Insert
+   //
+   handle schedule(clock::time_point deadline, callback fn);
+
+   //
+   // Remove
+   //
+   bool   cancel(handle h);
+   size_t expire(clock::time_point now);
+
+   //
+   // Access
+   //
+   clock::time_point earliest() const;
+
+   //
+   // Status
+   //
+   size_t size()  const { return numActive;      }
+   bool   empty() const { return numActive == 0; }
+
+private:
+
+   // one heap node: the key and the timer it was pushed for
+   struct Entry
+   {
+      clock::time_point deadline;
+      size_t slot;
+      size_t generation;    // stale once the slot's generation moves on
+   };
+
+   // the top of the queue is its largest item, so the later deadline is the smaller
+   struct later
+   {
+      bool operator () (const Entry & lhs, const Entry & rhs) const
+      {
+         return rhs.deadline < lhs.deadline;
+      }
+   };
+
+   // the rest of the timer, at a stable index
+   struct Slot
+   {
+      callback fn;
+      size_t generation;    // bumped every time the slot is released
+      bool   active;
+   };
+
+   bool isStale(const Entry & entry) const
+   {
+      return slots[entry.slot].generation != entry.generation;
+   }
+   void dropStale();
+   void compact();
+   void releaseSlot(size_t slot);
+
+   custom::priority_queue<Entry, custom::vector<Entry>, later> heap;   // earliest on top
+   custom::vector<Slot>     slots;
+   custom::vector<size_t>   freeSlots;
+   custom::vector<callback> batch;      // reused by expire()
+   size_t numActive;
+};
+
+/************************************************
+ * HEAP TIMER :: SCHEDULE
+ * Call fn once the deadline has passed
+ ***********************************************/
+inline heap_timer::handle heap_timer::schedule(clock::time_point deadline, callback fn)
+{
+   size_t slot;
+   if (!freeSlots.empty())
+   {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+   }
+   else
+   {
+      slot = slots.size();
+      slots.push_back(Slot{ callback(), 0, false });
+   }
+
+   slots[slot].fn = std::move(fn);
+   slots[slot].active = true;
+   heap.push(Entry{ deadline, slot, slots[slot].generation });
+   numActive++;
+
+   return handle{ slot, slots[slot].generation };
+}
+
+/************************************************
+ * HEAP TIMER :: CANCEL
+ * Stop a timer that has not fired yet. Its entry
+ * stays in the heap until it surfaces or the heap
+ * is compacted. Returns false if the handle is stale.
+ ***********************************************/
+inline bool heap_timer::cancel(handle h)
+{
+   if (h.slot >= slots.size() ||
+       !slots[h.slot].active ||
+       slots[h.slot].generation != h.generation)
+      return false;
+
+   releaseSlot(h.slot);
+   numActive--;
+   dropStale();
+   if (heap.size() > 2 * numActive)
+      compact();
+   return true;
+}
+
+/************************************************
+ * HEAP TIMER :: EXPIRE
+ * Pop every timer due at now, then run their
+ * callbacks. Callbacks may schedule or cancel.
+ * Returns the number fired.
+ ***********************************************/
+inline size_t heap_timer::expire(clock::time_point now)
+{
+   batch.clear();
+   while (!heap.empty() && heap.top().deadline <= now)
+   {
+      size_t slot = heap.top().slot;
+      heap.pop();
+      batch.push_back(std::move(slots[slot].fn));
+      releaseSlot(slot);
+      numActive--;
+      dropStale();
+   }
+
+   // the batch is moved aside in case a callback calls expire() again
+   custom::vector<callback> due(std::move(batch));
+   for (size_t i = 0; i < due.size(); i++)
+      due[i]();
+   size_t numFired = due.size();
+   due.clear();
+   batch = std::move(due);    // keep the capacity for next time
+   return numFired;
+}
+
+/************************************************
+ * HEAP TIMER :: EARLIEST
+ * The next deadline. The top is never stale.
+ ***********************************************/
+inline heap_timer::clock::time_point heap_timer::earliest() const
+{
+   if (heap.empty())
+      throw std::out_of_range("std:out_of_range");
+   return heap.top().deadline;
+}
+
+/************************************************
+ * HEAP TIMER :: DROP STALE
+ * Pop cancelled entries until a live one is on top
+ ***********************************************/
+inline void heap_timer::dropStale()
+{
+   while (!heap.empty() && isStale(heap.top()))
+      heap.pop();
+}
+
+/************************************************
+ * HEAP TIMER :: COMPACT
+ * Rebuild the heap from the live entries. Run once
+ * the stale outnumber the live, so each cancel pays
+ * for O(1) of the copy.
+ ***********************************************/
+inline void heap_timer::compact()
+{
+   custom::vector<Entry> live;
+   live.reserve(numActive);
+   const custom::vector<Entry> & entries = heap.data();
+   for (size_t i = 0; i < entries.size(); i++)
+      if (!isStale(entries[i]))
+         live.push_back(entries[i]);
+
+   custom::priority_queue<Entry, custom::vector<Entry>, later> rebuilt(later(), std::move(live));
+   swap(heap, rebuilt);
+}
+
+/************************************************
+ * HEAP TIMER :: RELEASE SLOT
+ * Invalidate outstanding handles and heap entries
+ * and recycle
+ ***********************************************/
+inline void heap_timer::releaseSlot(size_t slot)
+{
+   slots[slot].fn = nullptr;
+   slots[slot].active = false;
+   slots[slot].generation++;
+   freeSlots.push_back(slot);
+}
+
+} // namespace custom
@@ -0,0 +1,251 @@
+/***********************************************************************
+ * Header:
+ *    K-WAY MERGE
+ * Summary:
+ *    Merge k sorted runs into one sorted stream with a loser tree.
+ *    Each internal node of a tournament over the runs remembers the
+ *    loser of the match played there; the overall winner sits above
+ *    the root. Taking the winner only changes its own run, so only
+ *    the matches on that run's leaf-to-root path are replayed:
+ *    ceil(log2 k) comparisons per element, where a heap of run heads
+ *    needs about twice that.
+ *
+ *    The merge is lazy. Nothing is copied out of the runs; the
+ *    iterator reads the current winner and advances the tree.
+ *    Ties go to the earlier run, so the merge is stable.
+ *
+ *    This will contain the class definition of:
+ *        kway_merge              : A loser-tree merge of sorted runs
+ *        kway_merge::iterator    : A single-pass walk over the output
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>           // for std::ptrdiff_t
+#include <functional>        // for std::less
+#include <initializer_list>  // for std::initializer_list
+#include <iterator>          // for std::iterator_traits
+#include <stdexcept>         // for std::out_of_range
+#include <utility>           // for std::pair
+#include "vector.h"
+
+class TestKwayMerge;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * K-WAY MERGE
+ * Runs are [first, last) pairs, each sorted under
+ * Compare. The output is ascending under Compare.
+ *************************************************/
+template <class Iterator,
+          class Compare = std::less<typename std::iterator_traits<Iterator>::value_type>>
+class kway_merge
+{
+   friend class ::TestKwayMerge; // give the unit test class access to the privates
+public:
+   typedef typename std::iterator_traits<Iterator>::value_type value_type;
+   typedef typename std::iterator_traits<Iterator>::reference  reference;
+   typedef std::pair<Iterator, Iterator> range;
+
+   class iterator;
+
+   //
+   // construct
+   //
+   kway_merge(std::initializer_list<range> runs, const Compare & compare = Compare()) :
+      compare(compare)
+   {
+      for (const range & run : runs)
+         this->runs.push_back(run);
+      build();
+   }
+   explicit kway_merge(const custom::vector<range> & runs, const Compare & compare = Compare()) :
+      runs(runs), compare(compare)
+   {
+      build();
+   }
+
+   //
+   // Access
+   //
+   reference top() const;
+   const custom::vector<range> & remaining() const { return runs; }   // what is left of each run, in order
+   iterator begin() { return iterator(this); }
+   iterator end()   { return iterator(nullptr); }
+
+   //
+   // Remove
+   //
+   void pop();
+
+   //
+   // Status
+   //
+   bool empty() const { return runs.empty() || exhausted(tree[0]); }
+
+private:
+   bool exhausted(size_t run) const { return runs[run].first == runs[run].second; }
+   bool beats(size_t lhs, size_t rhs) const;
+   void build();
+   void replay(size_t run);
+
+   custom::vector<range>  runs;   // what is left of each run
+   custom::vector<size_t> tree;   // [0] is the winner, [1, k) the losers
+   Compare compare;
+};
+
+/*************************************************
+ * K-WAY MERGE :: ITERATOR
+ * Every copy shares the merge, so this is an input
+ * iterator: one pass, in order.
+ *************************************************/
+template <class Iterator, class Compare>
+class kway_merge <Iterator, Compare> :: iterator
+{
+public:
+   typedef std::input_iterator_tag                  iterator_category;
+   typedef typename kway_merge::value_type          value_type;
+   typedef std::ptrdiff_t                           difference_type;
+   typedef const value_type *                       pointer;
+   typedef typename kway_merge::reference           reference;
+
+   iterator() : merge(nullptr) {}
+   explicit iterator(kway_merge * merge) : merge(merge) {}
+
+   reference operator * () const { return merge->top(); }
+   pointer operator -> () const { return &merge->top(); }
+   iterator & operator ++ ()
+   {
+      merge->pop();
+      return *this;
+   }
+   // it++ must still let *it++ see the old element
+   struct postfix
+   {
+      value_type value;
+      const value_type & operator * () const { return value; }
+   };
+   postfix operator ++ (int)
+   {
+      postfix old = { merge->top() };
+      merge->pop();
+      return old;
+   }
+
+   // all that matters is whether either side has run dry
+   bool operator == (const iterator & rhs) const { return done() == rhs.done(); }
+   bool operator != (const iterator & rhs) const { return done() != rhs.done(); }
+
+private:
+   bool done() const { return merge == nullptr || merge->empty(); }
+
+   kway_merge * merge;
+};
+
+/************************************************
+ * K-WAY MERGE :: TOP
+ * The smallest head of all the runs
+ ***********************************************/
+template <class Iterator, class Compare>
+typename kway_merge <Iterator, Compare> :: reference
+kway_merge <Iterator, Compare> :: top() const
+{
+   if (empty())
+      throw std::out_of_range("std:out_of_range");
+   return *runs[tree[0]].first;
+}
+
+/************************************************
+ * K-WAY MERGE :: POP
+ * Advance the winning run and replay its path
+ ***********************************************/
+template <class Iterator, class Compare>
+void kway_merge <Iterator, Compare> :: pop()
+{
+   if (empty())
+      return;
+   size_t winner = tree[0];
+   ++runs[winner].first;
+   replay(winner);
+}
+
+/************************************************
+ * K-WAY MERGE :: BEATS
+ * Does the head of run lhs come out before that of
+ * rhs? A finished run loses to everything. One
+ * comparison settles it: the earlier run wins ties.
+ ***********************************************/
+template <class Iterator, class Compare>
+bool kway_merge <Iterator, Compare> :: beats(size_t lhs, size_t rhs) const
+{
+   if (exhausted(lhs))
+      return false;
+   if (exhausted(rhs))
+      return true;
+   if (lhs < rhs)
+      return !compare(*runs[rhs].first, *runs[lhs].first);
+   return compare(*runs[lhs].first, *runs[rhs].first);
+}
+
+/************************************************
+ * K-WAY MERGE :: BUILD
+ * Play the first tournament bottom-up. The leaf of
+ * run i is node k + i, so every internal node has
+ * exactly two children whatever k is.
+ ***********************************************/
+template <class Iterator, class Compare>
+void kway_merge <Iterator, Compare> :: build()
+{
+   size_t k = runs.size();
+   if (k == 0)
+      return;
+
+   custom::vector<size_t> winners(2 * k);
+   for (size_t i = 0; i < k; i++)
+      winners[k + i] = i;
+
+   tree = custom::vector<size_t>(k);
+   for (size_t node = k - 1; node >= 1; node--)
+   {
+      size_t left  = winners[2 * node];
+      size_t right = winners[2 * node + 1];
+      if (beats(left, right))
+      {
+         winners[node] = left;
+         tree[node] = right;
+      }
+      else
+      {
+         winners[node] = right;
+         tree[node] = left;
+      }
+   }
+   tree[0] = k > 1 ? winners[1] : 0;
+}
+
+/************************************************
+ * K-WAY MERGE :: REPLAY
+ * Climb from the leaf of run to the root. At each
+ * node the stored loser plays the climbing winner;
+ * whoever loses stays behind.
+ ***********************************************/
+template <class Iterator, class Compare>
+void kway_merge <Iterator, Compare> :: replay(size_t run)
+{
+   size_t winner = run;
+   for (size_t node = (runs.size() + run) / 2; node >= 1; node /= 2)
+      if (beats(tree[node], winner))
+      {
+         size_t loser = winner;
+         winner = tree[node];
+         tree[node] = loser;
+      }
+   tree[0] = winner;
+}
+
+} // namespace custom
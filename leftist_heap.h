@@ -0,0 +1,354 @@
+/***********************************************************************
+ * Header:
+ *    LEFTIST HEAP
+ * Summary:
+ *    A mergeable priority queue. Two leftist heaps meld in O(log n)
+ *    worst case, where two array heaps need n pushes or a heapify.
+ *
+ *    Every node keeps its rank: the length of the path down its right
+ *    spine. A node's left child never has a smaller rank than its
+ *    right, so right spines are at most log2(n + 1) long. Meld walks
+ *    the two right spines together like a merge of sorted lists, then
+ *    swaps children on the way back up wherever the rank rule broke.
+ *    push() and pop() are both melds.
+ *
+ *    The nodes live in a pool, a custom::vector of slots linked by
+ *    index with a free list, so there is one allocation per growth
+ *    rather than one per node and the nodes stay close together.
+ *    Heaps that share a pool meld without touching a single node
+ *    off the spines. Heaps in different pools still meld, but the
+ *    right-hand heap's nodes are moved over first, which is O(n).
+ *    A pool is not thread safe: heaps sharing one must be used from
+ *    one thread at a time.
+ *
+ *    This will contain the class definition of:
+ *        leftist_heap            : A meldable heap in a node pool
+ *        leftist_heap::pool      : The slab of nodes heaps can share
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <memory>      // for std::shared_ptr
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::move, std::forward, and std::swap
+#include "vector.h"
+
+class TestLeftistHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * LEFTIST HEAP
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class leftist_heap
+{
+   friend class ::TestLeftistHeap; // give the unit test class access to the privates
+public:
+   class pool;
+
+   //
+   // construct
+   //
+   explicit leftist_heap(const Compare & compare = Compare()) :
+      leftist_heap(std::make_shared<pool>(), compare)
+   {
+   }
+   explicit leftist_heap(std::shared_ptr<pool> nodes, const Compare & compare = Compare()) :
+      nodes(nodes), root(NIL), numElements(0), compare(compare)
+   {
+   }
+   leftist_heap(const leftist_heap & rhs) :
+      nodes(rhs.nodes), root(NIL), numElements(rhs.numElements), compare(rhs.compare)
+   {
+      root = adopt(*rhs.nodes, rhs.root, false /*steal*/);
+   }
+   leftist_heap(leftist_heap && rhs) noexcept :
+      nodes(rhs.nodes), root(rhs.root), numElements(rhs.numElements), compare(rhs.compare)
+   {
+      rhs.root = NIL;
+      rhs.numElements = 0;
+   }
+   leftist_heap & operator = (const leftist_heap & rhs) = delete;
+  ~leftist_heap() { clear(); }
+
+   //
+   // Access
+   //
+   const T & top() const;
+   std::shared_ptr<pool> get_pool() const { return nodes; }
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+   void meld(leftist_heap & rhs);
+
+   //
+   // Remove
+   //
+   void pop();
+   void clear();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   static constexpr size_t NIL = (size_t)-1;
+
+   size_t rank(size_t node) const { return node == NIL ? 0 : nodes->slots[node].rank; }
+   size_t meld(size_t lhs, size_t rhs);
+   size_t adopt(pool & from, size_t node, bool steal);
+
+   std::shared_ptr<pool>  nodes;
+   custom::vector<size_t> spine;   // reused by meld()
+   size_t  root;
+   size_t  numElements;
+   Compare compare;
+};
+
+/*************************************************
+ * LEFTIST HEAP :: POOL
+ * A slab of nodes. Freed slots are reused before
+ * the slab grows.
+ *************************************************/
+template <class T, class Compare>
+class leftist_heap <T, Compare> :: pool
+{
+   friend class leftist_heap;
+   friend class ::TestLeftistHeap;
+public:
+   void   reserve(size_t n) { slots.reserve(n); freeSlots.reserve(n); }
+   size_t capacity() const  { return slots.size(); }
+   size_t available() const { return freeSlots.size(); }
+
+private:
+   struct Node
+   {
+      T      value;
+      size_t left;
+      size_t right;
+      size_t rank;     // length of the right spine, counting this node
+   };
+
+   template <class U>
+   size_t allocate(U && value)
+   {
+      size_t slot;
+      if (!freeSlots.empty())
+      {
+         slot = freeSlots.back();
+         freeSlots.pop_back();
+         slots[slot].value = std::forward<U>(value);
+      }
+      else
+      {
+         slot = slots.size();
+         slots.push_back(Node{ std::forward<U>(value), NIL, NIL, 1 });
+      }
+      slots[slot].left = NIL;
+      slots[slot].right = NIL;
+      slots[slot].rank = 1;
+      return slot;
+   }
+   void release(size_t slot) { freeSlots.push_back(slot); }
+
+   custom::vector<Node>   slots;
+   custom::vector<size_t> freeSlots;
+};
+
+/************************************************
+ * LEFTIST HEAP :: TOP
+ * The largest item is always the root
+ ***********************************************/
+template <class T, class Compare>
+const T & leftist_heap <T, Compare> :: top() const
+{
+   if (root == NIL)
+      throw std::out_of_range("std:out_of_range");
+   return nodes->slots[root].value;
+}
+
+/************************************************
+ * LEFTIST HEAP :: PUSH
+ * Meld with a one-node heap
+ ***********************************************/
+template <class T, class Compare>
+void leftist_heap <T, Compare> :: push(const T & t)
+{
+   root = meld(root, nodes->allocate(t));
+   numElements++;
+}
+
+template <class T, class Compare>
+void leftist_heap <T, Compare> :: push(T && t)
+{
+   root = meld(root, nodes->allocate(std::move(t)));
+   numElements++;
+}
+
+/************************************************
+ * LEFTIST HEAP :: MELD
+ * Take every item out of rhs. O(log n) when the
+ * two share a pool.
+ ***********************************************/
+template <class T, class Compare>
+void leftist_heap <T, Compare> :: meld(leftist_heap & rhs)
+{
+   if (&rhs == this || rhs.root == NIL)
+      return;
+
+   size_t other = rhs.root;
+   if (rhs.nodes != nodes)
+      other = adopt(*rhs.nodes, rhs.root, true /*steal*/);
+
+   root = meld(root, other);
+   numElements += rhs.numElements;
+   rhs.root = NIL;
+   rhs.numElements = 0;
+}
+
+/************************************************
+ * LEFTIST HEAP :: POP
+ * Drop the root and meld its two subtrees
+ ***********************************************/
+template <class T, class Compare>
+void leftist_heap <T, Compare> :: pop()
+{
+   if (root == NIL)
+      return;
+
+   size_t old = root;
+   root = meld(nodes->slots[old].left, nodes->slots[old].right);
+   nodes->release(old);
+   numElements--;
+}
+
+/************************************************
+ * LEFTIST HEAP :: CLEAR
+ * Give every node back to the pool
+ ***********************************************/
+template <class T, class Compare>
+void leftist_heap <T, Compare> :: clear()
+{
+   if (root == NIL)
+      return;
+
+   spine.clear();
+   spine.push_back(root);
+   while (!spine.empty())
+   {
+      size_t node = spine.back();
+      spine.pop_back();
+      if (nodes->slots[node].left != NIL)
+         spine.push_back(nodes->slots[node].left);
+      if (nodes->slots[node].right != NIL)
+         spine.push_back(nodes->slots[node].right);
+      nodes->release(node);
+   }
+   root = NIL;
+   numElements = 0;
+}
+
+/************************************************
+ * LEFTIST HEAP :: MELD (by root)
+ * Merge the right spines top-down, remembering the
+ * path, then walk it back up restoring the rank
+ * rule. Only spine nodes are touched.
+ ***********************************************/
+template <class T, class Compare>
+size_t leftist_heap <T, Compare> :: meld(size_t lhs, size_t rhs)
+{
+   if (lhs == NIL)
+      return rhs;
+   if (rhs == NIL)
+      return lhs;
+
+   custom::vector<typename pool::Node> & slots = nodes->slots;
+
+   // the larger root wins; the loser is melded into its right subtree
+   if (compare(slots[lhs].value, slots[rhs].value))
+      std::swap(lhs, rhs);
+   size_t result = lhs;
+
+   spine.clear();
+   spine.push_back(lhs);
+   size_t node = lhs;
+   size_t next = slots[node].right;
+   while (next != NIL)
+   {
+      if (compare(slots[next].value, slots[rhs].value))
+         std::swap(next, rhs);
+      slots[node].right = next;
+      spine.push_back(next);
+      node = next;
+      next = slots[node].right;
+   }
+   slots[node].right = rhs;
+
+   // back up the path: the heavier side goes left
+   for (size_t i = spine.size(); i-- > 0; )
+   {
+      node = spine[i];
+      if (rank(slots[node].left) < rank(slots[node].right))
+         std::swap(slots[node].left, slots[node].right);
+      slots[node].rank = rank(slots[node].right) + 1;
+   }
+   return result;
+}
+
+/************************************************
+ * LEFTIST HEAP :: ADOPT
+ * Copy the tree under node from another pool into
+ * ours, keeping its shape. With steal, the values
+ * are moved and the old nodes freed.
+ ***********************************************/
+template <class T, class Compare>
+size_t leftist_heap <T, Compare> :: adopt(pool & from, size_t node, bool steal)
+{
+   if (node == NIL)
+      return NIL;
+
+   // pairs of {node in from, its copy in ours}
+   custom::vector<std::pair<size_t, size_t>> work;
+   size_t copy = steal ? nodes->allocate(std::move(from.slots[node].value))
+                       : nodes->allocate(from.slots[node].value);
+   work.push_back(std::make_pair(node, copy));
+   while (!work.empty())
+   {
+      std::pair<size_t, size_t> pair = work.back();
+      work.pop_back();
+      nodes->slots[pair.second].rank = from.slots[pair.first].rank;
+
+      size_t children[2] = { from.slots[pair.first].left, from.slots[pair.first].right };
+      for (int side = 0; side < 2; side++)
+      {
+         size_t child = NIL;
+         if (children[side] != NIL)
+         {
+            child = steal ? nodes->allocate(std::move(from.slots[children[side]].value))
+                          : nodes->allocate(from.slots[children[side]].value);
+            work.push_back(std::make_pair(children[side], child));
+         }
+         if (side == 0)
+            nodes->slots[pair.second].left = child;
+         else
+            nodes->slots[pair.second].right = child;
+      }
+      if (steal)
+         from.release(pair.first);
+   }
+   return copy;
+}
+
+} // namespace custom
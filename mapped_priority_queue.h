@@ -0,0 +1,433 @@
+/***********************************************************************
+ * Header:
+ *    MAPPED PRIORITY QUEUE
+ * Summary:
+ *    A binary heap that lives in a memory-mapped file, so a restarted
+ *    process opens the file and has its queue back at once: nothing is
+ *    read, parsed, or re-heapified. The file is:
+ *        header   magic, version, element size, count, capacity,
+ *                 checksum, and a dirty flag; padded to 64 bytes
+ *        heap     capacity slots of T, the first count in heap order
+ *
+ *    The checksum is a sum of a hash of every item. Sifting only moves
+ *    items around, so push and pop keep it up to date in O(1). The
+ *    dirty flag is set while an operation is under way. Opening a file
+ *    left dirty by a crash re-checks the checksum and re-heapifies. A
+ *    push or pop caught between updating the checksum and the count is
+ *    finished; any other mismatch means the file cannot be trusted, and
+ *    opening throws.
+ *
+ *    How soon a change reaches the disk is up to the msync_policy:
+ *        none     the kernel writes pages back in its own time. A
+ *                 crash of the process loses nothing; a crash of the
+ *                 machine may.
+ *        async    every push and pop schedules the write-back
+ *        sync     every push and pop waits for it: durable, and slow
+ *    sync() forces a write-back under any policy.
+ *
+ *    T should have no padding, or the checksum may change as items are
+ *    copied. Reopen a file with the same T, platform and Compare.
+ *
+ *    This will contain the class definition of:
+ *        mapped_priority_queue   : A priority queue in a mapped file
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include <cassert>
+#include <cerrno>          // for errno
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t and uint32_t
+#include <cstring>         // for std::memcpy and std::memcmp
+#include <functional>      // for std::less
+#include <stdexcept>       // for std::out_of_range and std::runtime_error
+#include <string>
+#include <system_error>    // for std::system_error
+#include <type_traits>     // for std::is_trivially_copyable
+#include <fcntl.h>         // for open
+#include <sys/mman.h>      // for mmap, mremap, msync and munmap
+#include <sys/stat.h>      // for fstat
+#include <unistd.h>        // for ftruncate and close
+#include "heap.h"
+
+class TestMappedPriorityQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * MSYNC POLICY
+ * When changes are written back to the file
+ *************************************************/
+enum class msync_policy { none, async, sync };
+
+/*************************************************
+ * MAPPED PRIORITY QUEUE
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class mapped_priority_queue
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "mapped_priority_queue stores T as raw bytes");
+   static_assert(alignof(T) <= 64, "mapped_priority_queue aligns items to 64 bytes at most");
+   friend class ::TestMappedPriorityQueue; // give the unit test class access to the privates
+public:
+
+   //
+   // construct: open the file, or create it if it is missing or empty
+   //
+   explicit mapped_priority_queue(const std::string & path,
+                                  msync_policy policy = msync_policy::none,
+                                  const Compare & compare = Compare());
+   mapped_priority_queue(const mapped_priority_queue &) = delete;
+   mapped_priority_queue & operator = (const mapped_priority_queue &) = delete;
+  ~mapped_priority_queue();
+
+   //
+   // Access
+   //
+   const T & top() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void reserve(size_t n);
+
+   //
+   // Remove
+   //
+   void pop();
+   void clear();
+
+   //
+   // Durability
+   //
+   void sync();
+   bool verify() const { return checksumOf(data(), size()) == head->checksum; }
+
+   //
+   // Status
+   //
+   size_t size()     const { return (size_t)head->count; }
+   bool   empty()    const { return head->count == 0; }
+   size_t capacity() const { return (size_t)head->capacity; }
+
+private:
+   static constexpr uint32_t VERSION = 1;
+   static constexpr size_t   HEADER_BYTES = 64;
+
+   struct header
+   {
+      char     magic[8];      // "CPQHEAP" and a zero
+      uint32_t version;
+      uint32_t elementSize;
+      uint64_t count;
+      uint64_t capacity;
+      uint64_t checksum;      // sum of hashOf() over the first count items
+      uint32_t dirty;         // an operation was under way
+   };
+   static_assert(sizeof(header) <= HEADER_BYTES, "the header fits its padding");
+
+   T *       data()       { return reinterpret_cast<T *>(base + HEADER_BYTES); }
+   const T * data() const { return reinterpret_cast<const T *>(base + HEADER_BYTES); }
+
+   static uint64_t hashOf(const T & t);
+   static uint64_t checksumOf(const T * items, size_t count);
+
+   void create();
+   void validate();
+   void grow(size_t newCapacity);
+   void afterChange();
+   void unmap();
+
+   std::string  path;
+   int          fd;
+   char *       base;          // the whole file, mapped
+   size_t       mappedBytes;
+   header *     head;
+   msync_policy policy;
+   Compare      compare;
+};
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: CONSTRUCTOR
+ ***********************************************/
+template <class T, class Compare>
+mapped_priority_queue <T, Compare> :: mapped_priority_queue(const std::string & path,
+                                                             msync_policy policy,
+                                                             const Compare & compare) :
+   path(path), fd(-1), base(nullptr), mappedBytes(0), head(nullptr),
+   policy(policy), compare(compare)
+{
+   fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+   if (fd < 0)
+      throw std::system_error(errno, std::system_category(), "open " + path);
+
+   struct stat status;
+   if (fstat(fd, &status) != 0)
+   {
+      int error = errno;
+      unmap();
+      throw std::system_error(error, std::system_category(), "fstat " + path);
+   }
+
+   try
+   {
+      if (status.st_size == 0)
+         create();
+      else
+      {
+         mappedBytes = (size_t)status.st_size;
+         void * p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+         if (p == MAP_FAILED)
+            throw std::system_error(errno, std::system_category(), "mmap " + path);
+         base = static_cast<char *>(p);
+         head = reinterpret_cast<header *>(base);
+         validate();
+      }
+   }
+   catch (...)
+   {
+      unmap();
+      throw;
+   }
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: DESTRUCTOR
+ * Unmapping loses nothing: the pages belong to
+ * the file. Wait for them if durability was asked.
+ ***********************************************/
+template <class T, class Compare>
+mapped_priority_queue <T, Compare> :: ~mapped_priority_queue()
+{
+   if (base != nullptr && policy != msync_policy::none)
+      msync(base, mappedBytes, MS_SYNC);
+   unmap();
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: CREATE
+ * A new file with room for a page or so of items
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: create()
+{
+   size_t initial = 4096 / sizeof(T) + 1;
+   mappedBytes = HEADER_BYTES + initial * sizeof(T);
+   if (ftruncate(fd, (off_t)mappedBytes) != 0)
+      throw std::system_error(errno, std::system_category(), "ftruncate " + path);
+   void * p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (p == MAP_FAILED)
+      throw std::system_error(errno, std::system_category(), "mmap " + path);
+   base = static_cast<char *>(p);
+   head = reinterpret_cast<header *>(base);
+
+   std::memcpy(head->magic, "CPQHEAP", 8);
+   head->version     = VERSION;
+   head->elementSize = (uint32_t)sizeof(T);
+   head->count       = 0;
+   head->capacity    = initial;
+   head->checksum    = 0;
+   head->dirty       = 0;
+   afterChange();
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: VALIDATE
+ * Is this our kind of file? If an operation was
+ * cut short, check the items are all there and put
+ * them back in heap order.
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: validate()
+{
+   if (mappedBytes < HEADER_BYTES || std::memcmp(head->magic, "CPQHEAP", 8) != 0)
+      throw std::runtime_error(path + " is not a mapped_priority_queue");
+   if (head->version != VERSION)
+      throw std::runtime_error(path + " has version " + std::to_string(head->version));
+   if (head->elementSize != sizeof(T))
+      throw std::runtime_error(path + " holds items of " + std::to_string(head->elementSize) + " bytes");
+   if (head->count > head->capacity || mappedBytes < HEADER_BYTES + head->capacity * sizeof(T))
+      throw std::runtime_error(path + " is truncated");
+
+   if (head->dirty)
+   {
+      // push and pop change the checksum one step before the count, so
+      // a crash between the two leaves one item half counted: finish it
+      uint64_t sum = checksumOf(data(), size());
+      if (sum != head->checksum && head->count < head->capacity &&
+          sum + hashOf(data()[size()]) == head->checksum)
+         head->count++;
+      else if (sum != head->checksum && head->count > 0 &&
+               sum - hashOf(data()[size() - 1]) == head->checksum)
+         head->count--;
+      else if (sum != head->checksum)
+         throw std::runtime_error(path + " fails its checksum");
+      custom::make_heap(data(), data() + size(), compare);
+      head->dirty = 0;
+      afterChange();
+   }
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: HASH
+ * FNV-1a over the bytes of one item
+ ***********************************************/
+template <class T, class Compare>
+uint64_t mapped_priority_queue <T, Compare> :: hashOf(const T & t)
+{
+   const unsigned char * bytes = reinterpret_cast<const unsigned char *>(&t);
+   uint64_t hash = 14695981039346656037ull;
+   for (size_t i = 0; i < sizeof(T); i++)
+      hash = (hash ^ bytes[i]) * 1099511628211ull;
+   return hash;
+}
+
+template <class T, class Compare>
+uint64_t mapped_priority_queue <T, Compare> :: checksumOf(const T * items, size_t count)
+{
+   uint64_t sum = 0;
+   for (size_t i = 0; i < count; i++)
+      sum += hashOf(items[i]);
+   return sum;
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: TOP
+ ***********************************************/
+template <class T, class Compare>
+const T & mapped_priority_queue <T, Compare> :: top() const
+{
+   if (empty())
+      throw std::out_of_range("std:out_of_range");
+   return data()[0];
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: PUSH
+ * Append, count it, then sift it up
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: push(const T & t)
+{
+   if (head->count == head->capacity)
+      grow(2 * capacity());
+
+   head->dirty = 1;
+   size_t index = size();
+   std::memcpy(static_cast<void *>(data() + index), &t, sizeof(T));
+   head->checksum += hashOf(t);
+   head->count++;
+   custom::siftUp(data(), index, compare);
+   head->dirty = 0;
+   afterChange();
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: POP
+ * Swap the top to the end, uncount it, sift down
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: pop()
+{
+   if (empty())
+      return;
+
+   head->dirty = 1;
+   size_t last = size() - 1;
+   if (last > 0)
+   {
+      using std::swap;
+      swap(data()[0], data()[last]);
+   }
+   head->checksum -= hashOf(data()[last]);
+   head->count--;
+   if (size() > 1)
+      custom::siftDown(data(), 0, size(), compare);
+   head->dirty = 0;
+   afterChange();
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: CLEAR
+ * Empty, keeping the file at its size
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: clear()
+{
+   head->count = 0;
+   head->checksum = 0;
+   afterChange();
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: RESERVE
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: reserve(size_t n)
+{
+   if (n > capacity())
+      grow(n);
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: GROW
+ * Extend the file, then the mapping. The mapping
+ * may move, so no pointer into it survives this.
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: grow(size_t newCapacity)
+{
+   size_t newBytes = HEADER_BYTES + newCapacity * sizeof(T);
+   if (ftruncate(fd, (off_t)newBytes) != 0)
+      throw std::system_error(errno, std::system_category(), "ftruncate " + path);
+   void * p = mremap(base, mappedBytes, newBytes, MREMAP_MAYMOVE);
+   if (p == MAP_FAILED)
+      throw std::system_error(errno, std::system_category(), "mremap " + path);
+   base = static_cast<char *>(p);
+   head = reinterpret_cast<header *>(base);
+   mappedBytes = newBytes;
+   head->capacity = newCapacity;
+}
+
+/************************************************
+ * MAPPED PRIORITY QUEUE :: SYNC
+ * Write every changed page back and wait for it
+ ***********************************************/
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: sync()
+{
+   if (msync(base, mappedBytes, MS_SYNC) != 0)
+      throw std::system_error(errno, std::system_category(), "msync " + path);
+}
+
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: afterChange()
+{
+   if (policy == msync_policy::async)
+      msync(base, mappedBytes, MS_ASYNC);
+   else if (policy == msync_policy::sync)
+      sync();
+}
+
+template <class T, class Compare>
+void mapped_priority_queue <T, Compare> :: unmap()
+{
+   if (base != nullptr)
+      munmap(base, mappedBytes);
+   if (fd >= 0)
+      ::close(fd);
+   base = nullptr;
+   head = nullptr;
+   fd = -1;
+}
+
+} // namespace custom
+
+#endif // __linux__
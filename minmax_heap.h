@@ -0,0 +1,337 @@
+/***********************************************************************
+ * Header:
+ *    MIN-MAX HEAP
+ * Summary:
+ *    A double-ended priority queue. Levels alternate: every node on
+ *    an even level (the root is level 0) is no larger than anything
+ *    below it, and every node on an odd level is no smaller. The
+ *    smallest item is therefore the root and the largest is one of
+ *    its two children.
+ *
+ *    This will contain the class definition of:
+ *        minmax_heap             : A class that represents a Min-Max Heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <functional>  // for std::less
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::swap
+#include "vector.h"
+
+class TestMinMaxHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * MIN-MAX HEAP
+ * O(1) min() and max(); O(log n) push(),
+ * pop_min() and pop_max().
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class minmax_heap
+{
+   friend class ::TestMinMaxHeap; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   minmax_heap(const Compare & compare = Compare()) : compare(compare) {}
+   minmax_heap(const minmax_heap & rhs) : container(rhs.container), compare(rhs.compare) {}
+   minmax_heap(minmax_heap && rhs) : container(std::move(rhs.container)), compare(rhs.compare) {}
+   template <class Iterator>
+   minmax_heap(Iterator first, Iterator last, const Compare & compare = Compare()) :
+      compare(compare)
+   {
+      for (Iterator element = first; element != last; ++element)
+         container.push_back(*element);
+      heapify();
+   }
+   explicit minmax_heap(custom::vector<T> && rhs, const Compare & compare = Compare()) :
+      container(std::move(rhs)), compare(compare)
+   {
+      heapify();
+   }
+  ~minmax_heap() {}
+
+   //
+   // Access
+   //
+   const T & min() const;
+   const T & max() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+
+   //
+   // Remove
+   //
+   void pop_min();
+   void pop_max();
+
+   //
+   // Status
+   //
+   size_t size()  const { return container.size();  }
+   bool   empty() const { return container.empty(); }
+
+private:
+
+   static bool isMinLevel(size_t index);
+   size_t indexMax() const;                    // where the largest item lives
+   void heapify();                             // convert the container into a min-max heap
+   void percolateUp(size_t index);             // fix the heap from index up
+   template <bool isMin>
+   void percolateUpLevels(size_t index);       // ... along the min or the max levels
+   void percolateDown(size_t index);           // fix the heap from index down
+   template <bool isMin>
+   void percolateDownLevels(size_t index);     // ... along the min or the max levels
+
+   // is lhs further toward the min end (isMin) or the max end than rhs?
+   template <bool isMin>
+   bool before(const T & lhs, const T & rhs) const
+   {
+      return isMin ? compare(lhs, rhs) : compare(rhs, lhs);
+   }
+
+   void swapElements(size_t lhs, size_t rhs)
+   {
+      using std::swap;
+      swap(container[lhs], container[rhs]);
+   }
+
+   custom::vector<T> container;   // 0-based
+   Compare compare;
+};
+
+/************************************************
+ * MIN-MAX HEAP :: MIN
+ * The smallest item: always the root
+ ***********************************************/
+template <class T, class Compare>
+const T & minmax_heap <T, Compare> :: min() const
+{
+   if (container.empty())
+      throw std::out_of_range("std:out_of_range");
+   return container.front();
+}
+
+/************************************************
+ * MIN-MAX HEAP :: MAX
+ * The largest item: the larger child of the root
+ ***********************************************/
+template <class T, class Compare>
+const T & minmax_heap <T, Compare> :: max() const
+{
+   if (container.empty())
+      throw std::out_of_range("std:out_of_range");
+   return container[indexMax()];
+}
+
+/************************************************
+ * MIN-MAX HEAP :: PUSH
+ * Add to the end and percolate up
+ ***********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: push(const T & t)
+{
+   container.push_back(t);
+   percolateUp(container.size() - 1);
+}
+
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: push(T && t)
+{
+   container.push_back(std::move(t));
+   percolateUp(container.size() - 1);
+}
+
+/************************************************
+ * MIN-MAX HEAP :: POP MIN
+ * Replace the root with the last item and push
+ * it down the min levels
+ ***********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: pop_min()
+{
+   if (container.empty())
+      return;
+
+   swapElements(0, container.size() - 1);
+   container.pop_back();
+   if (!container.empty())
+      percolateDown(0);
+}
+
+/************************************************
+ * MIN-MAX HEAP :: POP MAX
+ * Replace the largest with the last item and push
+ * it down the max levels
+ ***********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: pop_max()
+{
+   if (container.empty())
+      return;
+
+   size_t index = indexMax();
+   swapElements(index, container.size() - 1);
+   container.pop_back();
+   if (index < container.size())
+      percolateDown(index);
+}
+
+/************************************************
+ * MIN-MAX HEAP :: IS MIN LEVEL
+ * The root is on level 0, its children on level 1...
+ ***********************************************/
+template <class T, class Compare>
+bool minmax_heap <T, Compare> :: isMinLevel(size_t index)
+{
+   size_t level = 0;
+   for (size_t n = index + 1; n > 1; n >>= 1)
+      level++;
+   return level % 2 == 0;
+}
+
+/************************************************
+ * MIN-MAX HEAP :: INDEX MAX
+ * One comparison at most
+ ***********************************************/
+template <class T, class Compare>
+size_t minmax_heap <T, Compare> :: indexMax() const
+{
+   if (container.size() == 1)
+      return 0;
+   if (container.size() == 2)
+      return 1;
+   return compare(container[1], container[2]) ? 2 : 1;
+}
+
+/************************************************
+ * MIN-MAX HEAP :: HEAPIFY
+ * Floyd's bottom-up construction works level for
+ * level just as it does in a binary heap
+ ***********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: heapify()
+{
+   for (size_t index = container.size() / 2; index-- > 0; )
+      percolateDown(index);
+}
+
+/************************************************
+ * MIN-MAX HEAP :: PERCOLATE UP
+ * A new item is first checked against its parent,
+ * which is on the other kind of level. That decides
+ * whether it climbs the min levels or the max ones.
+ ***********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: percolateUp(size_t index)
+{
+   if (index == 0)
+      return;
+
+   size_t parent = (index - 1) / 2;
+   if (isMinLevel(index))
+   {
+      if (compare(container[parent], container[index]))
+      {
+         swapElements(index, parent);
+         percolateUpLevels<false>(parent);
+      }
+      else
+         percolateUpLevels<true>(index);
+   }
+   else
+   {
+      if (compare(container[index], container[parent]))
+      {
+         swapElements(index, parent);
+         percolateUpLevels<true>(parent);
+      }
+      else
+         percolateUpLevels<false>(index);
+   }
+}
+
+/************************************************
+ * MIN-MAX HEAP :: PERCOLATE UP LEVELS
+ * Climb by grandparents, staying on one kind of level
+ ***********************************************/
+template <class T, class Compare>
+template <bool isMin>
+void minmax_heap <T, Compare> :: percolateUpLevels(size_t index)
+{
+   while (index > 2)
+   {
+      size_t grandparent = ((index - 1) / 2 - 1) / 2;
+      if (!before<isMin>(container[index], container[grandparent]))
+         break;
+      swapElements(index, grandparent);
+      index = grandparent;
+   }
+}
+
+/************************************************
+ * MIN-MAX HEAP :: PERCOLATE DOWN
+ ***********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: percolateDown(size_t index)
+{
+   if (isMinLevel(index))
+      percolateDownLevels<true>(index);
+   else
+      percolateDownLevels<false>(index);
+}
+
+/************************************************
+ * MIN-MAX HEAP :: PERCOLATE DOWN LEVELS
+ * Find the most extreme of the children and
+ * grandchildren. A child ends the walk; a grandchild
+ * may have to trade places with its parent before
+ * we carry on from there.
+ ***********************************************/
+template <class T, class Compare>
+template <bool isMin>
+void minmax_heap <T, Compare> :: percolateDownLevels(size_t index)
+{
+   size_t size = container.size();
+   for (;;)
+   {
+      size_t child = 2 * index + 1;
+      if (child >= size)
+         return;
+
+      // the children and grandchildren are contiguous in two runs
+      size_t best = child;
+      if (child + 1 < size && before<isMin>(container[child + 1], container[best]))
+         best = child + 1;
+      size_t grandchild = 2 * child + 1;
+      for (size_t i = grandchild; i < grandchild + 4 && i < size; i++)
+         if (before<isMin>(container[i], container[best]))
+            best = i;
+
+      if (!before<isMin>(container[best], container[index]))
+         return;
+      swapElements(best, index);
+
+      if (best < grandchild)
+         return;                               // it was a child: done
+
+      size_t parent = (best - 1) / 2;
+      if (before<isMin>(container[parent], container[best]))
+         swapElements(best, parent);
+      index = best;
+   }
+}
+
+} // namespace custom
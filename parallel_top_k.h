@@ -0,0 +1,206 @@
+/***********************************************************************
+ * Header:
+ *    PARALLEL TOP K
+ * Summary:
+ *    The best K items of a random-access range, found by several
+ *    threads at once. Each thread keeps a private top_k over its own
+ *    slice, so nothing is shared on the hot path; the K survivors of
+ *    every slice are merged at the end.
+ *
+ *    For arithmetic keys the threads also share a threshold through
+ *    an atomic: once any thread holds K items, nothing worse than its
+ *    weakest can make the final cut, so every thread may reject those
+ *    without touching its own heap.
+ *
+ *    This will contain the definitions of:
+ *        shared_threshold        : The best bar any thread has reached
+ *        parallel_top_k          : Split, collect, and merge
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <atomic>      // for std::atomic
+#include <functional>  // for std::less
+#include <iterator>    // for std::iterator_traits
+#include <mutex>       // for std::mutex
+#include <thread>      // for std::thread
+#include <type_traits> // for std::is_arithmetic
+#include "vector.h"
+#include "top_k.h"
+
+namespace custom
+{
+
+/*************************************************
+ * SHARED THRESHOLD
+ * A bar that only ever gets higher. Publishing is
+ * rare (a thread's own threshold must have improved)
+ * so it takes a lock; reading is one atomic load,
+ * done once per block through a view.
+ *************************************************/
+template <class T, class Compare, bool enabled = std::is_arithmetic<T>::value>
+class shared_threshold
+{
+public:
+   explicit shared_threshold(const Compare & compare) :
+      compare(compare), valid(false), value(T()) {}
+
+   // what one thread last saw of the shared bar
+   class view
+   {
+   public:
+      explicit view(shared_threshold & shared) :
+         shared(shared), valid(false), bar(T()) {}
+
+      // catch up with the other threads
+      void refresh()
+      {
+         if (shared.valid.load(std::memory_order_acquire))
+         {
+            bar = shared.value.load(std::memory_order_relaxed);
+            valid = true;
+         }
+      }
+
+      // t cannot make the final cut
+      bool rejects(const T & t) const
+      {
+         return valid && !shared.compare(bar, t);
+      }
+
+      // this thread's threshold went up: tell the others if it beats theirs
+      void offer(const T & t)
+      {
+         if (!valid || shared.compare(bar, t))
+         {
+            shared.publish(t);
+            bar = t;
+            valid = true;
+         }
+      }
+
+   private:
+      shared_threshold & shared;
+      bool valid;
+      T bar;
+   };
+
+private:
+   void publish(const T & t)
+   {
+      std::lock_guard<std::mutex> guard(lock);
+      if (!valid.load(std::memory_order_relaxed) ||
+          compare(value.load(std::memory_order_relaxed), t))
+      {
+         value.store(t, std::memory_order_relaxed);
+         valid.store(true, std::memory_order_release);
+      }
+   }
+
+   Compare compare;
+   std::mutex lock;              // serializes publishers
+   std::atomic<bool> valid;      // has any thread filled its heap yet?
+   std::atomic<T> value;
+};
+
+/*************************************************
+ * SHARED THRESHOLD : not arithmetic
+ * No atomic to put it in: every thread goes it alone
+ *************************************************/
+template <class T, class Compare>
+class shared_threshold <T, Compare, false>
+{
+public:
+   explicit shared_threshold(const Compare &) {}
+
+   class view
+   {
+   public:
+      explicit view(shared_threshold &) {}
+      void refresh() {}
+      bool rejects(const T &) const { return false; }
+      void offer(const T &) {}
+   };
+};
+
+/************************************************
+ * PARALLEL TOP K
+ * The K best of [first, last) under Compare, best
+ * first. numThreads of 0 means one per core.
+ ***********************************************/
+template <size_t K, class RandomIt,
+          class Compare = std::less<typename std::iterator_traits<RandomIt>::value_type>>
+custom::vector<typename std::iterator_traits<RandomIt>::value_type>
+parallel_top_k(RandomIt first, RandomIt last, size_t numThreads = 0,
+               const Compare & compare = Compare())
+{
+   typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+   size_t num = (size_t)(last - first);
+   if (numThreads == 0)
+      numThreads = std::thread::hardware_concurrency();
+   if (numThreads > num)
+      numThreads = num;
+   if (numThreads == 0)
+      numThreads = 1;
+
+   // re-read the shared bar this often
+   const size_t blockSize = 4096;
+
+   shared_threshold<T, Compare> shared(compare);
+   custom::vector<custom::vector<T>> results(numThreads);
+
+   auto work = [&](size_t slice)
+   {
+      RandomIt begin = first + (num *  slice      / numThreads);
+      RandomIt end   = first + (num * (slice + 1) / numThreads);
+
+      top_k<T, K, Compare> local(compare);
+      typename shared_threshold<T, Compare>::view bar(shared);
+      while (begin != end)
+      {
+         bar.refresh();
+         RandomIt blockEnd = (size_t)(end - begin) > blockSize ? begin + blockSize : end;
+         for (; begin != blockEnd; ++begin)
+            if (!bar.rejects(*begin) && local.push(*begin) && local.full())
+               bar.offer(local.threshold());
+      }
+      results[slice] = local.extract();
+   };
+
+   if (numThreads == 1)
+      work(0);
+   else
+   {
+      custom::vector<std::thread> threads;
+      threads.reserve(numThreads);
+      for (size_t i = 0; i < numThreads; i++)
+         threads.push_back(std::thread(work, i));
+      for (size_t i = 0; i < numThreads; i++)
+         threads[i].join();
+   }
+
+   // at most numThreads * K survivors left to merge
+   top_k<T, K, Compare> merged(compare);
+   for (size_t i = 0; i < numThreads; i++)
+      for (size_t j = 0; j < results[i].size(); j++)
+         merged.push(std::move(results[i][j]));
+   return merged.extract();
+}
+
+/************************************************
+ * PARALLEL TOP K : VECTOR
+ * The same over the whole of a custom::vector
+ ***********************************************/
+template <size_t K, class T, class Compare = std::less<T>>
+custom::vector<T> parallel_top_k(const custom::vector<T> & v, size_t numThreads = 0,
+                                 const Compare & compare = Compare())
+{
+   if (v.empty())
+      return custom::vector<T>();
+   return parallel_top_k<K>(&v[0], &v[0] + v.size(), numThreads, compare);
+}
+
+} // namespace custom
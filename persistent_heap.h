@@ -0,0 +1,327 @@
+/***********************************************************************
+ * Header:
+ *    PERSISTENT HEAP
+ * Summary:
+ *    An immutable priority queue. push() and pop() leave the heap
+ *    alone and hand back a new version; the old one stays valid and
+ *    unchanged. A copy is a snapshot and costs O(1), where copying a
+ *    priority_queue copies its whole vector.
+ *
+ *    The shape is a leftist heap: every node keeps its rank, the
+ *    length of its right spine, and a left child never ranks below
+ *    its right. Meld only walks the two right spines, at most
+ *    log2(n + 1) nodes each, so only those nodes are copied. Every
+ *    left subtree hanging off them is shared with the old version.
+ *    push() and pop() are both melds, so each costs O(log n) time
+ *    and O(log n) new nodes.
+ *
+ *    Nodes carry a count of the parents and heaps that point at them.
+ *    When a version goes away its root is released, and any node no
+ *    one points at any more goes back to the pool along with its
+ *    children's references. As in leftist_heap, the nodes live in a
+ *    pool: a custom::vector of slots linked by index with a free
+ *    list. A version and everything made from it share one pool. A
+ *    pool is not thread safe: versions sharing one must be used from
+ *    one thread at a time.
+ *
+ *    This will contain the class definition of:
+ *        persistent_heap         : An immutable heap with shared nodes
+ *        persistent_heap::pool   : The slab of refcounted nodes
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <memory>      // for std::shared_ptr
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::move, std::forward, and std::swap
+#include "vector.h"
+
+class TestPersistentHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * PERSISTENT HEAP
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class persistent_heap
+{
+   friend class ::TestPersistentHeap; // give the unit test class access to the privates
+public:
+   class pool;
+
+   //
+   // construct
+   //
+   explicit persistent_heap(const Compare & compare = Compare()) :
+      persistent_heap(std::make_shared<pool>(), compare)
+   {
+   }
+   explicit persistent_heap(std::shared_ptr<pool> nodes, const Compare & compare = Compare()) :
+      nodes(nodes), root(NIL), numElements(0), compare(compare)
+   {
+   }
+   persistent_heap(const persistent_heap & rhs) :
+      nodes(rhs.nodes), root(rhs.root), numElements(rhs.numElements), compare(rhs.compare)
+   {
+      nodes->retain(root);
+   }
+   persistent_heap(persistent_heap && rhs) noexcept :
+      nodes(rhs.nodes), root(rhs.root), numElements(rhs.numElements), compare(rhs.compare)
+   {
+      rhs.root = NIL;
+      rhs.numElements = 0;
+   }
+   persistent_heap & operator = (const persistent_heap & rhs);
+   persistent_heap & operator = (persistent_heap && rhs) noexcept;
+  ~persistent_heap() { nodes->release(root); }
+
+   //
+   // Access
+   //
+   const T & top() const;
+   std::shared_ptr<pool> get_pool() const { return nodes; }
+
+   //
+   // New versions: this heap is left as it was
+   //
+   persistent_heap push(const T & t) const;
+   persistent_heap push(T && t) const;
+   persistent_heap pop() const;
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   static constexpr size_t NIL = (size_t)-1;
+
+   // a version that already owns a reference to root
+   persistent_heap(std::shared_ptr<pool> nodes, size_t root, size_t numElements,
+                   const Compare & compare) :
+      nodes(nodes), root(root), numElements(numElements), compare(compare)
+   {
+   }
+
+   size_t rank(size_t node) const { return node == NIL ? 0 : nodes->slots[node].rank; }
+   size_t meld(size_t lhs, size_t rhs) const;
+
+   std::shared_ptr<pool> nodes;
+   size_t  root;
+   size_t  numElements;
+   Compare compare;
+};
+
+/*************************************************
+ * PERSISTENT HEAP :: POOL
+ * A slab of refcounted nodes. Freed slots are
+ * reused before the slab grows.
+ *************************************************/
+template <class T, class Compare>
+class persistent_heap <T, Compare> :: pool
+{
+   friend class persistent_heap;
+   friend class ::TestPersistentHeap;
+public:
+   void   reserve(size_t n) { slots.reserve(n); freeSlots.reserve(n); }
+   size_t capacity() const  { return slots.size(); }
+   size_t available() const { return freeSlots.size(); }
+
+private:
+   struct Node
+   {
+      T      value;
+      size_t left;
+      size_t right;
+      size_t rank;     // length of the right spine, counting this node
+      size_t refs;     // parents and heaps pointing here
+   };
+
+   // a node with one reference, held by the caller
+   template <class U>
+   size_t allocate(U && value)
+   {
+      size_t slot;
+      if (!freeSlots.empty())
+      {
+         slot = freeSlots.back();
+         freeSlots.pop_back();
+         slots[slot].value = std::forward<U>(value);
+      }
+      else
+      {
+         slot = slots.size();
+         slots.push_back(Node{ std::forward<U>(value), NIL, NIL, 1, 1 });
+      }
+      slots[slot].left = NIL;
+      slots[slot].right = NIL;
+      slots[slot].rank = 1;
+      slots[slot].refs = 1;
+      return slot;
+   }
+
+   void retain(size_t node)
+   {
+      if (node != NIL)
+         slots[node].refs++;
+   }
+
+   // drop one reference; a node no one holds frees its children in turn
+   void release(size_t node)
+   {
+      if (node == NIL || --slots[node].refs > 0)
+         return;
+      dropped.clear();
+      dropped.push_back(node);
+      while (!dropped.empty())
+      {
+         node = dropped.back();
+         dropped.pop_back();
+         for (size_t child : { slots[node].left, slots[node].right })
+            if (child != NIL && --slots[child].refs == 0)
+               dropped.push_back(child);
+         freeSlots.push_back(node);
+      }
+   }
+
+   custom::vector<Node>   slots;
+   custom::vector<size_t> freeSlots;
+   custom::vector<size_t> spine;     // reused by meld()
+   custom::vector<size_t> dropped;   // reused by release()
+};
+
+/************************************************
+ * PERSISTENT HEAP :: ASSIGNMENT
+ * Take the other version's root before letting
+ * go of ours, in case they share nodes
+ ***********************************************/
+template <class T, class Compare>
+persistent_heap <T, Compare> & persistent_heap <T, Compare> :: operator = (const persistent_heap & rhs)
+{
+   rhs.nodes->retain(rhs.root);
+   nodes->release(root);
+   nodes = rhs.nodes;
+   root = rhs.root;
+   numElements = rhs.numElements;
+   compare = rhs.compare;
+   return *this;
+}
+
+template <class T, class Compare>
+persistent_heap <T, Compare> & persistent_heap <T, Compare> :: operator = (persistent_heap && rhs) noexcept
+{
+   if (&rhs != this)
+   {
+      nodes->release(root);
+      nodes = rhs.nodes;
+      root = rhs.root;
+      numElements = rhs.numElements;
+      compare = rhs.compare;
+      rhs.root = NIL;
+      rhs.numElements = 0;
+   }
+   return *this;
+}
+
+/************************************************
+ * PERSISTENT HEAP :: TOP
+ * The largest item is always the root
+ ***********************************************/
+template <class T, class Compare>
+const T & persistent_heap <T, Compare> :: top() const
+{
+   if (root == NIL)
+      throw std::out_of_range("std:out_of_range");
+   return nodes->slots[root].value;
+}
+
+/************************************************
+ * PERSISTENT HEAP :: PUSH
+ * Meld with a one-node heap. If the new node ends
+ * up under the old spine it is shared rather than
+ * copied, and our hold on it is simply dropped.
+ ***********************************************/
+template <class T, class Compare>
+persistent_heap <T, Compare> persistent_heap <T, Compare> :: push(const T & t) const
+{
+   size_t single = nodes->allocate(t);
+   size_t result = meld(root, single);
+   nodes->release(single);
+   return persistent_heap(nodes, result, numElements + 1, compare);
+}
+
+template <class T, class Compare>
+persistent_heap <T, Compare> persistent_heap <T, Compare> :: push(T && t) const
+{
+   size_t single = nodes->allocate(std::move(t));
+   size_t result = meld(root, single);
+   nodes->release(single);
+   return persistent_heap(nodes, result, numElements + 1, compare);
+}
+
+/************************************************
+ * PERSISTENT HEAP :: POP
+ * Meld the root's two subtrees. Popping an empty
+ * heap gives back another empty one.
+ ***********************************************/
+template <class T, class Compare>
+persistent_heap <T, Compare> persistent_heap <T, Compare> :: pop() const
+{
+   if (root == NIL)
+      return *this;
+
+   size_t result = meld(nodes->slots[root].left, nodes->slots[root].right);
+   return persistent_heap(nodes, result, numElements - 1, compare);
+}
+
+/************************************************
+ * PERSISTENT HEAP :: MELD (by root)
+ * Neither tree may change, so each node on the
+ * merged right spine is a fresh copy. Its left
+ * subtree, and whatever is left of the spine the
+ * merge did not reach, are shared by reference.
+ * The caller owns the one reference to the result.
+ ***********************************************/
+template <class T, class Compare>
+size_t persistent_heap <T, Compare> :: meld(size_t lhs, size_t rhs) const
+{
+   custom::vector<typename pool::Node> & slots = nodes->slots;
+   custom::vector<size_t> & spine = nodes->spine;
+
+   // walk both spines top-down, copying the larger root each step
+   spine.clear();
+   while (lhs != NIL && rhs != NIL)
+   {
+      if (compare(slots[lhs].value, slots[rhs].value))
+         std::swap(lhs, rhs);
+      size_t copy = nodes->allocate(slots[lhs].value);
+      slots[copy].left = slots[lhs].left;
+      nodes->retain(slots[copy].left);
+      spine.push_back(copy);
+      lhs = slots[lhs].right;
+   }
+   size_t tail = (lhs == NIL) ? rhs : lhs;
+   nodes->retain(tail);
+
+   // back up the path: hang each copy on the one above, heavier side left
+   size_t below = tail;
+   for (size_t i = spine.size(); i-- > 0; )
+   {
+      size_t node = spine[i];
+      slots[node].right = below;
+      if (rank(slots[node].left) < rank(slots[node].right))
+         std::swap(slots[node].left, slots[node].right);
+      slots[node].rank = rank(slots[node].right) + 1;
+      below = node;
+   }
+   return below;
+}
+
+} // namespace custom
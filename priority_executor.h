@@ -0,0 +1,343 @@
+/***********************************************************************
+ * Header:
+ *    PRIORITY EXECUTOR
+ * Summary:
+ *    A thread pool that runs tasks in priority order. Each worker
+ *    owns a local priority queue; an idle worker steals the
+ *    highest-priority half of another worker's queue.
+ *
+ *    This will contain the class definition of:
+ *        priority_executor       : A work-stealing priority thread pool
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <atomic>              // for std::atomic
+#include <condition_variable>  // for std::condition_variable
+#include <functional>          // for std::function
+#include <future>              // for std::future and std::packaged_task
+#include <memory>              // for std::shared_ptr
+#include <mutex>               // for std::mutex
+#include <thread>              // for std::thread
+#include "priority_queue.h"
+
+class TestPriorityExecutor;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * PRIORITY EXECUTOR
+ * Run submitted tasks on a pool of workers, the
+ * highest priority first. Within one worker's heap,
+ * equal priorities run in the order they were
+ * submitted; across workers they may not.
+ *************************************************/
+class priority_executor
+{
+   friend class ::TestPriorityExecutor; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   explicit priority_executor(size_t numThreads = std::thread::hardware_concurrency(),
+                              bool yieldToHigher = false);
+   priority_executor(const priority_executor & rhs) = delete;
+   priority_executor & operator = (const priority_executor & rhs) = delete;
+  ~priority_executor();
+
+   //
+   // Insert
+   //
+   template <class F>
+   auto submit(int priority, F && fn) -> std::future<decltype(fn())>;
+
+   //
+   // Status
+   //
+   size_t size()       const { return pending; }
+   size_t numThreads() const { return workers.size(); }
+
+private:
+
+   // one unit of work; a larger priority runs first
+   struct Task
+   {
+      int priority;
+      size_t sequence;
+      std::function<void()> fn;
+
+      bool operator < (const Task & rhs) const
+      {
+         if (priority != rhs.priority)
+            return priority < rhs.priority;
+         return sequence > rhs.sequence;   // older tasks win ties
+      }
+   };
+
+   // a worker and the local heap it pulls from
+   struct Worker
+   {
+      std::mutex lock;
+      custom::priority_queue<Task> heap;
+      std::thread thread;
+   };
+
+   void push(Task && task);
+   bool popLocal(size_t index, Task & task);
+   bool steal(size_t index, Task & task);
+   bool yieldTo(size_t index, Task & task);
+   void workerLoop(size_t index);
+
+   // which worker, if any, the calling thread is
+   static const priority_executor * & currentExecutor()
+   {
+      static thread_local const priority_executor * executor = nullptr;
+      return executor;
+   }
+   static size_t & currentIndex()
+   {
+      static thread_local size_t index = 0;
+      return index;
+   }
+
+   custom::vector<Worker *> workers;
+   bool yieldToHigher;                // look for higher-priority work between tasks
+   std::atomic<size_t> pending;       // tasks sitting in some worker's heap
+   std::atomic<size_t> arrivals;      // bumped under sleepLock whenever work lands in a heap
+   std::atomic<size_t> sequence;      // submission order
+   std::atomic<size_t> nextWorker;    // round-robin target for outside submits
+   std::mutex sleepLock;
+   std::condition_variable wake;
+   bool done;
+};
+
+/************************************************
+ * PRIORITY EXECUTOR :: CONSTRUCTOR
+ * Start the workers
+ ***********************************************/
+inline priority_executor::priority_executor(size_t numThreads, bool yieldToHigher) :
+   yieldToHigher(yieldToHigher), pending(0), arrivals(0), sequence(0), nextWorker(0), done(false)
+{
+   if (numThreads == 0)
+      numThreads = 1;
+
+   workers.reserve(numThreads);
+   for (size_t i = 0; i < numThreads; i++)
+      workers.push_back(new Worker);
+   for (size_t i = 0; i < numThreads; i++)
+      workers[i]->thread = std::thread(&priority_executor::workerLoop, this, i);
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: DESTRUCTOR
+ * Run everything that is still queued, then
+ * stop the workers
+ ***********************************************/
+inline priority_executor::~priority_executor()
+{
+   {
+      std::lock_guard<std::mutex> guard(sleepLock);
+      done = true;
+   }
+   wake.notify_all();
+
+   // the others may still be stealing, so join them all before freeing
+   for (size_t i = 0; i < workers.size(); i++)
+      workers[i]->thread.join();
+   for (size_t i = 0; i < workers.size(); i++)
+      delete workers[i];
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: SUBMIT
+ * Queue fn to run at the given priority. The
+ * result (or exception) comes back in the future.
+ ***********************************************/
+template <class F>
+auto priority_executor::submit(int priority, F && fn) -> std::future<decltype(fn())>
+{
+   typedef decltype(fn()) R;
+
+   // std::function needs something copyable, so share the packaged task
+   auto job = std::make_shared<std::packaged_task<R()>>(std::forward<F>(fn));
+   std::future<R> result = job->get_future();
+
+   Task task;
+   task.priority = priority;
+   task.sequence = sequence++;
+   task.fn = [job]() { (*job)(); };
+   push(std::move(task));
+
+   return result;
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: PUSH
+ * Workers submit to their own heap; everyone else
+ * spreads their work round-robin
+ ***********************************************/
+inline void priority_executor::push(Task && task)
+{
+   size_t index;
+   if (currentExecutor() == this)
+      index = currentIndex();
+   else
+      index = nextWorker++ % workers.size();
+
+   // count it first so a worker never sees a negative backlog, and
+   // announce it only once it is in the heap for a woken worker to find
+   {
+      std::lock_guard<std::mutex> guard(sleepLock);
+      pending++;
+      {
+         std::lock_guard<std::mutex> heapGuard(workers[index]->lock);
+         workers[index]->heap.push(std::move(task));
+      }
+      arrivals++;
+   }
+   wake.notify_one();
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: POP LOCAL
+ * Take the best task from our own heap
+ ***********************************************/
+inline bool priority_executor::popLocal(size_t index, Task & task)
+{
+   std::lock_guard<std::mutex> guard(workers[index]->lock);
+   return workers[index]->heap.pop(task);
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: STEAL
+ * Find the fullest victim and take the top half of
+ * its heap. The best of those is returned in task,
+ * the rest go in our own heap.
+ ***********************************************/
+inline bool priority_executor::steal(size_t index, Task & task)
+{
+   // pick the victim with the most work
+   size_t victim = index;
+   size_t most = 0;
+   for (size_t i = 0; i < workers.size(); i++)
+   {
+      if (i == index)
+         continue;
+      std::lock_guard<std::mutex> guard(workers[i]->lock);
+      if (workers[i]->heap.size() > most)
+      {
+         most = workers[i]->heap.size();
+         victim = i;
+      }
+   }
+   if (victim == index)
+      return false;
+
+   // pop the top half; never hold two worker locks at once
+   custom::vector<Task> loot;
+   {
+      std::lock_guard<std::mutex> guard(workers[victim]->lock);
+      size_t numSteal = (workers[victim]->heap.size() + 1) / 2;
+      loot.reserve(numSteal);
+      for (size_t i = 0; i < numSteal; i++)
+      {
+         loot.push_back(Task());
+         workers[victim]->heap.pop(loot.back());
+      }
+   }
+   if (loot.empty())
+      return false;
+
+   task = std::move(loot[0]);
+   if (loot.size() > 1)
+   {
+      std::lock_guard<std::mutex> guard(workers[index]->lock);
+      for (size_t i = 1; i < loot.size(); i++)
+         workers[index]->heap.push(std::move(loot[i]));
+   }
+
+   // the rest is stealable again, so someone asleep may take a share
+   if (loot.size() > 1)
+   {
+      {
+         std::lock_guard<std::mutex> guard(sleepLock);
+         arrivals++;
+      }
+      wake.notify_one();
+   }
+   return true;
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: YIELD TO
+ * Before running task, see whether another worker
+ * holds something more urgent. If so, put task back
+ * and take the urgent one instead.
+ ***********************************************/
+inline bool priority_executor::yieldTo(size_t index, Task & task)
+{
+   for (size_t i = 0; i < workers.size(); i++)
+   {
+      if (i == index)
+         continue;
+
+      Task better;
+      {
+         std::lock_guard<std::mutex> guard(workers[i]->lock);
+         if (workers[i]->heap.empty() || !(task < workers[i]->heap.top()))
+            continue;
+         workers[i]->heap.pop(better);
+      }
+
+      std::lock_guard<std::mutex> guard(workers[index]->lock);
+      workers[index]->heap.push(std::move(task));
+      task = std::move(better);
+      return true;
+   }
+   return false;
+}
+
+/************************************************
+ * PRIORITY EXECUTOR :: WORKER LOOP
+ * Run local work, steal when out, sleep when
+ * there is nothing anywhere. A sleeping worker
+ * wakes only when work has arrived since it last
+ * looked, not merely because pending is nonzero:
+ * pending also counts tasks another worker has
+ * taken but not yet started.
+ ***********************************************/
+inline void priority_executor::workerLoop(size_t index)
+{
+   currentExecutor() = this;
+   currentIndex() = index;
+
+   for (;;)
+   {
+      // read before looking, so anything pushed after we look wakes us
+      size_t seen = arrivals;
+
+      Task task;
+      if (popLocal(index, task) || steal(index, task))
+      {
+         if (yieldToHigher)
+            yieldTo(index, task);
+         pending--;
+         task.fn();
+         continue;
+      }
+
+      // once done, leave only if nothing came in since we looked:
+      // whatever is left sits in a heap whose owner will run it
+      std::unique_lock<std::mutex> guard(sleepLock);
+      wake.wait(guard, [this, seen]() { return done || arrivals != seen; });
+      if (done && arrivals == seen)
+         return;
+   }
+}
+
+} // namespace custom
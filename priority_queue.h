@@ -19,6 +19,12 @@
 #pragma once
 
 #include <cassert>
+#include <exception>  // for std::exception_ptr in the parallel heapify
+#include <functional> // for std::less
+#include <stdexcept>  // for std::out_of_range
+#include <thread>     // for std::thread in the parallel heapify
+#include <utility>    // for std::swap
+#include "heap.h"
 #include "vector.h"
 
 class TestPQueue;    // forward declaration for unit test class
@@ -28,38 +34,46 @@ namespace custom
 
 /*************************************************
  * P QUEUE
- * Create a priority queue.
+ * Create a priority queue. The top is the largest
+ * item under Compare, so std::greater<T> makes a
+ * min-queue.
+ * Building from a container of parallelThreshold
+ * items or more heapifies on several threads, each
+ * with its own copy of Compare: comparing and
+ * swapping T must then be safe from many threads at
+ * once, and whatever state the copies gather is
+ * not kept.
  *************************************************/
-template<class T>
+template <class T, class Container = custom::vector<T>, class Compare = std::less<T>>
 class priority_queue
 {
    friend class ::TestPQueue; // give the unit test class access to the privates
-   template <class TT>
-   friend void swap(priority_queue<TT>& lhs, priority_queue<TT>& rhs);
+   template <class TT, class CC, class PP>
+   friend void swap(priority_queue<TT, CC, PP>& lhs, priority_queue<TT, CC, PP>& rhs);
 public:
 
    //
    // construct
    //
    // default
-   priority_queue()
+   explicit priority_queue(const Compare & compare = Compare()) : compare(compare)
    {
-      container = 0;
    }
    // copy
-   priority_queue(const priority_queue &  rhs)
+   priority_queue(const priority_queue &  rhs) : compare(rhs.compare)
    {
       container = rhs.container;
    }
    // move
-   priority_queue(priority_queue && rhs)
+   priority_queue(priority_queue && rhs) : compare(rhs.compare)
    {
       container = std::move(rhs.container);
    }
    
    // range
    template <class Iterator>
-   priority_queue(Iterator first, Iterator last) 
+   priority_queue(Iterator first, Iterator last, const Compare & compare = Compare()) :
+      compare(compare)
    {
       container.reserve(last - first);
       for(Iterator element = first; element != last; ++element)
@@ -68,12 +82,18 @@ public:
       }
       
    }
-   explicit priority_queue (custom::vector<T> && rhs) 
+   explicit priority_queue (Container && rhs) : priority_queue(Compare(), std::move(rhs))
+   {
+   }
+   priority_queue (const Compare & compare, Container && rhs) : compare(compare)
    {
       container = std::move(rhs);
-      heapify();
+      if (container.size() >= parallelThreshold)
+         heapifyParallel(std::thread::hardware_concurrency());
+      else
+         heapify();
    }
-   explicit priority_queue (custom::vector<T>& rhs)
+   explicit priority_queue (Container& rhs)
    {
       container = rhs;
       heapify();
@@ -91,11 +111,19 @@ public:
    //
    void  push(const T& t);
    void  push(T&& t);     
+   template <class Iterator>
+   void  push(Iterator first, Iterator last);
+
+   void  reserve(size_t n)
+   {
+      container.reserve(n);
+   }
 
    //
    // Remove
    //
    void  pop(); 
+   bool  pop(T & t);      // FALSE if the queue was empty
 
    //
    // Status
@@ -108,13 +136,24 @@ public:
    { 
       return container.empty();
    }
+
+   // the heap array itself, for saving it whole
+   const Container & data() const
+   {
+      return container;
+   }
    
 private:
 
    void heapify();                            // convert the container in to a heap
+   void heapifyParallel(size_t numThreads);   // same as heapify, but the subtrees are split across threads
    bool percolateDown(size_t indexHeap);      // fix heap from index down. This is a heap index!
 
-   custom::vector<T> container; 
+   // below this many elements, the threads cost more than they save
+   static const size_t parallelThreshold = 1 << 20;
+
+   Container container; 
+   Compare compare;
 
 };
 
@@ -122,8 +161,8 @@ private:
  * P QUEUE :: TOP
  * Get the maximum item from the heap: the top item.
  ***********************************************/
-template <class T>
-const T & priority_queue <T> :: top() const
+template <class T, class Container, class Compare>
+const T & priority_queue <T, Container, Compare> :: top() const
 {
    // check empty first
    if (container.empty())
@@ -137,14 +176,15 @@ const T & priority_queue <T> :: top() const
  * P QUEUE :: POP
  * Delete the top item from the heap.
  **********************************************/
-template <class T>
-void priority_queue<T>::pop()
+template <class T, class Container, class Compare>
+void priority_queue<T, Container, Compare>::pop()
 {
     if (container.empty())
         return;
 
     // Swap first and last elements (0-based)
-    std::swap(container[0], container[container.size() - 1]);
+    using std::swap;
+    swap(container[0], container[container.size() - 1]);
     
     // Remove the last element
     container.pop_back();
@@ -154,53 +194,60 @@ void priority_queue<T>::pop()
         percolateDown(1);
 }
 
+/**********************************************
+ * P QUEUE :: POP (into)
+ * Move the top item out, then delete it. Saves
+ * the copy that top() followed by pop() costs.
+ **********************************************/
+template <class T, class Container, class Compare>
+bool priority_queue<T, Container, Compare>::pop(T & t)
+{
+    if (container.empty())
+        return false;
+
+    t = std::move(container[0]);
+    pop();
+    return true;
+}
+
 /*****************************************
  * P QUEUE :: PUSH
  * Add a new element to the heap, reallocating as necessary
  ****************************************/
-template <class T>
-void priority_queue<T>::push(const T& t)
+template <class T, class Container, class Compare>
+void priority_queue<T, Container, Compare>::push(const T& t)
 {
     container.push_back(t);
-   
+
     // Percolate up from the last element
-    size_t index = container.size();
-    
-    while (index > 1)
-    {
-        size_t parent = index / 2;
-        if (container[parent - 1] < container[index - 1])
-        {
-            std::swap(container[parent - 1], container[index - 1]);
-            index = parent;
-        }
-        else
-        {
-            break;
-        }
-    }
+    custom::siftUp(&container[0], container.size() - 1, compare);
 }
 
-template <class T>
-void priority_queue<T>::push(T&& t)
+template <class T, class Container, class Compare>
+void priority_queue<T, Container, Compare>::push(T&& t)
 {
     container.push_back(std::move(t));
+
     // Percolate up from the last element
-    size_t index = container.size();
-    
-    while (index > 1)
-    {
-        size_t parent = index / 2;
-        if (container[parent - 1] < container[index - 1])
-        {
-            std::swap(container[parent - 1], container[index - 1]);
-            index = parent;
-        }
-        else
-        {
-            break;
-        }
-    }
+    custom::siftUp(&container[0], container.size() - 1, compare);
+}
+
+/*****************************************
+ * P QUEUE :: PUSH RANGE
+ * Add a batch of elements with one pass over
+ * the heap rather than one sift each
+ ****************************************/
+template <class T, class Container, class Compare>
+template <class Iterator>
+void priority_queue<T, Container, Compare>::push(Iterator first, Iterator last)
+{
+    size_t before = container.size();
+    for (Iterator element = first; element != last; ++element)
+        container.push_back(*element);
+
+    if (container.size() > before)
+        custom::append_heap(&container[0], &container[0] + before,
+                            &container[0] + container.size(), compare);
 }
 
 /************************************************
@@ -209,43 +256,24 @@ void priority_queue<T>::push(T&& t)
  * order. Take care of that little detail!
  * Return TRUE if anything changed.
  ************************************************/
-template <class T>
-bool priority_queue<T>::percolateDown(size_t indexHeap)
+template <class T, class Container, class Compare>
+bool priority_queue<T, Container, Compare>::percolateDown(size_t indexHeap)
 {
     // Convert to 0-based index for array access
     size_t index = indexHeap - 1;
     size_t size = container.size();
-    
-    if (index >= size) return false;
 
-    size_t leftChild = 2 * index + 1;  // 0-based left child
-    size_t rightChild = 2 * index + 2; // 0-based right child
-    size_t largest = index;
-
-    // Find the largest among parent and both children
-    if (leftChild < size && container[largest] < container[leftChild])
-        largest = leftChild;
-
-    if (rightChild < size && container[largest] < container[rightChild])
-        largest = rightChild;
-
-    // If parent isn't largest, swap and continue
-    if (largest != index)
-    {
-        std::swap(container[index], container[largest]);
-        percolateDown(largest + 1); // Convert back to 1-based for recursion
-        return true;
-    }
+    if (index >= size) return false;
 
-    return false;
+    return custom::siftDown(&container[0], index, size, compare);
 }
 
 /************************************************
  * P QUEUE :: HEAPIFY
  * Turn the container into a heap.
  ************************************************/
-template <class T>
-void priority_queue<T>::heapify()
+template <class T, class Container, class Compare>
+void priority_queue<T, Container, Compare>::heapify()
 {
     if (container.empty()) return;
    
@@ -255,15 +283,111 @@ void priority_queue<T>::heapify()
             percolateDown(indexHeap);
 }
 
+/************************************************
+ * P QUEUE :: HEAPIFY PARALLEL
+ * Turn the container into a heap using numThreads threads.
+ * The nodes on one level all root disjoint subtrees, so
+ * we pick a split level with at least one root per thread
+ * and give each thread a contiguous run of those roots.
+ * Each thread heapifies its subtrees bottom-up, one level
+ * at a time, then the levels above the split are finished
+ * sequentially. The result is identical to heapify().
+ * Every thread sifts with its own copy of compare,
+ * and anything a thread throws is rethrown here
+ * once they have all been joined.
+ ************************************************/
+template <class T, class Container, class Compare>
+void priority_queue<T, Container, Compare>::heapifyParallel(size_t numThreads)
+{
+   size_t num = container.size();
+   size_t numInternal = num / 2;      // 0-based indices below this have children
+
+   // find the split level: the first one with a root for every thread
+   size_t level = 0;
+   while (((size_t)1 << level) < numThreads)
+      level++;
+   size_t firstRoot = ((size_t)1 << level) - 1;   // 0-based
+
+   // not enough work to split up
+   if (numThreads < 2 || firstRoot >= numInternal)
+   {
+      heapify();
+      return;
+   }
+
+   // each thread owns the roots [begin, end) on the split level
+   size_t numRoots = ((size_t)1 << level);
+   T * heap = &container[0];
+   auto work = [heap, num, numInternal](size_t begin, size_t end, Compare compare,
+                                        std::exception_ptr & error)
+   {
+      try
+      {
+         // find the deepest level below these roots that has internal nodes
+         size_t depth = 0;
+         while ((((begin + 1) << (depth + 1)) - 1) < numInternal)
+            depth++;
+
+         // Floyd's algorithm restricted to the subtrees, bottom-up
+         for (size_t k = depth + 1; k-- > 0; )
+         {
+            size_t lo = ((begin + 1) << k) - 1;
+            size_t hi = ((end   + 1) << k) - 1;
+            if (hi > numInternal)
+               hi = numInternal;
+            for (size_t index = hi; index > lo; index--)
+               custom::siftDown(heap, index - 1, num, compare);
+         }
+      }
+      catch (...)
+      {
+         error = std::current_exception();
+      }
+   };
+
+   // std::thread copies compare here, on this thread
+   custom::vector<std::exception_ptr> errors;
+   errors.reserve(numThreads);
+   for (size_t i = 0; i < numThreads; i++)
+      errors.push_back(nullptr);
+   custom::vector<std::thread> threads;
+   threads.reserve(numThreads);
+   std::exception_ptr error;
+   try
+   {
+      for (size_t i = 0; i < numThreads; i++)
+      {
+         size_t begin = firstRoot + numRoots *  i      / numThreads;
+         size_t end   = firstRoot + numRoots * (i + 1) / numThreads;
+         threads.push_back(std::thread(work, begin, end, compare, std::ref(errors[i])));
+      }
+   }
+   catch (...)
+   {
+      error = std::current_exception();   // could not start them all
+   }
+   for (size_t i = 0; i < threads.size(); i++)
+      threads[i].join();
+   for (size_t i = 0; i < errors.size() && !error; i++)
+      error = errors[i];
+   if (error)
+      std::rethrow_exception(error);
+
+   // finish the levels above the split
+   for (size_t indexHeap = firstRoot; indexHeap >= 1; indexHeap--)
+      percolateDown(indexHeap);
+}
+
 /************************************************
  * SWAP
  * Swap the contents of two priority queues
  ************************************************/
-template <class T>
-inline void swap(custom::priority_queue <T>& lhs,
-                 custom::priority_queue <T>& rhs)
+template <class T, class Container, class Compare>
+inline void swap(custom::priority_queue <T, Container, Compare>& lhs,
+                 custom::priority_queue <T, Container, Compare>& rhs)
 {
    std::swap(lhs.container, rhs.container); 
+   std::swap(lhs.compare, rhs.compare);
 }
 
 };
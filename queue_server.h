@@ -0,0 +1,751 @@
+/***********************************************************************
+ * Header:
+ *    QUEUE SERVER
+ * Summary:
+ *    A small local server that owns a priority_queue and lets the
+ *    services on one host share it over a Unix domain socket, and the
+ *    client library that talks to it. The protocol is binary:
+ *        request    one op byte, then the item's bytes for a push
+ *                       1 push    2 pop    3 peek
+ *        response   one status byte, then the item's bytes for item
+ *                       0 ok      1 item   2 empty
+ *    Every request gets exactly one response, in order, so a client
+ *    may send many requests before reading any answers.
+ *
+ *    The server is one thread and an epoll loop. Each tick, it reads
+ *    whatever every ready client has sent and applies the batch in
+ *    rounds. A client's requests split at each pop or peek: round 0 is
+ *    its pushes up to and including its first pop or peek, round 1 the
+ *    pushes up to its second, and so on. Each round puts every client's
+ *    pushes into the heap in a single pass, then answers the round's
+ *    pops and peeks. Each client's requests still take effect in the
+ *    order it sent them; only requests from different clients, all
+ *    still waiting on their answers, are reordered. Under load, one
+ *    tick carries many requests and the heap is touched once a round.
+ *
+ *    The server and clients must agree on T.
+ *
+ *    This will contain the class definitions of:
+ *        queue_server            : Serves a priority queue on a socket
+ *        queue_client            : Talks to a queue_server
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include <algorithm>       // for std::stable_sort
+#include <cassert>
+#include <cerrno>          // for errno
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint8_t and uint64_t
+#include <cstring>         // for std::memcpy
+#include <functional>      // for std::less
+#include <stdexcept>       // for std::runtime_error
+#include <string>
+#include <system_error>    // for std::system_error
+#include <type_traits>     // for std::is_trivially_copyable
+#include <sys/epoll.h>     // for epoll_create1, epoll_ctl and epoll_wait
+#include <sys/eventfd.h>   // for eventfd
+#include <sys/socket.h>    // for socket, bind, listen, accept4 and connect
+#include <sys/stat.h>      // for lstat
+#include <sys/un.h>        // for sockaddr_un
+#include <unistd.h>        // for read, write, close and unlink
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestQueueServer;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * QUEUE PROTOCOL
+ * The bytes on the wire
+ *************************************************/
+enum class queue_op     : uint8_t { push = 1, pop = 2, peek = 3 };
+enum class queue_status : uint8_t { ok = 0, item = 1, empty = 2 };
+
+/*************************************************
+ * UNIX ADDRESS
+ * A socket path as a sockaddr_un
+ *************************************************/
+inline sockaddr_un unixAddress(const std::string & path)
+{
+   sockaddr_un address = {};
+   address.sun_family = AF_UNIX;
+   if (path.size() >= sizeof(address.sun_path))
+      throw std::runtime_error(path + " is too long for a socket path");
+   std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+   return address;
+}
+
+/*************************************************
+ * QUEUE SERVER
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class queue_server
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "queue_server sends T as raw bytes");
+   friend class ::TestQueueServer; // give the unit test class access to the privates
+public:
+
+   //
+   // construct: listen at path, replacing a socket a dead server left there
+   //
+   explicit queue_server(const std::string & path, const Compare & compare = Compare());
+   queue_server(const queue_server &) = delete;
+   queue_server & operator = (const queue_server &) = delete;
+  ~queue_server();
+
+   //
+   // Serve: tick until stop() is called. Safe to call stop() from any thread.
+   //
+   void run();
+   void stop();
+
+   // wait up to timeout ms (-1 for ever) for requests, then apply them
+   // all: the number of requests applied
+   size_t tick(int timeout);
+
+   //
+   // Status: only from the serving thread
+   //
+   size_t size()        const { return queue.size(); }
+   size_t numClients()  const { return clients.size(); }
+   uint64_t numTicks()    const { return ticks; }
+   uint64_t numRequests() const { return requests; }
+
+private:
+   static constexpr size_t PUSH_BYTES = 1 + sizeof(T);
+   static constexpr size_t READ_BYTES = 64 * 1024;
+
+   // one connection and the bytes either way not yet dealt with
+   struct client
+   {
+      int         fd;
+      size_t      index;      // in clients
+      std::string in;         // requests, maybe ending in part of one
+      std::string out;        // responses not yet written
+      bool        writable;   // are we waiting on EPOLLOUT?
+      bool        closed;
+      size_t      round;      // pops and peeks so far in this batch
+   };
+
+   // a request taken off the wire, waiting for the batch to be applied
+   struct request
+   {
+      client *  from;
+      queue_op  op;
+      size_t    item;     // in pushed, for a push
+      size_t    round;    // pops and peeks from the same client before it
+   };
+
+   void removeStale(const sockaddr_un & address);
+   void accept();
+   void receive(client * c);
+   void parse(client * c);
+   void apply();
+   void send(client * c);
+   void drop(client * c);
+   void watch(client * c, bool writable);
+
+   std::string path;
+   int         listenFd;
+   int         epollFd;
+   int         stopFd;            // an eventfd that stop() writes to
+   bool        stopping;
+   priority_queue<T, custom::vector<T>, Compare> queue;
+   custom::vector<client *> clients;
+   custom::vector<request>  batch;           // this tick's requests, in order
+   custom::vector<T>        pushed;          // this tick's pushes
+   custom::vector<T>        staged;          // one round's pushes
+   custom::vector<client *> touched;         // clients with responses to send
+   uint64_t    ticks;
+   uint64_t    requests;
+};
+
+/************************************************
+ * QUEUE SERVER :: CONSTRUCTOR
+ ***********************************************/
+template <class T, class Compare>
+queue_server <T, Compare> :: queue_server(const std::string & path, const Compare & compare) :
+   path(path), listenFd(-1), epollFd(-1), stopFd(-1), stopping(false), queue(compare),
+   ticks(0), requests(0)
+{
+   sockaddr_un address = unixAddress(path);
+   bool bound = false;
+   try
+   {
+      removeStale(address);
+      listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+      if (listenFd < 0)
+         throw std::system_error(errno, std::system_category(), "socket " + path);
+      if (bind(listenFd, (sockaddr *)&address, sizeof(address)) != 0)
+         throw std::system_error(errno, std::system_category(), "bind " + path);
+      bound = true;
+      if (listen(listenFd, SOMAXCONN) != 0)
+         throw std::system_error(errno, std::system_category(), "listen " + path);
+
+      epollFd = epoll_create1(EPOLL_CLOEXEC);
+      if (epollFd < 0)
+         throw std::system_error(errno, std::system_category(), "epoll_create1");
+      stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      if (stopFd < 0)
+         throw std::system_error(errno, std::system_category(), "eventfd");
+
+      // the listener is known by a null pointer, the stop event by this
+      epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.ptr = nullptr;
+      if (epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event) != 0)
+         throw std::system_error(errno, std::system_category(), "epoll_ctl " + path);
+      event.data.ptr = this;
+      if (epoll_ctl(epollFd, EPOLL_CTL_ADD, stopFd, &event) != 0)
+         throw std::system_error(errno, std::system_category(), "epoll_ctl eventfd");
+   }
+   catch (...)
+   {
+      if (stopFd >= 0)
+         ::close(stopFd);
+      if (epollFd >= 0)
+         ::close(epollFd);
+      if (listenFd >= 0)
+         ::close(listenFd);
+      if (bound)
+         ::unlink(path.c_str());
+      throw;
+   }
+}
+
+/************************************************
+ * QUEUE SERVER :: REMOVE STALE
+ * A socket file that nobody answers on was left by
+ * a server that died; one that answers is in use
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: removeStale(const sockaddr_un & address)
+{
+   struct stat status;
+   if (lstat(path.c_str(), &status) != 0 || !S_ISSOCK(status.st_mode))
+      return;
+
+   int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+   if (probe < 0)
+      throw std::system_error(errno, std::system_category(), "socket " + path);
+   bool answered = connect(probe, (const sockaddr *)&address, sizeof(address)) == 0;
+   ::close(probe);
+   if (answered)
+      throw std::runtime_error("a server is already listening at " + path);
+   ::unlink(path.c_str());
+}
+
+/************************************************
+ * QUEUE SERVER :: DESTRUCTOR
+ * Hang up on everyone and take the socket away
+ ***********************************************/
+template <class T, class Compare>
+queue_server <T, Compare> :: ~queue_server()
+{
+   for (size_t i = 0; i < clients.size(); i++)
+   {
+      ::close(clients[i]->fd);
+      delete clients[i];
+   }
+   ::close(stopFd);
+   ::close(epollFd);
+   ::close(listenFd);
+   ::unlink(path.c_str());
+}
+
+/************************************************
+ * QUEUE SERVER :: RUN and STOP
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: run()
+{
+   while (!stopping)
+      tick(-1);
+   stopping = false;
+}
+
+template <class T, class Compare>
+void queue_server <T, Compare> :: stop()
+{
+   uint64_t one = 1;
+   if (write(stopFd, &one, sizeof(one)) != sizeof(one))
+      throw std::system_error(errno, std::system_category(), "write eventfd");
+}
+
+/************************************************
+ * QUEUE SERVER :: TICK
+ * Read from everyone who is ready, apply the batch,
+ * answer, and only then close the clients that
+ * hung up
+ ***********************************************/
+template <class T, class Compare>
+size_t queue_server <T, Compare> :: tick(int timeout)
+{
+   const int maxEvents = 256;
+   epoll_event events[maxEvents];
+   int numEvents = epoll_wait(epollFd, events, maxEvents, timeout);
+   if (numEvents < 0)
+   {
+      if (errno == EINTR)
+         return 0;
+      throw std::system_error(errno, std::system_category(), "epoll_wait");
+   }
+
+   for (int i = 0; i < numEvents; i++)
+   {
+      void * source = events[i].data.ptr;
+      if (source == nullptr)
+         accept();
+      else if (source == this)
+      {
+         uint64_t count;
+         if (read(stopFd, &count, sizeof(count)) == sizeof(count))
+            stopping = true;
+      }
+      else
+      {
+         client * c = static_cast<client *>(source);
+         if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+            receive(c);
+         if (events[i].events & EPOLLOUT)
+            touched.push_back(c);
+      }
+   }
+
+   size_t applied = batch.size();
+   apply();
+   for (size_t i = 0; i < touched.size(); i++)
+      send(touched[i]);
+   touched.clear();
+
+   // clients go last, once nothing in this tick points at them
+   for (size_t i = clients.size(); i-- > 0; )
+      if (clients[i]->closed)
+         drop(clients[i]);
+
+   ticks++;
+   requests += applied;
+   return applied;
+}
+
+/************************************************
+ * QUEUE SERVER :: ACCEPT
+ * Take every connection that is waiting
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: accept()
+{
+   for (;;)
+   {
+      int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (fd < 0)
+      {
+         if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED)
+            return;
+         if (errno == EMFILE || errno == ENFILE)
+            return;   // try again next tick, once someone hangs up
+         throw std::system_error(errno, std::system_category(), "accept " + path);
+      }
+
+      client * c = new client{ fd, clients.size(), std::string(), std::string(), false, false, 0 };
+      epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.ptr = c;
+      if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+      {
+         ::close(fd);
+         delete c;
+         continue;
+      }
+      clients.push_back(c);
+   }
+}
+
+/************************************************
+ * QUEUE SERVER :: RECEIVE
+ * Read until the socket is dry, then take off
+ * every whole request
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: receive(client * c)
+{
+   char buffer[READ_BYTES];
+   for (;;)
+   {
+      ssize_t numRead = read(c->fd, buffer, sizeof(buffer));
+      if (numRead > 0)
+      {
+         c->in.append(buffer, (size_t)numRead);
+         continue;
+      }
+      if (numRead < 0 && errno == EINTR)
+         continue;
+      if (numRead == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+         c->closed = true;
+      break;
+   }
+   parse(c);
+}
+
+/************************************************
+ * QUEUE SERVER :: PARSE
+ * Requests join the batch, each marked with its
+ * round; pushed items wait in pushed. A byte that
+ * is no request ends the conversation.
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: parse(client * c)
+{
+   size_t used = 0;
+   while (used < c->in.size())
+   {
+      queue_op op = (queue_op)c->in[used];
+      request r = { c, op, 0, c->round };
+      if (op == queue_op::push)
+      {
+         if (c->in.size() - used < PUSH_BYTES)
+            break;
+         T t;
+         std::memcpy(static_cast<void *>(&t), c->in.data() + used + 1, sizeof(T));
+         r.item = pushed.size();
+         pushed.push_back(t);
+         used += PUSH_BYTES;
+      }
+      else if (op == queue_op::pop || op == queue_op::peek)
+      {
+         c->round++;
+         used += 1;
+      }
+      else
+      {
+         c->closed = true;
+         used = c->in.size();
+         break;
+      }
+      batch.push_back(r);
+   }
+   c->in.erase(0, used);
+}
+
+/************************************************
+ * QUEUE SERVER :: APPLY
+ * Round by round: one heap pass for the round's
+ * pushes, then its pops and peeks in the order
+ * they came. A client's responses still go out in
+ * the order of its requests.
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: apply()
+{
+   if (batch.empty())
+      return;
+
+   // by round, and within a round the pushes first
+   std::stable_sort(batch.begin(), batch.end(), [](const request & lhs, const request & rhs)
+   {
+      return lhs.round < rhs.round ||
+             (lhs.round == rhs.round && lhs.op == queue_op::push && rhs.op != queue_op::push);
+   });
+
+   char response[1 + sizeof(T)];
+   for (size_t i = 0; i < batch.size(); i++)
+   {
+      client * c = batch[i].from;
+      if (c->out.empty() && !c->writable)
+         touched.push_back(c);
+
+      if (batch[i].op == queue_op::push)
+      {
+         staged.push_back(pushed[batch[i].item]);
+         c->out.push_back((char)queue_status::ok);
+         continue;
+      }
+
+      if (!staged.empty())
+      {
+         queue.push(staged.begin(), staged.end());
+         staged.clear();
+      }
+      if (queue.empty())
+         c->out.push_back((char)queue_status::empty);
+      else
+      {
+         response[0] = (char)queue_status::item;
+         std::memcpy(response + 1, &queue.top(), sizeof(T));
+         c->out.append(response, sizeof(response));
+         if (batch[i].op == queue_op::pop)
+            queue.pop();
+      }
+   }
+   if (!staged.empty())
+      queue.push(staged.begin(), staged.end());
+   staged.clear();
+
+   for (size_t i = 0; i < clients.size(); i++)
+      clients[i]->round = 0;
+   batch.clear();
+   pushed.clear();
+}
+
+/************************************************
+ * QUEUE SERVER :: SEND
+ * Write what we can; if the client is not keeping
+ * up, wait for EPOLLOUT rather than block
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: send(client * c)
+{
+   size_t sent = 0;
+   while (sent < c->out.size())
+   {
+      ssize_t numWritten = ::send(c->fd, c->out.data() + sent, c->out.size() - sent, MSG_NOSIGNAL);
+      if (numWritten > 0)
+         sent += (size_t)numWritten;
+      else if (numWritten < 0 && errno == EINTR)
+         continue;
+      else
+      {
+         if (numWritten < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+            c->closed = true;
+         break;
+      }
+   }
+   c->out.erase(0, sent);
+   if (c->closed)
+      c->out.clear();
+
+   bool waiting = !c->out.empty();
+   if (waiting != c->writable)
+      watch(c, waiting);
+}
+
+template <class T, class Compare>
+void queue_server <T, Compare> :: watch(client * c, bool writable)
+{
+   epoll_event event = {};
+   event.events = EPOLLIN | (writable ? (uint32_t)EPOLLOUT : 0u);
+   event.data.ptr = c;
+   epoll_ctl(epollFd, EPOLL_CTL_MOD, c->fd, &event);
+   c->writable = writable;
+}
+
+/************************************************
+ * QUEUE SERVER :: DROP
+ * Close the connection; the last client takes its
+ * place in the list
+ ***********************************************/
+template <class T, class Compare>
+void queue_server <T, Compare> :: drop(client * c)
+{
+   ::close(c->fd);   // closing takes it out of the epoll set too
+   size_t last = clients.size() - 1;
+   clients[c->index] = clients[last];
+   clients[c->index]->index = c->index;
+   clients.pop_back();
+   delete c;
+}
+
+/*************************************************
+ * QUEUE CLIENT
+ * One connection to a queue_server. Requests can
+ * be sent one at a time and waited for, or sent
+ * in a run with send_* and flush, and the answers
+ * collected with receive.
+ *************************************************/
+template <class T>
+class queue_client
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "queue_client sends T as raw bytes");
+   friend class ::TestQueueServer; // give the unit test class access to the privates
+public:
+
+   //
+   // construct: connect to the server at path
+   //
+   explicit queue_client(const std::string & path);
+   queue_client(const queue_client &) = delete;
+   queue_client & operator = (const queue_client &) = delete;
+  ~queue_client() { ::close(fd); }
+
+   //
+   // One request, one answer
+   //
+   void push(const T & t);
+   bool pop(T & t);      // FALSE if the queue was empty
+   bool peek(T & t);     // FALSE if the queue was empty
+
+   // a run of pushes in one write
+   template <class Iterator>
+   void push(Iterator first, Iterator last);
+
+   //
+   // Pipelined: queue up requests, flush, then receive one answer each
+   //
+   void send_push(const T & t);
+   void send_pop()  { out.push_back((char)queue_op::pop);  }
+   void send_peek() { out.push_back((char)queue_op::peek); }
+   void flush();
+   queue_status receive(T & t);
+
+private:
+   void readSome();
+
+   std::string path;
+   int         fd;
+   std::string out;        // requests not yet sent
+   std::string in;         // answers not yet received
+   size_t      inUsed;     // how much of in has been received
+};
+
+/************************************************
+ * QUEUE CLIENT :: CONSTRUCTOR
+ ***********************************************/
+template <class T>
+queue_client <T> :: queue_client(const std::string & path) : path(path), fd(-1), inUsed(0)
+{
+   sockaddr_un address = unixAddress(path);
+   fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+   if (fd < 0)
+      throw std::system_error(errno, std::system_category(), "socket " + path);
+   if (connect(fd, (sockaddr *)&address, sizeof(address)) != 0)
+   {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::system_category(), "connect " + path);
+   }
+}
+
+/************************************************
+ * QUEUE CLIENT :: PUSH, POP and PEEK
+ ***********************************************/
+template <class T>
+void queue_client <T> :: push(const T & t)
+{
+   send_push(t);
+   flush();
+   T ignored;
+   receive(ignored);
+}
+
+template <class T>
+template <class Iterator>
+void queue_client <T> :: push(Iterator first, Iterator last)
+{
+   size_t count = 0;
+   for (Iterator element = first; element != last; ++element, ++count)
+      send_push(*element);
+   flush();
+   T ignored;
+   for (size_t i = 0; i < count; i++)
+      receive(ignored);
+}
+
+template <class T>
+bool queue_client <T> :: pop(T & t)
+{
+   send_pop();
+   flush();
+   return receive(t) == queue_status::item;
+}
+
+template <class T>
+bool queue_client <T> :: peek(T & t)
+{
+   send_peek();
+   flush();
+   return receive(t) == queue_status::item;
+}
+
+template <class T>
+void queue_client <T> :: send_push(const T & t)
+{
+   out.push_back((char)queue_op::push);
+   out.append(reinterpret_cast<const char *>(&t), sizeof(T));
+}
+
+/************************************************
+ * QUEUE CLIENT :: FLUSH
+ * Write every request queued up
+ ***********************************************/
+template <class T>
+void queue_client <T> :: flush()
+{
+   size_t sent = 0;
+   while (sent < out.size())
+   {
+      ssize_t numWritten = ::send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+      if (numWritten < 0 && errno == EINTR)
+         continue;
+      if (numWritten < 0)
+         throw std::system_error(errno, std::system_category(), "send " + path);
+      sent += (size_t)numWritten;
+   }
+   out.clear();
+}
+
+/************************************************
+ * QUEUE CLIENT :: RECEIVE
+ * The answer to the oldest request not yet
+ * answered. t is filled in for an item.
+ ***********************************************/
+template <class T>
+queue_status queue_client <T> :: receive(T & t)
+{
+   while (in.size() - inUsed < 1)
+      readSome();
+   queue_status status = (queue_status)in[inUsed];
+   if (status == queue_status::item)
+   {
+      while (in.size() - inUsed < 1 + sizeof(T))
+         readSome();
+      std::memcpy(static_cast<void *>(&t), in.data() + inUsed + 1, sizeof(T));
+      inUsed += 1 + sizeof(T);
+   }
+   else
+      inUsed += 1;
+
+   if (inUsed == in.size())
+   {
+      in.clear();
+      inUsed = 0;
+   }
+   return status;
+}
+
+template <class T>
+void queue_client <T> :: readSome()
+{
+   if (inUsed > 0)
+   {
+      in.erase(0, inUsed);
+      inUsed = 0;
+   }
+   char buffer[64 * 1024];
+   for (;;)
+   {
+      ssize_t numRead = read(fd, buffer, sizeof(buffer));
+      if (numRead > 0)
+      {
+         in.append(buffer, (size_t)numRead);
+         return;
+      }
+      if (numRead < 0 && errno == EINTR)
+         continue;
+      if (numRead == 0)
+         throw std::runtime_error(path + " closed the connection");
+      throw std::system_error(errno, std::system_category(), "read " + path);
+   }
+}
+
+} // namespace custom
+
+#endif // __linux__
@@ -0,0 +1,190 @@
+/***********************************************************************
+ * Header:
+ *    RUNNING QUANTILE
+ * Summary:
+ *    An exact quantile of everything seen so far, without sorting.
+ *    The values are split between two priority queues: a max-queue
+ *    holding the lower part and a min-queue holding the upper part.
+ *    The split is kept at the quantile's rank, so the answer is the
+ *    top of the lower queue, and the next value up (needed to
+ *    interpolate) is the top of the upper one.
+ *
+ *    Inserting is O(log n) and reading the quantile is O(1). A batch
+ *    is dropped into the two queues as is and rebalanced once.
+ *
+ *    This will contain the class definition of:
+ *        running_quantile        : A streaming quantile tracker
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <functional>  // for std::less and std::greater
+#include <stdexcept>   // for std::out_of_range and std::invalid_argument
+#include "priority_queue.h"
+
+class TestRunningQuantile;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * RUNNING QUANTILE
+ * With n values, the q quantile is the value of
+ * rank q(n-1) counting from 0, interpolating
+ * between neighbours when that is not whole.
+ * q = 0.5 is the median.
+ *************************************************/
+template <class T>
+class running_quantile
+{
+   friend class ::TestRunningQuantile; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   explicit running_quantile(double quantile = 0.5) : quantile(quantile)
+   {
+      if (!(quantile >= 0.0 && quantile <= 1.0))
+         throw std::invalid_argument("quantile must be in [0, 1]");
+   }
+
+   //
+   // Insert
+   //
+   void insert(const T & t);
+   template <class Iterator>
+   void insert(Iterator first, Iterator last);
+
+   //
+   // Access
+   //
+   const T & value() const;
+   double interpolated() const;
+
+   //
+   // Status
+   //
+   size_t size()  const { return lower.size() + upper.size(); }
+   bool   empty() const { return lower.empty() && upper.empty(); }
+
+private:
+   size_t targetLower() const;   // how many values belong below the split
+   void   rebalance();
+   void   place(const T & t);
+
+   double quantile;
+   priority_queue<T, custom::vector<T>, std::less<T>>    lower;   // top is the largest
+   priority_queue<T, custom::vector<T>, std::greater<T>> upper;   // top is the smallest
+};
+
+/************************************************
+ * RUNNING QUANTILE :: INSERT
+ * Place the value, then shift at most one across
+ ***********************************************/
+template <class T>
+void running_quantile <T> :: insert(const T & t)
+{
+   place(t);
+   rebalance();
+}
+
+/************************************************
+ * RUNNING QUANTILE :: INSERT BATCH
+ * Place every value against the same split, then
+ * rebalance once for the whole batch
+ ***********************************************/
+template <class T>
+template <class Iterator>
+void running_quantile <T> :: insert(Iterator first, Iterator last)
+{
+   for (Iterator it = first; it != last; ++it)
+      place(*it);
+   rebalance();
+}
+
+/************************************************
+ * RUNNING QUANTILE :: VALUE
+ * The value of rank floor(q(n-1)): the lower top
+ ***********************************************/
+template <class T>
+const T & running_quantile <T> :: value() const
+{
+   if (lower.empty())
+      throw std::out_of_range("std:out_of_range");
+   return lower.top();
+}
+
+/************************************************
+ * RUNNING QUANTILE :: INTERPOLATED
+ * Between the lower top and the upper top, in
+ * proportion to the fractional part of the rank
+ ***********************************************/
+template <class T>
+double running_quantile <T> :: interpolated() const
+{
+   if (lower.empty())
+      throw std::out_of_range("std:out_of_range");
+
+   double rank = quantile * (double)(size() - 1);
+   double fraction = rank - (double)(lower.size() - 1);
+   if (fraction <= 0.0 || upper.empty())
+      return (double)lower.top();
+   return (double)lower.top() + fraction * ((double)upper.top() - (double)lower.top());
+}
+
+/************************************************
+ * RUNNING QUANTILE :: TARGET LOWER
+ * Ranks 0 through floor(q(n-1)) sit below the split
+ ***********************************************/
+template <class T>
+size_t running_quantile <T> :: targetLower() const
+{
+   size_t num = size();
+   if (num == 0)
+      return 0;
+   size_t rank = (size_t)(quantile * (double)(num - 1));
+   if (rank > num - 1)
+      rank = num - 1;
+   return rank + 1;
+}
+
+/************************************************
+ * RUNNING QUANTILE :: PLACE
+ * Keep everything below no larger than everything
+ * above; the sizes are fixed up later
+ ***********************************************/
+template <class T>
+void running_quantile <T> :: place(const T & t)
+{
+   if (!lower.empty() && !(lower.top() < t))
+      lower.push(t);
+   else
+      upper.push(t);
+}
+
+/************************************************
+ * RUNNING QUANTILE :: REBALANCE
+ * Move tops across until the lower part holds
+ * exactly the values up to the quantile's rank
+ ***********************************************/
+template <class T>
+void running_quantile <T> :: rebalance()
+{
+   size_t target = targetLower();
+   while (lower.size() > target)
+   {
+      upper.push(lower.top());
+      lower.pop();
+   }
+   while (lower.size() < target)
+   {
+      lower.push(upper.top());
+      upper.pop();
+   }
+}
+
+} // namespace custom
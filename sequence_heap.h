@@ -0,0 +1,318 @@
+/***********************************************************************
+ * Header:
+ *    SEQUENCE HEAP
+ * Summary:
+ *    A priority queue for very large n, after Sanders' sequence heap.
+ *    A binary heap of hundreds of millions of items takes a cache or
+ *    TLB miss on nearly every level it sifts through. Here almost all
+ *    of the items sit in sorted runs that are only ever read and
+ *    written front to back.
+ *
+ *    The pieces, from smallest to largest:
+ *        insertion heap   a binary heap of at most m new items
+ *        deletion buffer  the largest items of all the runs, sorted
+ *        group j          up to k sorted runs of about m k^j items,
+ *                         read through a loser tree (kway_merge)
+ *    When the insertion heap fills, it is sorted together with the
+ *    deletion buffer: the largest go back to the buffer and the rest
+ *    become a new run in group 0. A group that already holds k runs
+ *    is first merged into one run and passed on to the next group.
+ *    The top is the larger of the insertion heap's top and the
+ *    buffer's; the buffer is refilled by merging the groups.
+ *
+ *    m should keep the insertion heap and buffer in L1, and k keeps
+ *    one group's run heads within the cache and TLB.
+ *
+ *    This will contain the class definition of:
+ *        sequence_heap           : A cache-efficient priority queue
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <algorithm>   // for std::sort and std::reverse
+#include <cassert>
+#include <cstddef>     // for size_t
+#include <functional>  // for std::less
+#include <stdexcept>   // for std::out_of_range and std::invalid_argument
+#include <utility>     // for std::move and std::pair
+#include "heap.h"
+#include "kway_merge.h"
+#include "vector.h"
+
+class TestSequenceHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * SEQUENCE HEAP
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class sequence_heap
+{
+   friend class ::TestSequenceHeap; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   explicit sequence_heap(size_t m = 256, size_t k = 64, const Compare & compare = Compare()) :
+      m(m), k(k), numElements(0), compare(compare)
+   {
+      if (m < 1 || k < 2)
+         throw std::invalid_argument("sequence_heap needs m >= 1 and k >= 2");
+      insertion.reserve(m);
+      deletion.reserve(m);
+   }
+
+   //
+   // Access
+   //
+   const T & top() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+
+   //
+   // Remove
+   //
+   void pop();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   // runs are kept largest first, which is ascending under this
+   struct reversed
+   {
+      Compare compare;
+      bool operator () (const T & lhs, const T & rhs) const { return compare(rhs, lhs); }
+   };
+   typedef custom::kway_merge<T *, reversed> merger;
+
+   // up to k runs and the tree that merges them
+   struct group
+   {
+      group(const reversed & order) : merge(custom::vector<typename merger::range>(), order) {}
+      custom::vector<custom::vector<T>> runs;
+      merger merge;
+   };
+
+   void afterPush();
+   bool insertionOnTop() const;
+   void spill();
+   void addRun(size_t index, custom::vector<T> && run);
+   void refill();
+
+   size_t m;                               // insertion heap and buffer capacity
+   size_t k;                               // runs per group
+   custom::vector<T> insertion;            // a binary heap under Compare
+   custom::vector<T> deletion;             // ascending: the largest is at the back
+   custom::vector<group> groups;
+   size_t  numElements;
+   Compare compare;
+};
+
+/************************************************
+ * SEQUENCE HEAP :: TOP
+ * The larger of the two small structures' tops.
+ * Every run item is no larger than the buffer's.
+ ***********************************************/
+template <class T, class Compare>
+const T & sequence_heap <T, Compare> :: top() const
+{
+   if (numElements == 0)
+      throw std::out_of_range("std:out_of_range");
+   return insertionOnTop() ? insertion.front() : deletion.back();
+}
+
+/************************************************
+ * SEQUENCE HEAP :: PUSH
+ * Into the insertion heap; spill it when full
+ ***********************************************/
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: push(const T & t)
+{
+   insertion.push_back(t);
+   afterPush();
+}
+
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: push(T && t)
+{
+   insertion.push_back(std::move(t));
+   afterPush();
+}
+
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: afterPush()
+{
+   custom::push_heap(insertion.begin(), insertion.end(), compare);
+   numElements++;
+   if (insertion.size() >= m)
+      spill();
+}
+
+/************************************************
+ * SEQUENCE HEAP :: POP
+ * Take the top from wherever it is. An empty
+ * buffer is refilled from the groups at once, so
+ * top() never has to.
+ ***********************************************/
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: pop()
+{
+   if (numElements == 0)
+      return;
+
+   if (insertionOnTop())
+   {
+      custom::pop_heap(insertion.begin(), insertion.end(), compare);
+      insertion.pop_back();
+   }
+   else
+   {
+      deletion.pop_back();
+      if (deletion.empty())
+         refill();
+   }
+   numElements--;
+}
+
+/************************************************
+ * SEQUENCE HEAP :: INSERTION ON TOP
+ * Is the overall top in the insertion heap?
+ ***********************************************/
+template <class T, class Compare>
+bool sequence_heap <T, Compare> :: insertionOnTop() const
+{
+   if (insertion.empty())
+      return false;
+   if (deletion.empty())
+      return true;
+   return !compare(insertion.front(), deletion.back());
+}
+
+/************************************************
+ * SEQUENCE HEAP :: SPILL
+ * Sort the insertion heap with the buffer. The
+ * buffer keeps as many as it had, now the largest
+ * of both, so it still beats every run; the rest
+ * is a new run for group 0.
+ ***********************************************/
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: spill()
+{
+   size_t keep = deletion.size();
+   custom::vector<T> all(std::move(insertion));
+   for (size_t i = 0; i < deletion.size(); i++)
+      all.push_back(std::move(deletion[i]));
+   insertion = custom::vector<T>();
+   insertion.reserve(m);
+   deletion.clear();
+
+   // largest first
+   std::sort(all.begin(), all.end(), reversed{ compare });
+
+   for (size_t i = keep; i-- > 0; )
+      deletion.push_back(std::move(all[i]));
+   custom::vector<T> run;
+   run.reserve(all.size() - keep);
+   for (size_t i = keep; i < all.size(); i++)
+      run.push_back(std::move(all[i]));
+
+   addRun(0, std::move(run));
+   if (deletion.empty())
+      refill();
+}
+
+/************************************************
+ * SEQUENCE HEAP :: ADD RUN
+ * Put a sorted run in group index. If the group is
+ * full, merge what is left of its runs into one and
+ * hand that up to the next group first.
+ ***********************************************/
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: addRun(size_t index, custom::vector<T> && run)
+{
+   if (run.empty())
+      return;
+   while (groups.size() <= index)
+      groups.push_back(group(reversed{ compare }));
+
+   // drop the runs this group has used up
+   group & current = groups[index];
+   const custom::vector<typename merger::range> & remaining = current.merge.remaining();
+   custom::vector<custom::vector<T>> live;
+   custom::vector<typename merger::range> ranges;
+   size_t numLeft = 0;
+   for (size_t i = 0; i < remaining.size(); i++)
+      if (remaining[i].first != remaining[i].second)
+      {
+         live.push_back(std::move(current.runs[i]));
+         ranges.push_back(remaining[i]);
+         numLeft += remaining[i].second - remaining[i].first;
+      }
+
+   if (live.size() >= k)
+   {
+      // one long run, read front to back out of k
+      custom::vector<T> merged;
+      merged.reserve(numLeft);
+      merger all(ranges, reversed{ compare });
+      while (!all.empty())
+      {
+         merged.push_back(std::move(all.top()));
+         all.pop();
+      }
+      live.clear();
+      ranges.clear();
+      addRun(index + 1, std::move(merged));
+   }
+
+   // moving a custom::vector keeps its buffer, so the range stays good
+   T * first = &run[0];
+   T * last = first + run.size();
+   live.push_back(std::move(run));
+   ranges.push_back(std::make_pair(first, last));
+
+   group & target = groups[index];     // addRun above may have moved the groups
+   target.runs = std::move(live);
+   target.merge = merger(ranges, reversed{ compare });
+}
+
+/************************************************
+ * SEQUENCE HEAP :: REFILL
+ * Merge the largest m items of all the groups into
+ * the empty buffer. Every group hands out its items
+ * largest first, so picking the best head each time
+ * takes the overall largest.
+ ***********************************************/
+template <class T, class Compare>
+void sequence_heap <T, Compare> :: refill()
+{
+   assert(deletion.empty());
+   while (deletion.size() < m)
+   {
+      group * best = nullptr;
+      for (size_t i = 0; i < groups.size(); i++)
+         if (!groups[i].merge.empty() &&
+             (best == nullptr || compare(best->merge.top(), groups[i].merge.top())))
+            best = &groups[i];
+      if (best == nullptr)
+         break;
+      deletion.push_back(std::move(best->merge.top()));
+      best->merge.pop();
+   }
+   std::reverse(deletion.begin(), deletion.end());
+}
+
+} // namespace custom
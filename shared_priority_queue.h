@@ -0,0 +1,439 @@
+/***********************************************************************
+ * Header:
+ *    SHARED PRIORITY QUEUE
+ * Summary:
+ *    A fixed-capacity binary heap in a POSIX shared-memory segment, so
+ *    worker processes on one machine push and pop a common queue
+ *    directly, with no broker and no round trip. The segment is:
+ *        header   magic, version, element size, capacity, count, the
+ *                 state of the operation under way, and the mutex;
+ *                 padded to 64 bytes
+ *        pending  one slot of T: the item being sifted
+ *        heap     capacity slots of T, the first count in heap order
+ *
+ *    Every operation holds a process-shared robust mutex. If a process
+ *    dies holding it, the next process to lock it is told so, and
+ *    repairs the heap before going on. To make that possible, push and
+ *    pop sift a hole rather than swapping: the moving item waits in
+ *    the pending slot, and the header records where the hole is after
+ *    every step. At any moment, putting the pending item in the hole
+ *    gives back every item exactly once; recovery does that and then
+ *    re-heapifies.
+ *
+ *    The first process to open a name creates and initializes the
+ *    segment; capacity only matters to that one. The others wait for
+ *    it to be ready, then check it holds items of their T. The segment
+ *    outlives every process until remove() unlinks it.
+ *
+ *    T must not hold pointers. Every process must use the same Compare.
+ *
+ *    This will contain the class definition of:
+ *        shared_priority_queue   : A priority queue in shared memory
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include <atomic>          // for std::atomic
+#include <cassert>
+#include <cerrno>          // for errno
+#include <chrono>          // for std::chrono::milliseconds
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t and uint32_t
+#include <cstring>         // for std::memcpy and std::memcmp
+#include <functional>      // for std::less
+#include <stdexcept>       // for std::out_of_range and std::runtime_error
+#include <string>
+#include <system_error>    // for std::system_error
+#include <thread>          // for std::this_thread::sleep_for
+#include <type_traits>     // for std::is_trivially_copyable
+#include <fcntl.h>         // for O_CREAT and O_EXCL
+#include <pthread.h>       // for pthread_mutex_t
+#include <sys/mman.h>      // for shm_open, mmap and munmap
+#include <sys/stat.h>      // for fstat
+#include <unistd.h>        // for ftruncate and close
+#include "heap.h"
+
+class TestSharedPriorityQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * SHARED PRIORITY QUEUE
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class shared_priority_queue
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "shared_priority_queue stores T as raw bytes");
+   static_assert(alignof(T) <= 64, "shared_priority_queue aligns items to 64 bytes at most");
+   static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                 "the hole must be stored in one instruction");
+   friend class ::TestSharedPriorityQueue; // give the unit test class access to the privates
+public:
+
+   //
+   // construct: open the segment, or create it with room for capacity items
+   //
+   shared_priority_queue(const std::string & name, size_t capacity,
+                         const Compare & compare = Compare());
+   shared_priority_queue(const shared_priority_queue &) = delete;
+   shared_priority_queue & operator = (const shared_priority_queue &) = delete;
+  ~shared_priority_queue();
+
+   // unlink the segment; processes that have it open keep it
+   static void remove(const std::string & name) { shm_unlink(name.c_str()); }
+
+   //
+   // Access: a copy, since another process may pop it at any time
+   //
+   T top() const;
+
+   //
+   // Insert: FALSE if the queue is full
+   //
+   bool push(const T & t);
+
+   //
+   // Remove: FALSE if there was nothing to pop
+   //
+   bool pop(T & t);
+
+   //
+   // Status
+   //
+   size_t size()     const;
+   bool   empty()    const { return size() == 0; }
+   size_t capacity() const { return (size_t)head->capacity; }
+
+private:
+   static constexpr uint32_t VERSION = 1;
+   static constexpr uint32_t READY = 0x51455053;   // "SPEQ"
+   static constexpr uint64_t NONE = ~(uint64_t)0;  // no operation under way
+
+   struct header
+   {
+      std::atomic<uint32_t> ready;   // READY once the creator is done
+      uint32_t version;
+      uint32_t elementSize;
+      uint32_t reserved;
+      char     magic[8];             // "CPQSHM" and zeros
+      uint64_t capacity;
+      uint64_t count;
+      std::atomic<uint64_t> hole;    // where pending belongs, or NONE
+      uint64_t pendingCount;         // the count once the operation is done
+      uint64_t recoveries;           // times a dead owner was cleaned up after
+      pthread_mutex_t mutex;
+   };
+
+   static constexpr size_t roundUp(size_t bytes) { return (bytes + 63) / 64 * 64; }
+   static constexpr size_t PENDING_OFFSET = roundUp(sizeof(header));
+   static constexpr size_t DATA_OFFSET    = PENDING_OFFSET + roundUp(sizeof(T));
+   static size_t bytesFor(size_t capacity) { return DATA_OFFSET + capacity * sizeof(T); }
+
+   T * pending() const { return reinterpret_cast<T *>(base + PENDING_OFFSET); }
+   T * data()    const { return reinterpret_cast<T *>(base + DATA_OFFSET); }
+
+   // hold the mutex for the life of the guard
+   struct guard
+   {
+      explicit guard(const shared_priority_queue & queue) : queue(queue) { queue.lock(); }
+     ~guard() { pthread_mutex_unlock(&queue.head->mutex); }
+      const shared_priority_queue & queue;
+   };
+
+   void create(int fd, size_t capacity);
+   void attach(int fd);
+   void lock() const;
+   void recover() const;
+
+   std::string name;
+   char *      base;          // the whole segment, mapped
+   size_t      mappedBytes;
+   header *    head;
+   Compare     compare;
+};
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: CONSTRUCTOR
+ * Exactly one process wins the exclusive create;
+ * everyone else attaches to what it built.
+ ***********************************************/
+template <class T, class Compare>
+shared_priority_queue <T, Compare> :: shared_priority_queue(const std::string & name,
+                                                             size_t capacity,
+                                                             const Compare & compare) :
+   name(name), base(nullptr), mappedBytes(0), head(nullptr), compare(compare)
+{
+   if (capacity == 0)
+      throw std::invalid_argument("shared_priority_queue needs a capacity");
+
+   bool creator = true;
+   int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+   if (fd < 0 && errno == EEXIST)
+   {
+      creator = false;
+      fd = shm_open(name.c_str(), O_RDWR, 0600);
+   }
+   if (fd < 0)
+      throw std::system_error(errno, std::system_category(), "shm_open " + name);
+
+   try
+   {
+      if (creator)
+         create(fd, capacity);
+      else
+         attach(fd);
+   }
+   catch (...)
+   {
+      if (base != nullptr)
+         munmap(base, mappedBytes);
+      ::close(fd);
+      if (creator)
+         shm_unlink(name.c_str());
+      throw;
+   }
+   ::close(fd);   // the mapping keeps the segment
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: DESTRUCTOR
+ * The items belong to the segment, not to us
+ ***********************************************/
+template <class T, class Compare>
+shared_priority_queue <T, Compare> :: ~shared_priority_queue()
+{
+   if (base != nullptr)
+      munmap(base, mappedBytes);
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: CREATE
+ * Size the segment, set up a robust process-shared
+ * mutex, and only then say it is ready
+ ***********************************************/
+template <class T, class Compare>
+void shared_priority_queue <T, Compare> :: create(int fd, size_t capacity)
+{
+   mappedBytes = bytesFor(capacity);
+   if (ftruncate(fd, (off_t)mappedBytes) != 0)
+      throw std::system_error(errno, std::system_category(), "ftruncate " + name);
+   void * p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (p == MAP_FAILED)
+      throw std::system_error(errno, std::system_category(), "mmap " + name);
+   base = static_cast<char *>(p);
+   head = reinterpret_cast<header *>(base);
+
+   head->version      = VERSION;
+   head->elementSize  = (uint32_t)sizeof(T);
+   std::memcpy(head->magic, "CPQSHM\0", 8);
+   head->capacity     = capacity;
+   head->count        = 0;
+   head->hole.store(NONE);
+   head->pendingCount = 0;
+   head->recoveries   = 0;
+
+   pthread_mutexattr_t attributes;
+   pthread_mutexattr_init(&attributes);
+   pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+   pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+   int error = pthread_mutex_init(&head->mutex, &attributes);
+   pthread_mutexattr_destroy(&attributes);
+   if (error != 0)
+      throw std::system_error(error, std::system_category(), "pthread_mutex_init " + name);
+
+   head->ready.store(READY, std::memory_order_release);
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: ATTACH
+ * Wait for the creator to size the segment and
+ * mark it ready, then check it is ours
+ ***********************************************/
+template <class T, class Compare>
+void shared_priority_queue <T, Compare> :: attach(int fd)
+{
+   const int numTries = 2000;   // a millisecond apart
+   struct stat status;
+   for (int i = 0; ; i++)
+   {
+      if (fstat(fd, &status) != 0)
+         throw std::system_error(errno, std::system_category(), "fstat " + name);
+      if ((size_t)status.st_size >= DATA_OFFSET)
+         break;
+      if (i == numTries)
+         throw std::runtime_error(name + " was never initialized");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   mappedBytes = (size_t)status.st_size;
+   void * p = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+   if (p == MAP_FAILED)
+      throw std::system_error(errno, std::system_category(), "mmap " + name);
+   base = static_cast<char *>(p);
+   head = reinterpret_cast<header *>(base);
+
+   for (int i = 0; head->ready.load(std::memory_order_acquire) != READY; i++)
+   {
+      if (i == numTries)
+         throw std::runtime_error(name + " was never initialized");
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+   }
+
+   if (std::memcmp(head->magic, "CPQSHM\0", 8) != 0)
+      throw std::runtime_error(name + " is not a shared_priority_queue");
+   if (head->version != VERSION)
+      throw std::runtime_error(name + " has version " + std::to_string(head->version));
+   if (head->elementSize != sizeof(T))
+      throw std::runtime_error(name + " holds items of " + std::to_string(head->elementSize) + " bytes");
+   if (mappedBytes < bytesFor((size_t)head->capacity))
+      throw std::runtime_error(name + " is truncated");
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: LOCK
+ * EOWNERDEAD: we hold the lock, but whoever held
+ * it before died, perhaps in mid-sift
+ ***********************************************/
+template <class T, class Compare>
+void shared_priority_queue <T, Compare> :: lock() const
+{
+   int error = pthread_mutex_lock(&head->mutex);
+   if (error == EOWNERDEAD)
+   {
+      recover();
+      pthread_mutex_consistent(&head->mutex);
+   }
+   else if (error != 0)
+      throw std::system_error(error, std::system_category(), "pthread_mutex_lock " + name);
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: RECOVER
+ * Finish the dead owner's operation by putting the
+ * pending item in the hole, then heapify, since
+ * the sift stopped part way
+ ***********************************************/
+template <class T, class Compare>
+void shared_priority_queue <T, Compare> :: recover() const
+{
+   uint64_t hole = head->hole.load();
+   if (hole != NONE)
+   {
+      if (hole < head->pendingCount)
+         data()[hole] = *pending();
+      head->count = head->pendingCount;
+      head->hole.store(NONE);
+   }
+   Compare compare = this->compare;
+   custom::make_heap(data(), data() + head->count, compare);
+   head->recoveries++;
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: TOP
+ ***********************************************/
+template <class T, class Compare>
+T shared_priority_queue <T, Compare> :: top() const
+{
+   guard locked(*this);
+   if (head->count == 0)
+      throw std::out_of_range("std:out_of_range");
+   return data()[0];
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: SIZE
+ ***********************************************/
+template <class T, class Compare>
+size_t shared_priority_queue <T, Compare> :: size() const
+{
+   guard locked(*this);
+   return (size_t)head->count;
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: PUSH
+ * The new item waits in pending while the hole
+ * climbs from the end; each parent it passes
+ * moves down into the hole
+ ***********************************************/
+template <class T, class Compare>
+bool shared_priority_queue <T, Compare> :: push(const T & t)
+{
+   guard locked(*this);
+   uint64_t count = head->count;
+   if (count == head->capacity)
+      return false;
+
+   T * items = data();
+   *pending() = t;
+   head->pendingCount = count + 1;
+   head->hole.store(count);          // from here on a death is recoverable
+   head->count = count + 1;
+
+   size_t hole = (size_t)count;
+   while (hole > 0)
+   {
+      size_t parent = (hole - 1) / 2;
+      if (!compare(items[parent], *pending()))
+         break;
+      items[hole] = items[parent];
+      head->hole.store(parent);
+      hole = parent;
+   }
+   items[hole] = *pending();
+   head->hole.store(NONE);
+   return true;
+}
+
+/************************************************
+ * SHARED PRIORITY QUEUE :: POP
+ * The last item waits in pending while the hole
+ * left by the top sinks; each larger child it
+ * passes moves up into the hole
+ ***********************************************/
+template <class T, class Compare>
+bool shared_priority_queue <T, Compare> :: pop(T & t)
+{
+   guard locked(*this);
+   uint64_t count = head->count;
+   if (count == 0)
+      return false;
+
+   T * items = data();
+   t = items[0];
+   size_t last = (size_t)count - 1;
+   *pending() = items[last];
+   head->pendingCount = last;
+   head->hole.store(0);              // from here on a death is recoverable
+   head->count = last;
+
+   size_t hole = 0;
+   for (;;)
+   {
+      size_t child = 2 * hole + 1;
+      if (child >= last)
+         break;
+      if (child + 1 < last && compare(items[child], items[child + 1]))
+         child++;
+      if (!compare(*pending(), items[child]))
+         break;
+      items[hole] = items[child];
+      head->hole.store(child);
+      hole = child;
+   }
+   if (last > 0)
+      items[hole] = *pending();
+   head->hole.store(NONE);
+   return true;
+}
+
+} // namespace custom
+
+#endif // __linux__
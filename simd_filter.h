@@ -0,0 +1,302 @@
+/***********************************************************************
+ * Header:
+ *    SIMD FILTER
+ * Summary:
+ *    Skip over a run of keys that cannot beat a threshold. When a
+ *    bounded heap is full, nearly every candidate loses to its weakest
+ *    member; comparing eight floats or int32s (four int64s) at a time
+ *    against the threshold lets us step over the losers without a
+ *    branch per key and stop only on a possible survivor.
+ *
+ *    The widest instruction set is chosen at run time: AVX2 when the
+ *    processor has it, then SSE2, then plain scalar code. Only x86
+ *    has vector kernels; everywhere else the scalar loop is used.
+ *    Nothing here needs special compiler flags.
+ *
+ *    This will contain:
+ *        simd::level             : The instruction sets we can use
+ *        simd::skip              : The dispatched kernels
+ *        filter                  : Pick the kernel for a key and comparator
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>     // for size_t
+#include <cstdint>     // for int32_t and int64_t
+#include <functional>  // for std::less and std::greater
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CUSTOM_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>    // for __cpuidex and _BitScanForward
+#endif
+#endif
+
+// GCC and Clang compile one function at a time for a wider target;
+// MSVC accepts the intrinsics anywhere
+#if defined(CUSTOM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CUSTOM_TARGET_SSE2 __attribute__((target("sse2")))
+#define CUSTOM_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CUSTOM_TARGET_SSE2
+#define CUSTOM_TARGET_AVX2
+#endif
+
+namespace custom
+{
+namespace simd
+{
+
+/*************************************************
+ * LEVEL
+ * The instruction sets in order of width
+ *************************************************/
+enum level { SCALAR, SSE2, AVX2 };
+
+/************************************************
+ * PROBE
+ * Ask the processor (and the OS, for the AVX state)
+ ***********************************************/
+inline level probe()
+{
+#if defined(CUSTOM_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+   __builtin_cpu_init();
+   if (__builtin_cpu_supports("avx2"))
+      return AVX2;
+   if (__builtin_cpu_supports("sse2"))
+      return SSE2;
+#elif defined(CUSTOM_SIMD_X86) && defined(_MSC_VER)
+   int info[4];
+   __cpuidex(info, 0, 0);
+   int numIds = info[0];
+   __cpuidex(info, 1, 0);
+   bool sse2    = (info[3] & (1 << 26)) != 0;
+   bool osxsave = (info[2] & (1 << 27)) != 0;
+   bool avx     = (info[2] & (1 << 28)) != 0;
+   if (numIds >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6)
+   {
+      __cpuidex(info, 7, 0);
+      if (info[1] & (1 << 5))
+         return AVX2;
+   }
+   if (sse2)
+      return SSE2;
+#endif
+   return SCALAR;
+}
+
+/************************************************
+ * DETECT
+ * Probe once, then remember
+ ***********************************************/
+inline level detect()
+{
+   static const level cached = probe();
+   return cached;
+}
+
+/************************************************
+ * LOWEST BIT
+ * The index of the first lane that matched
+ ***********************************************/
+inline unsigned int lowestBit(unsigned int mask)
+{
+#ifdef _MSC_VER
+   unsigned long index;
+   _BitScanForward(&index, mask);
+   return (unsigned int)index;
+#else
+   return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+
+/************************************************
+ * SKIP SCALAR
+ * The index of the first key that beats the threshold,
+ * or n. With largest, beating means being larger.
+ ***********************************************/
+template <bool largest, class T>
+size_t skipScalar(const T * keys, size_t n, T threshold)
+{
+   for (size_t i = 0; i < n; i++)
+      if (largest ? threshold < keys[i] : keys[i] < threshold)
+         return i;
+   return n;
+}
+
+#ifdef CUSTOM_SIMD_X86
+
+/************************************************
+ * SKIP SSE2
+ * Four lanes. SSE2 has no 64-bit compare, so int64
+ * keys stay scalar at this level.
+ ***********************************************/
+template <bool largest>
+CUSTOM_TARGET_SSE2 size_t skipSse2(const float * keys, size_t n, float threshold)
+{
+   __m128 bound = _mm_set1_ps(threshold);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128 block = _mm_loadu_ps(keys + i);
+      __m128 beats = largest ? _mm_cmpgt_ps(block, bound) : _mm_cmplt_ps(block, bound);
+      unsigned int mask = (unsigned int)_mm_movemask_ps(beats);
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + skipScalar<largest>(keys + i, n - i, threshold);
+}
+
+template <bool largest>
+CUSTOM_TARGET_SSE2 size_t skipSse2(const int32_t * keys, size_t n, int32_t threshold)
+{
+   __m128i bound = _mm_set1_epi32(threshold);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m128i block = _mm_loadu_si128((const __m128i *)(keys + i));
+      __m128i beats = largest ? _mm_cmpgt_epi32(block, bound) : _mm_cmplt_epi32(block, bound);
+      unsigned int mask = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(beats));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + skipScalar<largest>(keys + i, n - i, threshold);
+}
+
+/************************************************
+ * SKIP AVX2
+ * Eight lanes for float and int32, four for int64
+ ***********************************************/
+template <bool largest>
+CUSTOM_TARGET_AVX2 size_t skipAvx2(const float * keys, size_t n, float threshold)
+{
+   __m256 bound = _mm256_set1_ps(threshold);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256 block = _mm256_loadu_ps(keys + i);
+      __m256 beats = _mm256_cmp_ps(block, bound, largest ? _CMP_GT_OQ : _CMP_LT_OQ);
+      unsigned int mask = (unsigned int)_mm256_movemask_ps(beats);
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + skipScalar<largest>(keys + i, n - i, threshold);
+}
+
+template <bool largest>
+CUSTOM_TARGET_AVX2 size_t skipAvx2(const int32_t * keys, size_t n, int32_t threshold)
+{
+   __m256i bound = _mm256_set1_epi32(threshold);
+   size_t i = 0;
+   for (; i + 8 <= n; i += 8)
+   {
+      __m256i block = _mm256_loadu_si256((const __m256i *)(keys + i));
+      __m256i beats = largest ? _mm256_cmpgt_epi32(block, bound) : _mm256_cmpgt_epi32(bound, block);
+      unsigned int mask = (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(beats));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + skipScalar<largest>(keys + i, n - i, threshold);
+}
+
+template <bool largest>
+CUSTOM_TARGET_AVX2 size_t skipAvx2(const int64_t * keys, size_t n, int64_t threshold)
+{
+   __m256i bound = _mm256_set1_epi64x(threshold);
+   size_t i = 0;
+   for (; i + 4 <= n; i += 4)
+   {
+      __m256i block = _mm256_loadu_si256((const __m256i *)(keys + i));
+      __m256i beats = largest ? _mm256_cmpgt_epi64(block, bound) : _mm256_cmpgt_epi64(bound, block);
+      unsigned int mask = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(beats));
+      if (mask)
+         return i + lowestBit(mask);
+   }
+   return i + skipScalar<largest>(keys + i, n - i, threshold);
+}
+
+#endif // CUSTOM_SIMD_X86
+
+/************************************************
+ * SKIP
+ * Dispatch on the level, the detected one unless
+ * told otherwise. Never ask for more than detect().
+ ***********************************************/
+template <bool largest>
+size_t skip(const float * keys, size_t n, float threshold, level use = detect())
+{
+#ifdef CUSTOM_SIMD_X86
+   if (use == AVX2)
+      return skipAvx2<largest>(keys, n, threshold);
+   if (use == SSE2)
+      return skipSse2<largest>(keys, n, threshold);
+#endif
+   (void)use;
+   return skipScalar<largest>(keys, n, threshold);
+}
+
+template <bool largest>
+size_t skip(const int32_t * keys, size_t n, int32_t threshold, level use = detect())
+{
+#ifdef CUSTOM_SIMD_X86
+   if (use == AVX2)
+      return skipAvx2<largest>(keys, n, threshold);
+   if (use == SSE2)
+      return skipSse2<largest>(keys, n, threshold);
+#endif
+   (void)use;
+   return skipScalar<largest>(keys, n, threshold);
+}
+
+template <bool largest>
+size_t skip(const int64_t * keys, size_t n, int64_t threshold, level use = detect())
+{
+#ifdef CUSTOM_SIMD_X86
+   if (use == AVX2)
+      return skipAvx2<largest>(keys, n, threshold);
+#endif
+   (void)use;
+   return skipScalar<largest>(keys, n, threshold);
+}
+
+} // namespace simd
+
+/*************************************************
+ * FILTER
+ * Find the first key that beats the threshold under
+ * Compare: compare(threshold, key). Anything but the
+ * specializations below goes one key at a time.
+ *************************************************/
+template <class T, class Compare>
+struct filter
+{
+   static size_t skip(const T * keys, size_t n, const T & threshold, const Compare & compare)
+   {
+      for (size_t i = 0; i < n; i++)
+         if (compare(threshold, keys[i]))
+            return i;
+      return n;
+   }
+};
+
+template <class T, bool largest>
+struct simd_filter
+{
+   template <class Compare>
+   static size_t skip(const T * keys, size_t n, const T & threshold, const Compare &)
+   {
+      return simd::skip<largest>(keys, n, threshold);
+   }
+};
+
+template <> struct filter<float,   std::less<float>>      : simd_filter<float,   true>  {};
+template <> struct filter<float,   std::greater<float>>   : simd_filter<float,   false> {};
+template <> struct filter<int32_t, std::less<int32_t>>    : simd_filter<int32_t, true>  {};
+template <> struct filter<int32_t, std::greater<int32_t>> : simd_filter<int32_t, false> {};
+template <> struct filter<int64_t, std::less<int64_t>>    : simd_filter<int64_t, true>  {};
+template <> struct filter<int64_t, std::greater<int64_t>> : simd_filter<int64_t, false> {};
+
+} // namespace custom
@@ -0,0 +1,398 @@
+/***********************************************************************
+ * Header:
+ *    SLIDING WINDOW
+ * Summary:
+ *    The best of the recent past. Events arrive with non-decreasing
+ *    timestamps, and expire(cutoff) drops everything stamped before
+ *    the cutoff. A timestamp can be a clock reading ("the last 60
+ *    seconds") or just an event counter ("the last N events").
+ *
+ *    sliding_max keeps a monotonic deque: each new value evicts every
+ *    older value it beats, so the front is always the window's max.
+ *    Pushes and expiry are amortized O(1).
+ *
+ *    sliding_top_k keeps all live events in a heap and expires them
+ *    lazily: stale entries are only discarded when they surface at
+ *    the root, or when they make up half the heap and it is compacted.
+ *    Pushes are O(log n) and a bulk expiry is amortized O(1) per event.
+ *
+ *    This will contain the class definitions of:
+ *        ring                    : A growable circular deque
+ *        sliding_max             : Max over a window
+ *        sliding_top_k           : The best K over a window
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <chrono>      // for std::chrono::steady_clock
+#include <functional>  // for std::less
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::swap
+#include "vector.h"
+#include "top_k.h"
+
+class TestSlidingWindow;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * RING
+ * A deque over one power-of-two buffer. It doubles
+ * when full and never shrinks, so a window that has
+ * reached its working size stops allocating.
+ *************************************************/
+template <class T>
+class ring
+{
+   friend class ::TestSlidingWindow; // give the unit test class access to the privates
+public:
+   ring() : head(0), count(0) {}
+
+   void push_back(const T & t)
+   {
+      if (count == buffer.size())
+         grow();
+      buffer[(head + count) & (buffer.size() - 1)] = t;
+      count++;
+   }
+   void pop_front()
+   {
+      assert(count > 0);
+      head = (head + 1) & (buffer.size() - 1);
+      count--;
+   }
+   void pop_back()
+   {
+      assert(count > 0);
+      count--;
+   }
+
+   T & front()             { assert(count > 0); return buffer[head]; }
+   T & back()              { assert(count > 0); return (*this)[count - 1]; }
+   const T & front() const { assert(count > 0); return buffer[head]; }
+   const T & back()  const { assert(count > 0); return (*this)[count - 1]; }
+   T & operator [] (size_t index)
+   {
+      return buffer[(head + index) & (buffer.size() - 1)];
+   }
+   const T & operator [] (size_t index) const
+   {
+      return buffer[(head + index) & (buffer.size() - 1)];
+   }
+
+   size_t size()  const { return count;      }
+   bool   empty() const { return count == 0; }
+
+private:
+   void grow()
+   {
+      custom::vector<T> bigger(buffer.size() ? buffer.size() * 2 : 8);
+      for (size_t i = 0; i < count; i++)
+         bigger[i] = std::move((*this)[i]);
+      buffer = std::move(bigger);
+      head = 0;
+   }
+
+   custom::vector<T> buffer;   // the size is always a power of two
+   size_t head;                // index of the front
+   size_t count;
+};
+
+/*************************************************
+ * SLIDING MAX
+ * The largest value under Compare among those not
+ * yet expired. Of two equal values the newer one
+ * is kept, since it outlives the older.
+ *************************************************/
+template <class T,
+          class Time = std::chrono::steady_clock::time_point,
+          class Compare = std::less<T>>
+class sliding_max
+{
+   friend class ::TestSlidingWindow; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   sliding_max(const Compare & compare = Compare()) : compare(compare) {}
+
+   //
+   // Insert
+   //
+   void push(const Time & time, const T & value);
+
+   //
+   // Remove
+   //
+   void expire(const Time & cutoff);
+
+   //
+   // Access
+   //
+   const T & max() const;
+
+   //
+   // Status
+   //
+   bool empty() const { return candidates.empty(); }
+
+private:
+   struct Entry
+   {
+      Time time;
+      T    value;
+   };
+
+   ring<Entry> candidates;   // values decreasing from front to back
+   Compare compare;
+};
+
+/************************************************
+ * SLIDING MAX :: PUSH
+ * Anything older that the new value beats can
+ * never be the max again
+ ***********************************************/
+template <class T, class Time, class Compare>
+void sliding_max <T, Time, Compare> :: push(const Time & time, const T & value)
+{
+   assert(candidates.empty() || !(time < candidates.back().time));
+   while (!candidates.empty() && !compare(value, candidates.back().value))
+      candidates.pop_back();
+   candidates.push_back(Entry{ time, value });
+}
+
+/************************************************
+ * SLIDING MAX :: EXPIRE
+ * Drop everything stamped before the cutoff
+ ***********************************************/
+template <class T, class Time, class Compare>
+void sliding_max <T, Time, Compare> :: expire(const Time & cutoff)
+{
+   while (!candidates.empty() && candidates.front().time < cutoff)
+      candidates.pop_front();
+}
+
+/************************************************
+ * SLIDING MAX :: MAX
+ ***********************************************/
+template <class T, class Time, class Compare>
+const T & sliding_max <T, Time, Compare> :: max() const
+{
+   if (candidates.empty())
+      throw std::out_of_range("std:out_of_range");
+   return candidates.front().value;
+}
+
+/*************************************************
+ * SLIDING TOP K
+ * The K largest values under Compare among those
+ * not yet expired.
+ *************************************************/
+template <class T, size_t K,
+          class Time = std::chrono::steady_clock::time_point,
+          class Compare = std::less<T>>
+class sliding_top_k
+{
+   friend class ::TestSlidingWindow; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   sliding_top_k(const Compare & compare = Compare()) :
+      haveCutoff(false), cutoff(), compare(compare) {}
+
+   //
+   // Insert
+   //
+   void push(const Time & time, const T & value);
+
+   //
+   // Remove
+   //
+   size_t expire(const Time & cutoff);
+
+   //
+   // Access
+   //
+   custom::vector<T> top() const;
+
+   //
+   // Status
+   //
+   size_t size()  const { return times.size();  }
+   bool   empty() const { return times.empty(); }
+
+private:
+   struct Entry
+   {
+      Time time;
+      T    value;
+   };
+
+   bool live(const Entry & entry) const { return !haveCutoff || !(entry.time < cutoff); }
+   void percolateUp(size_t index);
+   void percolateDown(size_t index);
+   void compact();
+
+   void swapElements(size_t lhs, size_t rhs)
+   {
+      using std::swap;
+      swap(heap[lhs], heap[rhs]);
+   }
+
+   custom::vector<Entry> heap;        // 0-based max-heap by value; may hold stale entries
+   ring<Time> times;                  // the live events, oldest first
+   mutable custom::vector<size_t> stack;   // reused by top()
+   bool haveCutoff;
+   Time cutoff;
+   Compare compare;
+};
+
+/************************************************
+ * SLIDING TOP K :: PUSH
+ ***********************************************/
+template <class T, size_t K, class Time, class Compare>
+void sliding_top_k <T, K, Time, Compare> :: push(const Time & time, const T & value)
+{
+   assert(times.empty() || !(time < times.back()));
+   times.push_back(time);
+   heap.push_back(Entry{ time, value });
+   percolateUp(heap.size() - 1);
+}
+
+/************************************************
+ * SLIDING TOP K :: EXPIRE
+ * Forget everything stamped before the cutoff. Only
+ * the root is cleaned right away; the rest is left
+ * until there is as much stale as live. Returns the
+ * number of events that left the window.
+ ***********************************************/
+template <class T, size_t K, class Time, class Compare>
+size_t sliding_top_k <T, K, Time, Compare> :: expire(const Time & cutoff)
+{
+   if (haveCutoff && !(this->cutoff < cutoff))
+      return 0;
+   this->cutoff = cutoff;
+   haveCutoff = true;
+
+   size_t numExpired = 0;
+   while (!times.empty() && times.front() < cutoff)
+   {
+      times.pop_front();
+      numExpired++;
+   }
+
+   if (heap.size() > 2 * times.size() + 16)
+      compact();
+   else
+      while (!heap.empty() && !live(heap[0]))
+      {
+         swapElements(0, heap.size() - 1);
+         heap.pop_back();
+         if (!heap.empty())
+            percolateDown(0);
+      }
+   return numExpired;
+}
+
+/************************************************
+ * SLIDING TOP K :: TOP
+ * Walk the heap from the root, collecting live
+ * entries. A subtree whose root cannot beat the K
+ * found so far holds nothing better, so it is
+ * skipped. Best first.
+ ***********************************************/
+template <class T, size_t K, class Time, class Compare>
+custom::vector<T> sliding_top_k <T, K, Time, Compare> :: top() const
+{
+   top_k<T, K, Compare> best(compare);
+   stack.clear();
+   if (!heap.empty())
+      stack.push_back(0);
+
+   while (!stack.empty())
+   {
+      size_t index = stack.back();
+      stack.pop_back();
+
+      if (best.full() && !compare(best.threshold(), heap[index].value))
+         continue;
+      if (live(heap[index]))
+         best.push(heap[index].value);
+
+      size_t left = 2 * index + 1;
+      if (left < heap.size())
+         stack.push_back(left);
+      if (left + 1 < heap.size())
+         stack.push_back(left + 1);
+   }
+   return best.extract();
+}
+
+/************************************************
+ * SLIDING TOP K :: PERCOLATE UP and DOWN
+ ***********************************************/
+template <class T, size_t K, class Time, class Compare>
+void sliding_top_k <T, K, Time, Compare> :: percolateUp(size_t index)
+{
+   while (index > 0)
+   {
+      size_t parent = (index - 1) / 2;
+      if (!compare(heap[parent].value, heap[index].value))
+         break;
+      swapElements(index, parent);
+      index = parent;
+   }
+}
+
+template <class T, size_t K, class Time, class Compare>
+void sliding_top_k <T, K, Time, Compare> :: percolateDown(size_t index)
+{
+   for (;;)
+   {
+      size_t left    = 2 * index + 1;
+      size_t right   = 2 * index + 2;
+      size_t largest = index;
+
+      if (left < heap.size() && compare(heap[largest].value, heap[left].value))
+         largest = left;
+      if (right < heap.size() && compare(heap[largest].value, heap[right].value))
+         largest = right;
+
+      if (largest == index)
+         return;
+      swapElements(index, largest);
+      index = largest;
+   }
+}
+
+/************************************************
+ * SLIDING TOP K :: COMPACT
+ * Squeeze out the stale entries and re-heapify:
+ * O(n), paid for by the n/2 expiries behind it
+ ***********************************************/
+template <class T, size_t K, class Time, class Compare>
+void sliding_top_k <T, K, Time, Compare> :: compact()
+{
+   size_t numLive = 0;
+   for (size_t i = 0; i < heap.size(); i++)
+      if (live(heap[i]))
+      {
+         if (i != numLive)
+            swapElements(numLive, i);
+         numLive++;
+      }
+   while (heap.size() > numLive)
+      heap.pop_back();
+
+   for (size_t index = heap.size() / 2; index-- > 0; )
+      percolateDown(index);
+}
+
+} // namespace custom
@@ -0,0 +1,367 @@
+/***********************************************************************
+ * Header:
+ *    TEST B-HEAP
+ * Summary:
+ *    Unit tests for the paged heap layout and the B-heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "b_heap.h"          // class under test
+#include "priority_queue.h"
+#include "unitTest.h"        // unit test baseclass
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST B-HEAP
+ * Unit tests for the b_heap class
+ ***********************************************/
+class TestBHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Layout
+      test_pageSlots_standard();
+      test_position_skipsSlotZero();
+      test_children_withinPage();
+      test_children_acrossPages();
+      test_parent_inverse();
+      test_allocator_aligned();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_standard();
+      test_push_newPage();
+
+      // Remove
+      test_pop_sorted();
+      test_pop_dropsPage();
+      test_pop_greater();
+      test_pop_strings();
+
+      // Mixed
+      test_mixed_matchesQueue();
+
+      report("BHeap");
+   }
+
+   // four ints to a 16-byte "page": three nodes each
+   typedef custom::b_heap<int, std::less<int>, 16> small;
+
+   /***************************************
+    * LAYOUT
+    ***************************************/
+
+   // a page holds the largest power of two that fits
+   void test_pageSlots_standard()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(small::P == 4);
+      assertUnit((custom::b_heap<int>::P == 1024));
+      assertUnit((custom::b_heap<int64_t>::P == 512));
+      assertUnit((custom::b_heap<int, std::less<int>, 20>::P == 4));
+   }  // teardown
+
+   // nodes fill slots 1..P-1 of each page in turn
+   void test_position_skipsSlotZero()
+   {  // setup
+      // exercise
+      // verify
+      //    page 0: _ 0 1 2   page 1: _ 3 4 5   page 2: _ 6 ...
+      assertUnit(small::position(0) == 1);
+      assertUnit(small::position(2) == 3);
+      assertUnit(small::position(3) == 5);
+      assertUnit(small::position(5) == 7);
+      assertUnit(small::position(6) == 9);
+   }  // teardown
+
+   // the top half of a page has its children beside it
+   void test_children_withinPage()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(small::firstChild(1) == 2);
+      assertUnit(small::secondChild(1) == 3);
+      assertUnit((custom::b_heap<int>::firstChild(5 * 1024 + 100) == 5 * 1024 + 200));
+      assertUnit((custom::b_heap<int>::secondChild(5 * 1024 + 100) == 5 * 1024 + 201));
+   }  // teardown
+
+   // a page's leaves hang P child pages off it
+   void test_children_acrossPages()
+   {  // setup
+      // exercise
+      // verify
+      //    page 0 leaves 2 and 3 -> pages 1, 2 and 3, 4
+      assertUnit(small::firstChild(2) == 1 * 4 + 1);
+      assertUnit(small::secondChild(2) == 2 * 4 + 1);
+      assertUnit(small::firstChild(3) == 3 * 4 + 1);
+      assertUnit(small::secondChild(3) == 4 * 4 + 1);
+      //    page 1 leaf 2 -> page 5
+      assertUnit(small::firstChild(4 + 2) == 5 * 4 + 1);
+   }  // teardown
+
+   // parent undoes both children, and parents come first in memory
+   void test_parent_inverse()
+   {  // setup
+      bool inverse = true;
+      bool ordered = true;
+      // exercise
+      for (size_t i = 1; i < 5000; i++)
+      {
+         size_t p = small::position(i);
+         size_t up = small::parent(p);
+         inverse = inverse &&
+            (small::firstChild(up) == p || small::secondChild(up) == p);
+         ordered = ordered && up < p;
+      }
+      for (size_t i = 1; i < 100000; i += 7)
+      {
+         size_t p = custom::b_heap<int>::position(i);
+         size_t up = custom::b_heap<int>::parent(p);
+         inverse = inverse &&
+            (custom::b_heap<int>::firstChild(up) == p || custom::b_heap<int>::secondChild(up) == p);
+      }
+      // verify
+      assertUnit(inverse);
+      assertUnit(ordered);
+   }  // teardown
+
+   // the storage starts on a page
+   void test_allocator_aligned()
+   {  // setup
+      custom::b_heap<int> heap;
+      // exercise
+      for (int i = 0; i < 3000; i++)
+         heap.push(i);
+      // verify
+      assertUnit(((uintptr_t)&heap.container[0] % 4096) == 0);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing in it
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::b_heap<int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.container.empty());
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty heap
+   void test_top_empty()
+   {  // setup
+      custom::b_heap<int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // the largest is on top
+   void test_push_standard()
+   {  // setup
+      small heap;
+      int values[] = { 4, 9, 2, 7, 7, 1, 8 };
+      // exercise
+      for (int value : values)
+         heap.push(value);
+      // verify
+      assertUnit(heap.top() == 9);
+      assertUnit(heap.size() == 7);
+      assertUnit(isHeap(heap));
+   }  // teardown
+
+   // the fourth node opens page 1 under leaf 2
+   void test_push_newPage()
+   {  // setup
+      small heap;
+      heap.push(1);
+      heap.push(2);
+      heap.push(3);
+      // exercise
+      heap.push(4);
+      // verify
+      //    [_ 3 1 2] + 4 under slot 2  ->  [_ 4 3 2] [_ 1]
+      assertUnit(heap.container.size() == 6);
+      assertUnit(heap.container[1] == 4);
+      assertUnit(heap.container[2] == 3);
+      assertUnit(heap.container[5] == 1);
+      assertUnit(isHeap(heap));
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // everything comes out largest first
+   void test_pop_sorted()
+   {  // setup
+      small heap;
+      std::vector<int> values;
+      unsigned int seed = 43;
+      for (int i = 0; i < 2000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 700));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<int>());
+      // exercise
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+      assertUnit(heap.container.empty());
+   }  // teardown
+
+   // a page with nothing but its empty slot is let go
+   void test_pop_dropsPage()
+   {  // setup
+      small heap;
+      for (int i = 0; i < 4; i++)
+         heap.push(i);
+      // exercise
+      heap.pop();
+      // verify
+      //    [_ 3 2 1] [_ 0]  ->  [_ 2 0 1]
+      assertUnit(heap.container.size() == 4);
+      assertUnit(heap.top() == 2);
+      assertUnit(isHeap(heap));
+   }  // teardown
+
+   // greater<> puts the smallest on top
+   void test_pop_greater()
+   {  // setup
+      custom::b_heap<int, std::greater<int>, 32> heap;
+      for (int i = 100; i > 0; i--)
+         heap.push((i * 37) % 100);
+      // exercise
+      bool ascending = true;
+      int previous = -1;
+      while (!heap.empty())
+      {
+         ascending = ascending && previous <= heap.top();
+         previous = heap.top();
+         heap.pop();
+      }
+      // verify
+      assertUnit(ascending);
+   }  // teardown
+
+   // items that own memory move through the pages intact
+   void test_pop_strings()
+   {  // setup
+      custom::b_heap<std::string, std::less<std::string>, 128> heap;
+      std::vector<std::string> values;
+      for (int i = 0; i < 60; i++)
+      {
+         values.push_back("key-" + std::to_string((i * 17) % 60 + 100));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<std::string>());
+      // exercise
+      std::vector<std::string> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+   }  // teardown
+
+   /***************************************
+    * MIXED
+    ***************************************/
+
+   // interleaved pushes and pops keep step with priority_queue
+   void test_mixed_matchesQueue()
+   {  // setup
+      custom::b_heap<int, std::less<int>, 64> heap;
+      custom::priority_queue<int> queue;
+      unsigned int seed = 11;
+      bool same = true;
+      // exercise
+      for (int step = 0; step < 20000 && same; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         if ((seed >> 8) % 3 != 0 || queue.empty())
+         {
+            seed = seed * 1103515245 + 12345;
+            int value = (int)((seed >> 8) % 100000);
+            heap.push(value);
+            queue.push(value);
+         }
+         else
+         {
+            same = heap.top() == queue.top();
+            heap.pop();
+            queue.pop();
+         }
+         same = same && heap.size() == queue.size();
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(isHeap(heap));
+   }  // teardown
+
+private:
+   // no node beats its parent
+   template <class T, class C, size_t B>
+   static bool isHeap(const custom::b_heap<T, C, B> & heap)
+   {
+      typedef custom::b_heap<T, C, B> heap_type;
+      for (size_t i = 1; i < heap.size(); i++)
+      {
+         size_t p = heap_type::position(i);
+         if (heap.compare(heap.container[heap_type::parent(p)], heap.container[p]))
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,333 @@
+/***********************************************************************
+ * Header:
+ *    TEST COROUTINE SCHEDULER
+ * Summary:
+ *    Unit tests for the coroutine scheduler
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "coroutine_scheduler.h"   // class under test
+#include "unitTest.h"              // unit test baseclass
+#include "spy.h"
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+/***********************************************
+ * TEST COROUTINE SCHEDULER
+ * Unit tests for the coroutine_scheduler class
+ ***********************************************/
+class TestCoroutineScheduler : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Insert
+      test_spawn_priorityOrder();
+      test_spawn_fifoWithinPriority();
+
+      // Awaitables
+      test_yield_lowerPriority();
+      test_yield_higherPriority();
+      test_sleepUntil_order();
+      test_sleepUntil_past();
+
+      // Run
+      test_run_manyThreads();
+      test_stop();
+      test_stop_beforeRun();
+      test_destroy_queued();
+
+      report("CoroutineScheduler");
+   }
+
+   /***************************************
+    * SPAWN
+    ***************************************/
+
+   // coroutines start highest priority first
+   void test_spawn_priorityOrder()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(record(&log, 1), 1);
+      scheduler.spawn(record(&log, 3), 3);
+      scheduler.spawn(record(&log, 2), 2);
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 3);
+      if (log.size() == 3)
+      {
+         assertUnit(log[0] == 3);
+         assertUnit(log[1] == 2);
+         assertUnit(log[2] == 1);
+      }
+      assertUnit(scheduler.size() == 0);
+   }  // teardown
+
+   // equal priorities start in the order they were spawned
+   void test_spawn_fifoWithinPriority()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(record(&log, 10), 0);
+      scheduler.spawn(record(&log, 20), 0);
+      scheduler.spawn(record(&log, 30), 0);
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 3);
+      if (log.size() == 3)
+      {
+         assertUnit(log[0] == 10);
+         assertUnit(log[1] == 20);
+         assertUnit(log[2] == 30);
+      }
+   }  // teardown
+
+   /***************************************
+    * YIELD
+    ***************************************/
+
+   // yielding at a low priority lets the others go first
+   void test_yield_lowerPriority()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(yieldThenRecord(&scheduler, &log, 1, 0 /*yield priority*/), 5);
+      scheduler.spawn(record(&log, 2), 3);
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 3);
+      if (log.size() == 3)
+      {
+         assertUnit(log[0] == 1);   // before the yield
+         assertUnit(log[1] == 2);
+         assertUnit(log[2] == 1);   // after the yield
+      }
+   }  // teardown
+
+   // yielding at a high priority comes straight back
+   void test_yield_higherPriority()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(yieldThenRecord(&scheduler, &log, 1, 9 /*yield priority*/), 5);
+      scheduler.spawn(record(&log, 2), 3);
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 3);
+      if (log.size() == 3)
+      {
+         assertUnit(log[0] == 1);
+         assertUnit(log[1] == 1);
+         assertUnit(log[2] == 2);
+      }
+   }  // teardown
+
+   /***************************************
+    * SLEEP UNTIL
+    ***************************************/
+
+   // sleepers wake in deadline order, after the deadline
+   void test_sleepUntil_order()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      custom::coroutine_scheduler::clock::time_point start =
+         custom::coroutine_scheduler::clock::now();
+      scheduler.spawn(sleepThenRecord(&scheduler, &log, 30, start + std::chrono::milliseconds(30)));
+      scheduler.spawn(sleepThenRecord(&scheduler, &log, 10, start + std::chrono::milliseconds(10)));
+      scheduler.spawn(record(&log, 0));
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(custom::coroutine_scheduler::clock::now() - start >= std::chrono::milliseconds(30));
+      assertUnit(log.size() == 3);
+      if (log.size() == 3)
+      {
+         assertUnit(log[0] == 0);
+         assertUnit(log[1] == 10);
+         assertUnit(log[2] == 30);
+      }
+   }  // teardown
+
+   // a deadline in the past does not suspend at all
+   void test_sleepUntil_past()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(sleepThenRecord(&scheduler, &log, 1,
+                      custom::coroutine_scheduler::clock::now() - std::chrono::seconds(1)), 5);
+      scheduler.spawn(record(&log, 2), 3);
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 2);
+      if (log.size() == 2)
+      {
+         assertUnit(log[0] == 1);
+         assertUnit(log[1] == 2);
+      }
+   }  // teardown
+
+   /***************************************
+    * RUN and STOP
+    ***************************************/
+
+   // every resume happens exactly once across several threads
+   void test_run_manyThreads()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      scheduler.reserve(100);
+      std::atomic<int> count(0);
+      for (int i = 0; i < 100; i++)
+         scheduler.spawn(countYields(&scheduler, &count, 10), i % 4);
+      // exercise
+      scheduler.run(4);
+      // verify
+      assertUnit(count == 1000);
+      assertUnit(scheduler.size() == 0);
+   }  // teardown
+
+   // stop leaves the rest of the work queued
+   void test_stop()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(stopThenRecord(&scheduler, &log, 1), 5);
+      scheduler.spawn(record(&log, 2), 3);
+      // exercise
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 1);
+      assertUnit(scheduler.size() == 1);
+      // teardown
+      scheduler.run();
+      assertUnit(log.size() == 2);
+   }
+
+   // a stop that lands before run is not lost, and is spent by that run
+   void test_stop_beforeRun()
+   {  // setup
+      custom::coroutine_scheduler scheduler;
+      Log log;
+      scheduler.spawn(record(&log, 1), 5);
+      scheduler.spawn(record(&log, 2), 3);
+      // exercise
+      scheduler.stop();
+      scheduler.run();
+      // verify
+      assertUnit(log.size() == 0);
+      assertUnit(scheduler.size() == 2);
+      // teardown
+      scheduler.run();
+      assertUnit(log.size() == 2);
+   }
+
+   /***************************************
+    * DESTRUCTOR
+    ***************************************/
+
+   // coroutines left queued after stop() are destroyed with the scheduler
+   void test_destroy_queued()
+   {  // setup
+      Spy::reset();
+      {
+         custom::coroutine_scheduler scheduler;
+         Log log;
+         scheduler.spawn(holdThenYield(&scheduler), 5);
+         scheduler.spawn(holdThenSleep(&scheduler), 4);
+         scheduler.spawn(stopThenRecord(&scheduler, &log, 1), 3);
+         scheduler.spawn(record(&log, 2), 2);
+         scheduler.run();
+         assertUnit(scheduler.size() == 3);
+         assertUnit(Spy::numNondefault() == 2);
+         assertUnit(Spy::numDestructor() == 0);
+         // exercise
+      }
+      // verify
+      assertUnit(Spy::numDestructor() == 2);
+      assertUnit(Spy::numDelete() == Spy::numAlloc());
+   }
+
+private:
+   typedef std::vector<int> Log;
+
+   /***************************************
+    * COROUTINES
+    * Free-standing so that their frames do not
+    * refer to a temporary lambda object
+    ***************************************/
+   static custom::coroutine_task record(Log * log, int value)
+   {
+      log->push_back(value);
+      co_return;
+   }
+
+   static custom::coroutine_task yieldThenRecord(custom::coroutine_scheduler * scheduler,
+                                                 Log * log, int value, int priority)
+   {
+      log->push_back(value);
+      co_await scheduler->yield(priority);
+      log->push_back(value);
+   }
+
+   static custom::coroutine_task sleepThenRecord(custom::coroutine_scheduler * scheduler,
+                                                 Log * log, int value,
+                                                 custom::coroutine_scheduler::clock::time_point deadline)
+   {
+      co_await scheduler->sleep_until(deadline);
+      log->push_back(value);
+   }
+
+   static custom::coroutine_task holdThenYield(custom::coroutine_scheduler * scheduler)
+   {
+      Spy held(7);
+      co_await scheduler->yield(0);
+      held.set(8);
+   }
+
+   static custom::coroutine_task holdThenSleep(custom::coroutine_scheduler * scheduler)
+   {
+      Spy held(9);
+      co_await scheduler->sleep_until(custom::coroutine_scheduler::clock::now() + std::chrono::hours(1));
+      held.set(10);
+   }
+
+   static custom::coroutine_task stopThenRecord(custom::coroutine_scheduler * scheduler,
+                                                Log * log, int value)
+   {
+      log->push_back(value);
+      scheduler->stop();
+      co_return;
+   }
+
+   static custom::coroutine_task countYields(custom::coroutine_scheduler * scheduler,
+                                             std::atomic<int> * count, int numYields)
+   {
+      for (int i = 0; i < numYields; i++)
+      {
+         (*count)++;
+         co_await scheduler->yield(i % 3);
+      }
+   }
+};
+
+#endif // __cpp_impl_coroutine
+
+#endif // DEBUG
@@ -0,0 +1,608 @@
+/***********************************************************************
+ * Header:
+ *    TEST DURABLE PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the priority queue with a write-ahead log. A crash
+ *    is a queue destroyed without a checkpoint, or files put back the
+ *    way a crash would have left them.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#ifdef __linux__
+
+#include "durable_priority_queue.h"   // class under test
+#include "priority_queue.h"
+#include "unitTest.h"                 // unit test baseclass
+
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/***********************************************
+ * TEST DURABLE PRIORITY QUEUE
+ * Unit tests for the durable_priority_queue class
+ ***********************************************/
+class TestDurablePriorityQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_fresh();
+      test_construct_recoverLog();
+      test_construct_recoverCheckpoint();
+      test_construct_oneHeapify();
+      test_construct_tornTail();
+      test_construct_staleLog();
+      test_construct_checkpointBeforeLog();
+      test_construct_damagedCheckpoint();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_logged();
+      test_push_range();
+      test_push_failedWrite();
+
+      // Remove
+      test_pop_empty();
+      test_pop_equalKeys();
+
+      // Durability
+      test_checkpoint_periodic();
+      test_checkpoint_truncatesLog();
+      test_checkpoint_concurrent();
+      test_groupCommit_threads();
+
+      report("DurablePQueue");
+   }
+
+   typedef custom::durable_priority_queue<int> queue_type;
+
+   // a scratch path with no log or checkpoint beside it
+   static std::string scratch(const std::string & name)
+   {
+      std::string path = scratchPath("dpq", name);
+      cleanup(path);
+      return path;
+   }
+   static void cleanup(const std::string & path)
+   {
+      std::remove((path + ".wal").c_str());
+      std::remove((path + ".ckpt").c_str());
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // no files: an empty queue and an empty log
+   void test_construct_fresh()
+   {  // setup
+      std::string path = scratch("fresh");
+      {
+         // exercise
+         queue_type queue(path);
+         // verify
+         assertUnit(queue.empty());
+         assertUnit(queue.generation == 0);
+      }
+      assertUnit(!std::filesystem::exists(path + ".ckpt"));
+      assertUnit(std::filesystem::file_size(path + ".wal") == sizeof(queue_type::header));
+      // teardown
+      cleanup(path);
+   }
+
+   // everything acknowledged is there after a crash
+   void test_construct_recoverLog()
+   {  // setup
+      std::string path = scratch("recoverlog");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 100; i++)
+            queue.push((i * 37) % 100);
+         int popped;
+         queue.pop(popped);
+         queue.pop(popped);
+      }  // crash
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.size() == 98);
+      assertUnit(queue.top() == 97);
+      // teardown
+      cleanup(path);
+   }
+
+   // a checkpoint and the log after it add up
+   void test_construct_recoverCheckpoint()
+   {  // setup
+      std::string path = scratch("recoverckpt");
+      custom::priority_queue<int> reference;
+      {
+         queue_type queue(path);
+         int popped;
+         for (int i = 0; i < 50; i++)
+         {
+            queue.push(i);
+            reference.push(i);
+         }
+         queue.checkpoint();
+         for (int i = 0; i < 10; i++)
+         {
+            queue.pop(popped);
+            reference.pop();
+         }
+         for (int i = 100; i < 120; i++)
+         {
+            queue.push(i);
+            reference.push(i);
+         }
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      bool same = queue.size() == reference.size();
+      int item;
+      while (same && queue.pop(item))
+      {
+         same = item == reference.top();
+         reference.pop();
+      }
+      assertUnit(same);
+      assertUnit(reference.empty());
+      // teardown
+      cleanup(path);
+   }
+
+   // recovery heapifies once instead of sifting every record
+   void test_construct_oneHeapify()
+   {  // setup
+      std::string path = scratch("heapify");
+      {
+         custom::durable_priority_queue<int, counting> queue(path);
+         for (int i = 0; i < 2000; i++)
+            queue.push(i);
+      }
+      counting::count = 0;
+      // exercise
+      custom::durable_priority_queue<int, counting> queue(path);
+      // verify
+      //    heapify is under 2n; 2000 pushes of a rising key cost ~20000
+      assertUnit(counting::count < 2 * 2000);
+      assertUnit(queue.size() == 2000);
+      assertUnit(queue.top() == 1999);
+      // teardown
+      cleanup(path);
+   }
+
+   // half a record at the end was never acknowledged
+   void test_construct_tornTail()
+   {  // setup
+      std::string path = scratch("torn");
+      {
+         queue_type queue(path);
+         queue.push(5);
+         queue.push(8);
+      }
+      {
+         std::ofstream wal(path + ".wal", std::ios::binary | std::ios::app);
+         wal.write("\x01\x63\x00", 3);
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.size() == 2);
+      assertUnit(queue.top() == 8);
+      assertUnit(std::filesystem::file_size(path + ".wal") ==
+                 sizeof(queue_type::header) + 2 * queue_type::RECORD_BYTES);
+      // teardown
+      cleanup(path);
+   }
+
+   // a crash between the checkpoint and the new log leaves the old
+   // log behind; its records are already in the checkpoint
+   void test_construct_staleLog()
+   {  // setup
+      std::string path = scratch("stale");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 10; i++)
+            queue.push(i);
+         std::filesystem::copy_file(path + ".wal", path + ".old");
+         queue.checkpoint();
+      }
+      std::filesystem::rename(path + ".old", path + ".wal");
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.size() == 10);
+      // teardown
+      cleanup(path);
+   }
+
+   // a crash after the checkpoint, before its new log: the old log
+   // holds records that came after the copy, and they are kept
+   void test_construct_checkpointBeforeLog()
+   {  // setup
+      std::string path = scratch("beforelog");
+      std::string other = scratch("beforelog-other");
+      {
+         queue_type queue(path);
+         queue_type longer(other);
+         for (int i = 0; i < 10; i++)
+         {
+            queue.push(i);
+            longer.push(i);
+         }
+         queue.checkpoint();
+         for (int i = 10; i < 13; i++)
+            longer.push(i);
+      }
+      std::filesystem::rename(other + ".wal", path + ".wal");
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.size() == 13);
+      assertUnit(queue.top() == 12);
+      assertUnit(queue.generation == 1);
+      assertUnit(queue.numSinceCheckpoint == 3);
+      assertUnit(std::filesystem::file_size(path + ".wal") ==
+                 sizeof(queue_type::header) + 3 * queue_type::RECORD_BYTES);
+      // teardown
+      cleanup(path);
+      cleanup(other);
+   }
+
+   // a checkpoint that does not add up is refused
+   void test_construct_damagedCheckpoint()
+   {  // setup
+      std::string path = scratch("damaged");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 10; i++)
+            queue.push(i);
+         queue.checkpoint();
+      }
+      {
+         std::fstream ckpt(path + ".ckpt", std::ios::binary | std::ios::in | std::ios::out);
+         ckpt.seekp(sizeof(queue_type::header) + 4);
+         ckpt.write("\x7f", 1);
+      }
+      // exercise
+      bool thrown = false;
+      try
+      {
+         queue_type queue(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      cleanup(path);
+   }
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty queue
+   void test_top_empty()
+   {  // setup
+      std::string path = scratch("top");
+      queue_type queue(path);
+      // exercise
+      try
+      {
+         queue.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      // teardown
+      cleanup(path);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // a push is on disk, synced, when it returns
+   void test_push_logged()
+   {  // setup
+      std::string path = scratch("push");
+      queue_type queue(path);
+      // exercise
+      queue.push(42);
+      // verify
+      assertUnit(queue.numDurable == queue.numAppended);
+      assertUnit(queue.pending.empty());
+      assertUnit(queue.numSyncs == 1);
+      assertUnit(std::filesystem::file_size(path + ".wal") ==
+                 sizeof(queue_type::header) + queue_type::RECORD_BYTES);
+      // teardown
+      cleanup(path);
+   }
+
+   // a range of pushes shares one write and one sync
+   void test_push_range()
+   {  // setup
+      std::string path = scratch("pushrange");
+      std::vector<int> values{ 4, 9, 1, 7, 3 };
+      {
+         queue_type queue(path);
+         // exercise
+         queue.push(values.begin(), values.end());
+         // verify
+         assertUnit(queue.numSyncs == 1);
+         assertUnit(queue.numAppended == 5);
+         assertUnit(queue.top() == 9);
+      }
+      queue_type queue(path);
+      assertUnit(queue.size() == 5);
+      // teardown
+      cleanup(path);
+   }
+
+   // a write cut short by the disk: the torn record goes, and so does the queue
+   void test_push_failedWrite()
+   {  // setup
+      std::string path = scratch("failed");
+      queue_type queue(path);
+      queue.push(5);
+      queue.push(8);
+      size_t durable = sizeof(queue_type::header) + 2 * queue_type::RECORD_BYTES;
+      //    the file may grow by a record and a half, then no more
+      void (*handler)(int) = signal(SIGXFSZ, SIG_IGN);
+      rlimit limit;
+      getrlimit(RLIMIT_FSIZE, &limit);
+      rlimit small = limit;
+      small.rlim_cur = durable + queue_type::RECORD_BYTES + queue_type::RECORD_BYTES / 2;
+      setrlimit(RLIMIT_FSIZE, &small);
+      std::vector<int> values{ 20, 30, 40 };
+      // exercise
+      bool thrown = false;
+      try
+      {
+         queue.push(values.begin(), values.end());
+      }
+      catch (const std::system_error &)
+      {
+         thrown = true;
+      }
+      setrlimit(RLIMIT_FSIZE, &limit);
+      signal(SIGXFSZ, handler);
+      // verify
+      assertUnit(thrown);
+      assertUnit(queue.numDurable == 2);
+      assertUnit(std::filesystem::file_size(path + ".wal") == durable);
+      bool failed = false;
+      try
+      {
+         queue.push(1);
+      }
+      catch (const std::runtime_error &)
+      {
+         failed = true;
+      }
+      assertUnit(failed);
+      failed = false;
+      try
+      {
+         queue.top();
+      }
+      catch (const std::runtime_error &)
+      {
+         failed = true;
+      }
+      assertUnit(failed);
+      queue_type reopened(path);
+      assertUnit(reopened.size() == 2);
+      assertUnit(reopened.top() == 8);
+      // teardown
+      cleanup(path);
+   }
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // nothing to pop, nothing logged
+   void test_pop_empty()
+   {  // setup
+      std::string path = scratch("popempty");
+      queue_type queue(path);
+      int item = -1;
+      // exercise
+      bool popped = queue.pop(item);
+      // verify
+      assertUnit(!popped);
+      assertUnit(item == -1);
+      assertUnit(queue.numAppended == 0);
+      // teardown
+      cleanup(path);
+   }
+
+   // items equal under Compare: recovery removes the very one popped
+   struct job
+   {
+      int priority;
+      int id;
+   };
+   struct byPriority
+   {
+      bool operator () (const job & lhs, const job & rhs) const { return lhs.priority < rhs.priority; }
+   };
+   void test_pop_equalKeys()
+   {  // setup
+      std::string path = scratch("equal");
+      int poppedId;
+      {
+         custom::durable_priority_queue<job, byPriority> queue(path);
+         for (int id = 0; id < 8; id++)
+            queue.push(job{ 5, id });
+         job popped;
+         queue.pop(popped);
+         poppedId = popped.id;
+      }
+      // exercise
+      custom::durable_priority_queue<job, byPriority> queue(path);
+      // verify
+      bool missing = true;
+      int count = 0;
+      job item;
+      while (queue.pop(item))
+      {
+         missing = missing && item.id != poppedId;
+         count++;
+      }
+      assertUnit(missing);
+      assertUnit(count == 7);
+      // teardown
+      cleanup(path);
+   }
+
+   /***************************************
+    * DURABILITY
+    ***************************************/
+
+   // every checkpointEvery records the log starts over
+   void test_checkpoint_periodic()
+   {  // setup
+      std::string path = scratch("periodic");
+      queue_type queue(path, 10);
+      // exercise
+      for (int i = 0; i < 25; i++)
+         queue.push(i);
+      // verify
+      //    generation 0 at open, then checkpoints at records 10 and 20
+      assertUnit(queue.generation == 2);
+      assertUnit(queue.numSinceCheckpoint == 5);
+      assertUnit(std::filesystem::file_size(path + ".wal") ==
+                 sizeof(queue_type::header) + 5 * queue_type::RECORD_BYTES);
+      // teardown
+      cleanup(path);
+   }
+
+   // a checkpoint holds the whole array and empties the log
+   void test_checkpoint_truncatesLog()
+   {  // setup
+      std::string path = scratch("truncate");
+      queue_type queue(path);
+      for (int i = 0; i < 30; i++)
+         queue.push(i);
+      // exercise
+      queue.checkpoint();
+      // verify
+      assertUnit(std::filesystem::file_size(path + ".wal") == sizeof(queue_type::header));
+      assertUnit(std::filesystem::file_size(path + ".ckpt") ==
+                 sizeof(queue_type::header) + 30 * sizeof(int));
+      // teardown
+      cleanup(path);
+   }
+
+   // pushes go on while checkpoints are written, and none is lost
+   void test_checkpoint_concurrent()
+   {  // setup
+      std::string path = scratch("concurrent");
+      const int numThreads = 4;
+      const int numEach = 200;
+      {
+         queue_type queue(path, 50);
+         for (int i = 0; i < 1000; i++)
+            queue.push(-i);
+         // exercise
+         std::vector<std::thread> threads;
+         for (int t = 0; t < numThreads; t++)
+            threads.push_back(std::thread([&queue, t, numEach]()
+            {
+               for (int i = 0; i < numEach; i++)
+                  queue.push(t * 1000 + i);
+            }));
+         threads.push_back(std::thread([&queue]()
+         {
+            for (int i = 0; i < 5; i++)
+               queue.checkpoint();
+         }));
+         for (std::thread & thread : threads)
+            thread.join();
+         // verify
+         assertUnit(queue.size() == 1000 + numThreads * numEach);
+         assertUnit(queue.generation > 5);
+      }
+      queue_type queue(path);
+      assertUnit(queue.size() == 1000 + numThreads * numEach);
+      assertUnit(queue.top() == 3199);
+      // teardown
+      cleanup(path);
+   }
+
+   // threads that wait together share an fdatasync
+   void test_groupCommit_threads()
+   {  // setup
+      std::string path = scratch("group");
+      const int numThreads = 8;
+      const int numEach = 50;
+      {
+         queue_type queue(path);
+         // exercise
+         std::vector<std::thread> threads;
+         for (int t = 0; t < numThreads; t++)
+            threads.push_back(std::thread([&queue, t, numEach]()
+            {
+               for (int i = 0; i < numEach; i++)
+                  queue.push(t * 1000 + i);
+            }));
+         for (std::thread & thread : threads)
+            thread.join();
+         // verify
+         assertUnit(queue.size() == numThreads * numEach);
+         assertUnit(queue.numSyncs < (size_t)(numThreads * numEach));
+         assertUnit(queue.numDurable == queue.numAppended);
+      }
+      queue_type queue(path);
+      assertUnit(queue.size() == numThreads * numEach);
+      assertUnit(queue.top() == 7049);
+      // teardown
+      cleanup(path);
+   }
+
+private:
+   // a less-than that counts how often it runs
+   struct counting
+   {
+      static int count;
+      bool operator () (int lhs, int rhs) const
+      {
+         count++;
+         return lhs < rhs;
+      }
+   };
+};
+
+inline int TestDurablePriorityQueue::counting::count = 0;
+
+#endif // __linux__
+#endif // DEBUG
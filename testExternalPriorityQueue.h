@@ -0,0 +1,393 @@
+/***********************************************************************
+ * Header:
+ *    TEST EXTERNAL PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the priority queue that spills to disk. Every test
+ *    runs with a budget of a few hundred bytes so the runs, the
+ *    blocks, and the merging of runs all get exercised.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "external_priority_queue.h"   // class under test
+#include "priority_queue.h"
+#include "unitTest.h"                  // unit test baseclass
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST EXTERNAL PRIORITY QUEUE
+ * Unit tests for the external_priority_queue class
+ ***********************************************/
+class TestExternalPriorityQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_budget();
+      test_construct_badDirectory();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_inMemory();
+      test_push_spill();
+      test_push_mergeRuns();
+      test_push_mergeLevels();
+
+      // Remove
+      test_pop_sorted();
+      test_pop_greater();
+      test_pop_records();
+      test_pop_removesFiles();
+      test_pop_releasesRuns();
+      test_clear_removesFiles();
+
+      // Mixed
+      test_mixed_matchesQueue();
+
+      report("ExternalPQueue");
+   }
+
+   // 64 ints in memory, blocks of 8, and room for 8 blocks
+   typedef custom::external_priority_queue<int> queue_type;
+   static const size_t smallBudget = 2 * 64 * sizeof(int);
+   static const size_t smallBlock  = 8 * sizeof(int);
+   static std::string directory()
+   {
+      return std::filesystem::temp_directory_path().string();
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // the budget splits between the heap and the run blocks
+   void test_construct_budget()
+   {  // setup
+      // exercise
+      queue_type queue(smallBudget, directory(), smallBlock);
+      // verify
+      assertUnit(queue.empty());
+      assertUnit(queue.heapCapacity == 64);
+      assertUnit(queue.blockItems == 8);
+      assertUnit(queue.maxRuns == 8);
+      assertUnit(queue.runs.empty());
+   }  // teardown
+
+   // the first spill reports a directory it cannot write to
+   void test_construct_badDirectory()
+   {  // setup
+      custom::external_priority_queue<int> queue(2 * 4 * sizeof(int), "/nonexistent/epq", sizeof(int));
+      bool thrown = false;
+      // exercise
+      try
+      {
+         for (int i = 0; i < 10; i++)
+            queue.push(i);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty queue
+   void test_top_empty()
+   {  // setup
+      custom::external_priority_queue<int> queue;
+      // exercise
+      try
+      {
+         queue.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // within the budget nothing touches the disk
+   void test_push_inMemory()
+   {  // setup
+      queue_type queue(smallBudget, directory(), smallBlock);
+      // exercise
+      for (int i = 0; i < 64; i++)
+         queue.push((i * 13) % 64);
+      // verify
+      assertUnit(queue.runs.empty());
+      assertUnit(queue.size() == 64);
+      assertUnit(queue.top() == 63);
+   }  // teardown
+
+   // one past the budget writes the heap out as a sorted run
+   void test_push_spill()
+   {  // setup
+      queue_type queue(smallBudget, directory(), smallBlock);
+      for (int i = 0; i < 64; i++)
+         queue.push(i);
+      // exercise
+      queue.push(-1);
+      // verify
+      assertUnit(queue.runs.size() == 1);
+      assertUnit(queue.heap.size() == 1);
+      assertUnit(queue.runs[0].head() == 63);
+      assertUnit(queue.runs[0].block.size() == 8);
+      assertUnit(queue.runs[0].numUnread == 56);
+      assertUnit(std::filesystem::exists(queue.runs[0].path));
+      assertUnit(std::filesystem::file_size(queue.runs[0].path) == 64 * sizeof(int));
+      assertUnit(queue.top() == 63);
+   }  // teardown
+
+   // more runs than blocks fit are merged
+   void test_push_mergeRuns()
+   {  // setup
+      custom::external_priority_queue<int> queue(2 * 16 * sizeof(int), directory(), 4 * sizeof(int));
+      // exercise: 16 in memory, room for 4 blocks
+      for (int i = 0; i < 16 * 6; i++)
+         queue.push((i * 37) % 96);
+      // verify
+      assertUnit(queue.maxRuns == 4);
+      assertUnit(queue.runs.size() <= 4);
+      assertUnit(queue.runs[0].numUnread + queue.runs[0].block.size() == 64);
+      assertUnit(queue.size() == 96);
+      assertUnit(queue.top() == 95);
+   }  // teardown
+
+   // runs are merged by level: each item is rewritten a few times, not once per merge
+   void test_push_mergeLevels()
+   {  // setup
+      custom::external_priority_queue<int> queue(2 * 16 * sizeof(int), directory(), 4 * sizeof(int));
+      const int numItems = 16 * 1000;
+      // exercise: 1000 spills with room for 4 blocks
+      for (int i = 0; i < numItems; i++)
+         queue.push((i * 37) % numItems);
+      // verify
+      //    merging every run each time rewrites each item ~65 times
+      assertUnit(queue.numWritten < 20 * (size_t)numItems);
+      assertUnit(queue.runs.size() <= 4);
+      size_t highest = 0;
+      for (size_t r = 0; r < queue.runs.size(); r++)
+         highest = std::max(highest, queue.runs[r].level);
+      assertUnit(highest >= 3);
+      std::vector<int> output;
+      while (!queue.empty())
+      {
+         output.push_back(queue.top());
+         queue.pop();
+      }
+      bool sorted = (int)output.size() == numItems;
+      for (size_t i = 0; sorted && i < output.size(); i++)
+         sorted = output[i] == numItems - 1 - (int)i;
+      assertUnit(sorted);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // many times the budget comes out in order
+   void test_pop_sorted()
+   {  // setup
+      queue_type queue(smallBudget, directory(), smallBlock);
+      std::vector<int> values;
+      unsigned int seed = 71;
+      for (int i = 0; i < 5000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 2000));
+         queue.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<int>());
+      // exercise
+      std::vector<int> output;
+      while (!queue.empty())
+      {
+         output.push_back(queue.top());
+         queue.pop();
+      }
+      // verify
+      assertUnit(output == values);
+      assertUnit(queue.runs.empty());
+   }  // teardown
+
+   // greater<> puts the smallest on top
+   void test_pop_greater()
+   {  // setup
+      custom::external_priority_queue<int, std::greater<int>> queue(2 * 8 * sizeof(int), directory(), 2 * sizeof(int));
+      for (int i = 200; i > 0; i--)
+         queue.push((i * 7) % 200);
+      // exercise
+      bool ascending = true;
+      int previous = -1;
+      while (!queue.empty())
+      {
+         ascending = ascending && previous <= queue.top();
+         previous = queue.top();
+         queue.pop();
+      }
+      // verify
+      assertUnit(ascending);
+   }  // teardown
+
+   // a plain struct goes through the files whole
+   struct record
+   {
+      int    key;
+      double payload;
+      bool operator < (const record & rhs) const { return key < rhs.key; }
+   };
+   void test_pop_records()
+   {  // setup
+      custom::external_priority_queue<record> queue(2 * 8 * sizeof(record), directory(), 2 * sizeof(record));
+      for (int i = 0; i < 100; i++)
+         queue.push(record{ (i * 41) % 100, ((i * 41) % 100) * 0.5 });
+      // exercise
+      bool intact = true;
+      for (int key = 99; key >= 0; key--)
+      {
+         intact = intact && queue.top().key == key && queue.top().payload == key * 0.5;
+         queue.pop();
+      }
+      // verify
+      assertUnit(intact);
+      assertUnit(queue.empty());
+   }  // teardown
+
+   // a run's file goes once it is read to the end
+   void test_pop_removesFiles()
+   {  // setup
+      queue_type queue(smallBudget, directory(), smallBlock);
+      for (int i = 0; i < 65; i++)
+         queue.push(i);
+      std::string path = queue.runs[0].path;
+      // exercise
+      while (!queue.empty())
+         queue.pop();
+      // verify
+      assertUnit(!std::filesystem::exists(path));
+   }  // teardown
+
+   // runs drained while another stays live do not pile up
+   void test_pop_releasesRuns()
+   {  // setup
+      queue_type queue(smallBudget, directory(), smallBlock);
+      for (int i = 0; i < 65; i++)
+         queue.push(0);   // a run of the lowest items, never drained
+      // exercise
+      size_t mostRuns = 0;
+      size_t mostBlock = 0;
+      bool sorted = true;
+      for (int cycle = 0; cycle < 500; cycle++)
+      {
+         for (int i = 0; i < 200; i++)
+            queue.push(1000 + (i * 37) % 200);
+         int previous = 1199;
+         for (int i = 0; i < 200; i++)
+         {
+            sorted = sorted && queue.top() <= previous && queue.top() >= 1000;
+            previous = queue.top();
+            queue.pop();
+         }
+         size_t block = 0;
+         for (size_t r = 0; r < queue.runs.size(); r++)
+            block += queue.runs[r].block.capacity();
+         mostRuns = std::max(mostRuns, queue.runs.size());
+         mostBlock = std::max(mostBlock, block);
+      }
+      // verify
+      assertUnit(sorted);
+      assertUnit(queue.size() == 65);
+      assertUnit(mostRuns <= queue.maxRuns);
+      assertUnit(mostBlock <= queue.maxRuns * queue.blockItems);
+      assertUnit(queue.runs.size() == queue.runHeap.size());
+   }  // teardown
+
+   // clear and the destructor leave nothing behind
+   void test_clear_removesFiles()
+   {  // setup
+      queue_type queue(smallBudget, directory(), smallBlock);
+      for (int i = 0; i < 300; i++)
+         queue.push(i);
+      std::vector<std::string> paths;
+      for (size_t r = 0; r < queue.runs.size(); r++)
+         paths.push_back(queue.runs[r].path);
+      // exercise
+      queue.clear();
+      // verify
+      assertUnit(paths.size() == 4);
+      bool gone = true;
+      for (const std::string & path : paths)
+         gone = gone && !std::filesystem::exists(path);
+      assertUnit(gone);
+      assertUnit(queue.empty());
+   }  // teardown
+
+   /***************************************
+    * MIXED
+    ***************************************/
+
+   // interleaved pushes and pops keep step with priority_queue
+   void test_mixed_matchesQueue()
+   {  // setup
+      custom::external_priority_queue<int> queue(2 * 32 * sizeof(int), directory(), 4 * sizeof(int));
+      custom::priority_queue<int> reference;
+      unsigned int seed = 5;
+      bool same = true;
+      // exercise
+      for (int step = 0; step < 20000 && same; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         if ((seed >> 8) % 3 != 0 || reference.empty())
+         {
+            seed = seed * 1103515245 + 12345;
+            int value = (int)((seed >> 8) % 100000);
+            queue.push(value);
+            reference.push(value);
+         }
+         else
+         {
+            same = queue.top() == reference.top();
+            queue.pop();
+            reference.pop();
+         }
+         same = same && queue.size() == reference.size();
+      }
+      while (same && !reference.empty())
+      {
+         same = queue.top() == reference.top();
+         queue.pop();
+         reference.pop();
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(queue.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
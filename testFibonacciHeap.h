@@ -0,0 +1,505 @@
+/***********************************************************************
+ * Header:
+ *    TEST FIBONACCI HEAP
+ * Summary:
+ *    Unit tests for the Fibonacci heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "fibonacci_heap.h"   // class under test
+#include "unitTest.h"         // unit test baseclass
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST FIBONACCI HEAP
+ * Unit tests for the fibonacci_heap class
+ ***********************************************/
+class TestFibonacciHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_top_empty();
+      test_value_stale();
+
+      // Insert
+      test_push_one();
+      test_push_rootList();
+
+      // Remove
+      test_pop_consolidate();
+      test_pop_sorted();
+      test_pop_reuseSlots();
+
+      // Decrease key
+      test_decreaseKey_root();
+      test_decreaseKey_cut();
+      test_decreaseKey_cascade();
+      test_decreaseKey_stale();
+      test_decreaseKey_raise();
+      test_decreaseKey_greater();
+      test_decreaseKey_random();
+      test_decreaseKey_dijkstra();
+
+      report("FibonacciHeap");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing in the slab
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::fibonacci_heap<int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.nodes.empty());
+      assertUnit(heap.minimum == custom::fibonacci_heap<int>::NIL);
+   }  // teardown
+
+   /***************************************
+    * ACCESS
+    ***************************************/
+
+   // no top in an empty heap
+   void test_top_empty()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   // a popped item's handle no longer reads
+   void test_value_stale()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      custom::fibonacci_heap<int>::handle h = heap.push(7);
+      assertUnit(heap.value(h) == 7);
+      heap.pop();
+      // exercise
+      bool thrown = false;
+      try
+      {
+         heap.value(h);
+      }
+      catch (const std::out_of_range &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(!heap.contains(h));
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // one node, its own circle
+   void test_push_one()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      // exercise
+      custom::fibonacci_heap<int>::handle h = heap.push(42);
+      // verify
+      assertUnit(h.slot == 0);
+      assertUnit(h.generation == 0);
+      assertUnit(heap.top() == 42);
+      assertUnit(heap.size() == 1);
+      assertUnit(heap.nodes[0].left == 0);
+      assertUnit(heap.nodes[0].right == 0);
+   }  // teardown
+
+   // pushes are lazy: every item is a root of degree 0
+   void test_push_rootList()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      // exercise
+      heap.push(5);
+      heap.push(2);
+      heap.push(8);
+      heap.push(3);
+      // verify
+      assertUnit(heap.top() == 2);
+      assertUnit(countRoots(heap) == 4);
+      bool flat = true;
+      for (size_t i = 0; i < heap.nodes.size(); i++)
+         flat = flat && heap.nodes[i].parent == heap.NIL && heap.nodes[i].degree == 0;
+      assertUnit(flat);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // removing one of five leaves a single tree of degree 2
+   void test_pop_consolidate()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      int values[] = { 3, 1, 4, 5, 2 };
+      for (int value : values)
+         heap.push(value);
+      // exercise
+      heap.pop();
+      // verify
+      //        2
+      //      3   4
+      //          5
+      assertUnit(heap.top() == 2);
+      assertUnit(heap.size() == 4);
+      assertUnit(countRoots(heap) == 1);
+      assertUnit(heap.nodes[heap.minimum].degree == 2);
+      assertUnit(isHeapOrdered(heap));
+   }  // teardown
+
+   // everything comes out smallest first
+   void test_pop_sorted()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      std::vector<int> values;
+      unsigned int seed = 13;
+      for (int i = 0; i < 500; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 1000));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end());
+      // exercise
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+   }  // teardown
+
+   // popped slots are recycled: the slab does not grow
+   void test_pop_reuseSlots()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      for (int i = 0; i < 100; i++)
+         heap.push(i);
+      while (!heap.empty())
+         heap.pop();
+      // exercise
+      custom::fibonacci_heap<int>::handle h = heap.push(7);
+      for (int i = 1; i < 100; i++)
+         heap.push(i);
+      // verify
+      assertUnit(heap.nodes.size() == 100);
+      assertUnit(h.generation == 1);
+      assertUnit(heap.freeSlots.empty());
+   }  // teardown
+
+   /***************************************
+    * DECREASE KEY
+    ***************************************/
+
+   // lowering a root only moves the minimum
+   void test_decreaseKey_root()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      heap.push(5);
+      custom::fibonacci_heap<int>::handle h = heap.push(9);
+      heap.push(7);
+      // exercise
+      bool found = heap.decrease_key(h, 1);
+      // verify
+      assertUnit(found);
+      assertUnit(heap.top() == 1);
+      assertUnit(heap.minimum == h.slot);
+      assertUnit(countRoots(heap) == 3);
+   }  // teardown
+
+   // a child that beats its parent moves to the root list
+   void test_decreaseKey_cut()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      custom::vector<custom::fibonacci_heap<int>::handle> handles;
+      for (int i = 0; i < 9; i++)
+         handles.push_back(heap.push(i * 10));
+      heap.pop();           // one tree of 8: 10 at the root
+      size_t child = NIL();
+      for (size_t i = 1; i < handles.size() && child == NIL(); i++)
+         if (heap.nodes[handles[i].slot].parent != heap.NIL &&
+             heap.nodes[heap.nodes[handles[i].slot].parent].parent != heap.NIL)
+            child = i;
+      assertUnit(child != NIL());
+      if (child == NIL())
+         return;
+      size_t parent = heap.nodes[handles[child].slot].parent;
+      size_t degree = heap.nodes[parent].degree;
+      // exercise
+      heap.decrease_key(handles[child], 5);
+      // verify
+      assertUnit(heap.nodes[handles[child].slot].parent == heap.NIL);
+      assertUnit(heap.nodes[parent].degree == degree - 1);
+      assertUnit(heap.nodes[parent].marked);
+      assertUnit(heap.top() == 5);
+      assertUnit(countRoots(heap) == 2);
+      assertUnit(isHeapOrdered(heap));
+   }  // teardown
+
+   // a marked parent that loses a second child is cut as well
+   void test_decreaseKey_cascade()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      custom::vector<custom::fibonacci_heap<int>::handle> handles;
+      for (int i = 0; i < 17; i++)
+         handles.push_back(heap.push(100 + i));
+      heap.pop();           // one tree of 16, a binomial tree of degree 4
+      // find a non-root with two children
+      size_t middle = NIL();
+      for (size_t slot = 0; slot < heap.nodes.size() && middle == NIL(); slot++)
+         if (heap.nodes[slot].active && heap.nodes[slot].parent != heap.NIL &&
+             heap.nodes[slot].degree >= 2)
+            middle = slot;
+      assertUnit(middle != NIL());
+      if (middle == NIL())
+         return;
+      size_t first = heap.nodes[middle].child;
+      size_t second = heap.nodes[first].right;
+      // exercise
+      heap.decrease_key(handleOf(heap, first), 1);
+      bool markedAfterOne = heap.nodes[middle].marked;
+      heap.decrease_key(handleOf(heap, second), 2);
+      // verify
+      assertUnit(markedAfterOne);
+      assertUnit(heap.nodes[middle].parent == heap.NIL);
+      assertUnit(!heap.nodes[middle].marked);
+      assertUnit(heap.top() == 1);
+      assertUnit(isHeapOrdered(heap));
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      assertUnit(output.size() == 16);
+      assertUnit(std::is_sorted(output.begin(), output.end()));
+   }  // teardown
+
+   // the handle of a popped item is refused
+   void test_decreaseKey_stale()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      custom::fibonacci_heap<int>::handle h = heap.push(3);
+      heap.pop();
+      heap.push(8);      // reuses the slot
+      // exercise
+      bool found = heap.decrease_key(h, 1);
+      // verify
+      assertUnit(!found);
+      assertUnit(heap.top() == 8);
+   }  // teardown
+
+   // the key can only go down
+   void test_decreaseKey_raise()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      custom::fibonacci_heap<int>::handle h = heap.push(3);
+      bool thrown = false;
+      // exercise
+      try
+      {
+         heap.decrease_key(h, 4);
+      }
+      catch (const std::invalid_argument &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(heap.top() == 3);
+   }  // teardown
+
+   // with greater<> the top is the largest and keys go up
+   void test_decreaseKey_greater()
+   {  // setup
+      custom::fibonacci_heap<int, std::greater<int>> heap;
+      heap.push(5);
+      custom::fibonacci_heap<int, std::greater<int>>::handle h = heap.push(2);
+      heap.push(9);
+      // exercise
+      heap.decrease_key(h, 20);
+      // verify
+      assertUnit(heap.top() == 20);
+      heap.pop();
+      assertUnit(heap.top() == 9);
+   }  // teardown
+
+   // a random mix of every operation agrees with a brute-force model
+   void test_decreaseKey_random()
+   {  // setup
+      custom::fibonacci_heap<int> heap;
+      std::vector<custom::fibonacci_heap<int>::handle> handles;
+      std::vector<int> model;          // the current key of each handle, -1 once popped
+      unsigned int seed = 99;
+      bool same = true;
+      // exercise
+      for (int step = 0; step < 5000 && same; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         unsigned int op = (seed >> 8) % 10;
+         seed = seed * 1103515245 + 12345;
+         int key = (int)((seed >> 8) % 100000);
+         if (op < 4 || heap.empty())
+         {
+            handles.push_back(heap.push(key));
+            model.push_back(key);
+         }
+         else if (op < 8)
+         {
+            size_t i = (size_t)key % handles.size();
+            if (model[i] >= 0)
+            {
+               int lower = model[i] - key % 1000;
+               if (lower < 0)
+                  lower = 0;
+               heap.decrease_key(handles[i], lower);
+               model[i] = lower;
+            }
+         }
+         else
+         {
+            int smallest = -1;
+            for (int value : model)
+               if (value >= 0 && (smallest < 0 || value < smallest))
+                  smallest = value;
+            same = heap.top() == smallest;
+            heap.pop();
+            for (size_t i = 0; i < model.size(); i++)
+               if (model[i] == smallest && !heap.contains(handles[i]))
+               {
+                  model[i] = -1;
+                  break;
+               }
+         }
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(isHeapOrdered(heap));
+   }  // teardown
+
+   // shortest paths on a small graph
+   void test_decreaseKey_dijkstra()
+   {  // setup
+      //   0 --4-- 1 --1-- 3
+      //   |      /|       |
+      //   1    2  5       1
+      //   |  /    |       |
+      //   2 --8-- 4 --3-- 5
+      struct Edge { size_t to; int weight; };
+      std::vector<std::vector<Edge>> graph(6);
+      auto connect = [&graph](size_t a, size_t b, int weight)
+      {
+         graph[a].push_back(Edge{ b, weight });
+         graph[b].push_back(Edge{ a, weight });
+      };
+      connect(0, 1, 4);
+      connect(0, 2, 1);
+      connect(1, 2, 2);
+      connect(1, 3, 1);
+      connect(1, 4, 5);
+      connect(2, 4, 8);
+      connect(3, 5, 1);
+      connect(4, 5, 3);
+      typedef std::pair<int, size_t> item;   // {distance, vertex}
+      custom::fibonacci_heap<item> heap;
+      std::vector<custom::fibonacci_heap<item>::handle> handles(6);
+      std::vector<int> distance(6, 1 << 30);
+      distance[0] = 0;
+      for (size_t v = 0; v < 6; v++)
+         handles[v] = heap.push(item(distance[v], v));
+      // exercise
+      while (!heap.empty())
+      {
+         size_t u = heap.top().second;
+         heap.pop();
+         for (const Edge & edge : graph[u])
+            if (distance[u] + edge.weight < distance[edge.to])
+            {
+               distance[edge.to] = distance[u] + edge.weight;
+               heap.decrease_key(handles[edge.to], item(distance[edge.to], edge.to));
+            }
+      }
+      // verify
+      assertUnit(distance == std::vector<int>({ 0, 3, 1, 4, 8, 5 }));
+   }  // teardown
+
+private:
+   static size_t NIL() { return custom::fibonacci_heap<int>::NIL; }
+
+   template <class T, class C>
+   static size_t countRoots(const custom::fibonacci_heap<T, C> & heap)
+   {
+      if (heap.minimum == heap.NIL)
+         return 0;
+      size_t count = 0;
+      size_t root = heap.minimum;
+      do
+      {
+         count++;
+         root = heap.nodes[root].right;
+      }
+      while (root != heap.minimum);
+      return count;
+   }
+
+   // every child no less than its parent, and the minimum is a smallest root
+   template <class T, class C>
+   static bool isHeapOrdered(const custom::fibonacci_heap<T, C> & heap)
+   {
+      for (size_t slot = 0; slot < heap.nodes.size(); slot++)
+      {
+         if (!heap.nodes[slot].active)
+            continue;
+         size_t parent = heap.nodes[slot].parent;
+         if (parent != heap.NIL && heap.nodes[slot].value < heap.nodes[parent].value)
+            return false;
+         if (parent == heap.NIL && heap.nodes[slot].value < heap.nodes[heap.minimum].value)
+            return false;
+      }
+      return true;
+   }
+
+   template <class T, class C>
+   static typename custom::fibonacci_heap<T, C>::handle
+   handleOf(const custom::fibonacci_heap<T, C> & heap, size_t slot)
+   {
+      return typename custom::fibonacci_heap<T, C>::handle{ slot, heap.nodes[slot].generation };
+   }
+};
+
+#endif // DEBUG
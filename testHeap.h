@@ -0,0 +1,362 @@
+/***********************************************************************
+ * Header:
+ *    TEST HEAP
+ * Summary:
+ *    Unit tests for the free heap algorithms
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "heap.h"             // functions under test
+#include "priority_queue.h"   // shares the kernels
+#include "vector.h"
+#include "unitTest.h"         // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/***********************************************
+ * TEST HEAP
+ * Unit tests for make_heap, push_heap, append_heap,
+ * pop_heap, sort_heap and partial_sort
+ ***********************************************/
+class TestHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Iterator
+      test_iterator_randomAccess();
+
+      // Make
+      test_makeHeap_empty();
+      test_makeHeap_twoLevels();
+      test_makeHeap_greater();
+
+      // Push and Pop
+      test_pushHeap_standard();
+      test_pushHeap_matchesQueue();
+      test_popHeap_standard();
+      test_popHeap_one();
+      test_appendHeap_few();
+      test_appendHeap_many();
+
+      // Sort
+      test_sortHeap_standard();
+      test_sortHeap_inPlace();
+      test_partialSort_standard();
+      test_partialSort_none();
+      test_partialSort_greater();
+      test_partialSort_random();
+
+      report("Heap");
+   }
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // custom::vector iterators jump, subtract, and order
+   void test_iterator_randomAccess()
+   {  // setup
+      custom::vector<int> v{ 10, 20, 30, 40, 50 };
+      custom::vector<int>::iterator first = v.begin();
+      // exercise
+      custom::vector<int>::iterator third = first + 2;
+      custom::vector<int>::iterator last = v.end();
+      // verify
+      assertUnit(*third == 30);
+      assertUnit(first[4] == 50);
+      assertUnit(last - first == 5);
+      assertUnit(last - 1 == first + 4);
+      assertUnit(first < third);
+      assertUnit(third >= first);
+      third -= 2;
+      assertUnit(third == first);
+   }  // teardown
+
+   /***************************************
+    * MAKE HEAP
+    ***************************************/
+
+   // nothing to do
+   void test_makeHeap_empty()
+   {  // setup
+      custom::vector<Spy> v;
+      Spy::reset();
+      // exercise
+      custom::make_heap(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numSwap() == 0);
+   }  // teardown
+
+   // the same work priority_queue does when it heapifies
+   void test_makeHeap_twoLevels()
+   {  // setup
+      //   v = [1, 2, 3, 4, 5, 6, 7]
+      custom::vector<Spy> v{ Spy(1), Spy(2), Spy(3), Spy(4), Spy(5), Spy(6), Spy(7) };
+      Spy::reset();
+      // exercise
+      custom::make_heap(v.begin(), v.end());
+      // verify
+      //             7
+      //          5      6
+      //         4 2    1 3
+      assertUnit(Spy::numLessthan() == 8); // compare[6<7][3<7][4<5][2<5][5<7][1<7][6<3][1<6]
+      assertUnit(Spy::numSwap() == 4);     // swap(3,7)(2,5)(1,7)(1,6)
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      int expected[] = { 7, 5, 6, 4, 2, 1, 3 };
+      for (int i = 0; i < 7; i++)
+         assertUnit(v[i].get() == expected[i]);
+   }  // teardown
+
+   // greater<> makes a min-heap
+   void test_makeHeap_greater()
+   {  // setup
+      std::vector<int> v{ 5, 9, 2, 7, 1, 8 };
+      // exercise
+      custom::make_heap(v.begin(), v.end(), std::greater<int>());
+      // verify
+      assertUnit(v[0] == 1);
+      assertUnit(std::is_heap(v.begin(), v.end(), std::greater<int>()));
+   }  // teardown
+
+   /***************************************
+    * PUSH HEAP and POP HEAP
+    ***************************************/
+
+   // the last item climbs to where it belongs
+   void test_pushHeap_standard()
+   {  // setup
+      //             7                      9
+      //          5      6      ->      5       7
+      //         4 2    9              4 2     6
+      custom::vector<int> v{ 7, 5, 6, 4, 2 };
+      v.push_back(9);
+      // exercise
+      custom::push_heap(v.begin(), v.end());
+      // verify
+      int expected[] = { 9, 5, 7, 4, 2, 6 };
+      for (int i = 0; i < 6; i++)
+         assertUnit(v[i] == expected[i]);
+   }  // teardown
+
+   // push_heap and pop_heap keep step with priority_queue
+   void test_pushHeap_matchesQueue()
+   {  // setup
+      int values[] = { 4, 8, 1, 9, 3, 9, 7, 2, 6, 5 };
+      custom::priority_queue<int> pq;
+      std::vector<int> v;
+      bool same = true;
+      // exercise
+      for (int value : values)
+      {
+         pq.push(value);
+         v.push_back(value);
+         custom::push_heap(v.begin(), v.end());
+         same = same && pq.top() == v.front();
+      }
+      while (same && !v.empty())
+      {
+         custom::pop_heap(v.begin(), v.end());
+         same = pq.top() == v.back();
+         pq.pop();
+         v.pop_back();
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(pq.empty());
+   }  // teardown
+
+   // the top goes to the back; the rest is still a heap
+   void test_popHeap_standard()
+   {  // setup
+      custom::vector<Spy> v{ Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5) };
+      Spy::reset();
+      // exercise
+      custom::pop_heap(v.begin(), v.end());
+      // verify
+      assertUnit(v[6].get() == 10);
+      assertUnit(v[0].get() == 9);
+      assertUnit(std::is_heap(v.begin(), v.end() - 1));
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+   }  // teardown
+
+   // one item is already popped
+   void test_popHeap_one()
+   {  // setup
+      custom::vector<Spy> v{ Spy(10) };
+      Spy::reset();
+      // exercise
+      custom::pop_heap(v.begin(), v.end());
+      // verify
+      assertUnit(v[0].get() == 10);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+   }  // teardown
+
+   // a few new items on a big heap only touch their ancestors
+   void test_appendHeap_few()
+   {  // setup
+      std::vector<int> v;
+      for (int i = 0; i < 1000; i++)
+         v.push_back((i * 7919) % 1009);
+      std::make_heap(v.begin(), v.end());
+      for (int value : { 2000, -5, 500 })
+         v.push_back(value);
+      std::vector<int> expected = v;
+      std::sort(expected.begin(), expected.end());
+      int numCompares = 0;
+      // exercise
+      custom::append_heap(v.begin(), v.begin() + 1000, v.end(),
+                          [&numCompares](int lhs, int rhs) { numCompares++; return lhs < rhs; });
+      // verify
+      //    three pushes would cost about 3 * 2 * 10; make_heap, about 2000
+      assertUnit(std::is_heap(v.begin(), v.end()));
+      assertUnit(v.front() == 2000);
+      assertUnit(numCompares < 100);
+      std::sort(v.begin(), v.end());
+      assertUnit(v == expected);
+   }  // teardown
+
+   // more new items than old, at every split of a small heap
+   void test_appendHeap_many()
+   {  // setup
+      bool heaps = true;
+      bool kept = true;
+      for (size_t split = 0; split <= 40; split++)
+      {
+         std::vector<int> v;
+         for (int i = 0; i < 40; i++)
+            v.push_back((i * 37) % 41);
+         std::make_heap(v.begin(), v.begin() + split);
+         std::vector<int> expected = v;
+         std::sort(expected.begin(), expected.end());
+         // exercise
+         custom::append_heap(v.begin(), v.begin() + split, v.end());
+         // verify
+         heaps = heaps && std::is_heap(v.begin(), v.end());
+         std::sort(v.begin(), v.end());
+         kept = kept && v == expected;
+      }
+      assertUnit(heaps);
+      assertUnit(kept);
+   }  // teardown
+
+   /***************************************
+    * SORT HEAP and PARTIAL SORT
+    ***************************************/
+
+   // a heap comes out ascending
+   void test_sortHeap_standard()
+   {  // setup
+      custom::vector<int> v{ 10, 8, 9, 4, 3, 7, 5 };
+      // exercise
+      custom::sort_heap(v.begin(), v.end());
+      // verify
+      int expected[] = { 3, 4, 5, 7, 8, 9, 10 };
+      for (int i = 0; i < 7; i++)
+         assertUnit(v[i] == expected[i]);
+   }  // teardown
+
+   // heap-sort a vector we own: no allocation, no copies
+   void test_sortHeap_inPlace()
+   {  // setup
+      custom::vector<Spy> v;
+      unsigned int seed = 71;
+      for (int i = 0; i < 200; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         v.push_back(Spy((int)((seed >> 8) % 1000)));
+      }
+      Spy::reset();
+      // exercise
+      custom::make_heap(v.begin(), v.end());
+      custom::sort_heap(v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      bool sorted = true;
+      for (size_t i = 1; i < v.size(); i++)
+         sorted = sorted && !(v[i].get() < v[i - 1].get());
+      assertUnit(sorted);
+   }  // teardown
+
+   // the three smallest, in order, at the front
+   void test_partialSort_standard()
+   {  // setup
+      custom::vector<int> v{ 9, 4, 7, 1, 8, 2, 6, 3 };
+      // exercise
+      custom::partial_sort(v.begin(), v.begin() + 3, v.end());
+      // verify
+      assertUnit(v[0] == 1);
+      assertUnit(v[1] == 2);
+      assertUnit(v[2] == 3);
+      bool rest = true;
+      for (size_t i = 3; i < v.size(); i++)
+         rest = rest && v[i] > 3;
+      assertUnit(rest);
+   }  // teardown
+
+   // an empty front touches nothing
+   void test_partialSort_none()
+   {  // setup
+      custom::vector<Spy> v{ Spy(3), Spy(1), Spy(2) };
+      Spy::reset();
+      // exercise
+      custom::partial_sort(v.begin(), v.begin(), v.end());
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(v[0].get() == 3);
+   }  // teardown
+
+   // greater<> gives the largest, descending
+   void test_partialSort_greater()
+   {  // setup
+      int v[] = { 9, 4, 7, 1, 8, 2, 6, 3 };
+      // exercise
+      custom::partial_sort(v, v + 2, v + 8, std::greater<int>());
+      // verify
+      assertUnit(v[0] == 9);
+      assertUnit(v[1] == 8);
+   }  // teardown
+
+   // every prefix length agrees with sorting everything
+   void test_partialSort_random()
+   {  // setup
+      std::vector<int> values;
+      unsigned int seed = 3;
+      for (int i = 0; i < 150; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 100));
+      }
+      std::vector<int> sorted(values);
+      std::sort(sorted.begin(), sorted.end());
+      bool same = true;
+      // exercise
+      for (size_t m = 0; m <= values.size() && same; m += 7)
+      {
+         std::vector<int> v(values);
+         custom::partial_sort(v.begin(), v.begin() + m, v.end());
+         // verify
+         same = std::equal(v.begin(), v.begin() + m, sorted.begin());
+      }
+      assertUnit(same);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,259 @@
+/***********************************************************************
+ * Header:
+ *    TEST HEAP TIMER
+ * Summary:
+ *    Unit tests for the heap timer
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "heap_timer.h"   // class under test
+#include "unitTest.h"     // unit test baseclass
+
+#include <chrono>
+#include <vector>
+
+#undef assertHeap
+#define assertHeap(x) assertHeapParameters(x, __LINE__, __FUNCTION__)
+
+/***********************************************
+ * TEST HEAP TIMER
+ * Unit tests for the heap_timer class
+ ***********************************************/
+class TestHeapTimer : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Insert
+      test_schedule_empty();
+      test_schedule_earlier();
+      test_schedule_later();
+
+      // Remove
+      test_cancel_root();
+      test_cancel_middle();
+      test_cancel_stale();
+      test_cancel_compacts();
+      test_expire_nothingDue();
+      test_expire_someDue();
+      test_expire_reschedule();
+
+      report("HeapTimer");
+   }
+
+   /***************************************
+    * SCHEDULE
+    ***************************************/
+
+   // the first timer becomes the earliest
+   void test_schedule_empty()
+   {  // setup
+      custom::heap_timer timer;
+      // exercise
+      custom::heap_timer::handle h = timer.schedule(at(50), []() {});
+      // verify
+      assertUnit(timer.size() == 1);
+      assertUnit(timer.earliest() == at(50));
+      assertUnit(h.slot == 0);
+      assertUnit(h.generation == 0);
+      assertHeap(timer);
+   }  // teardown
+
+   // an earlier timer percolates to the root
+   void test_schedule_earlier()
+   {  // setup
+      custom::heap_timer timer;
+      timer.schedule(at(50), []() {});
+      timer.schedule(at(40), []() {});
+      timer.schedule(at(30), []() {});
+      // exercise
+      timer.schedule(at(10), []() {});
+      // verify
+      assertUnit(timer.size() == 4);
+      assertUnit(timer.earliest() == at(10));
+      assertHeap(timer);
+   }  // teardown
+
+   // a later timer stays below the root
+   void test_schedule_later()
+   {  // setup
+      custom::heap_timer timer;
+      timer.schedule(at(10), []() {});
+      timer.schedule(at(20), []() {});
+      // exercise
+      timer.schedule(at(90), []() {});
+      // verify
+      assertUnit(timer.size() == 3);
+      assertUnit(timer.earliest() == at(10));
+      assertUnit(timer.heap.data()[2].deadline == at(90));
+      assertHeap(timer);
+   }  // teardown
+
+   /***************************************
+    * CANCEL
+    ***************************************/
+
+   // cancel the earliest timer
+   void test_cancel_root()
+   {  // setup
+      custom::heap_timer timer;
+      custom::heap_timer::handle h = timer.schedule(at(10), []() {});
+      timer.schedule(at(30), []() {});
+      timer.schedule(at(20), []() {});
+      // exercise
+      bool returnValue = timer.cancel(h);
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(timer.size() == 2);
+      assertUnit(timer.earliest() == at(20));
+      assertHeap(timer);
+   }  // teardown
+
+   // cancel from the middle of a larger heap
+   void test_cancel_middle()
+   {  // setup
+      custom::heap_timer timer;
+      std::vector<custom::heap_timer::handle> handles;
+      for (int i = 0; i < 20; i++)
+         handles.push_back(timer.schedule(at((i * 7) % 20), []() {}));
+      // exercise
+      bool returnValue = true;
+      for (int i = 0; i < 20; i += 3)
+         returnValue = timer.cancel(handles[i]) && returnValue;
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(timer.size() == 13);
+      assertHeap(timer);
+   }  // teardown
+
+   // a handle is no good once its timer is gone, even if the slot is reused
+   void test_cancel_stale()
+   {  // setup
+      custom::heap_timer timer;
+      custom::heap_timer::handle h = timer.schedule(at(10), []() {});
+      timer.cancel(h);
+      custom::heap_timer::handle reused = timer.schedule(at(20), []() {});
+      // exercise
+      bool returnValue = timer.cancel(h);
+      // verify
+      assertUnit(returnValue == false);
+      assertUnit(reused.slot == h.slot);
+      assertUnit(timer.size() == 1);
+   }  // teardown
+
+   // once most entries are cancelled the heap is rebuilt from the live ones
+   void test_cancel_compacts()
+   {  // setup
+      custom::heap_timer timer;
+      std::vector<custom::heap_timer::handle> handles;
+      for (int i = 0; i < 100; i++)
+         handles.push_back(timer.schedule(at(i), []() {}));
+      // exercise
+      for (int i = 1; i < 100; i += 2)
+         timer.cancel(handles[i]);
+      for (int i = 2; i < 100; i += 4)
+         timer.cancel(handles[i]);
+      // verify
+      assertUnit(timer.size() == 25);
+      assertUnit(timer.heap.size() <= 2 * timer.size());
+      assertUnit(timer.earliest() == at(0));
+      assertHeap(timer);
+   }  // teardown
+
+   /***************************************
+    * EXPIRE
+    ***************************************/
+
+   // nothing fires before its deadline
+   void test_expire_nothingDue()
+   {  // setup
+      custom::heap_timer timer;
+      int numCalls = 0;
+      timer.schedule(at(10), [&]() { numCalls++; });
+      // exercise
+      size_t numFired = timer.expire(at(9));
+      // verify
+      assertUnit(numFired == 0);
+      assertUnit(numCalls == 0);
+      assertUnit(timer.size() == 1);
+   }  // teardown
+
+   // everything due fires in deadline order, the rest stays
+   void test_expire_someDue()
+   {  // setup
+      custom::heap_timer timer;
+      std::vector<int> fired;
+      for (int i : { 40, 10, 30, 20, 50 })
+         timer.schedule(at(i), [&fired, i]() { fired.push_back(i); });
+      // exercise
+      size_t numFired = timer.expire(at(30));
+      // verify
+      assertUnit(numFired == 3);
+      assertUnit(fired.size() == 3);
+      if (fired.size() == 3)
+      {
+         assertUnit(fired[0] == 10);
+         assertUnit(fired[1] == 20);
+         assertUnit(fired[2] == 30);
+      }
+      assertUnit(timer.size() == 2);
+      assertUnit(timer.earliest() == at(40));
+      assertHeap(timer);
+   }  // teardown
+
+   // a callback may schedule a new timer; it waits for the next expire
+   void test_expire_reschedule()
+   {  // setup
+      custom::heap_timer timer;
+      int numCalls = 0;
+      timer.schedule(at(10), [&]()
+      {
+         numCalls++;
+         timer.schedule(at(5), [&]() { numCalls++; });
+      });
+      // exercise
+      size_t numFired = timer.expire(at(10));
+      // verify
+      assertUnit(numFired == 1);
+      assertUnit(numCalls == 1);
+      assertUnit(timer.size() == 1);
+      // teardown
+      timer.expire(at(10));
+      assertUnit(numCalls == 2);
+   }
+
+private:
+   // a fixed point in time, ms milliseconds after the epoch
+   static custom::heap_timer::clock::time_point at(int ms)
+   {
+      return custom::heap_timer::clock::time_point(std::chrono::milliseconds(ms));
+   }
+
+   // every parent is due no later than its children, the top is live,
+   // and every live timer has exactly one entry
+   void assertHeapParameters(const custom::heap_timer & timer, int line, const char * function)
+   {
+      const custom::vector<custom::heap_timer::Entry> & heap = timer.heap.data();
+      for (size_t i = 1; i < heap.size(); i++)
+         assertIndirect(!(heap[i].deadline < heap[(i - 1) / 2].deadline));
+      if (!heap.empty())
+         assertIndirect(!timer.isStale(heap[0]));
+      size_t numLive = 0;
+      for (size_t i = 0; i < heap.size(); i++)
+         if (!timer.isStale(heap[i]))
+         {
+            assertIndirect(timer.slots[heap[i].slot].active);
+            numLive++;
+         }
+      assertIndirect(numLive == timer.size());
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,292 @@
+/***********************************************************************
+ * Header:
+ *    TEST K-WAY MERGE
+ * Summary:
+ *    Unit tests for the loser-tree k-way merge
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "kway_merge.h"   // class under test
+#include "unitTest.h"     // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/***********************************************
+ * TEST K-WAY MERGE
+ * Unit tests for the kway_merge class
+ ***********************************************/
+class TestKwayMerge : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_noRuns();
+      test_construct_emptyRuns();
+      test_construct_standard();
+
+      // Access
+      test_top_empty();
+      test_pop_oneRun();
+
+      // Merge
+      test_merge_standard();
+      test_merge_oddRuns();
+      test_merge_stable();
+      test_merge_greater();
+      test_merge_comparisons();
+      test_merge_random();
+
+      // Iterator
+      test_iterator_lazy();
+      test_iterator_postfix();
+
+      report("KwayMerge");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // no runs at all: empty from the start
+   void test_construct_noRuns()
+   {  // setup
+      custom::vector<std::pair<const int *, const int *>> runs;
+      // exercise
+      custom::kway_merge<const int *> merge(runs);
+      // verify
+      assertUnit(merge.empty());
+      assertUnit(merge.begin() == merge.end());
+   }  // teardown
+
+   // runs that are all empty
+   void test_construct_emptyRuns()
+   {  // setup
+      int dummy[1] = { 0 };
+      // exercise
+      custom::kway_merge<const int *> merge({ { dummy, dummy }, { dummy, dummy }, { dummy, dummy } });
+      // verify
+      assertUnit(merge.empty());
+   }  // teardown
+
+   // the first tournament finds the smallest head and keeps the losers
+   void test_construct_standard()
+   {  // setup
+      //  runs:  0:[4]  1:[2]  2:[7]  3:[5]
+      //                 (1)              winner
+      //                 [3]              5 lost to 2
+      //           [0]         [2]        4 lost to 2, 7 lost to 5
+      //          4   2       7   5
+      int a[] = { 4 }, b[] = { 2 }, c[] = { 7 }, d[] = { 5 };
+      // exercise
+      custom::kway_merge<const int *> merge({ { a, a + 1 }, { b, b + 1 }, { c, c + 1 }, { d, d + 1 } });
+      // verify
+      assertUnit(merge.tree.size() == 4);
+      if (merge.tree.size() == 4)
+      {
+         assertUnit(merge.tree[0] == 1);   // run of 2
+         assertUnit(merge.tree[1] == 3);   // run of 5 lost at the root
+         assertUnit(merge.tree[2] == 0);   // run of 4 lost to 2
+         assertUnit(merge.tree[3] == 2);   // run of 7 lost to 5
+      }
+      assertUnit(merge.top() == 2);
+   }  // teardown
+
+   /***************************************
+    * TOP and POP
+    ***************************************/
+
+   // nothing left to look at
+   void test_top_empty()
+   {  // setup
+      int dummy[1] = { 0 };
+      custom::kway_merge<const int *> merge({ { dummy, dummy } });
+      // exercise
+      try
+      {
+         merge.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   // a single run comes out as it is
+   void test_pop_oneRun()
+   {  // setup
+      int a[] = { 1, 3, 5 };
+      custom::kway_merge<const int *> merge({ { a, a + 3 } });
+      // exercise
+      std::vector<int> output;
+      while (!merge.empty())
+      {
+         output.push_back(merge.top());
+         merge.pop();
+      }
+      // verify
+      assertUnit(output == std::vector<int>({ 1, 3, 5 }));
+   }  // teardown
+
+   /***************************************
+    * MERGE
+    ***************************************/
+
+   // four runs of different lengths
+   void test_merge_standard()
+   {  // setup
+      int a[] = { 1, 5, 9 }, b[] = { 2, 6 }, c[] = { 3 }, d[] = { 0, 4, 7, 8 };
+      custom::kway_merge<const int *> merge({ { a, a + 3 }, { b, b + 2 }, { c, c + 1 }, { d, d + 4 } });
+      // exercise
+      std::vector<int> output(merge.begin(), merge.end());
+      // verify
+      assertUnit(output == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+      assertUnit(merge.empty());
+   }  // teardown
+
+   // k that is not a power of two, and one run empty
+   void test_merge_oddRuns()
+   {  // setup
+      int a[] = { 10, 40 }, b[] = { 20 }, c[] = { 0 }, d[] = { 5, 30, 50 }, e[] = { 25 };
+      custom::kway_merge<const int *> merge({ { a, a + 2 }, { b, b + 1 }, { c, c }, { d, d + 3 }, { e, e + 1 } });
+      // exercise
+      std::vector<int> output(merge.begin(), merge.end());
+      // verify
+      assertUnit(output == std::vector<int>({ 5, 10, 20, 25, 30, 40, 50 }));
+   }  // teardown
+
+   // equal keys come out in run order
+   void test_merge_stable()
+   {  // setup
+      typedef std::pair<int, char> item;
+      item a[] = { { 1, 'a' }, { 2, 'a' } };
+      item b[] = { { 1, 'b' }, { 2, 'b' } };
+      item c[] = { { 1, 'c' } };
+      auto byKey = [](const item & lhs, const item & rhs) { return lhs.first < rhs.first; };
+      custom::kway_merge<const item *, decltype(byKey)> merge(
+         { { c, c + 1 }, { a, a + 2 }, { b, b + 2 } }, byKey);
+      // exercise
+      std::string order;
+      for (custom::kway_merge<const item *, decltype(byKey)>::iterator it = merge.begin(); it != merge.end(); ++it)
+         order += it->second;
+      // verify
+      assertUnit(order == "cabab");
+   }  // teardown
+
+   // descending runs with greater<>
+   void test_merge_greater()
+   {  // setup
+      std::vector<int> a { 9, 4, 1 }, b { 8, 8, 2 };
+      custom::kway_merge<std::vector<int>::const_iterator, std::greater<int>> merge(
+         { { a.cbegin(), a.cend() }, { b.cbegin(), b.cend() } });
+      // exercise
+      std::vector<int> output(merge.begin(), merge.end());
+      // verify
+      assertUnit(output == std::vector<int>({ 9, 8, 8, 4, 2, 1 }));
+   }  // teardown
+
+   // with 8 live runs every element costs exactly 3 comparisons
+   void test_merge_comparisons()
+   {  // setup
+      std::vector<std::vector<Spy>> runs(8);
+      for (int i = 0; i < 8; i++)
+         for (int j = 0; j < 4; j++)
+            runs[i].push_back(Spy(j * 8 + i));
+      custom::vector<std::pair<const Spy *, const Spy *>> ranges;
+      for (int i = 0; i < 8; i++)
+         ranges.push_back(std::make_pair(runs[i].data(), runs[i].data() + 4));
+      custom::kway_merge<const Spy *> merge(ranges);
+      Spy::reset();
+      // exercise: the first 24 elements come out before any run is dry
+      for (int i = 0; i < 24; i++)
+         merge.pop();
+      // verify
+      assertUnit(Spy::numLessthan() == 24 * 3);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(merge.top() == Spy(24));
+   }  // teardown
+
+   // hundreds of random runs agree with sorting everything
+   void test_merge_random()
+   {  // setup
+      std::vector<std::vector<int>> runs(300);
+      std::vector<int> everything;
+      unsigned int seed = 37;
+      for (std::vector<int> & run : runs)
+      {
+         seed = seed * 1103515245 + 12345;
+         size_t length = (seed >> 8) % 50;
+         for (size_t j = 0; j < length; j++)
+         {
+            seed = seed * 1103515245 + 12345;
+            run.push_back((int)((seed >> 8) % 10000));
+         }
+         std::sort(run.begin(), run.end());
+         everything.insert(everything.end(), run.begin(), run.end());
+      }
+      std::sort(everything.begin(), everything.end());
+      custom::vector<std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>> ranges;
+      for (const std::vector<int> & run : runs)
+         ranges.push_back(std::make_pair(run.cbegin(), run.cend()));
+      // exercise
+      custom::kway_merge<std::vector<int>::const_iterator> merge(ranges);
+      std::vector<int> output(merge.begin(), merge.end());
+      // verify
+      assertUnit(output == everything);
+   }  // teardown
+
+   /***************************************
+    * ITERATOR
+    ***************************************/
+
+   // the merge reads the runs in place: no output buffer
+   void test_iterator_lazy()
+   {  // setup
+      std::vector<Spy> a { Spy(1), Spy(4) }, b { Spy(2), Spy(3) };
+      custom::kway_merge<const Spy *> merge({ { a.data(), a.data() + 2 }, { b.data(), b.data() + 2 } });
+      Spy::reset();
+      // exercise
+      custom::kway_merge<const Spy *>::iterator it = merge.begin();
+      const Spy & first = *it;
+      ++it;
+      const Spy & second = *it;
+      // verify
+      assertUnit(&first == &a[0]);
+      assertUnit(&second == &b[0]);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+   }  // teardown
+
+   // *it++ sees the element it stepped over
+   void test_iterator_postfix()
+   {  // setup
+      int a[] = { 1, 3 }, b[] = { 2 };
+      custom::kway_merge<const int *> merge({ { a, a + 2 }, { b, b + 1 } });
+      custom::kway_merge<const int *>::iterator it = merge.begin();
+      // exercise
+      int first = *it++;
+      int second = *it++;
+      // verify
+      assertUnit(first == 1);
+      assertUnit(second == 2);
+      assertUnit(*it == 3);
+   }  // teardown
+};
+
+#endif // DEBUG
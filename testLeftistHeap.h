@@ -0,0 +1,444 @@
+/***********************************************************************
+ * Header:
+ *    TEST LEFTIST HEAP
+ * Summary:
+ *    Unit tests for the meldable leftist heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "leftist_heap.h"   // class under test
+#include "unitTest.h"       // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST LEFTIST HEAP
+ * Unit tests for the leftist_heap class
+ ***********************************************/
+class TestLeftistHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_sharedPool();
+      test_constructCopy_standard();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_standard();
+      test_push_shape();
+
+      // Remove
+      test_pop_sorted();
+      test_pop_reuseSlots();
+      test_clear_returnsNodes();
+
+      // Meld
+      test_meld_empty();
+      test_meld_self();
+      test_meld_sharedPool();
+      test_meld_comparisons();
+      test_meld_otherPool();
+      test_meld_greater();
+      test_meld_random();
+
+      report("LeftistHeap");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a heap with a pool of its own and nothing in it
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::leftist_heap<int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.nodes != nullptr);
+      assertUnit(heap.nodes->capacity() == 0);
+      assertUnit(heap.root == custom::leftist_heap<int>::NIL);
+   }  // teardown
+
+   // two heaps on one pool draw from the same slab
+   void test_construct_sharedPool()
+   {  // setup
+      std::shared_ptr<custom::leftist_heap<int>::pool> nodes =
+         std::make_shared<custom::leftist_heap<int>::pool>();
+      // exercise
+      custom::leftist_heap<int> a(nodes);
+      custom::leftist_heap<int> b(nodes);
+      a.push(1);
+      b.push(2);
+      // verify
+      assertUnit(a.get_pool() == b.get_pool());
+      assertUnit(nodes->capacity() == 2);
+      assertUnit(a.top() == 1);
+      assertUnit(b.top() == 2);
+   }  // teardown
+
+   // a copy is a separate tree in the same pool
+   void test_constructCopy_standard()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      heap.push(3);
+      heap.push(9);
+      heap.push(5);
+      // exercise
+      custom::leftist_heap<int> copy(heap);
+      copy.pop();
+      // verify
+      assertUnit(heap.size() == 3);
+      assertUnit(heap.top() == 9);
+      assertUnit(copy.size() == 2);
+      assertUnit(copy.top() == 5);
+      assertUnit(copy.get_pool() == heap.get_pool());
+      assertUnit(isLeftist(copy));
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty heap
+   void test_top_empty()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // the largest is on top
+   void test_push_standard()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      // exercise
+      heap.push(4);
+      heap.push(8);
+      heap.push(6);
+      // verify
+      assertUnit(heap.top() == 8);
+      assertUnit(heap.size() == 3);
+   }  // teardown
+
+   // ascending pushes each become the new root with the old tree on the left
+   void test_push_shape()
+   {  // setup
+      //     3         rank 1
+      //    /
+      //   2           rank 1
+      //  /
+      // 1
+      custom::leftist_heap<int> heap;
+      // exercise
+      heap.push(1);
+      heap.push(2);
+      heap.push(3);
+      // verify
+      const auto & slots = heap.nodes->slots;
+      assertUnit(slots[heap.root].value == 3);
+      assertUnit(slots[heap.root].right == heap.NIL);
+      assertUnit(slots[heap.root].rank == 1);
+      size_t left = slots[heap.root].left;
+      assertUnit(left != heap.NIL && slots[left].value == 2);
+      assertUnit(isLeftist(heap));
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // everything comes out largest first
+   void test_pop_sorted()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      std::vector<int> values;
+      unsigned int seed = 21;
+      for (int i = 0; i < 500; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 1000));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<int>());
+      assertUnit(isLeftist(heap));
+      // exercise
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+   }  // teardown
+
+   // popped nodes go back to the pool and are used again
+   void test_pop_reuseSlots()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      for (int i = 0; i < 50; i++)
+         heap.push(i);
+      for (int i = 0; i < 20; i++)
+         heap.pop();
+      assertUnit(heap.nodes->available() == 20);
+      // exercise
+      for (int i = 0; i < 20; i++)
+         heap.push(i);
+      // verify
+      assertUnit(heap.nodes->capacity() == 50);
+      assertUnit(heap.nodes->available() == 0);
+   }  // teardown
+
+   // a heap on a shared pool hands its nodes back when it goes
+   void test_clear_returnsNodes()
+   {  // setup
+      std::shared_ptr<custom::leftist_heap<int>::pool> nodes =
+         std::make_shared<custom::leftist_heap<int>::pool>();
+      {
+         custom::leftist_heap<int> heap(nodes);
+         for (int i = 0; i < 10; i++)
+            heap.push(i);
+         // exercise
+      }
+      // verify
+      assertUnit(nodes->capacity() == 10);
+      assertUnit(nodes->available() == 10);
+   }  // teardown
+
+   /***************************************
+    * MELD
+    ***************************************/
+
+   // melding nothing changes nothing, either way round
+   void test_meld_empty()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      custom::leftist_heap<int> empty(heap.get_pool());
+      heap.push(5);
+      // exercise
+      heap.meld(empty);
+      empty.meld(heap);
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(empty.size() == 1);
+      assertUnit(empty.top() == 5);
+   }  // teardown
+
+   // a heap melded with itself is left alone
+   void test_meld_self()
+   {  // setup
+      custom::leftist_heap<int> heap;
+      heap.push(1);
+      heap.push(2);
+      // exercise
+      heap.meld(heap);
+      // verify
+      assertUnit(heap.size() == 2);
+      assertUnit(heap.top() == 2);
+   }  // teardown
+
+   // two heaps on one pool meld in place
+   void test_meld_sharedPool()
+   {  // setup
+      custom::leftist_heap<int> a;
+      custom::leftist_heap<int> b(a.get_pool());
+      int odd[] = { 1, 3, 5, 7, 9 };
+      int even[] = { 2, 4, 6, 8 };
+      for (int value : odd)
+         a.push(value);
+      for (int value : even)
+         b.push(value);
+      size_t capacity = a.nodes->capacity();
+      // exercise
+      a.meld(b);
+      // verify
+      assertUnit(b.empty());
+      assertUnit(a.size() == 9);
+      assertUnit(a.nodes->capacity() == capacity);
+      assertUnit(isLeftist(a));
+      std::vector<int> output;
+      while (!a.empty())
+      {
+         output.push_back(a.top());
+         a.pop();
+      }
+      assertUnit(output == std::vector<int>({ 9, 8, 7, 6, 5, 4, 3, 2, 1 }));
+   }  // teardown
+
+   // a meld only compares along the two right spines: no copies either
+   void test_meld_comparisons()
+   {  // setup
+      custom::leftist_heap<Spy> a;
+      custom::leftist_heap<Spy> b(a.get_pool());
+      for (int i = 0; i < 1000; i++)
+      {
+         a.push(Spy(2 * i));
+         b.push(Spy(2 * i + 1));
+      }
+      assertUnit(rightSpine(a) <= 10);   // log2(1001)
+      assertUnit(rightSpine(b) <= 10);
+      Spy::reset();
+      // exercise
+      a.meld(b);
+      // verify
+      assertUnit(Spy::numLessthan() <= 20);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(a.size() == 2000);
+      assertUnit(a.top().get() == 1999);
+   }  // teardown
+
+   // heaps in different pools meld by moving the nodes over
+   void test_meld_otherPool()
+   {  // setup
+      custom::leftist_heap<int> a;
+      custom::leftist_heap<int> b;
+      for (int i = 0; i < 10; i++)
+      {
+         a.push(i * 10);
+         b.push(i * 10 + 5);
+      }
+      // exercise
+      a.meld(b);
+      // verify
+      assertUnit(b.empty());
+      assertUnit(b.nodes->available() == 10);
+      assertUnit(a.nodes->capacity() == 20);
+      assertUnit(a.size() == 20);
+      assertUnit(a.top() == 95);
+      assertUnit(isLeftist(a));
+      int expected = 95;
+      bool sorted = true;
+      while (!a.empty())
+      {
+         sorted = sorted && a.top() == expected;
+         expected -= 5;
+         a.pop();
+      }
+      assertUnit(sorted);
+   }  // teardown
+
+   // greater<> puts the smallest on top
+   void test_meld_greater()
+   {  // setup
+      custom::leftist_heap<int, std::greater<int>> a;
+      custom::leftist_heap<int, std::greater<int>> b(a.get_pool());
+      a.push(7);
+      a.push(3);
+      b.push(5);
+      b.push(1);
+      // exercise
+      a.meld(b);
+      // verify
+      assertUnit(a.top() == 1);
+      a.pop();
+      assertUnit(a.top() == 3);
+   }  // teardown
+
+   // many heaps melded pairwise agree with sorting everything
+   void test_meld_random()
+   {  // setup
+      custom::leftist_heap<int> first;
+      std::vector<custom::leftist_heap<int>> heaps;
+      std::vector<int> everything;
+      unsigned int seed = 5;
+      for (int h = 0; h < 64; h++)
+      {
+         heaps.push_back(custom::leftist_heap<int>(first.get_pool()));
+         seed = seed * 1103515245 + 12345;
+         int count = (int)((seed >> 8) % 40);
+         for (int i = 0; i < count; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            everything.push_back((int)((seed >> 8) % 10000));
+            heaps.back().push(everything.back());
+         }
+      }
+      std::sort(everything.begin(), everything.end(), std::greater<int>());
+      // exercise
+      for (size_t width = 1; width < heaps.size(); width *= 2)
+         for (size_t i = 0; i + width < heaps.size(); i += 2 * width)
+            heaps[i].meld(heaps[i + width]);
+      // verify
+      assertUnit(isLeftist(heaps[0]));
+      std::vector<int> output;
+      while (!heaps[0].empty())
+      {
+         output.push_back(heaps[0].top());
+         heaps[0].pop();
+      }
+      assertUnit(output == everything);
+   }  // teardown
+
+private:
+   // heap order, the rank rule, and the right size
+   template <class T, class C>
+   static bool isLeftist(const custom::leftist_heap<T, C> & heap)
+   {
+      if (heap.root == heap.NIL)
+         return heap.numElements == 0;
+      size_t count = 0;
+      std::vector<size_t> work(1, heap.root);
+      while (!work.empty())
+      {
+         size_t node = work.back();
+         work.pop_back();
+         count++;
+         size_t left = heap.nodes->slots[node].left;
+         size_t right = heap.nodes->slots[node].right;
+         if (heap.rank(left) < heap.rank(right))
+            return false;
+         if (heap.nodes->slots[node].rank != heap.rank(right) + 1)
+            return false;
+         for (size_t child : { left, right })
+            if (child != heap.NIL)
+            {
+               if (heap.compare(heap.nodes->slots[node].value, heap.nodes->slots[child].value))
+                  return false;
+               work.push_back(child);
+            }
+      }
+      return count == heap.numElements;
+   }
+
+   template <class T, class C>
+   static size_t rightSpine(const custom::leftist_heap<T, C> & heap)
+   {
+      return heap.rank(heap.root);
+   }
+};
+
+#endif // DEBUG
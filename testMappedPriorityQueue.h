@@ -0,0 +1,489 @@
+/***********************************************************************
+ * Header:
+ *    TEST MAPPED PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the priority queue in a memory-mapped file
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#ifdef __linux__
+
+#include "mapped_priority_queue.h"   // class under test
+#include "priority_queue.h"
+#include "unitTest.h"                // unit test baseclass
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+/***********************************************
+ * TEST MAPPED PRIORITY QUEUE
+ * Unit tests for the mapped_priority_queue class
+ ***********************************************/
+class TestMappedPriorityQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_create();
+      test_construct_reopen();
+      test_construct_noRebuild();
+      test_construct_notAHeap();
+      test_construct_wrongVersion();
+      test_construct_wrongElementSize();
+      test_construct_dirtyRecovers();
+      test_construct_dirtyHalfPush();
+      test_construct_dirtyHalfPop();
+      test_construct_dirtyCorrupt();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_checksum();
+      test_push_grow();
+
+      // Remove
+      test_pop_sorted();
+      test_pop_checksum();
+      test_clear_persists();
+
+      // Durability
+      test_policy_sync();
+
+      report("MappedPQueue");
+   }
+
+   typedef custom::mapped_priority_queue<int> queue_type;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a missing file is created with a header and a page of room
+   void test_construct_create()
+   {  // setup
+      std::string path = scratchPath("mpq", "create");
+      {
+         // exercise
+         queue_type queue(path);
+         // verify
+         assertUnit(queue.empty());
+         assertUnit(queue.head->version == 1);
+         assertUnit(queue.head->elementSize == sizeof(int));
+         assertUnit(queue.capacity() == 1025);
+         assertUnit(queue.head->dirty == 0);
+      }
+      assertUnit(std::filesystem::file_size(path) == 64 + 1025 * sizeof(int));
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // the items are there when the file is opened again
+   void test_construct_reopen()
+   {  // setup
+      std::string path = scratchPath("mpq", "reopen");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 100; i++)
+            queue.push((i * 37) % 100);
+         queue.pop();
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.size() == 99);
+      assertUnit(queue.top() == 98);
+      assertUnit(queue.verify());
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a clean file opens without a single comparison
+   void test_construct_noRebuild()
+   {  // setup
+      std::string path = scratchPath("mpq", "norebuild");
+      {
+         custom::mapped_priority_queue<int, counting> queue(path);
+         for (int i = 0; i < 1000; i++)
+            queue.push(i);
+      }
+      counting::count = 0;
+      // exercise
+      custom::mapped_priority_queue<int, counting> queue(path);
+      // verify
+      assertUnit(counting::count == 0);
+      assertUnit(queue.size() == 1000);
+      assertUnit(queue.top() == 999);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // some other file is refused
+   void test_construct_notAHeap()
+   {  // setup
+      std::string path = scratchPath("mpq", "notaheap");
+      std::FILE * file = std::fopen(path.c_str(), "wb");
+      std::fputs("this is just some text that is not a heap file at all, honestly.", file);
+      std::fclose(file);
+      // exercise
+      bool thrown = false;
+      try
+      {
+         queue_type queue(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a file from a later version is refused
+   void test_construct_wrongVersion()
+   {  // setup
+      std::string path = scratchPath("mpq", "version");
+      {
+         queue_type queue(path);
+         queue.push(1);
+         queue.head->version = 2;
+      }
+      // exercise
+      bool thrown = false;
+      try
+      {
+         queue_type queue(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a file of ints is not a file of doubles
+   void test_construct_wrongElementSize()
+   {  // setup
+      std::string path = scratchPath("mpq", "elementsize");
+      {
+         queue_type queue(path);
+         queue.push(1);
+      }
+      // exercise
+      bool thrown = false;
+      try
+      {
+         custom::mapped_priority_queue<double> queue(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a crash in mid-sift: every item is there, so re-heapify
+   void test_construct_dirtyRecovers()
+   {  // setup
+      std::string path = scratchPath("mpq", "dirty");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 50; i++)
+            queue.push(i);
+         // out of heap order, as an interrupted sift would leave it
+         std::swap(queue.data()[0], queue.data()[49]);
+         queue.head->dirty = 1;
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.head->dirty == 0);
+      assertUnit(queue.top() == 49);
+      bool sorted = true;
+      for (int expected = 49; expected >= 0; expected--)
+      {
+         sorted = sorted && queue.top() == expected;
+         queue.pop();
+      }
+      assertUnit(sorted);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a crash after a push's checksum, before its count: the push is finished
+   void test_construct_dirtyHalfPush()
+   {  // setup
+      std::string path = scratchPath("mpq", "halfpush");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 50; i++)
+            queue.push(i);
+         queue.head->dirty = 1;
+         queue.data()[50] = 77;
+         queue.head->checksum += queue_type::hashOf(77);
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.head->dirty == 0);
+      assertUnit(queue.size() == 51);
+      assertUnit(queue.verify());
+      assertUnit(queue.top() == 77);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a crash after a pop's checksum, before its count: the pop is finished
+   void test_construct_dirtyHalfPop()
+   {  // setup
+      std::string path = scratchPath("mpq", "halfpop");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 50; i++)
+            queue.push(i);
+         queue.head->dirty = 1;
+         std::swap(queue.data()[0], queue.data()[49]);
+         queue.head->checksum -= queue_type::hashOf(queue.data()[49]);
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.head->dirty == 0);
+      assertUnit(queue.size() == 49);
+      assertUnit(queue.verify());
+      assertUnit(queue.top() == 48);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a crash that lost an item cannot be trusted
+   void test_construct_dirtyCorrupt()
+   {  // setup
+      std::string path = scratchPath("mpq", "corrupt");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 50; i++)
+            queue.push(i);
+         queue.data()[10] = 1000;
+         queue.head->dirty = 1;
+      }
+      // exercise
+      bool thrown = false;
+      try
+      {
+         queue_type queue(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty queue
+   void test_top_empty()
+   {  // setup
+      std::string path = scratchPath("mpq", "top");
+      queue_type queue(path);
+      // exercise
+      try
+      {
+         queue.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // each push adds its item's hash and leaves the file clean
+   void test_push_checksum()
+   {  // setup
+      std::string path = scratchPath("mpq", "pushsum");
+      queue_type queue(path);
+      // exercise
+      queue.push(7);
+      queue.push(3);
+      queue.push(9);
+      // verify
+      assertUnit(queue.head->checksum ==
+                 queue_type::hashOf(7) + queue_type::hashOf(3) + queue_type::hashOf(9));
+      assertUnit(queue.head->dirty == 0);
+      assertUnit(queue.top() == 9);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a full file doubles, and the mapping follows it
+   void test_push_grow()
+   {  // setup
+      std::string path = scratchPath("mpq", "grow");
+      {
+         queue_type queue(path);
+         // exercise
+         for (int i = 0; i < 5000; i++)
+            queue.push(i);
+         // verify
+         assertUnit(queue.capacity() == 8200);
+         assertUnit(queue.top() == 4999);
+      }
+      assertUnit(std::filesystem::file_size(path) == 64 + 8200 * sizeof(int));
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // the order matches priority_queue, across a reopen
+   void test_pop_sorted()
+   {  // setup
+      std::string path = scratchPath("mpq", "popsorted");
+      custom::priority_queue<int> reference;
+      {
+         queue_type queue(path);
+         unsigned int seed = 19;
+         for (int i = 0; i < 3000; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            queue.push((int)((seed >> 8) % 1000));
+            reference.push((int)((seed >> 8) % 1000));
+         }
+      }
+      // exercise
+      queue_type queue(path);
+      bool same = queue.size() == reference.size();
+      while (same && !reference.empty())
+      {
+         same = queue.top() == reference.top();
+         queue.pop();
+         reference.pop();
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(queue.empty());
+      assertUnit(queue.head->checksum == 0);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // the checksum follows every pop
+   void test_pop_checksum()
+   {  // setup
+      std::string path = scratchPath("mpq", "popsum");
+      queue_type queue(path);
+      for (int i = 0; i < 200; i++)
+         queue.push((i * 7) % 200);
+      // exercise
+      bool valid = true;
+      for (int i = 0; i < 150; i++)
+      {
+         queue.pop();
+         valid = valid && queue.verify();
+      }
+      // verify
+      assertUnit(valid);
+      assertUnit(queue.size() == 50);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // clear empties the file for the next open too
+   void test_clear_persists()
+   {  // setup
+      std::string path = scratchPath("mpq", "clear");
+      {
+         queue_type queue(path);
+         for (int i = 0; i < 20; i++)
+            queue.push(i);
+         // exercise
+         queue.clear();
+      }
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.empty());
+      assertUnit(queue.verify());
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   /***************************************
+    * DURABILITY
+    ***************************************/
+
+   // every policy writes the same file
+   void test_policy_sync()
+   {  // setup
+      std::string path = scratchPath("mpq", "policy");
+      {
+         queue_type queue(path, custom::msync_policy::sync);
+         for (int i = 0; i < 20; i++)
+            queue.push(i);
+      }
+      {
+         queue_type queue(path, custom::msync_policy::async);
+         queue.pop();
+         queue.sync();
+      }
+      // exercise
+      queue_type queue(path);
+      // verify
+      assertUnit(queue.size() == 19);
+      assertUnit(queue.top() == 18);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+private:
+   // a less-than that counts how often it runs
+   struct counting
+   {
+      static int count;
+      bool operator () (int lhs, int rhs) const
+      {
+         count++;
+         return lhs < rhs;
+      }
+   };
+};
+
+inline int TestMappedPriorityQueue::counting::count = 0;
+
+#endif // __linux__
+#endif // DEBUG
@@ -0,0 +1,521 @@
+/***********************************************************************
+ * Header:
+ *    TEST MIN-MAX HEAP
+ * Summary:
+ *    Unit tests for the min-max heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "minmax_heap.h"   // class under test
+#include "unitTest.h"      // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#undef assertMinMax
+#define assertMinMax(x) assertMinMaxParameters(x, __LINE__, __FUNCTION__)
+
+/***********************************************
+ * TEST MIN-MAX HEAP
+ * Unit tests for the minmax_heap class
+ ***********************************************/
+class TestMinMaxHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructMoveInit_standard();
+      test_constructRange_standard();
+
+      // Access
+      test_min_empty();
+      test_min_standard();
+      test_max_empty();
+      test_max_one();
+      test_max_standard();
+
+      // Insert
+      test_push_empty();
+      test_push_levelThreeMin();
+      test_push_levelThreeMax();
+
+      // Remove
+      test_popMin_empty();
+      test_popMin_standard();
+      test_popMax_two();
+      test_popMax_standard();
+      test_pushPop_random();
+
+      report("MinMaxHeap");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor, no allocations
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::minmax_heap <Spy> heap;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numNondefault() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(heap.container.empty());
+   }  // teardown
+
+   // heapify a vector that is in no order at all
+   void test_constructMoveInit_standard()
+   {  // setup
+      custom::vector <Spy> v { Spy(3), Spy(1), Spy(4), Spy(1), Spy(5), Spy(9), Spy(2), Spy(6) };
+      Spy::reset();
+      // exercise
+      custom::minmax_heap <Spy> heap(std::move(v));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(heap.container.size() == 8);
+      assertUnit(v.size() == 0);
+      assertMinMax(heap);
+      assertUnit(heap.min() == Spy(1));
+      assertUnit(heap.max() == Spy(9));
+   }  // teardown
+
+   // build from a range of integers
+   void test_constructRange_standard()
+   {  // setup
+      std::vector <int> source { 7, 2, 9, 4, 4, 8, 1, 3, 6, 5 };
+      // exercise
+      custom::minmax_heap <int> heap(source.begin(), source.end());
+      // verify
+      assertUnit(heap.size() == 10);
+      assertMinMax(heap);
+      assertUnit(heap.min() == 1);
+      assertUnit(heap.max() == 9);
+   }  // teardown
+
+   /***************************************
+    * MIN and MAX
+    ***************************************/
+
+   // min of an empty heap throws
+   void test_min_empty()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      Spy::reset();
+      // exercise
+      try
+      {
+         heap.min();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      assertUnit(Spy::numLessthan() == 0);
+   }  // teardown
+
+   // min is the root; no comparisons needed
+   void test_min_standard()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      setupStandardFixture(heap);
+      Spy::reset();
+      // exercise
+      const Spy & value = heap.min();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(value.get() == 1);
+      assertStandardFixture(heap);
+      // teardown
+      teardownStandardFixture(heap);
+   }
+
+   // max of an empty heap throws
+   void test_max_empty()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      Spy::reset();
+      // exercise
+      try
+      {
+         heap.max();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      assertUnit(Spy::numLessthan() == 0);
+   }  // teardown
+
+   // with a single element, min and max are the same
+   void test_max_one()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      heap.container.push_back(Spy(42));
+      Spy::reset();
+      // exercise
+      const Spy & value = heap.max();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(value.get() == 42);
+      assertUnit(&heap.max() == &heap.min());
+      // teardown
+      heap.container.clear();
+   }
+
+   // max is the larger child of the root: one comparison
+   void test_max_standard()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      setupStandardFixture(heap);
+      Spy::reset();
+      // exercise
+      const Spy & value = heap.max();
+      // verify
+      assertUnit(Spy::numLessthan() == 1);    // compare [9<8]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(value.get() == 9);
+      assertStandardFixture(heap);
+      // teardown
+      teardownStandardFixture(heap);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push onto an empty heap: nothing to compare
+   void test_push_empty()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      heap.container.reserve(4);
+      Spy s(7);
+      Spy::reset();
+      // exercise
+      heap.push(s);
+      // verify
+      assertUnit(Spy::numCopy() == 1);        // copy [7]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [7]
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(heap.container.size() == 1);
+      if (heap.container.size() == 1)
+         assertUnit(heap.container[0] == Spy(7));
+      // teardown
+      heap.container.clear();
+   }
+
+   // a new smallest item lands on a max level and climbs the min levels
+   void test_push_levelThreeMin()
+   {  // setup
+      //                 1
+      //           9           8
+      //        3     4     2     5
+      custom::minmax_heap <Spy> heap;
+      setupStandardFixture(heap);
+      Spy::reset();
+      // exercise
+      heap.push(Spy(0));
+      // verify
+      assertUnit(Spy::numNondefault() == 1);  // create [0]
+      assertUnit(Spy::numAlloc() == 1);       // allocate [0]
+      assertUnit(Spy::numCopyMove() == 1);    // move [0] into the container
+      assertUnit(Spy::numDestructor() == 1);  // the moved-from temporary
+      assertUnit(Spy::numDelete() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numLessthan() == 2);    // compare [0<3][0<1]
+      assertUnit(Spy::numSwap() == 2);        // swap [0,3][0,1]
+      //                 0
+      //           9           8
+      //        1     4     2     5
+      //      3
+      assertUnit(heap.container.size() == 8);
+      if (heap.container.size() == 8)
+      {
+         assertUnit(heap.container[0] == Spy(0));
+         assertUnit(heap.container[1] == Spy(9));
+         assertUnit(heap.container[2] == Spy(8));
+         assertUnit(heap.container[3] == Spy(1));
+         assertUnit(heap.container[4] == Spy(4));
+         assertUnit(heap.container[5] == Spy(2));
+         assertUnit(heap.container[6] == Spy(5));
+         assertUnit(heap.container[7] == Spy(3));
+      }
+      assertMinMax(heap);
+      // teardown
+      teardownStandardFixture(heap);
+   }
+
+   // a new largest item stays on the max levels
+   void test_push_levelThreeMax()
+   {  // setup
+      //                 1
+      //           9           8
+      //        3     4     2     5
+      custom::minmax_heap <Spy> heap;
+      setupStandardFixture(heap);
+      Spy::reset();
+      // exercise
+      heap.push(Spy(10));
+      // verify
+      assertUnit(Spy::numLessthan() == 2);    // compare [10<3][9<10]
+      assertUnit(Spy::numSwap() == 1);        // swap [10,9]
+      assertUnit(Spy::numCopy() == 0);
+      //                 1
+      //          10           8
+      //        3     4     2     5
+      //      9
+      assertUnit(heap.container.size() == 8);
+      if (heap.container.size() == 8)
+      {
+         assertUnit(heap.container[0] == Spy(1));
+         assertUnit(heap.container[1] == Spy(10));
+         assertUnit(heap.container[2] == Spy(8));
+         assertUnit(heap.container[3] == Spy(3));
+         assertUnit(heap.container[4] == Spy(4));
+         assertUnit(heap.container[5] == Spy(2));
+         assertUnit(heap.container[6] == Spy(5));
+         assertUnit(heap.container[7] == Spy(9));
+      }
+      assertMinMax(heap);
+      // teardown
+      teardownStandardFixture(heap);
+   }
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop from an empty heap does nothing
+   void test_popMin_empty()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      Spy::reset();
+      // exercise
+      heap.pop_min();
+      heap.pop_max();
+      // verify
+      assertUnit(Spy::numDestructor() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(heap.container.empty());
+   }  // teardown
+
+   // pop the smallest: the last item drops down the min levels
+   void test_popMin_standard()
+   {  // setup
+      //                 1
+      //           9           8
+      //        3     4     2     5
+      custom::minmax_heap <Spy> heap;
+      setupStandardFixture(heap);
+      Spy::reset();
+      // exercise
+      heap.pop_min();
+      // verify
+      assertUnit(Spy::numSwap() == 2);        // swap [1,5] [5,2]
+      assertUnit(Spy::numDestructor() == 1);  // destroy [1]
+      assertUnit(Spy::numDelete() == 1);      // delete [1]
+      assertUnit(Spy::numLessthan() == 6);    // compare [8<9][3<8][4<3][2<3][2<5][8<5]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      //                 2
+      //           9           8
+      //        3     4     5
+      assertUnit(heap.container.size() == 6);
+      if (heap.container.size() == 6)
+      {
+         assertUnit(heap.container[0] == Spy(2));
+         assertUnit(heap.container[1] == Spy(9));
+         assertUnit(heap.container[2] == Spy(8));
+         assertUnit(heap.container[3] == Spy(3));
+         assertUnit(heap.container[4] == Spy(4));
+         assertUnit(heap.container[5] == Spy(5));
+      }
+      assertMinMax(heap);
+      // teardown
+      teardownStandardFixture(heap);
+   }
+
+   // pop the largest of two: the root stays
+   void test_popMax_two()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      heap.container = { Spy(3), Spy(8) };
+      Spy::reset();
+      // exercise
+      heap.pop_max();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(Spy::numDestructor() == 1);  // destroy [8]
+      assertUnit(heap.container.size() == 1);
+      if (heap.container.size() == 1)
+         assertUnit(heap.container[0] == Spy(3));
+      // teardown
+      heap.container.clear();
+   }
+
+   // pop the largest: the last item drops down the max levels
+   void test_popMax_standard()
+   {  // setup
+      //                 1
+      //           9           8
+      //        3     4     2     5
+      custom::minmax_heap <Spy> heap;
+      setupStandardFixture(heap);
+      Spy::reset();
+      // exercise
+      heap.pop_max();
+      // verify
+      assertUnit(Spy::numSwap() == 1);        // swap [9,5]
+      assertUnit(Spy::numDestructor() == 1);  // destroy [9]
+      assertUnit(Spy::numDelete() == 1);      // delete [9]
+      assertUnit(Spy::numLessthan() == 3);    // compare [9<8][3<4][5<4]
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      //                 1
+      //           5           8
+      //        3     4     2
+      assertUnit(heap.container.size() == 6);
+      if (heap.container.size() == 6)
+      {
+         assertUnit(heap.container[0] == Spy(1));
+         assertUnit(heap.container[1] == Spy(5));
+         assertUnit(heap.container[2] == Spy(8));
+         assertUnit(heap.container[3] == Spy(3));
+         assertUnit(heap.container[4] == Spy(4));
+         assertUnit(heap.container[5] == Spy(2));
+      }
+      assertMinMax(heap);
+      // teardown
+      teardownStandardFixture(heap);
+   }
+
+   // interleaved pushes and pops from both ends agree with a sorted list
+   void test_pushPop_random()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      std::vector <int> reference;
+      unsigned int seed = 31337;
+      bool same = true;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)((seed >> 8) % 500);
+         if (value % 3 != 0 || reference.empty())
+         {
+            heap.push(value);
+            reference.push_back(value);
+         }
+         else if (value % 2)
+         {
+            std::vector<int>::iterator it = std::min_element(reference.begin(), reference.end());
+            same = same && heap.min() == *it;
+            reference.erase(it);
+            heap.pop_min();
+         }
+         else
+         {
+            std::vector<int>::iterator it = std::max_element(reference.begin(), reference.end());
+            same = same && heap.max() == *it;
+            reference.erase(it);
+            heap.pop_max();
+         }
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(heap.size() == reference.size());
+      assertMinMax(heap);
+   }  // teardown
+
+   /***************************************************
+    * SETUP STANDARD FIXTURE
+    *                 1
+    *           9           8
+    *        3     4     2     5
+    *
+    *   +---+---+---+---+---+---+---+---+---+
+    *   | 1 | 9 | 8 | 3 | 4 | 2 | 5 |   |   |
+    *   +---+---+---+---+---+---+---+---+---+
+    ***************************************************/
+   void setupStandardFixture(custom::minmax_heap <Spy> & heap)
+   {
+      heap.container = { Spy(1), Spy(9), Spy(8), Spy(3), Spy(4), Spy(2), Spy(5) };
+      heap.container.reserve(9);
+   }
+
+   /***************************************************
+    * VERIFY STANDARD FIXTURE
+    ***************************************************/
+   void assertStandardFixtureParameters(const custom::minmax_heap <Spy> & heap, int line, const char * function)
+   {
+      assertIndirect(heap.container.size() == 7);
+      if (heap.container.size() == 7)
+      {
+         assertIndirect(heap.container[0] == Spy(1));
+         assertIndirect(heap.container[1] == Spy(9));
+         assertIndirect(heap.container[2] == Spy(8));
+         assertIndirect(heap.container[3] == Spy(3));
+         assertIndirect(heap.container[4] == Spy(4));
+         assertIndirect(heap.container[5] == Spy(2));
+         assertIndirect(heap.container[6] == Spy(5));
+      }
+   }
+
+   /***************************************************
+    * VERIFY MIN-MAX ORDER
+    * Every node is no larger (min level) or no smaller
+    * (max level) than each of its descendants
+    ***************************************************/
+   template <class T>
+   void assertMinMaxParameters(const custom::minmax_heap <T> & heap, int line, const char * function)
+   {
+      for (size_t i = 1; i < heap.container.size(); i++)
+         for (size_t ancestor = (i - 1) / 2; ; ancestor = (ancestor - 1) / 2)
+         {
+            if (custom::minmax_heap <T>::isMinLevel(ancestor))
+               assertIndirect(!(heap.container[i] < heap.container[ancestor]));
+            else
+               assertIndirect(!(heap.container[ancestor] < heap.container[i]));
+            if (ancestor == 0)
+               break;
+         }
+   }
+
+   /***************************************************
+    * TEARDOWN STANDARD FIXTURE
+    ***************************************************/
+   void teardownStandardFixture(custom::minmax_heap <Spy> & heap)
+   {
+      heap.container.clear();
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,231 @@
+/***********************************************************************
+ * Header:
+ *    TEST PARALLEL TOP K
+ * Summary:
+ *    Unit tests for the parallel top-K search
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "parallel_top_k.h"   // class under test
+#include "unitTest.h"         // unit test baseclass
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST PARALLEL TOP K
+ * Unit tests for parallel_top_k and shared_threshold
+ ***********************************************/
+class TestParallelTopK : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Shared threshold
+      test_sharedThreshold_unset();
+      test_sharedThreshold_onlyRises();
+      test_sharedThreshold_disabled();
+
+      // Search
+      test_search_empty();
+      test_search_fewerThanK();
+      test_search_moreThreadsThanItems();
+      test_search_oneThread();
+      test_search_manyThreads();
+      test_search_greater();
+      test_search_strings();
+      test_search_vector();
+
+      report("ParallelTopK");
+   }
+
+   /***************************************
+    * SHARED THRESHOLD
+    ***************************************/
+
+   // nothing is rejected until someone publishes
+   void test_sharedThreshold_unset()
+   {  // setup
+      custom::shared_threshold<int, std::less<int>> shared((std::less<int>()));
+      custom::shared_threshold<int, std::less<int>>::view bar(shared);
+      // exercise
+      bar.refresh();
+      // verify
+      assertUnit(!bar.rejects(-1000000));
+   }  // teardown
+
+   // a worse offer from another thread does not lower the bar
+   void test_sharedThreshold_onlyRises()
+   {  // setup
+      custom::shared_threshold<int, std::less<int>> shared((std::less<int>()));
+      custom::shared_threshold<int, std::less<int>>::view first(shared);
+      custom::shared_threshold<int, std::less<int>>::view second(shared);
+      custom::shared_threshold<int, std::less<int>>::view reader(shared);
+      // exercise
+      first.offer(50);
+      second.offer(20);
+      reader.refresh();
+      // verify
+      assertUnit(reader.rejects(50));    // ties cannot get in
+      assertUnit(reader.rejects(30));
+      assertUnit(!reader.rejects(51));
+   }  // teardown
+
+   // no atomic for strings: every item goes to the local heap
+   void test_sharedThreshold_disabled()
+   {  // setup
+      custom::shared_threshold<std::string, std::less<std::string>> shared((std::less<std::string>()));
+      custom::shared_threshold<std::string, std::less<std::string>>::view bar(shared);
+      // exercise
+      bar.offer("zzz");
+      bar.refresh();
+      // verify
+      assertUnit(!bar.rejects("aaa"));
+   }  // teardown
+
+   /***************************************
+    * SEARCH
+    ***************************************/
+
+   // an empty range has no best
+   void test_search_empty()
+   {  // setup
+      std::vector<int> source;
+      // exercise
+      custom::vector<int> result = custom::parallel_top_k<5>(source.begin(), source.end(), 4);
+      // verify
+      assertUnit(result.size() == 0);
+   }  // teardown
+
+   // fewer than K items: all of them, sorted
+   void test_search_fewerThanK()
+   {  // setup
+      std::vector<int> source { 4, 9, 1 };
+      // exercise
+      custom::vector<int> result = custom::parallel_top_k<5>(source.begin(), source.end(), 2);
+      // verify
+      assertUnit(result.size() == 3);
+      if (result.size() == 3)
+      {
+         assertUnit(result[0] == 9);
+         assertUnit(result[1] == 4);
+         assertUnit(result[2] == 1);
+      }
+   }  // teardown
+
+   // more threads than items: each gets at most one
+   void test_search_moreThreadsThanItems()
+   {  // setup
+      std::vector<int> source { 6, 2, 8, 5 };
+      // exercise
+      custom::vector<int> result = custom::parallel_top_k<2>(source.begin(), source.end(), 16);
+      // verify
+      assertUnit(result.size() == 2);
+      if (result.size() == 2)
+      {
+         assertUnit(result[0] == 8);
+         assertUnit(result[1] == 6);
+      }
+   }  // teardown
+
+   // one thread is just a top_k
+   void test_search_oneThread()
+   {  // setup
+      std::vector<int> source = randomInts(10000, 11);
+      // exercise
+      custom::vector<int> result = custom::parallel_top_k<20>(source.begin(), source.end(), 1);
+      // verify
+      assertUnit(matchesSort(source, result, 20, std::greater<int>()));
+   }  // teardown
+
+   // the slices and the shared bar do not change the answer
+   void test_search_manyThreads()
+   {  // setup
+      std::vector<int> source = randomInts(200000, 12);
+      bool same = true;
+      // exercise
+      for (size_t numThreads = 2; numThreads <= 8; numThreads++)
+      {
+         custom::vector<int> result = custom::parallel_top_k<50>(source.begin(), source.end(), numThreads);
+         same = same && matchesSort(source, result, 50, std::greater<int>());
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // greater<> finds the smallest
+   void test_search_greater()
+   {  // setup
+      std::vector<double> source;
+      std::vector<int> ints = randomInts(50000, 13);
+      for (int value : ints)
+         source.push_back(value / 8.0);
+      // exercise
+      custom::vector<double> result = custom::parallel_top_k<10>(
+         source.begin(), source.end(), 4, std::greater<double>());
+      // verify
+      assertUnit(matchesSort(source, result, 10, std::less<double>()));
+   }  // teardown
+
+   // keys that cannot share a threshold still come out right
+   void test_search_strings()
+   {  // setup
+      std::vector<std::string> source;
+      std::vector<int> ints = randomInts(5000, 14);
+      for (int value : ints)
+         source.push_back(std::to_string(value));
+      // exercise
+      custom::vector<std::string> result = custom::parallel_top_k<7>(source.begin(), source.end(), 3);
+      // verify
+      assertUnit(matchesSort(source, result, 7, std::greater<std::string>()));
+   }  // teardown
+
+   // a custom::vector can be searched directly
+   void test_search_vector()
+   {  // setup
+      custom::vector<int> source;
+      std::vector<int> ints = randomInts(30000, 15);
+      for (int value : ints)
+         source.push_back(value);
+      // exercise
+      custom::vector<int> result = custom::parallel_top_k<8>(source, 4);
+      // verify
+      assertUnit(matchesSort(ints, result, 8, std::greater<int>()));
+   }  // teardown
+
+private:
+   static std::vector<int> randomInts(size_t num, unsigned int seed)
+   {
+      std::vector<int> values;
+      for (size_t i = 0; i < num; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 1000000));
+      }
+      return values;
+   }
+
+   // is result the first k of source once sorted by order?
+   template <class T, class Order>
+   static bool matchesSort(std::vector<T> source, const custom::vector<T> & result, size_t k, Order order)
+   {
+      std::sort(source.begin(), source.end(), order);
+      if (result.size() != k)
+         return false;
+      for (size_t i = 0; i < k; i++)
+         if (!(result[i] == source[i]))
+            return false;
+      return true;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,408 @@
+/***********************************************************************
+ * Header:
+ *    TEST PERSISTENT HEAP
+ * Summary:
+ *    Unit tests for the immutable heap with shared nodes
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "persistent_heap.h"   // class under test
+#include "priority_queue.h"
+#include "unitTest.h"          // unit test baseclass
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST PERSISTENT HEAP
+ * Unit tests for the persistent_heap class
+ ***********************************************/
+class TestPersistentHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructCopy_shares();
+      test_assign_standard();
+      test_assign_self();
+
+      // Access
+      test_top_empty();
+
+      // Push
+      test_push_leavesOld();
+      test_push_copiesSpine();
+      test_push_greater();
+
+      // Pop
+      test_pop_leavesOld();
+      test_pop_empty();
+      test_pop_sorted();
+
+      // Sharing
+      test_release_returnsNodes();
+      test_release_keepsShared();
+      test_fork_random();
+
+      report("PersistentHeap");
+   }
+
+   typedef custom::persistent_heap<int> heap_type;
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // a heap with a pool of its own and nothing in it
+   void test_construct_default()
+   {  // setup
+      // exercise
+      heap_type heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.nodes != nullptr);
+      assertUnit(heap.nodes->capacity() == 0);
+      assertUnit(heap.root == heap_type::NIL);
+   }  // teardown
+
+   // a copy is the same tree, one more reference on the root
+   void test_constructCopy_shares()
+   {  // setup
+      heap_type heap = build({ 3, 9, 5 });
+      size_t inUse = heap.nodes->capacity() - heap.nodes->available();
+      // exercise
+      heap_type copy(heap);
+      // verify
+      assertUnit(copy.root == heap.root);
+      assertUnit(copy.size() == 3);
+      assertUnit(copy.top() == 9);
+      assertUnit(heap.nodes->slots[heap.root].refs == 2);
+      assertUnit(heap.nodes->capacity() - heap.nodes->available() == inUse);
+   }  // teardown
+
+   // assigning drops the old tree and takes the new one
+   void test_assign_standard()
+   {  // setup
+      heap_type heap = build({ 1, 2, 3 });
+      heap_type other = heap.push(10);
+      // exercise
+      heap = other;
+      // verify
+      assertUnit(heap.root == other.root);
+      assertUnit(heap.size() == 4);
+      assertUnit(heap.top() == 10);
+      assertUnit(heap.nodes->slots[heap.root].refs == 2);
+      assertUnit(isLeftist(heap));
+   }  // teardown
+
+   // a version assigned to itself keeps its nodes
+   void test_assign_self()
+   {  // setup
+      heap_type heap = build({ 4, 7 });
+      heap_type & same = heap;
+      size_t available = heap.nodes->available();
+      // exercise
+      heap = same;
+      // verify
+      assertUnit(heap.size() == 2);
+      assertUnit(heap.top() == 7);
+      assertUnit(heap.nodes->slots[heap.root].refs == 1);
+      assertUnit(heap.nodes->available() == available);
+      assertUnit(isLeftist(heap));
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty heap
+   void test_top_empty()
+   {  // setup
+      heap_type heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push hands back a new version; the one it came from is unchanged
+   void test_push_leavesOld()
+   {  // setup
+      heap_type before = build({ 4, 8, 6 });
+      // exercise
+      heap_type after = before.push(20);
+      // verify
+      assertUnit(before.size() == 3);
+      assertUnit(before.top() == 8);
+      assertUnit(drain(before) == std::vector<int>({ 8, 6, 4 }));
+      assertUnit(after.size() == 4);
+      assertUnit(drain(after) == std::vector<int>({ 20, 8, 6, 4 }));
+      assertUnit(after.get_pool() == before.get_pool());
+      assertUnit(isLeftist(after));
+   }  // teardown
+
+   // only the right spine is copied: a push into 1023 items adds a handful of nodes
+   void test_push_copiesSpine()
+   {  // setup
+      heap_type heap;
+      for (int i = 0; i < 1023; i++)
+         heap = heap.push((int)((i * 2654435761u) >> 8));
+      size_t inUse = heap.nodes->capacity() - heap.nodes->available();
+      assertUnit(inUse == 1023);
+      // exercise
+      heap_type after = heap.push(-1);
+      // verify
+      //    the right spine of 1023 items is at most 10 long, plus the new node
+      size_t added = heap.nodes->capacity() - heap.nodes->available() - inUse;
+      assertUnit(added >= 1);
+      assertUnit(added <= 11);
+      assertUnit(rightSpine(heap) <= 10);
+      assertUnit(isLeftist(after));
+   }  // teardown
+
+   // with std::greater the smallest is on top
+   void test_push_greater()
+   {  // setup
+      custom::persistent_heap<int, std::greater<int>> heap;
+      // exercise
+      for (int value : { 5, 2, 8, 1, 9 })
+         heap = heap.push(value);
+      // verify
+      assertUnit(heap.top() == 1);
+      assertUnit(heap.pop().top() == 2);
+      assertUnit(isLeftist(heap));
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop hands back a new version; the one it came from is unchanged
+   void test_pop_leavesOld()
+   {  // setup
+      heap_type before = build({ 4, 8, 6, 2 });
+      // exercise
+      heap_type after = before.pop();
+      // verify
+      assertUnit(before.size() == 4);
+      assertUnit(drain(before) == std::vector<int>({ 8, 6, 4, 2 }));
+      assertUnit(after.size() == 3);
+      assertUnit(drain(after) == std::vector<int>({ 6, 4, 2 }));
+      assertUnit(isLeftist(after));
+   }  // teardown
+
+   // popping nothing gives nothing
+   void test_pop_empty()
+   {  // setup
+      heap_type heap;
+      // exercise
+      heap_type after = heap.pop();
+      // verify
+      assertUnit(after.empty());
+      assertUnit(after.root == heap_type::NIL);
+      assertUnit(heap.nodes->capacity() == 0);
+   }  // teardown
+
+   // everything comes out in the same order as priority_queue gives
+   void test_pop_sorted()
+   {  // setup
+      heap_type heap;
+      custom::priority_queue<int> queue;
+      unsigned int seed = 21;
+      for (int i = 0; i < 500; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)((seed >> 8) % 1000);
+         heap = heap.push(value);
+         queue.push(value);
+      }
+      assertUnit(isLeftist(heap));
+      // exercise
+      std::vector<int> fromHeap = drain(heap);
+      // verify
+      std::vector<int> fromQueue;
+      while (!queue.empty())
+      {
+         fromQueue.push_back(queue.top());
+         queue.pop();
+      }
+      assertUnit(fromHeap == fromQueue);
+      assertUnit(heap.size() == 500);
+   }  // teardown
+
+   /***************************************
+    * SHARING
+    ***************************************/
+
+   // once every version is gone, every node is back in the pool
+   void test_release_returnsNodes()
+   {  // setup
+      std::shared_ptr<heap_type::pool> nodes = std::make_shared<heap_type::pool>();
+      {
+         heap_type heap(nodes);
+         std::vector<heap_type> versions;
+         for (int i = 0; i < 100; i++)
+         {
+            heap = heap.push((i * 37) % 101);
+            if (i % 10 == 0)
+               versions.push_back(heap.pop());
+         }
+         assertUnit(nodes->available() < nodes->capacity());
+         // exercise
+      }
+      // verify
+      assertUnit(nodes->capacity() > 0);
+      assertUnit(nodes->available() == nodes->capacity());
+   }  // teardown
+
+   // dropping the old version keeps the nodes the new one still points at
+   void test_release_keepsShared()
+   {  // setup
+      heap_type * before = new heap_type(build({ 10, 20, 30, 40, 50, 60, 70 }));
+      heap_type after = before->pop().push(65);
+      size_t inUse = after.nodes->capacity() - after.nodes->available();
+      // exercise
+      delete before;
+      // verify
+      size_t stillInUse = after.nodes->capacity() - after.nodes->available();
+      assertUnit(stillInUse < inUse);
+      assertUnit(stillInUse == after.size());
+      assertUnit(drain(after) == std::vector<int>({ 65, 60, 50, 40, 30, 20, 10 }));
+      assertUnit(isLeftist(after));
+   }  // teardown
+
+   // many forks of many forks, each checked against a copied priority_queue
+   void test_fork_random()
+   {  // setup
+      std::vector<heap_type> heaps(1);
+      std::vector<custom::priority_queue<int>> queues(1);
+      unsigned int seed = 5;
+      // exercise
+      for (int step = 0; step < 2000; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         size_t which = (seed >> 8) % heaps.size();
+         seed = seed * 1103515245 + 12345;
+         int value = (int)((seed >> 8) % 10000);
+         if (heaps.size() < 64 && value % 5 == 0)
+         {
+            heaps.push_back(heaps[which]);
+            queues.push_back(queues[which]);
+         }
+         else if (value % 3 == 0 && !queues[which].empty())
+         {
+            heaps[which] = heaps[which].pop();
+            queues[which].pop();
+         }
+         else
+         {
+            heaps[which] = heaps[which].push(value);
+            queues[which].push(value);
+         }
+      }
+      // verify
+      bool agree = true;
+      for (size_t i = 0; i < heaps.size(); i++)
+      {
+         agree = agree && isLeftist(heaps[i]) && heaps[i].size() == queues[i].size();
+         std::vector<int> expected;
+         while (!queues[i].empty())
+         {
+            expected.push_back(queues[i].top());
+            queues[i].pop();
+         }
+         agree = agree && drain(heaps[i]) == expected;
+      }
+      assertUnit(agree);
+      assertUnit(heaps.size() > 1);
+   }  // teardown
+
+private:
+   static heap_type build(std::initializer_list<int> values)
+   {
+      heap_type heap;
+      for (int value : values)
+         heap = heap.push(value);
+      return heap;
+   }
+
+   // every item, largest first, through a chain of new versions
+   template <class T, class C>
+   static std::vector<T> drain(const custom::persistent_heap<T, C> & heap)
+   {
+      std::vector<T> output;
+      custom::persistent_heap<T, C> rest(heap);
+      while (!rest.empty())
+      {
+         output.push_back(rest.top());
+         rest = rest.pop();
+      }
+      return output;
+   }
+
+   // heap order, the rank rule, live refcounts, and the right size
+   template <class T, class C>
+   static bool isLeftist(const custom::persistent_heap<T, C> & heap)
+   {
+      if (heap.root == heap.NIL)
+         return heap.numElements == 0;
+      size_t count = 0;
+      std::vector<size_t> work(1, heap.root);
+      while (!work.empty())
+      {
+         size_t node = work.back();
+         work.pop_back();
+         count++;
+         if (heap.nodes->slots[node].refs == 0)
+            return false;
+         size_t left = heap.nodes->slots[node].left;
+         size_t right = heap.nodes->slots[node].right;
+         if (heap.rank(left) < heap.rank(right))
+            return false;
+         if (heap.nodes->slots[node].rank != heap.rank(right) + 1)
+            return false;
+         for (size_t child : { left, right })
+            if (child != heap.NIL)
+            {
+               if (heap.compare(heap.nodes->slots[node].value, heap.nodes->slots[child].value))
+                  return false;
+               work.push_back(child);
+            }
+      }
+      return count == heap.numElements;
+   }
+
+   template <class T, class C>
+   static size_t rightSpine(const custom::persistent_heap<T, C> & heap)
+   {
+      return heap.rank(heap.root);
+   }
+};
+
+#endif // DEBUG
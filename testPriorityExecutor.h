@@ -0,0 +1,244 @@
+/***********************************************************************
+ * Header:
+ *    TEST PRIORITY EXECUTOR
+ * Summary:
+ *    Unit tests for the priority executor
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "priority_executor.h"   // class under test
+#include "unitTest.h"            // unit test baseclass
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <future>
+#include <mutex>
+#include <vector>
+
+/***********************************************
+ * TEST PRIORITY EXECUTOR
+ * Unit tests for the priority_executor class
+ ***********************************************/
+class TestPriorityExecutor : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Insert
+      test_submit_value();
+      test_submit_priorityOrder();
+      test_submit_many();
+
+      // Utility
+      test_steal_half();
+      test_yieldTo_higher();
+      test_yieldTo_lower();
+      test_workerLoop_idleSleeps();
+
+      report("PriorityExecutor");
+   }
+
+   /***************************************
+    * SUBMIT
+    ***************************************/
+
+   // the future carries the return value
+   void test_submit_value()
+   {  // setup
+      custom::priority_executor executor(2);
+      // exercise
+      std::future<int> result = executor.submit(1, []() { return 42; });
+      // verify
+      assertUnit(result.get() == 42);
+   }  // teardown
+
+   // a single worker runs the backlog highest priority first
+   void test_submit_priorityOrder()
+   {  // setup
+      std::vector<int> order;
+      std::mutex orderLock;
+      std::promise<void> release;
+      std::shared_future<void> gate = release.get_future().share();
+      std::atomic<bool> started(false);
+      {
+         custom::priority_executor executor(1);
+         executor.submit(0, [&]() { started = true; gate.wait(); });
+         while (!started)
+            std::this_thread::yield();
+         // exercise
+         for (int priority : { 1, 5, 3, 5, 2 })
+            executor.submit(priority, [&, priority]()
+            {
+               std::lock_guard<std::mutex> guard(orderLock);
+               order.push_back(priority);
+            });
+         release.set_value();
+      }  // the destructor drains the queue
+      // verify
+      assertUnit(order.size() == 5);
+      if (order.size() == 5)
+      {
+         assertUnit(order[0] == 5);
+         assertUnit(order[1] == 5);
+         assertUnit(order[2] == 3);
+         assertUnit(order[3] == 2);
+         assertUnit(order[4] == 1);
+      }
+   }  // teardown
+
+   // every task runs exactly once
+   void test_submit_many()
+   {  // setup
+      std::atomic<int> count(0);
+      {
+         custom::priority_executor executor(4);
+         // exercise
+         for (int i = 0; i < 1000; i++)
+            executor.submit(i % 7, [&]() { count++; });
+      }
+      // verify
+      assertUnit(count == 1000);
+   }  // teardown
+
+   /***************************************
+    * STEAL and YIELD
+    ***************************************/
+
+   // an idle worker takes the top half of the victim's heap
+   void test_steal_half()
+   {  // setup
+      std::promise<void> release;
+      std::shared_future<void> gate = release.get_future().share();
+      std::atomic<int> started(0);
+      custom::priority_executor executor(2);
+      blockWorkers(executor, gate, started);
+      fillWorker(executor, 0, { 1, 4, 2, 3 });
+      custom::priority_executor::Task task;
+      // exercise
+      bool returnValue = executor.steal(1, task);
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(task.priority == 4);
+      assertUnit(executor.workers[0]->heap.size() == 2);
+      assertUnit(executor.workers[1]->heap.size() == 1);
+      if (executor.workers[1]->heap.size() == 1)
+         assertUnit(executor.workers[1]->heap.top().priority == 3);
+      if (executor.workers[0]->heap.size() == 2)
+         assertUnit(executor.workers[0]->heap.top().priority == 2);
+      // teardown
+      executor.workers[1]->heap.push(std::move(task));
+      release.set_value();
+   }
+
+   // a more urgent task elsewhere is swapped in
+   void test_yieldTo_higher()
+   {  // setup
+      std::promise<void> release;
+      std::shared_future<void> gate = release.get_future().share();
+      std::atomic<int> started(0);
+      custom::priority_executor executor(2, true /*yieldToHigher*/);
+      blockWorkers(executor, gate, started);
+      fillWorker(executor, 0, { 9 });
+      custom::priority_executor::Task task = makeTask(executor, 1);
+      // exercise
+      bool returnValue = executor.yieldTo(1, task);
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(task.priority == 9);
+      assertUnit(executor.workers[0]->heap.empty());
+      assertUnit(executor.workers[1]->heap.size() == 1);
+      if (executor.workers[1]->heap.size() == 1)
+         assertUnit(executor.workers[1]->heap.top().priority == 1);
+      // teardown
+      executor.workers[0]->heap.push(std::move(task));
+      release.set_value();
+   }
+
+   // nothing more urgent elsewhere: keep the task
+   void test_yieldTo_lower()
+   {  // setup
+      std::promise<void> release;
+      std::shared_future<void> gate = release.get_future().share();
+      std::atomic<int> started(0);
+      custom::priority_executor executor(2, true /*yieldToHigher*/);
+      blockWorkers(executor, gate, started);
+      fillWorker(executor, 0, { 3 });
+      custom::priority_executor::Task task = makeTask(executor, 8);
+      // exercise
+      bool returnValue = executor.yieldTo(1, task);
+      // verify
+      assertUnit(returnValue == false);
+      assertUnit(task.priority == 8);
+      assertUnit(executor.workers[0]->heap.size() == 1);
+      assertUnit(executor.workers[1]->heap.empty());
+      // teardown
+      executor.workers[0]->heap.push(std::move(task));
+      release.set_value();
+   }
+
+   // a worker with nothing to find sleeps, even while a task is counted pending
+   void test_workerLoop_idleSleeps()
+   {  // setup
+      custom::priority_executor executor(1);
+      executor.submit(0, []() {}).get();
+      {
+         std::lock_guard<std::mutex> guard(executor.sleepLock);
+         executor.pending++;   // as if a task were on its way to a heap
+      }
+      executor.wake.notify_all();
+      std::clock_t before = std::clock();
+      // exercise
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      // verify
+      std::clock_t used = std::clock() - before;
+      assertUnit(used < CLOCKS_PER_SEC / 20);
+      // teardown
+      executor.pending--;
+   }
+
+   /***************************************
+    * HELPERS
+    ***************************************/
+
+   // park every worker on the gate so the heaps hold still
+   void blockWorkers(custom::priority_executor & executor,
+                     std::shared_future<void> gate, std::atomic<int> & started)
+   {
+      int numThreads = (int)executor.numThreads();
+      for (int i = 0; i < numThreads; i++)
+         executor.submit(1000, [gate, &started]() { started++; gate.wait(); });
+      while (started < numThreads)
+         std::this_thread::yield();
+   }
+
+   // place do-nothing tasks directly in one worker's heap
+   void fillWorker(custom::priority_executor & executor, size_t index,
+                   std::initializer_list<int> priorities)
+   {
+      for (int priority : priorities)
+         executor.workers[index]->heap.push(makeTask(executor, priority));
+   }
+
+   // a do-nothing task, counted as pending because it will end up in a heap
+   custom::priority_executor::Task makeTask(custom::priority_executor & executor,
+                                            int priority)
+   {
+      custom::priority_executor::Task task;
+      task.priority = priority;
+      task.sequence = executor.sequence++;
+      task.fn = []() {};
+      std::lock_guard<std::mutex> guard(executor.sleepLock);
+      executor.pending++;
+      return task;
+   }
+};
+
+#endif // DEBUG
@@ -18,6 +18,31 @@
 #include "testPriorityQueue.h"  // for the priority queue unit tests
 #include "testSpy.h"            // for the spy unit tests
 #include "testVector.h"         // for the vector unit tests
+#include "testPriorityExecutor.h" // for the priority executor unit tests
+#include "testCoroutineScheduler.h" // for the coroutine scheduler unit tests
+#include "testHeapTimer.h"      // for the heap timer unit tests
+#include "testTimerService.h"   // for the timer service unit tests
+#include "testTimingWheel.h"    // for the timing wheel unit tests
+#include "testMinMaxHeap.h"     // for the min-max heap unit tests
+#include "testTopK.h"           // for the top-K collector unit tests
+#include "testSimdFilter.h"     // for the SIMD filter unit tests
+#include "testParallelTopK.h"   // for the parallel top-K unit tests
+#include "testSlidingWindow.h"  // for the sliding window unit tests
+#include "testRunningQuantile.h" // for the running quantile unit tests
+#include "testKwayMerge.h"      // for the k-way merge unit tests
+#include "testHeap.h"           // for the heap algorithm unit tests
+#include "testFibonacciHeap.h"  // for the Fibonacci heap unit tests
+#include "testLeftistHeap.h"    // for the leftist heap unit tests
+#include "testPersistentHeap.h" // for the persistent heap unit tests
+#include "testWeakHeap.h"       // for the weak heap unit tests
+#include "testSequenceHeap.h"   // for the sequence heap unit tests
+#include "testBHeap.h"          // for the B-heap unit tests
+#include "testExternalPriorityQueue.h" // for the external priority queue unit tests
+#include "testMappedPriorityQueue.h"   // for the mapped priority queue unit tests
+#include "testDurablePriorityQueue.h"  // for the durable priority queue unit tests
+#include "testVectorView.h"        // for the vector file and view unit tests
+#include "testSharedPriorityQueue.h" // for the shared-memory priority queue unit tests
+#include "testQueueServer.h"       // for the queue server unit tests
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -31,6 +56,35 @@ int main()
    TestSpy().run();
    TestVector().run();
    TestPQueue().run();
+   TestPriorityExecutor().run();
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+   TestCoroutineScheduler().run();
+#endif
+   TestHeapTimer().run();
+   TestTimingWheel().run();
+   TestMinMaxHeap().run();
+   TestTopK().run();
+   TestSimdFilter().run();
+   TestParallelTopK().run();
+   TestSlidingWindow().run();
+   TestRunningQuantile().run();
+   TestKwayMerge().run();
+   TestHeap().run();
+   TestFibonacciHeap().run();
+   TestLeftistHeap().run();
+   TestPersistentHeap().run();
+   TestWeakHeap().run();
+   TestSequenceHeap().run();
+   TestBHeap().run();
+   TestExternalPriorityQueue().run();
+   TestVectorView().run();
+#ifdef __linux__
+   TestTimerService().run();
+   TestMappedPriorityQueue().run();
+   TestDurablePriorityQueue().run();
+   TestSharedPriorityQueue().run();
+   TestQueueServer().run();
+#endif
 #endif // DEBUG
    
    return 0;
@@ -19,6 +19,8 @@
 #include <cassert>
 #include <memory>
 #include <deque>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 
@@ -85,12 +87,19 @@ public:
 //      test_percolateDown_nothing();
 //      test_percolateDown_oneLevel();
 //      test_percolateDown_twoLevels();
-//      test_percolateDown_nothingReversed();
-//      test_percolateDown_oneLevelReversed();
-//      test_percolateDown_twoLevelsReversed();
+      test_percolateDown_nothingReversed();
+      test_percolateDown_oneLevelReversed();
+      test_percolateDown_twoLevelsReversed();
 //      test_heapify_nothing();
 //      test_heapify_oneLevel();
 //      test_heapify_twoLevels();
+      test_heapifyParallel_twoLevels();
+      test_heapifyParallel_large();
+      test_heapifyParallel_ownCompare();
+      test_heapifyParallel_throws();
+      test_pushRange_standard();
+      test_popMove_empty();
+      test_popMove_standard();
 
       report("PQueue");
    }
@@ -1175,6 +1184,173 @@ public:
       pq.container.clear();
    }
 
+   // test parallel heapify with seven elements split across two threads
+   void test_heapifyParallel_twoLevels()
+   {  // setup
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 1 | 2 | 3 | 4 | 5 | 6 | 7 |   |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //             1
+      //          2      3
+      //         4 5    6 7
+      custom::priority_queue <int> pq;
+      pq.container = { 1, 2, 3, 4, 5, 6, 7 };
+      // Exercise
+      pq.heapifyParallel(2 /*numThreads*/);
+      // Verify
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 7 | 5 | 6 | 4 | 2 | 1 | 3 |   |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //             7
+      //          5      6
+      //         4 2    1 3
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[1 - 1] == 7);
+         assertUnit(pq.container[2 - 1] == 5);
+         assertUnit(pq.container[3 - 1] == 6);
+         assertUnit(pq.container[4 - 1] == 4);
+         assertUnit(pq.container[5 - 1] == 2);
+         assertUnit(pq.container[6 - 1] == 1);
+         assertUnit(pq.container[7 - 1] == 3);
+      }
+      // Teardown
+      pq.container.clear();
+   }
+
+   // test parallel heapify gives the same heap as the sequential one
+   void test_heapifyParallel_large()
+   {  // setup
+      custom::priority_queue <int> pqSequential;
+      custom::priority_queue <int> pqParallel;
+      for (int i = 0; i < 1000; i++)
+      {
+         pqSequential.container.push_back((i * 7919) % 1009);
+         pqParallel.container.push_back((i * 7919) % 1009);
+      }
+      // Exercise
+      pqSequential.heapify();
+      pqParallel.heapifyParallel(4 /*numThreads*/);
+      // Verify
+      assertUnit(pqParallel.container.size() == 1000);
+      bool same = true;
+      for (size_t i = 0; i < pqParallel.container.size(); i++)
+         if (pqParallel.container[i] != pqSequential.container[i])
+            same = false;
+      assertUnit(same);
+      // Teardown
+      pqSequential.container.clear();
+      pqParallel.container.clear();
+   }
+
+   // every thread sifts with a comparator of its own
+   void test_heapifyParallel_ownCompare()
+   {  // setup
+      custom::priority_queue <int, custom::vector<int>, oneThreadLess> pq;
+      for (int i = 0; i < 1000; i++)
+         pq.container.push_back((i * 7919) % 1009);
+      // Exercise
+      bool threw = false;
+      try
+      {
+         pq.heapifyParallel(4 /*numThreads*/);
+      }
+      catch (const std::logic_error &)
+      {
+         threw = true;
+      }
+      // Verify
+      assertUnit(threw == false);
+      bool isHeap = true;
+      for (size_t i = 1; i < pq.container.size(); i++)
+         isHeap = isHeap && !(pq.container[(i - 1) / 2] < pq.container[i]);
+      assertUnit(isHeap);
+      // Teardown
+      pq.container.clear();
+   }
+
+   // a comparator that throws on a worker thread throws from heapifyParallel
+   void test_heapifyParallel_throws()
+   {  // setup
+      custom::priority_queue <int, custom::vector<int>, limitedLess> pq;
+      for (int i = 0; i < 1000; i++)
+         pq.container.push_back(i);
+      // Exercise
+      bool threw = false;
+      try
+      {
+         pq.heapifyParallel(4 /*numThreads*/);
+      }
+      catch (const std::runtime_error &)
+      {
+         threw = true;
+      }
+      // Verify
+      assertUnit(threw == true);
+      assertUnit(pq.container.size() == 1000);
+      // Teardown
+      pq.container.clear();
+   }
+
+   // less, but a copy may only ever be used from one thread
+   struct oneThreadLess
+   {
+      std::thread::id user;
+      bool operator () (int lhs, int rhs)
+      {
+         if (user == std::thread::id())
+            user = std::this_thread::get_id();
+         else if (user != std::this_thread::get_id())
+            throw std::logic_error("comparator shared between threads");
+         return lhs < rhs;
+      }
+   };
+
+   // less, until a copy has been asked a few times
+   struct limitedLess
+   {
+      int numCalls = 0;
+      bool operator () (int lhs, int rhs)
+      {
+         if (++numCalls > 10)
+            throw std::runtime_error("out of comparisons");
+         return lhs < rhs;
+      }
+   };
+
+   // test a batch of pushes comes out the same as one at a time
+   void test_pushRange_standard()
+   {  // setup
+      custom::priority_queue <int> pqOne;
+      custom::priority_queue <int> pqBatch;
+      for (int i = 0; i < 100; i++)
+      {
+         pqOne.push((i * 31) % 101);
+         pqBatch.push((i * 31) % 101);
+      }
+      int batch[] = { 50, 150, -1, 99, 100, 0, 77 };
+      for (int value : batch)
+         pqOne.push(value);
+      // Exercise
+      pqBatch.push(batch, batch + 7);
+      // Verify
+      assertUnit(pqBatch.size() == 107);
+      bool same = pqBatch.size() == pqOne.size();
+      while (same && !pqOne.empty())
+      {
+         same = pqBatch.top() == pqOne.top();
+         pqBatch.pop();
+         pqOne.pop();
+      }
+      assertUnit(same);
+      // Teardown
+      pqOne.container.clear();
+      pqBatch.container.clear();
+   }
+
    /***************************************
     * TOP
     ***************************************/
@@ -1421,7 +1597,57 @@ public:
       teardownStandardFixture(pq);
    }
 
-   
+   // moving the top out of an empty priority queue
+   void test_popMove_empty()
+   {  // setup
+      custom::priority_queue <Spy> pq;
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool returnValue = pq.pop(value);
+      // verify
+      assertUnit(returnValue == false);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(value == Spy(99));
+      assertUnit(pq.container.size() == 0);
+   }  // teardown
+
+   // moving the top out of a 7-element priority queue
+   void test_popMove_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <Spy> pq;
+      setupStandardFixture(pq);
+      Spy value(99);
+      Spy::reset();
+      // exercise
+      bool returnValue = pq.pop(value);
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(Spy::numAssignMove() == 1);   // move [10] out
+      assertUnit(Spy::numSwap() == 3);         // swap [10,5] [9,5] [7,5]
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(value == Spy(10));
+      //                9
+      //          8            7
+      //       4     3      5
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
+      {
+         assertUnit(pq.container[0] == Spy(9));
+         assertUnit(pq.container[2] == Spy(7));
+         assertUnit(pq.container[5] == Spy(5));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
 
    /***************************************
     * PUSH
@@ -0,0 +1,461 @@
+/***********************************************************************
+ * Header:
+ *    TEST QUEUE SERVER
+ * Summary:
+ *    Unit tests for the priority queue server and its client. Where
+ *    the batching matters, the test drives the server's ticks itself;
+ *    elsewhere the server runs on its own thread.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#ifdef __linux__
+
+#include "queue_server.h"   // classes under test
+#include "unitTest.h"       // unit test baseclass
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/***********************************************
+ * TEST QUEUE SERVER
+ * Unit tests for the queue_server and
+ * queue_client classes
+ ***********************************************/
+class TestQueueServer : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_listens();
+      test_construct_replacesStale();
+      test_construct_refusesLive();
+      test_client_noServer();
+
+      // Requests
+      test_push_pop();
+      test_peek_leaves();
+      test_pop_empty();
+      test_pipeline_order();
+
+      // Batching
+      test_batch_oneTick();
+      test_batch_clientOrder();
+      test_batch_onePass();
+
+      // Connections
+      test_protocol_badOp();
+      test_client_hangup();
+      test_clients_threads();
+
+      report("QueueServer");
+   }
+
+   typedef custom::queue_server<int> server_type;
+   typedef custom::queue_client<int> client_type;
+
+   // tick until the server has taken this many connections
+   template <class Server>
+   static void acceptAll(Server & server, size_t numClients)
+   {
+      for (int i = 0; i < 100 && server.numClients() < numClients; i++)
+         server.tick(10);
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // the socket is there while the server is, and gone after
+   void test_construct_listens()
+   {  // setup
+      std::string path = scratchPath("qs", "listens");
+      {
+         // exercise
+         server_type server(path);
+         // verify
+         assertUnit(std::filesystem::is_socket(path));
+         assertUnit(server.size() == 0);
+         assertUnit(server.numClients() == 0);
+      }
+      assertUnit(!std::filesystem::exists(path));
+   }
+
+   // a socket a dead server left behind is taken over
+   void test_construct_replacesStale()
+   {  // setup
+      std::string path = scratchPath("qs", "stale");
+      int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+      sockaddr_un address = custom::unixAddress(path);
+      bind(stale, (sockaddr *)&address, sizeof(address));
+      ::close(stale);
+      assertUnit(std::filesystem::is_socket(path));
+      // exercise
+      server_type server(path);
+      // verify
+      client_type client(path);
+      acceptAll(server, 1);
+      assertUnit(server.numClients() == 1);
+   }  // teardown
+
+   // a socket a live server answers on is left alone
+   void test_construct_refusesLive()
+   {  // setup
+      std::string path = scratchPath("qs", "live");
+      server_type first(path);
+      // exercise
+      bool thrown = false;
+      try
+      {
+         server_type second(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      assertUnit(std::filesystem::is_socket(path));
+   }  // teardown
+
+   // nobody to talk to
+   void test_client_noServer()
+   {  // setup
+      std::string path = scratchPath("qs", "noserver");
+      // exercise
+      bool thrown = false;
+      try
+      {
+         client_type client(path);
+      }
+      catch (const std::system_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }
+
+   /***************************************
+    * REQUESTS
+    ***************************************/
+
+   // what goes in comes out largest first
+   void test_push_pop()
+   {  // setup
+      std::string path = scratchPath("qs", "pushpop");
+      server_type server(path);
+      std::thread serving([&server]() { server.run(); });
+      std::vector<int> popped;
+      {
+         client_type client(path);
+         // exercise
+         for (int value : { 4, 9, 1, 7, 3 })
+            client.push(value);
+         int item;
+         while (client.pop(item))
+            popped.push_back(item);
+      }
+      server.stop();
+      serving.join();
+      // verify
+      assertUnit(popped == std::vector<int>({ 9, 7, 4, 3, 1 }));
+      assertUnit(server.size() == 0);
+   }
+
+   // peek answers with the top and leaves it there
+   void test_peek_leaves()
+   {  // setup
+      std::string path = scratchPath("qs", "peek");
+      server_type server(path);
+      std::thread serving([&server]() { server.run(); });
+      int first = 0;
+      int second = 0;
+      {
+         client_type client(path);
+         client.push(5);
+         client.push(8);
+         // exercise
+         client.peek(first);
+         client.peek(second);
+      }
+      server.stop();
+      serving.join();
+      // verify
+      assertUnit(first == 8);
+      assertUnit(second == 8);
+      assertUnit(server.size() == 2);
+   }
+
+   // nothing to pop or peek
+   void test_pop_empty()
+   {  // setup
+      std::string path = scratchPath("qs", "popempty");
+      server_type server(path);
+      std::thread serving([&server]() { server.run(); });
+      bool popped = true;
+      bool peeked = true;
+      int item = -1;
+      {
+         client_type client(path);
+         // exercise
+         popped = client.pop(item);
+         peeked = client.peek(item);
+      }
+      server.stop();
+      serving.join();
+      // verify
+      assertUnit(!popped);
+      assertUnit(!peeked);
+      assertUnit(item == -1);
+   }
+
+   // answers come back one per request, in order
+   void test_pipeline_order()
+   {  // setup
+      std::string path = scratchPath("qs", "pipeline");
+      server_type server(path);
+      client_type client(path);
+      acceptAll(server, 1);
+      client.send_push(6);
+      client.send_peek();
+      client.send_pop();
+      client.send_pop();
+      client.send_peek();
+      // exercise
+      client.flush();
+      server.tick(1000);
+      // verify
+      int item = 0;
+      assertUnit(client.receive(item) == custom::queue_status::ok);
+      assertUnit(client.receive(item) == custom::queue_status::item && item == 6);
+      item = 0;
+      assertUnit(client.receive(item) == custom::queue_status::item && item == 6);
+      assertUnit(client.receive(item) == custom::queue_status::empty);
+      assertUnit(client.receive(item) == custom::queue_status::empty);
+   }  // teardown
+
+   /***************************************
+    * BATCHING
+    ***************************************/
+
+   // every client's requests go in one tick, each client's in its own order
+   void test_batch_oneTick()
+   {  // setup
+      std::string path = scratchPath("qs", "onetick");
+      server_type server(path);
+      client_type a(path);
+      client_type b(path);
+      client_type c(path);
+      acceptAll(server, 3);
+      client_type * clients[] = { &a, &b, &c };
+      for (int k = 0; k < 3; k++)
+      {
+         clients[k]->send_pop();
+         for (int i = 0; i < 10; i++)
+            clients[k]->send_push(k * 10 + i);
+         clients[k]->flush();
+      }
+      uint64_t ticksBefore = server.numTicks();
+      // exercise
+      size_t applied = server.tick(1000);
+      // verify
+      //    each pop was sent before its own pushes, so it finds nothing
+      assertUnit(applied == 33);
+      assertUnit(server.numTicks() == ticksBefore + 1);
+      assertUnit(server.size() == 30);
+      for (int k = 0; k < 3; k++)
+      {
+         int item = -1;
+         assertUnit(clients[k]->receive(item) == custom::queue_status::empty);
+         for (int i = 0; i < 10; i++)
+            assertUnit(clients[k]->receive(item) == custom::queue_status::ok);
+      }
+   }  // teardown
+
+   // a client's pop after its own push, in the same tick, sees that push
+   void test_batch_clientOrder()
+   {  // setup
+      std::string path = scratchPath("qs", "clientorder");
+      server_type server(path);
+      client_type client(path);
+      acceptAll(server, 1);
+      client.send_pop();
+      client.send_push(3);
+      client.send_peek();
+      client.send_push(8);
+      client.send_push(5);
+      client.send_pop();
+      client.send_pop();
+      client.flush();
+      // exercise
+      size_t applied = server.tick(1000);
+      // verify
+      assertUnit(applied == 7);
+      int item = -1;
+      assertUnit(client.receive(item) == custom::queue_status::empty);
+      assertUnit(client.receive(item) == custom::queue_status::ok);
+      assertUnit(client.receive(item) == custom::queue_status::item && item == 3);
+      assertUnit(client.receive(item) == custom::queue_status::ok);
+      assertUnit(client.receive(item) == custom::queue_status::ok);
+      assertUnit(client.receive(item) == custom::queue_status::item && item == 8);
+      assertUnit(client.receive(item) == custom::queue_status::item && item == 5);
+      assertUnit(server.size() == 1);
+   }  // teardown
+
+   // a batch of pushes is one heap pass, not one sift each
+   void test_batch_onePass()
+   {  // setup
+      std::string path = scratchPath("qs", "onepass");
+      custom::queue_server<int, counting> server(path);
+      client_type client(path);
+      acceptAll(server, 1);
+      for (int i = 0; i < 2000; i++)
+         client.send_push(i);
+      client.flush();
+      counting::count = 0;
+      // exercise
+      size_t applied = 0;
+      for (int i = 0; i < 100 && applied < 2000; i++)
+         applied += server.tick(100);
+      // verify
+      //    heapify is under 2n; 2000 pushes of a rising key cost ~20000
+      assertUnit(applied == 2000);
+      assertUnit(counting::count < 2 * 2000);
+      int item = -1;
+      for (int i = 0; i < 2000; i++)
+         client.receive(item);
+      client.send_peek();
+      client.flush();
+      server.tick(1000);
+      assertUnit(client.receive(item) == custom::queue_status::item);
+      assertUnit(item == 1999);
+   }  // teardown
+
+   /***************************************
+    * CONNECTIONS
+    ***************************************/
+
+   // a byte that is no request ends the conversation
+   void test_protocol_badOp()
+   {  // setup
+      std::string path = scratchPath("qs", "badop");
+      server_type server(path);
+      client_type client(path);
+      acceptAll(server, 1);
+      char junk = 9;
+      // exercise
+      ssize_t written = write(client.fd, &junk, 1);
+      server.tick(1000);
+      // verify
+      assertUnit(written == 1);
+      assertUnit(server.numClients() == 0);
+      bool thrown = false;
+      try
+      {
+         int item;
+         client.pop(item);
+      }
+      catch (const std::runtime_error &)   // a system_error too, if the send fails
+      {
+         thrown = true;
+      }
+      assertUnit(thrown);
+   }  // teardown
+
+   // a client that sends and leaves: its pushes count, and it is dropped
+   void test_client_hangup()
+   {  // setup
+      std::string path = scratchPath("qs", "hangup");
+      server_type server(path);
+      {
+         client_type client(path);
+         acceptAll(server, 1);
+         client.send_push(1);
+         client.send_push(2);
+         client.flush();
+      }
+      // exercise
+      for (int i = 0; i < 100 && server.numClients() > 0; i++)
+         server.tick(10);
+      // verify
+      assertUnit(server.numClients() == 0);
+      assertUnit(server.size() == 2);
+   }  // teardown
+
+   // many clients at once; every item turns up exactly once
+   void test_clients_threads()
+   {  // setup
+      std::string path = scratchPath("qs", "threads");
+      const int numThreads = 8;
+      const int numEach = 500;
+      server_type server(path);
+      std::thread serving([&server]() { server.run(); });
+      std::vector<std::vector<int>> popped(numThreads);
+      // exercise
+      std::vector<std::thread> threads;
+      for (int t = 0; t < numThreads; t++)
+         threads.push_back(std::thread([&path, &popped, t, numEach]()
+         {
+            client_type client(path);
+            int item;
+            for (int i = 0; i < numEach; i++)
+            {
+               client.push(t * numEach + i);
+               if (i % 2 == 1 && client.pop(item))
+                  popped[t].push_back(item);
+            }
+         }));
+      for (std::thread & thread : threads)
+         thread.join();
+      std::vector<int> seen;
+      {
+         client_type client(path);
+         int item;
+         while (client.pop(item))
+            seen.push_back(item);
+      }
+      server.stop();
+      serving.join();
+      // verify
+      for (const std::vector<int> & some : popped)
+         seen.insert(seen.end(), some.begin(), some.end());
+      std::sort(seen.begin(), seen.end());
+      bool exact = seen.size() == numThreads * numEach;
+      for (size_t i = 0; exact && i < seen.size(); i++)
+         exact = seen[i] == (int)i;
+      assertUnit(exact);
+      assertUnit(server.numRequests() > 0);
+   }
+
+private:
+   // a less-than that counts how often it runs
+   struct counting
+   {
+      static int count;
+      bool operator () (int lhs, int rhs) const
+      {
+         count++;
+         return lhs < rhs;
+      }
+   };
+};
+
+inline int TestQueueServer::counting::count = 0;
+
+#endif // __linux__
+#endif // DEBUG
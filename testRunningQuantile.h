@@ -0,0 +1,284 @@
+/***********************************************************************
+ * Header:
+ *    TEST RUNNING QUANTILE
+ * Summary:
+ *    Unit tests for the running quantile tracker
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "running_quantile.h"   // class under test
+#include "unitTest.h"           // unit test baseclass
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST RUNNING QUANTILE
+ * Unit tests for the running_quantile class
+ ***********************************************/
+class TestRunningQuantile : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_badQuantile();
+
+      // Access
+      test_value_empty();
+      test_value_one();
+
+      // Insert
+      test_insert_medianOdd();
+      test_insert_medianEven();
+      test_insert_minimum();
+      test_insert_maximum();
+      test_insert_ninetieth();
+      test_insert_random();
+      test_insertBatch_standard();
+      test_insertBatch_matchesSingle();
+
+      report("RunningQuantile");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // the median by default, and nothing in either queue
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::running_quantile<int> median;
+      // verify
+      assertUnit(median.quantile == 0.5);
+      assertUnit(median.lower.empty());
+      assertUnit(median.upper.empty());
+      assertUnit(median.empty());
+   }  // teardown
+
+   // a quantile outside [0, 1] is refused
+   void test_construct_badQuantile()
+   {  // setup
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::running_quantile<int> bad(1.5);
+      }
+      catch (const std::invalid_argument &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * VALUE
+    ***************************************/
+
+   // no values, no quantile
+   void test_value_empty()
+   {  // setup
+      custom::running_quantile<int> median;
+      // exercise
+      try
+      {
+         median.value();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   // one value is every quantile
+   void test_value_one()
+   {  // setup
+      custom::running_quantile<int> median;
+      // exercise
+      median.insert(42);
+      // verify
+      assertUnit(median.value() == 42);
+      assertUnit(median.interpolated() == 42.0);
+      assertUnit(median.lower.size() == 1);
+      assertUnit(median.upper.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * INSERT
+    ***************************************/
+
+   // {1, 3, 5, 7, 9}: the middle one, split 3 and 2
+   void test_insert_medianOdd()
+   {  // setup
+      custom::running_quantile<int> median;
+      int values[] = { 9, 1, 7, 3, 5 };
+      // exercise
+      for (int value : values)
+         median.insert(value);
+      // verify
+      assertUnit(median.value() == 5);
+      assertUnit(median.interpolated() == 5.0);
+      assertUnit(median.lower.size() == 3);
+      assertUnit(median.upper.size() == 2);
+      assertUnit(median.lower.top() == 5);
+      assertUnit(median.upper.top() == 7);
+   }  // teardown
+
+   // {2, 4, 6, 8}: the mean of the two in the middle
+   void test_insert_medianEven()
+   {  // setup
+      custom::running_quantile<int> median;
+      int values[] = { 8, 2, 6, 4 };
+      // exercise
+      for (int value : values)
+         median.insert(value);
+      // verify
+      assertUnit(median.value() == 4);
+      assertUnit(median.interpolated() == 5.0);
+      assertUnit(median.lower.size() == 2);
+      assertUnit(median.upper.size() == 2);
+   }  // teardown
+
+   // q = 0 tracks the smallest: one value below the split
+   void test_insert_minimum()
+   {  // setup
+      custom::running_quantile<int> minimum(0.0);
+      int values[] = { 5, 3, 8, 1, 9 };
+      // exercise
+      for (int value : values)
+         minimum.insert(value);
+      // verify
+      assertUnit(minimum.value() == 1);
+      assertUnit(minimum.lower.size() == 1);
+      assertUnit(minimum.upper.size() == 4);
+   }  // teardown
+
+   // q = 1 tracks the largest: nothing above the split
+   void test_insert_maximum()
+   {  // setup
+      custom::running_quantile<int> maximum(1.0);
+      int values[] = { 5, 3, 8, 1, 9 };
+      // exercise
+      for (int value : values)
+         maximum.insert(value);
+      // verify
+      assertUnit(maximum.value() == 9);
+      assertUnit(maximum.interpolated() == 9.0);
+      assertUnit(maximum.upper.empty());
+   }  // teardown
+
+   // p90 of 1..21: rank 18, the value 19
+   void test_insert_ninetieth()
+   {  // setup
+      custom::running_quantile<double> p90(0.9);
+      // exercise
+      for (int i = 21; i >= 1; i--)
+         p90.insert((double)i);
+      // verify
+      assertUnit(p90.value() == 19.0);
+      assertUnit(p90.lower.size() == 19);
+      assertUnit(p90.upper.size() == 2);
+   }  // teardown
+
+   // after every insert, several quantiles agree with sorting
+   void test_insert_random()
+   {  // setup
+      double quantiles[] = { 0.0, 0.25, 0.5, 0.9, 0.99, 1.0 };
+      bool same = true;
+      // exercise
+      for (double q : quantiles)
+      {
+         custom::running_quantile<int> tracker(q);
+         std::vector<int> values;
+         unsigned int seed = 555;
+         for (int i = 0; i < 500 && same; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            values.push_back((int)((seed >> 8) % 1000));
+            tracker.insert(values.back());
+            same = tracker.value() == expected(values, q) &&
+                   std::fabs(tracker.interpolated() - expectedInterpolated(values, q)) < 1e-9;
+         }
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // a batch lands in the right queues with one rebalance
+   void test_insertBatch_standard()
+   {  // setup
+      custom::running_quantile<int> median;
+      median.insert(50);
+      std::vector<int> batch { 10, 20, 30, 40, 60 };
+      // exercise
+      median.insert(batch.begin(), batch.end());
+      // verify
+      assertUnit(median.size() == 6);
+      assertUnit(median.value() == 30);
+      assertUnit(median.interpolated() == 35.0);
+      assertUnit(median.lower.size() == 3);
+      assertUnit(median.upper.size() == 3);
+   }  // teardown
+
+   // batches of every size end in the same place as single inserts
+   void test_insertBatch_matchesSingle()
+   {  // setup
+      custom::running_quantile<int> batched(0.75);
+      custom::running_quantile<int> single(0.75);
+      std::vector<int> values;
+      unsigned int seed = 808;
+      bool same = true;
+      // exercise
+      for (int round = 1; round <= 40 && same; round++)
+      {
+         std::vector<int> batch;
+         for (int i = 0; i < round; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            batch.push_back((int)((seed >> 8) % 10000));
+            single.insert(batch.back());
+         }
+         batched.insert(batch.begin(), batch.end());
+         same = batched.value() == single.value() &&
+                batched.lower.size() == single.lower.size() &&
+                batched.upper.size() == single.upper.size();
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+private:
+   static int expected(std::vector<int> values, double q)
+   {
+      std::sort(values.begin(), values.end());
+      return values[(size_t)(q * (double)(values.size() - 1))];
+   }
+
+   static double expectedInterpolated(std::vector<int> values, double q)
+   {
+      std::sort(values.begin(), values.end());
+      double rank = q * (double)(values.size() - 1);
+      size_t below = (size_t)rank;
+      if (below + 1 >= values.size())
+         return values[below];
+      return values[below] + (rank - (double)below) * (values[below + 1] - values[below]);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,322 @@
+/***********************************************************************
+ * Header:
+ *    TEST SEQUENCE HEAP
+ * Summary:
+ *    Unit tests for the sequence heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "sequence_heap.h"   // class under test
+#include "priority_queue.h"
+#include "unitTest.h"        // unit test baseclass
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST SEQUENCE HEAP
+ * Unit tests for the sequence_heap class
+ ***********************************************/
+class TestSequenceHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_badSizes();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_belowM();
+      test_push_spill();
+      test_push_cascade();
+
+      // Remove
+      test_pop_insertionFirst();
+      test_pop_refill();
+      test_pop_sorted();
+      test_pop_greater();
+      test_pop_strings();
+
+      // Mixed
+      test_mixed_matchesQueue();
+
+      report("SequenceHeap");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // empty, with room in the small buffers
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::sequence_heap<int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.m == 256);
+      assertUnit(heap.k == 64);
+      assertUnit(heap.insertion.capacity() >= 256);
+      assertUnit(heap.groups.empty());
+   }  // teardown
+
+   // a group must be able to hold two runs
+   void test_construct_badSizes()
+   {  // setup
+      bool thrown = false;
+      // exercise
+      try
+      {
+         custom::sequence_heap<int> heap(4, 1);
+      }
+      catch (const std::invalid_argument &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty heap
+   void test_top_empty()
+   {  // setup
+      custom::sequence_heap<int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // fewer than m items stay in the insertion heap
+   void test_push_belowM()
+   {  // setup
+      custom::sequence_heap<int> heap(4, 2);
+      // exercise
+      heap.push(3);
+      heap.push(9);
+      heap.push(5);
+      // verify
+      assertUnit(heap.insertion.size() == 3);
+      assertUnit(heap.groups.empty());
+      assertUnit(heap.top() == 9);
+   }  // teardown
+
+   // the m-th push sorts the heap into a run, and the buffer takes the best
+   void test_push_spill()
+   {  // setup
+      custom::sequence_heap<int> heap(4, 2);
+      // exercise
+      heap.push(3);
+      heap.push(9);
+      heap.push(5);
+      heap.push(7);
+      // verify
+      //    group 0: [9 7 5 3], moved straight to the buffer
+      assertUnit(heap.insertion.empty());
+      assertUnit(heap.groups.size() == 1);
+      assertUnit(heap.deletion.size() == 4);
+      assertUnit(heap.deletion.back() == 9);
+      assertUnit(heap.deletion.front() == 3);
+      assertUnit(heap.top() == 9);
+      assertUnit(heap.size() == 4);
+   }  // teardown
+
+   // k full runs merge into one in the next group
+   void test_push_cascade()
+   {  // setup
+      custom::sequence_heap<int> heap(4, 2);
+      // exercise: 5 spills of 4 with k = 2
+      for (int i = 0; i < 20; i++)
+         heap.push((i * 7) % 20);
+      // verify
+      assertUnit(heap.groups.size() >= 2);
+      assertUnit(heap.size() == 20);
+      bool runsSorted = true;
+      for (size_t g = 0; g < heap.groups.size(); g++)
+      {
+         assertUnit(heap.groups[g].runs.size() <= heap.k);
+         for (size_t r = 0; r < heap.groups[g].runs.size(); r++)
+         {
+            const custom::vector<int> & run = heap.groups[g].runs[r];
+            for (size_t i = 1; i < run.size(); i++)
+               runsSorted = runsSorted && !(run[i - 1] < run[i]);
+         }
+      }
+      assertUnit(runsSorted);
+      assertUnit(heap.top() == 19);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // a new push larger than the buffer comes out first
+   void test_pop_insertionFirst()
+   {  // setup
+      custom::sequence_heap<int> heap(4, 2);
+      for (int i = 1; i <= 4; i++)
+         heap.push(i);
+      heap.push(100);
+      // exercise
+      int first = heap.top();
+      heap.pop();
+      // verify
+      assertUnit(first == 100);
+      assertUnit(heap.insertion.empty());
+      assertUnit(heap.top() == 4);
+   }  // teardown
+
+   // draining the buffer pulls the next m from the groups
+   void test_pop_refill()
+   {  // setup
+      custom::sequence_heap<int> heap(4, 4);
+      for (int i = 0; i < 12; i++)
+         heap.push(i);
+      // exercise
+      for (int i = 0; i < 4; i++)
+         heap.pop();
+      // verify
+      assertUnit(heap.deletion.size() == 4);
+      assertUnit(heap.top() == 7);
+      assertUnit(heap.size() == 8);
+   }  // teardown
+
+   // a large random fill comes out in order
+   void test_pop_sorted()
+   {  // setup
+      custom::sequence_heap<int> heap(8, 3);
+      std::vector<int> values;
+      unsigned int seed = 61;
+      for (int i = 0; i < 3000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 5000));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<int>());
+      // exercise
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+   }  // teardown
+
+   // greater<> puts the smallest on top
+   void test_pop_greater()
+   {  // setup
+      custom::sequence_heap<int, std::greater<int>> heap(4, 2);
+      for (int i = 20; i > 0; i--)
+         heap.push(i);
+      // exercise
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      bool ascending = output.size() == 20;
+      for (size_t i = 0; ascending && i < output.size(); i++)
+         ascending = output[i] == (int)i + 1;
+      assertUnit(ascending);
+   }  // teardown
+
+   // items that own memory move through the runs intact
+   void test_pop_strings()
+   {  // setup
+      custom::sequence_heap<std::string> heap(4, 2);
+      std::vector<std::string> values;
+      for (int i = 0; i < 50; i++)
+      {
+         values.push_back("item-" + std::to_string((i * 31) % 50 + 100));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<std::string>());
+      // exercise
+      std::vector<std::string> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+   }  // teardown
+
+   /***************************************
+    * MIXED
+    ***************************************/
+
+   // interleaved pushes and pops keep step with priority_queue
+   void test_mixed_matchesQueue()
+   {  // setup
+      custom::sequence_heap<int> heap(16, 4);
+      custom::priority_queue<int> queue;
+      unsigned int seed = 7;
+      bool same = true;
+      // exercise
+      for (int step = 0; step < 20000 && same; step++)
+      {
+         seed = seed * 1103515245 + 12345;
+         if ((seed >> 8) % 3 != 0 || queue.empty())
+         {
+            seed = seed * 1103515245 + 12345;
+            int value = (int)((seed >> 8) % 100000);
+            heap.push(value);
+            queue.push(value);
+         }
+         else
+         {
+            same = heap.top() == queue.top();
+            heap.pop();
+            queue.pop();
+         }
+         same = same && heap.size() == queue.size();
+      }
+      while (same && !queue.empty())
+      {
+         same = heap.top() == queue.top();
+         heap.pop();
+         queue.pop();
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(heap.empty());
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,476 @@
+/***********************************************************************
+ * Header:
+ *    TEST SHARED PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the priority queue in shared memory. The stress
+ *    tests fork worker processes that share one queue, and kill them
+ *    at random while they work.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#ifdef __linux__
+
+#include "shared_priority_queue.h"   // class under test
+#include "priority_queue.h"
+#include "unitTest.h"                // unit test baseclass
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/***********************************************
+ * TEST SHARED PRIORITY QUEUE
+ * Unit tests for the shared_priority_queue class
+ ***********************************************/
+class TestSharedPriorityQueue : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_create();
+      test_construct_attach();
+      test_construct_keepsCapacity();
+      test_construct_wrongElementSize();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_full();
+
+      // Remove
+      test_pop_sorted();
+      test_pop_empty();
+
+      // Recovery
+      test_recover_ownerDied();
+      test_recover_midPush();
+      test_recover_midPop();
+
+      // Processes
+      test_stress_processes();
+      test_stress_killed();
+
+      report("SharedPQueue");
+   }
+
+   typedef custom::shared_priority_queue<int> queue_type;
+
+   // a fresh segment name for this process, with nothing there
+   static std::string scratch(const std::string & name)
+   {
+      std::string path = "/" + scratchName("spq", name);
+      queue_type::remove(path);
+      return path;
+   }
+
+   // lock in a child process, then die holding the lock
+   static void dieHoldingLock(const std::string & name)
+   {
+      pid_t child = fork();
+      if (child == 0)
+      {
+         queue_type queue(name, 1);
+         queue.lock();
+         _exit(0);
+      }
+      waitpid(child, nullptr, 0);
+   }
+
+   // is every item below its parent?
+   static bool isHeap(const queue_type & queue)
+   {
+      const int * items = queue.data();
+      for (size_t i = 1; i < queue.head->count; i++)
+         if (items[(i - 1) / 2] < items[i])
+            return false;
+      return true;
+   }
+
+   // the items in the queue, smallest first
+   static std::vector<int> contents(const queue_type & queue)
+   {
+      std::vector<int> items(queue.data(), queue.data() + queue.head->count);
+      std::sort(items.begin(), items.end());
+      return items;
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // the first to open a name builds the segment
+   void test_construct_create()
+   {  // setup
+      std::string name = scratch("create");
+      // exercise
+      queue_type queue(name, 100);
+      // verify
+      assertUnit(queue.empty());
+      assertUnit(queue.capacity() == 100);
+      assertUnit(queue.head->ready.load() == queue_type::READY);
+      assertUnit(queue.head->hole.load() == queue_type::NONE);
+      assertUnit(queue.mappedBytes == queue_type::DATA_OFFSET + 100 * sizeof(int));
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // a second mapping of the same name sees the same items
+   void test_construct_attach()
+   {  // setup
+      std::string name = scratch("attach");
+      queue_type first(name, 100);
+      first.push(5);
+      first.push(9);
+      // exercise
+      queue_type second(name, 100);
+      // verify
+      assertUnit(second.size() == 2);
+      assertUnit(second.top() == 9);
+      second.push(12);
+      assertUnit(first.top() == 12);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // only the creator's capacity counts
+   void test_construct_keepsCapacity()
+   {  // setup
+      std::string name = scratch("capacity");
+      queue_type first(name, 10);
+      // exercise
+      queue_type second(name, 5000);
+      // verify
+      assertUnit(second.capacity() == 10);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // a segment of ints is not a segment of doubles
+   void test_construct_wrongElementSize()
+   {  // setup
+      std::string name = scratch("elementsize");
+      queue_type first(name, 10);
+      // exercise
+      bool thrown = false;
+      try
+      {
+         custom::shared_priority_queue<double> second(name, 10);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty queue
+   void test_top_empty()
+   {  // setup
+      std::string name = scratch("top");
+      queue_type queue(name, 10);
+      // exercise
+      try
+      {
+         queue.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      // teardown
+      queue_type::remove(name);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // a full queue turns a push away and keeps what it has
+   void test_push_full()
+   {  // setup
+      std::string name = scratch("full");
+      queue_type queue(name, 3);
+      queue.push(1);
+      queue.push(2);
+      queue.push(3);
+      // exercise
+      bool pushed = queue.push(4);
+      // verify
+      assertUnit(!pushed);
+      assertUnit(queue.size() == 3);
+      assertUnit(queue.top() == 3);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // the order matches priority_queue
+   void test_pop_sorted()
+   {  // setup
+      std::string name = scratch("sorted");
+      queue_type queue(name, 3000);
+      custom::priority_queue<int> reference;
+      unsigned int seed = 23;
+      for (int i = 0; i < 3000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         queue.push((int)((seed >> 8) % 1000));
+         reference.push((int)((seed >> 8) % 1000));
+      }
+      // exercise
+      bool same = true;
+      int item;
+      while (queue.pop(item))
+      {
+         same = same && !reference.empty() && item == reference.top();
+         reference.pop();
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(reference.empty());
+      assertUnit(queue.head->hole.load() == queue_type::NONE);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // nothing to pop
+   void test_pop_empty()
+   {  // setup
+      std::string name = scratch("popempty");
+      queue_type queue(name, 10);
+      int item = -1;
+      // exercise
+      bool popped = queue.pop(item);
+      // verify
+      assertUnit(!popped);
+      assertUnit(item == -1);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   /***************************************
+    * RECOVERY
+    ***************************************/
+
+   // a process died holding the lock between operations: nothing to fix
+   void test_recover_ownerDied()
+   {  // setup
+      std::string name = scratch("ownerdied");
+      queue_type queue(name, 10);
+      queue.push(4);
+      queue.push(8);
+      dieHoldingLock(name);
+      // exercise
+      bool pushed = queue.push(6);
+      // verify
+      assertUnit(pushed);
+      assertUnit(queue.head->recoveries == 1);
+      assertUnit(queue.size() == 3);
+      assertUnit(queue.top() == 8);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // a push cut off after one step of its sift
+   void test_recover_midPush()
+   {  // setup
+      std::string name = scratch("midpush");
+      queue_type queue(name, 10);
+      for (int i : { 90, 70, 80, 10, 20, 30 })
+         queue.push(i);
+      //    pushing 75 at index 6: its parent, index 2 (80), has not moved
+      //    down yet, then has; the hole is at index 2
+      int * items = queue.data();
+      *queue.pending() = 75;
+      queue.head->pendingCount = 7;
+      queue.head->count = 7;
+      items[6] = items[2];
+      queue.head->hole.store(2);
+      items[2] = 12345;             // half-written rubbish; the hole is not an item
+      dieHoldingLock(name);
+      // exercise
+      int top = queue.top();
+      // verify
+      assertUnit(top == 90);
+      assertUnit(queue.head->recoveries == 1);
+      assertUnit(queue.head->hole.load() == queue_type::NONE);
+      assertUnit(isHeap(queue));
+      assertUnit(contents(queue) == std::vector<int>({ 10, 20, 30, 70, 75, 80, 90 }));
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // a pop cut off after the top went, before its sift was done
+   void test_recover_midPop()
+   {  // setup
+      std::string name = scratch("midpop");
+      queue_type queue(name, 10);
+      for (int i : { 90, 70, 80, 10, 20, 30 })
+         queue.push(i);
+      //    popping 90: the last item, 30, waits in pending and the hole
+      //    at the top has taken its larger child, 80, from index 2
+      int * items = queue.data();
+      *queue.pending() = items[5];
+      queue.head->pendingCount = 5;
+      queue.head->hole.store(0);
+      queue.head->count = 5;
+      items[0] = items[2];
+      queue.head->hole.store(2);
+      dieHoldingLock(name);
+      // exercise
+      size_t size = queue.size();
+      // verify
+      assertUnit(size == 5);
+      assertUnit(queue.head->recoveries == 1);
+      assertUnit(isHeap(queue));
+      assertUnit(contents(queue) == std::vector<int>({ 10, 20, 30, 70, 80 }));
+      // teardown
+      queue_type::remove(name);
+   }
+
+   /***************************************
+    * PROCESSES
+    ***************************************/
+
+   // workers push and pop at once; every item turns up exactly once
+   void test_stress_processes()
+   {  // setup
+      std::string name = scratch("stress");
+      const int numWorkers = 4;
+      const int numEach = 2000;
+      queue_type queue(name, numWorkers * numEach);
+      std::vector<pid_t> children;
+      std::vector<int> pipes;
+      // exercise
+      for (int w = 0; w < numWorkers; w++)
+      {
+         int ends[2];
+         if (pipe(ends) != 0)
+            break;
+         pid_t child = fork();
+         if (child == 0)
+         {
+            ::close(ends[0]);
+            queue_type worker(name, 1);
+            int popped[numEach / 2];
+            int numPopped = 0;
+            for (int i = 0; i < numEach; i++)
+            {
+               worker.push(w * numEach + i);
+               if (i % 2 == 1 && worker.pop(popped[numPopped]))
+                  numPopped++;
+            }
+            ssize_t written = write(ends[1], popped, numPopped * sizeof(int));
+            _exit(written == (ssize_t)(numPopped * sizeof(int)) ? 0 : 1);
+         }
+         ::close(ends[1]);
+         children.push_back(child);
+         pipes.push_back(ends[0]);
+      }
+      std::vector<int> seen;
+      for (size_t w = 0; w < children.size(); w++)
+      {
+         int buffer[numEach / 2];
+         ssize_t numRead;
+         while ((numRead = read(pipes[w], buffer, sizeof(buffer))) > 0)
+            seen.insert(seen.end(), buffer, buffer + numRead / sizeof(int));
+         ::close(pipes[w]);
+         waitpid(children[w], nullptr, 0);
+      }
+      // verify
+      //    what is left comes out in order
+      bool descending = true;
+      int item;
+      int previous = numWorkers * numEach;
+      while (queue.pop(item))
+      {
+         descending = descending && item <= previous;
+         previous = item;
+         seen.push_back(item);
+      }
+      std::sort(seen.begin(), seen.end());
+      bool exact = seen.size() == numWorkers * numEach;
+      for (size_t i = 0; exact && i < seen.size(); i++)
+         exact = seen[i] == (int)i;
+      assertUnit(children.size() == numWorkers);
+      assertUnit(descending);
+      assertUnit(exact);
+      // teardown
+      queue_type::remove(name);
+   }
+
+   // workers are killed mid-operation; the queue is still a heap of
+   // distinct items that were really pushed
+   void test_stress_killed()
+   {  // setup
+      std::string name = scratch("killed");
+      const int numWorkers = 4;
+      const int numEach = 1000000;
+      queue_type queue(name, 1 << 20);
+      std::vector<pid_t> children;
+      for (int w = 0; w < numWorkers; w++)
+      {
+         pid_t child = fork();
+         if (child == 0)
+         {
+            queue_type worker(name, 1);
+            int popped;
+            for (int i = 0; i < numEach; i++)
+            {
+               worker.push(w * numEach + i);
+               if (i % 3 == 2)
+                  worker.pop(popped);
+            }
+            for (;;)
+               pause();
+         }
+         children.push_back(child);
+      }
+      // exercise
+      for (pid_t child : children)
+      {
+         std::this_thread::sleep_for(std::chrono::milliseconds(20));
+         kill(child, SIGKILL);
+         waitpid(child, nullptr, 0);
+      }
+      // verify
+      size_t size = queue.size();
+      assertUnit(queue.head->hole.load() == queue_type::NONE);
+      assertUnit(isHeap(queue));
+      std::vector<int> items = contents(queue);
+      assertUnit(std::adjacent_find(items.begin(), items.end()) == items.end());
+      assertUnit(items.size() == size);
+      assertUnit(items.empty() || (items.front() >= 0 && items.back() < numWorkers * numEach));
+      // teardown
+      queue_type::remove(name);
+   }
+};
+
+#endif // __linux__
+#endif // DEBUG
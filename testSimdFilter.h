@@ -0,0 +1,234 @@
+/***********************************************************************
+ * Header:
+ *    TEST SIMD FILTER
+ * Summary:
+ *    Unit tests for the SIMD threshold filter. Every kernel the
+ *    processor supports is checked against the scalar loop.
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "simd_filter.h"   // class under test
+#include "unitTest.h"      // unit test baseclass
+#include "spy.h"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+/***********************************************
+ * TEST SIMD FILTER
+ * Unit tests for simd::skip and filter
+ ***********************************************/
+class TestSimdFilter : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Detect
+      test_detect_cached();
+
+      // Skip
+      test_skip_empty();
+      test_skip_none();
+      test_skip_first();
+      test_skip_tail();
+      test_skip_ties();
+      test_skip_nan();
+      test_skip_randomFloat();
+      test_skip_randomInt32();
+      test_skip_randomInt64();
+
+      // Filter
+      test_filter_generic();
+      test_filter_greater();
+
+      report("SimdFilter");
+   }
+
+   /***************************************
+    * DETECT
+    ***************************************/
+
+   // the answer never changes
+   void test_detect_cached()
+   {  // setup
+      // exercise
+      custom::simd::level first = custom::simd::detect();
+      custom::simd::level second = custom::simd::detect();
+      // verify
+      assertUnit(first == second);
+      assertUnit(first == custom::simd::probe());
+   }  // teardown
+
+   /***************************************
+    * SKIP
+    ***************************************/
+
+   // nothing to look at
+   void test_skip_empty()
+   {  // setup
+      float keys[1] = { 9.0f };
+      bool same = true;
+      // exercise
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+         same = same && custom::simd::skip<true>(keys, 0, 1.0f, (custom::simd::level)use) == 0;
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // every key loses: the whole run is skipped
+   void test_skip_none()
+   {  // setup
+      int32_t keys[19];
+      for (int i = 0; i < 19; i++)
+         keys[i] = i - 5;
+      bool same = true;
+      // exercise
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+         same = same && custom::simd::skip<true>(keys, 19, 13, (custom::simd::level)use) == 19;
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // a survivor in the very first lane
+   void test_skip_first()
+   {  // setup
+      int64_t keys[9] = { 100, 1, 1, 1, 1, 1, 1, 1, 1 };
+      bool same = true;
+      // exercise
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+         same = same && custom::simd::skip<true>(keys, 9, (int64_t)50, (custom::simd::level)use) == 0;
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // a survivor past the last full block is found by the scalar tail
+   void test_skip_tail()
+   {  // setup
+      float keys[11] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 99 };
+      bool same = true;
+      // exercise
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+         same = same && custom::simd::skip<true>(keys, 11, 50.0f, (custom::simd::level)use) == 10;
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // equal to the threshold does not beat it
+   void test_skip_ties()
+   {  // setup
+      int32_t keys[8] = { 7, 7, 7, 7, 7, 7, 7, 7 };
+      bool same = true;
+      // exercise
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+      {
+         same = same && custom::simd::skip<true >(keys, 8, 7, (custom::simd::level)use) == 8;
+         same = same && custom::simd::skip<false>(keys, 8, 7, (custom::simd::level)use) == 8;
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // NaN never beats anything, in either direction
+   void test_skip_nan()
+   {  // setup
+      float nan = std::numeric_limits<float>::quiet_NaN();
+      float keys[9] = { nan, nan, nan, nan, nan, nan, nan, nan, 3.0f };
+      bool same = true;
+      // exercise
+      for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+      {
+         same = same && custom::simd::skip<true >(keys, 9, 2.0f, (custom::simd::level)use) == 8;
+         same = same && custom::simd::skip<false>(keys, 9, 4.0f, (custom::simd::level)use) == 8;
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+   // every length and every survivor position agrees with the scalar loop
+   void test_skip_randomFloat()
+   {
+      assertUnit(agrees<float>());
+   }
+
+   void test_skip_randomInt32()
+   {
+      assertUnit(agrees<int32_t>());
+   }
+
+   void test_skip_randomInt64()
+   {
+      assertUnit(agrees<int64_t>());
+   }
+
+   /***************************************
+    * FILTER
+    ***************************************/
+
+   // a type without a kernel costs one comparison per key
+   void test_filter_generic()
+   {  // setup
+      std::vector <Spy> keys { Spy(1), Spy(2), Spy(3), Spy(8), Spy(4) };
+      Spy threshold(5);
+      Spy::reset();
+      // exercise
+      size_t index = custom::filter<Spy, std::less<Spy>>::skip(
+         keys.data(), keys.size(), threshold, std::less<Spy>());
+      // verify
+      assertUnit(index == 3);
+      assertUnit(Spy::numLessthan() == 4);   // [5<1] [5<2] [5<3] [5<8]
+   }  // teardown
+
+   // greater<> keeps the smallest, so smaller keys survive
+   void test_filter_greater()
+   {  // setup
+      int32_t keys[10] = { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+      // exercise
+      size_t index = custom::filter<int32_t, std::greater<int32_t>>::skip(
+         keys, 10, 3, std::greater<int32_t>());
+      // verify
+      assertUnit(index == 7);
+   }  // teardown
+
+private:
+   // compare every supported level to the scalar loop on random keys
+   template <class T>
+   bool agrees()
+   {
+      unsigned int seed = 4242;
+      bool same = true;
+      for (size_t n = 0; n <= 40 && same; n++)
+         for (int trial = 0; trial < 20 && same; trial++)
+         {
+            std::vector <T> keys(n + 1);
+            for (size_t i = 0; i < n; i++)
+            {
+               seed = seed * 1103515245 + 12345;
+               keys[i] = (T)((int)((seed >> 8) % 2001) - 1000);
+            }
+            // thresholds near the ends, so survivors are rare
+            seed = seed * 1103515245 + 12345;
+            T high = (T)(1000 - (int)((seed >> 8) % 100));
+            T low  = (T)((int)((seed >> 16) % 100) - 1000);
+
+            size_t above = custom::simd::skipScalar<true >(keys.data(), n, high);
+            size_t below = custom::simd::skipScalar<false>(keys.data(), n, low);
+            for (int use = custom::simd::SCALAR; use <= custom::simd::detect(); use++)
+            {
+               same = same && custom::simd::skip<true >(keys.data(), n, high, (custom::simd::level)use) == above;
+               same = same && custom::simd::skip<false>(keys.data(), n, low,  (custom::simd::level)use) == below;
+            }
+         }
+      return same;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,359 @@
+/***********************************************************************
+ * Header:
+ *    TEST SLIDING WINDOW
+ * Summary:
+ *    Unit tests for the ring, sliding_max and sliding_top_k
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "sliding_window.h"   // class under test
+#include "unitTest.h"         // unit test baseclass
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST SLIDING WINDOW
+ * Unit tests for the sliding window classes
+ ***********************************************/
+class TestSlidingWindow : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Ring
+      test_ring_wrap();
+      test_ring_grow();
+
+      // Sliding max
+      test_max_empty();
+      test_max_decreasing();
+      test_max_evicts();
+      test_max_expire();
+      test_max_ties();
+      test_max_clock();
+      test_max_random();
+
+      // Sliding top K
+      test_topK_empty();
+      test_topK_fewerThanK();
+      test_topK_expire();
+      test_topK_expireAll();
+      test_topK_staleRoot();
+      test_topK_compact();
+      test_topK_random();
+
+      report("SlidingWindow");
+   }
+
+   /***************************************
+    * RING
+    ***************************************/
+
+   // the front walks around the buffer without growing it
+   void test_ring_wrap()
+   {  // setup
+      custom::ring<int> r;
+      for (int i = 0; i < 6; i++)
+         r.push_back(i);
+      // exercise
+      for (int i = 0; i < 5; i++)
+         r.pop_front();
+      for (int i = 6; i < 12; i++)
+         r.push_back(i);
+      // verify
+      assertUnit(r.buffer.size() == 8);
+      assertUnit(r.size() == 7);
+      assertUnit(r.front() == 5);
+      assertUnit(r.back() == 11);
+      bool inOrder = true;
+      for (size_t i = 0; i < r.size(); i++)
+         inOrder = inOrder && r[i] == (int)(5 + i);
+      assertUnit(inOrder);
+   }  // teardown
+
+   // growing a wrapped ring keeps the order
+   void test_ring_grow()
+   {  // setup
+      custom::ring<int> r;
+      for (int i = 0; i < 8; i++)
+         r.push_back(i);
+      r.pop_front();
+      r.pop_front();
+      r.push_back(8);
+      r.push_back(9);
+      // exercise
+      r.push_back(10);
+      // verify
+      assertUnit(r.buffer.size() == 16);
+      assertUnit(r.head == 0);
+      bool inOrder = r.size() == 9;
+      for (size_t i = 0; inOrder && i < r.size(); i++)
+         inOrder = r[i] == (int)(2 + i);
+      assertUnit(inOrder);
+   }  // teardown
+
+   /***************************************
+    * SLIDING MAX
+    ***************************************/
+
+   // nothing in the window: no max
+   void test_max_empty()
+   {  // setup
+      custom::sliding_max<int, int> window;
+      // exercise
+      try
+      {
+         window.max();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      assertUnit(window.empty());
+   }  // teardown
+
+   // decreasing values are all kept as candidates
+   void test_max_decreasing()
+   {  // setup
+      custom::sliding_max<int, int> window;
+      // exercise
+      window.push(0, 9);
+      window.push(1, 7);
+      window.push(2, 4);
+      // verify
+      assertUnit(window.candidates.size() == 3);
+      assertUnit(window.max() == 9);
+   }  // teardown
+
+   // a larger value evicts every smaller one before it
+   void test_max_evicts()
+   {  // setup
+      custom::sliding_max<int, int> window;
+      window.push(0, 3);
+      window.push(1, 1);
+      window.push(2, 2);
+      // exercise
+      window.push(3, 5);
+      // verify
+      assertUnit(window.candidates.size() == 1);
+      assertUnit(window.max() == 5);
+   }  // teardown
+
+   // once the max leaves the window, the next candidate takes over
+   void test_max_expire()
+   {  // setup
+      custom::sliding_max<int, int> window;
+      window.push(0, 9);
+      window.push(1, 7);
+      window.push(2, 4);
+      // exercise
+      window.expire(1);
+      // verify
+      assertUnit(window.max() == 7);
+      window.expire(3);
+      assertUnit(window.empty());
+   }  // teardown
+
+   // the newer of two equal values is the one kept
+   void test_max_ties()
+   {  // setup
+      custom::sliding_max<int, int> window;
+      // exercise
+      window.push(0, 6);
+      window.push(5, 6);
+      window.expire(1);
+      // verify
+      assertUnit(window.candidates.size() == 1);
+      assertUnit(window.max() == 6);
+   }  // teardown
+
+   // real time stamps: max latency over the last 60 seconds
+   void test_max_clock()
+   {  // setup
+      typedef std::chrono::steady_clock clock;
+      clock::time_point start = clock::now();
+      custom::sliding_max<double> latency;
+      latency.push(start, 12.5);
+      latency.push(start + std::chrono::seconds(30), 3.0);
+      latency.push(start + std::chrono::seconds(70), 4.0);
+      // exercise
+      latency.expire(start + std::chrono::seconds(70) - std::chrono::seconds(60));
+      // verify
+      assertUnit(latency.max() == 4.0);
+   }  // teardown
+
+   // a count window agrees with scanning the last N
+   void test_max_random()
+   {  // setup
+      custom::sliding_max<int, int> window;
+      std::vector<int> values;
+      const int n = 50;
+      unsigned int seed = 99;
+      bool same = true;
+      // exercise
+      for (int i = 0; i < 5000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 1000));
+         window.push(i, values.back());
+         window.expire(i - n + 1);
+         int expected = *std::max_element(values.begin() + std::max(0, i - n + 1), values.end());
+         same = same && window.max() == expected;
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(window.candidates.size() <= (size_t)n);
+   }  // teardown
+
+   /***************************************
+    * SLIDING TOP K
+    ***************************************/
+
+   // nothing to report
+   void test_topK_empty()
+   {  // setup
+      custom::sliding_top_k<int, 3, int> window;
+      // exercise
+      custom::vector<int> best = window.top();
+      // verify
+      assertUnit(best.size() == 0);
+      assertUnit(window.empty());
+   }  // teardown
+
+   // fewer than K live: all of them, best first
+   void test_topK_fewerThanK()
+   {  // setup
+      custom::sliding_top_k<int, 3, int> window;
+      window.push(0, 4);
+      window.push(1, 8);
+      // exercise
+      custom::vector<int> best = window.top();
+      // verify
+      assertUnit(best.size() == 2);
+      if (best.size() == 2)
+      {
+         assertUnit(best[0] == 8);
+         assertUnit(best[1] == 4);
+      }
+   }  // teardown
+
+   // expired events no longer count, even when they are the best
+   void test_topK_expire()
+   {  // setup
+      custom::sliding_top_k<int, 2, int> window;
+      window.push(0, 100);
+      window.push(1, 1);
+      window.push(2, 90);
+      window.push(3, 5);
+      window.push(4, 3);
+      // exercise
+      size_t numExpired = window.expire(3);
+      custom::vector<int> best = window.top();
+      // verify
+      assertUnit(numExpired == 3);
+      assertUnit(window.size() == 2);
+      assertUnit(best.size() == 2);
+      if (best.size() == 2)
+      {
+         assertUnit(best[0] == 5);
+         assertUnit(best[1] == 3);
+      }
+   }  // teardown
+
+   // a bulk expiry past the newest event empties the window
+   void test_topK_expireAll()
+   {  // setup
+      custom::sliding_top_k<int, 4, int> window;
+      for (int i = 0; i < 100; i++)
+         window.push(i, i * 7 % 13);
+      // exercise
+      size_t numExpired = window.expire(1000);
+      // verify
+      assertUnit(numExpired == 100);
+      assertUnit(window.empty());
+      assertUnit(window.heap.empty());
+      assertUnit(window.top().size() == 0);
+   }  // teardown
+
+   // an expired root is dropped right away; others may linger
+   void test_topK_staleRoot()
+   {  // setup
+      custom::sliding_top_k<int, 2, int> window;
+      for (int i = 0; i < 40; i++)
+         window.push(i, i == 0 ? 1000 : i);
+      // exercise
+      window.expire(1);
+      // verify
+      assertUnit(window.heap.size() == 39);
+      assertUnit(window.heap[0].value == 39);
+      assertUnit(window.size() == 39);
+   }  // teardown
+
+   // stale entries never outnumber the live ones for long
+   void test_topK_compact()
+   {  // setup
+      custom::sliding_top_k<int, 5, int> window;
+      bool bounded = true;
+      // exercise: the newest is the best, so the stale entries sink out of sight
+      for (int i = 0; i < 10000; i++)
+      {
+         window.push(i, i);
+         window.expire(i - 99);
+         bounded = bounded && window.heap.size() <= 2 * window.size() + 16;
+      }
+      // verify
+      assertUnit(bounded);
+      assertUnit(window.size() == 100);
+      custom::vector<int> best = window.top();
+      assertUnit(best.size() == 5);
+      if (best.size() == 5)
+         assertUnit(best[0] == 9999);
+   }  // teardown
+
+   // a count window agrees with sorting the last N
+   void test_topK_random()
+   {  // setup
+      custom::sliding_top_k<int, 10, int> window;
+      std::vector<int> values;
+      const int n = 300;
+      unsigned int seed = 1234;
+      bool same = true;
+      // exercise
+      for (int i = 0; i < 3000 && same; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 5000));
+         window.push(i, values.back());
+         if (i % 7 == 0)
+            window.expire(i - n + 1);
+         if (i % 13 == 0)
+         {
+            int first = i % 7 == 0 ? std::max(0, i - n + 1) : std::max(0, (i / 7 * 7) - n + 1);
+            std::vector<int> recent(values.begin() + first, values.end());
+            std::sort(recent.begin(), recent.end(), std::greater<int>());
+            custom::vector<int> best = window.top();
+            same = best.size() == std::min<size_t>(10, recent.size());
+            for (size_t j = 0; same && j < best.size(); j++)
+               same = best[j] == recent[j];
+         }
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+};
+
+#endif // DEBUG
@@ -0,0 +1,175 @@
+/***********************************************************************
+ * Header:
+ *    TEST TIMER SERVICE
+ * Summary:
+ *    Unit tests for the timerfd-driven timer service
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+#ifdef __linux__
+
+#include "timer_service.h"   // class under test
+#include "unitTest.h"        // unit test baseclass
+
+#include <chrono>
+#include <vector>
+
+/***********************************************
+ * TEST TIMER SERVICE
+ * Unit tests for the timer_service class
+ ***********************************************/
+class TestTimerService : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Insert
+      test_schedule_arms();
+      test_schedule_earlierRearms();
+
+      // Remove
+      test_cancel_onlyTimer();
+      test_cancel_earliest();
+
+      // Run
+      test_wait_timeout();
+      test_wait_batch();
+
+      report("TimerService");
+   }
+
+   /***************************************
+    * SCHEDULE
+    ***************************************/
+
+   // the first timer arms the timerfd
+   void test_schedule_arms()
+   {  // setup
+      custom::timer_service<> service;
+      custom::timer_service<>::clock::time_point deadline = later(1000);
+      // exercise
+      service.schedule(deadline, []() {});
+      // verify
+      assertUnit(service.size() == 1);
+      assertUnit(service.armed);
+      assertUnit(service.armedFor == deadline);
+      assertUnit(kernelRemaining(service) > 0);
+   }  // teardown
+
+   // an earlier deadline moves the timerfd; a later one does not
+   void test_schedule_earlierRearms()
+   {  // setup
+      custom::timer_service<> service;
+      custom::timer_service<>::clock::time_point first = later(1000);
+      service.schedule(first, []() {});
+      // exercise
+      service.schedule(later(2000), []() {});
+      bool unchanged = service.armedFor == first;
+      custom::timer_service<>::clock::time_point earlier = later(500);
+      service.schedule(earlier, []() {});
+      // verify
+      assertUnit(unchanged);
+      assertUnit(service.armedFor == earlier);
+      assertUnit(service.size() == 3);
+   }  // teardown
+
+   /***************************************
+    * CANCEL
+    ***************************************/
+
+   // cancelling the last timer disarms the timerfd
+   void test_cancel_onlyTimer()
+   {  // setup
+      custom::timer_service<> service;
+      custom::timer_service<>::handle h = service.schedule(later(1000), []() {});
+      // exercise
+      bool returnValue = service.cancel(h);
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(service.empty());
+      assertUnit(!service.armed);
+      assertUnit(kernelRemaining(service) == 0);
+   }  // teardown
+
+   // cancelling the earliest timer arms for the next one
+   void test_cancel_earliest()
+   {  // setup
+      custom::timer_service<> service;
+      custom::timer_service<>::handle h = service.schedule(later(500), []() {});
+      custom::timer_service<>::clock::time_point next = later(1000);
+      service.schedule(next, []() {});
+      // exercise
+      bool returnValue = service.cancel(h);
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(service.size() == 1);
+      assertUnit(service.armedFor == next);
+   }  // teardown
+
+   /***************************************
+    * WAIT
+    ***************************************/
+
+   // nothing due within the timeout
+   void test_wait_timeout()
+   {  // setup
+      custom::timer_service<> service;
+      int numCalls = 0;
+      service.schedule(later(1000), [&]() { numCalls++; });
+      // exercise
+      size_t numFired = service.wait(10 /*ms*/);
+      // verify
+      assertUnit(numFired == 0);
+      assertUnit(numCalls == 0);
+      assertUnit(service.size() == 1);
+   }  // teardown
+
+   // everything expired fires in one dispatch, in deadline order
+   void test_wait_batch()
+   {  // setup
+      custom::timer_service<> service;
+      std::vector<int> fired;
+      custom::timer_service<>::clock::time_point now =
+         custom::timer_service<>::clock::now();
+      for (int i : { 3, 1, 2 })
+         service.schedule(now - std::chrono::milliseconds(i), [&fired, i]() { fired.push_back(i); });
+      service.schedule(later(1000), [&fired]() { fired.push_back(99); });
+      // exercise
+      size_t numFired = service.wait(1000 /*ms*/);
+      // verify
+      assertUnit(numFired == 3);
+      assertUnit(fired.size() == 3);
+      if (fired.size() == 3)
+      {
+         assertUnit(fired[0] == 3);
+         assertUnit(fired[1] == 2);
+         assertUnit(fired[2] == 1);
+      }
+      assertUnit(service.size() == 1);
+      assertUnit(service.armed);
+   }  // teardown
+
+private:
+   // ms milliseconds from now
+   static custom::timer_service<>::clock::time_point later(int ms)
+   {
+      return custom::timer_service<>::clock::now() + std::chrono::milliseconds(ms);
+   }
+
+   // what the kernel thinks: nanoseconds until the timerfd fires, 0 if disarmed
+   static long long kernelRemaining(const custom::timer_service<> & service)
+   {
+      itimerspec spec;
+      timerfd_gettime(service.fd(), &spec);
+      return (long long)spec.it_value.tv_sec * 1000000000LL + spec.it_value.tv_nsec;
+   }
+};
+
+#endif // __linux__
+#endif // DEBUG
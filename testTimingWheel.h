@@ -0,0 +1,253 @@
+/***********************************************************************
+ * Header:
+ *    TEST TIMING WHEEL
+ * Summary:
+ *    Unit tests for the hierarchical timing wheel
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "timing_wheel.h"   // class under test
+#include "heap_timer.h"     // the reference it must agree with
+#include "unitTest.h"       // unit test baseclass
+
+#include <chrono>
+#include <vector>
+
+/***********************************************
+ * TEST TIMING WHEEL
+ * Unit tests for the timing_wheel class
+ ***********************************************/
+class TestTimingWheel : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Insert
+      test_schedule_levelZero();
+      test_schedule_levelOne();
+      test_schedule_beyondRange();
+      test_schedule_overdue();
+
+      // Remove
+      test_cancel_standard();
+      test_cancel_stale();
+      test_expire_notEarly();
+      test_expire_cascade();
+      test_expire_matchesHeap();
+
+      // Access
+      test_earliest_levelZero();
+      test_earliest_levelOne();
+
+      report("TimingWheel");
+   }
+
+   /***************************************
+    * SCHEDULE
+    ***************************************/
+
+   // a near timer goes in the level-0 slot for its tick
+   void test_schedule_levelZero()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      // exercise
+      custom::timing_wheel::handle h = wheel.schedule(at(10), []() {});
+      // verify
+      assertUnit(wheel.size() == 1);
+      assertUnit(wheel.nodes[h.slot].bucket == 10);
+      assertUnit(wheel.buckets[10] == h.slot);
+   }  // teardown
+
+   // a timer 1000 ticks out goes in level 1, slot 1000 / 256
+   void test_schedule_levelOne()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      // exercise
+      custom::timing_wheel::handle h = wheel.schedule(at(1000), []() {});
+      // verify
+      assertUnit(wheel.nodes[h.slot].bucket == 256 + 3);
+   }  // teardown
+
+   // a timer past the top level parks in its last slot
+   void test_schedule_beyondRange()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      // exercise
+      custom::timing_wheel::handle h =
+         wheel.schedule(at(0) + std::chrono::hours(24 * 100), []() {});
+      // verify
+      assertUnit(wheel.nodes[h.slot].bucket == 3 * 256 + 255);
+   }  // teardown
+
+   // a deadline already passed fires on the next expire
+   void test_schedule_overdue()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      wheel.expire(at(100));
+      int numCalls = 0;
+      // exercise
+      wheel.schedule(at(20), [&]() { numCalls++; });
+      size_t numFired = wheel.expire(at(101));
+      // verify
+      assertUnit(numFired == 1);
+      assertUnit(numCalls == 1);
+      assertUnit(wheel.empty());
+   }  // teardown
+
+   /***************************************
+    * CANCEL
+    ***************************************/
+
+   // cancel unlinks the timer and it never fires
+   void test_cancel_standard()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      int numCalls = 0;
+      wheel.schedule(at(10), [&]() { numCalls++; });
+      custom::timing_wheel::handle h = wheel.schedule(at(10), [&]() { numCalls += 100; });
+      wheel.schedule(at(10), [&]() { numCalls++; });
+      // exercise
+      bool returnValue = wheel.cancel(h);
+      wheel.expire(at(10));
+      // verify
+      assertUnit(returnValue == true);
+      assertUnit(numCalls == 2);
+      assertUnit(wheel.empty());
+   }  // teardown
+
+   // a handle is no good once its timer is gone, even if the node is reused
+   void test_cancel_stale()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      custom::timing_wheel::handle h = wheel.schedule(at(10), []() {});
+      wheel.cancel(h);
+      custom::timing_wheel::handle reused = wheel.schedule(at(20), []() {});
+      // exercise
+      bool returnValue = wheel.cancel(h);
+      // verify
+      assertUnit(returnValue == false);
+      assertUnit(reused.slot == h.slot);
+      assertUnit(wheel.size() == 1);
+   }  // teardown
+
+   /***************************************
+    * EXPIRE
+    ***************************************/
+
+   // a deadline between ticks rounds up, never down
+   void test_expire_notEarly()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      int numCalls = 0;
+      wheel.schedule(at(10) + std::chrono::microseconds(500), [&]() { numCalls++; });
+      // exercise
+      size_t numEarly = wheel.expire(at(10));
+      size_t numOnTime = wheel.expire(at(11));
+      // verify
+      assertUnit(numEarly == 0);
+      assertUnit(numOnTime == 1);
+      assertUnit(numCalls == 1);
+   }  // teardown
+
+   // timers from every level fire on exactly their tick
+   void test_expire_cascade()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      std::vector<int> deadlines = { 5, 255, 256, 300, 65535, 65536, 70000, 131072 + 17 };
+      std::vector<int> firedAt(deadlines.size(), -1);
+      int now = 0;
+      for (size_t i = 0; i < deadlines.size(); i++)
+         wheel.schedule(at(deadlines[i]), [&firedAt, &now, i]() { firedAt[i] = now; });
+      // exercise
+      for (now = 1; now <= 131072 + 17; now++)
+         wheel.expire(at(now));
+      // verify
+      bool onTime = true;
+      for (size_t i = 0; i < deadlines.size(); i++)
+         if (firedAt[i] != deadlines[i])
+            onTime = false;
+      assertUnit(onTime);
+      assertUnit(wheel.empty());
+   }  // teardown
+
+   // the same trace fires the same timers at the same steps as heap_timer
+   void test_expire_matchesHeap()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      custom::heap_timer heap;
+      int sumWheel = 0;
+      int sumHeap = 0;
+      std::vector<custom::timing_wheel::handle> wheelHandles;
+      std::vector<custom::heap_timer::handle> heapHandles;
+      unsigned int seed = 12345;
+      for (int i = 0; i < 2000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int deadline = (int)((seed >> 8) % 100000);
+         wheelHandles.push_back(wheel.schedule(at(deadline), [&sumWheel, i]() { sumWheel += i; }));
+         heapHandles.push_back(heap.schedule(at(deadline), [&sumHeap, i]() { sumHeap += i; }));
+      }
+      for (int i = 0; i < 2000; i += 5)
+      {
+         wheel.cancel(wheelHandles[i]);
+         heap.cancel(heapHandles[i]);
+      }
+      // exercise
+      bool same = true;
+      for (int now = 0; now <= 100000; now += 37)
+      {
+         size_t numWheel = wheel.expire(at(now));
+         size_t numHeap = heap.expire(at(now));
+         if (numWheel != numHeap || sumWheel != sumHeap)
+            same = false;
+      }
+      // verify
+      assertUnit(same);
+      assertUnit(wheel.empty());
+      assertUnit(heap.empty());
+   }  // teardown
+
+   /***************************************
+    * EARLIEST
+    ***************************************/
+
+   // a level-0 timer is reported exactly
+   void test_earliest_levelZero()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      wheel.schedule(at(1000), []() {});
+      // exercise
+      wheel.schedule(at(10), []() {});
+      // verify
+      assertUnit(wheel.earliest() == at(10));
+   }  // teardown
+
+   // a higher-level timer is reported by when its slot cascades
+   void test_earliest_levelOne()
+   {  // setup
+      custom::timing_wheel wheel(std::chrono::milliseconds(1), at(0));
+      wheel.expire(at(5));
+      // exercise
+      wheel.schedule(at(1000), []() {});
+      // verify
+      assertUnit(wheel.earliest() == at(768));   // 3 * 256
+      wheel.expire(at(768));
+      assertUnit(wheel.earliest() == at(1000));
+   }  // teardown
+
+private:
+   // a fixed point in time, ms milliseconds after the epoch
+   static custom::timing_wheel::clock::time_point at(int ms)
+   {
+      return custom::timing_wheel::clock::time_point(std::chrono::milliseconds(ms));
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,469 @@
+/***********************************************************************
+ * Header:
+ *    TEST TOP K
+ * Summary:
+ *    Unit tests for the bounded top-K collector
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "top_k.h"     // class under test
+#include "unitTest.h"  // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST TOP K
+ * Unit tests for the top_k class
+ ***********************************************/
+class TestTopK : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_threshold_empty();
+      test_threshold_standard();
+
+      // Insert
+      test_push_empty();
+      test_push_fill();
+      test_push_reject();
+      test_push_rejectTie();
+      test_push_accept();
+      test_pushMove_accept();
+      test_pushBatch_fill();
+      test_pushBatch_rejectAll();
+      test_pushBatch_float();
+      test_pushBatch_int64Greater();
+
+      // Extract
+      test_extract_empty();
+      test_extract_standard();
+      test_extract_greater();
+      test_stream_random();
+
+      report("TopK");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // all K slots are reserved up front, but nothing is built
+   void test_construct_default()
+   {  // setup
+      Spy::reset();
+      // exercise
+      custom::top_k <Spy, 4> top;
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numDefault() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(top.container.size() == 0);
+      assertUnit(top.container.capacity() == 4);
+      assertUnit(top.capacity() == 4);
+   }  // teardown
+
+   /***************************************
+    * THRESHOLD
+    ***************************************/
+
+   // nothing collected yet: no threshold
+   void test_threshold_empty()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      Spy::reset();
+      // exercise
+      try
+      {
+         top.threshold();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+      assertUnit(Spy::numLessthan() == 0);
+   }  // teardown
+
+   // the threshold is the root
+   void test_threshold_standard()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      Spy::reset();
+      // exercise
+      const Spy & value = top.threshold();
+      // verify
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(value.get() == 2);
+      assertStandardFixture(top);
+      // teardown
+      teardownStandardFixture(top);
+   }
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // the first item goes straight in
+   void test_push_empty()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      Spy s(7);
+      Spy::reset();
+      // exercise
+      bool kept = top.push(s);
+      // verify
+      assertUnit(kept);
+      assertUnit(Spy::numCopy() == 1);
+      assertUnit(Spy::numAlloc() == 1);      // the copy of the Spy, not the container
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(top.size() == 1);
+      assertUnit(top.container.capacity() == 4);
+      assertUnit(top.threshold() == Spy(7));
+      // teardown
+      top.container.clear();
+   }
+
+   // every item is kept until the collector is full
+   void test_push_fill()
+   {  // setup
+      custom::top_k <int, 4> top;
+      // exercise
+      bool kept = top.push(7) && top.push(5) && top.push(3) && top.push(2);
+      // verify
+      assertUnit(kept);
+      assertUnit(top.full());
+      assertUnit(top.threshold() == 2);
+      assertUnit(top.container.capacity() == 4);
+      assertUnit(std::is_heap(&top.container[0], &top.container[0] + 4, std::greater<int>()));
+   }  // teardown
+
+   // a weaker item costs one comparison and nothing else
+   void test_push_reject()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      Spy s(1);
+      Spy::reset();
+      // exercise
+      bool kept = top.push(s);
+      // verify
+      assertUnit(!kept);
+      assertUnit(Spy::numLessthan() == 1);   // compare [2<1]
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numSwap() == 0);
+      assertStandardFixture(top);
+      // teardown
+      teardownStandardFixture(top);
+   }
+
+   // tying with the threshold is not good enough
+   void test_push_rejectTie()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      Spy s(2);
+      Spy::reset();
+      // exercise
+      bool kept = top.push(s);
+      // verify
+      assertUnit(!kept);
+      assertUnit(Spy::numLessthan() == 1);   // compare [2<2]
+      assertUnit(Spy::numAssign() == 0);
+      assertStandardFixture(top);
+      // teardown
+      teardownStandardFixture(top);
+   }
+
+   // a better item replaces the threshold in place
+   void test_push_accept()
+   {  // setup
+      //         2                   3
+      //      +--+--+             +--+--+
+      //      5     3     -->     5     6
+      //    +-+                 +-+
+      //    7                   7
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      const Spy * buffer = &top.container[0];
+      Spy s(6);
+      Spy::reset();
+      // exercise
+      bool kept = top.push(s);
+      // verify
+      assertUnit(kept);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 1);
+      assertUnit(Spy::numSwap() == 1);
+      assertUnit(Spy::numLessthan() == 3);   // [2<6] [5<6] [3<5]
+      assertUnit(&top.container[0] == buffer);
+      assertUnit(top.container.capacity() == 4);
+      assertUnit(top.size() == 4);
+      if (top.size() == 4)
+      {
+         assertUnit(top.container[0] == Spy(3));
+         assertUnit(top.container[1] == Spy(5));
+         assertUnit(top.container[2] == Spy(6));
+         assertUnit(top.container[3] == Spy(7));
+      }
+      // teardown
+      teardownStandardFixture(top);
+   }
+
+   // a better rvalue is moved in, not copied
+   void test_pushMove_accept()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      Spy s(9);
+      Spy::reset();
+      // exercise
+      bool kept = top.push(std::move(s));
+      // verify
+      assertUnit(kept);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 1);
+      assertUnit(Spy::numDelete() == 1);     // the old threshold
+      assertUnit(s.empty());
+      assertUnit(top.threshold() == Spy(3));
+      // teardown
+      teardownStandardFixture(top);
+   }
+
+   // a batch smaller than K is kept whole
+   void test_pushBatch_fill()
+   {  // setup
+      custom::top_k <int32_t, 4> top;
+      int32_t keys[3] = { 5, 9, 1 };
+      // exercise
+      size_t numKept = top.push_batch(keys, 3);
+      // verify
+      assertUnit(numKept == 3);
+      assertUnit(top.size() == 3);
+      assertUnit(top.threshold() == 1);
+   }  // teardown
+
+   // a type without SIMD support still pays one comparison per loser
+   void test_pushBatch_rejectAll()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      std::vector <Spy> keys { Spy(1), Spy(0), Spy(2), Spy(1), Spy(-4) };
+      Spy::reset();
+      // exercise
+      size_t numKept = top.push_batch(keys.data(), keys.size());
+      // verify
+      assertUnit(numKept == 0);
+      assertUnit(Spy::numLessthan() == 5);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertStandardFixture(top);
+      // teardown
+      teardownStandardFixture(top);
+   }
+
+   // the filtered path keeps exactly what pushing one at a time keeps
+   void test_pushBatch_float()
+   {  // setup
+      custom::top_k <float, 10> batched;
+      custom::top_k <float, 10> single;
+      std::vector <float> keys;
+      unsigned int seed = 777;
+      for (int i = 0; i < 5000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         keys.push_back((float)((seed >> 8) % 100000) / 7.0f);
+      }
+      size_t numSingle = 0;
+      for (float key : keys)
+         numSingle += single.push(key) ? 1 : 0;
+      // exercise
+      size_t numKept = batched.push_batch(keys.data(), keys.size());
+      // verify
+      assertUnit(numKept == numSingle);
+      custom::vector <float> lhs = batched.extract();
+      custom::vector <float> rhs = single.extract();
+      bool same = lhs.size() == 10 && rhs.size() == 10;
+      for (size_t i = 0; same && i < 10; i++)
+         same = lhs[i] == rhs[i];
+      assertUnit(same);
+   }  // teardown
+
+   // greater<> with int64 keys keeps the smallest
+   void test_pushBatch_int64Greater()
+   {  // setup
+      custom::top_k <int64_t, 3, std::greater<int64_t>> top;
+      std::vector <int64_t> keys;
+      for (int64_t i = 0; i < 100; i++)
+         keys.push_back((i * 37) % 101 + ((int64_t)1 << 40));
+      // exercise
+      top.push_batch(keys.data(), keys.size());
+      // verify
+      custom::vector <int64_t> result = top.extract();
+      assertUnit(result.size() == 3);
+      if (result.size() == 3)
+      {
+         assertUnit(result[0] == ((int64_t)1 << 40) + 0);
+         assertUnit(result[1] == ((int64_t)1 << 40) + 1);
+         assertUnit(result[2] == ((int64_t)1 << 40) + 2);
+      }
+   }  // teardown
+
+   /***************************************
+    * EXTRACT
+    ***************************************/
+
+   // nothing collected: an empty vector
+   void test_extract_empty()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      Spy::reset();
+      // exercise
+      custom::vector <Spy> result = top.extract();
+      // verify
+      assertUnit(result.size() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(top.empty());
+   }  // teardown
+
+   // best first, sorted in the collector's own buffer
+   void test_extract_standard()
+   {  // setup
+      custom::top_k <Spy, 4> top;
+      setupStandardFixture(top);
+      const Spy * buffer = &top.container[0];
+      Spy::reset();
+      // exercise
+      custom::vector <Spy> result = top.extract();
+      // verify
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(top.empty());
+      assertUnit(result.size() == 4);
+      assertUnit(&result[0] == buffer);
+      if (result.size() == 4)
+      {
+         assertUnit(result[0] == Spy(7));
+         assertUnit(result[1] == Spy(5));
+         assertUnit(result[2] == Spy(3));
+         assertUnit(result[3] == Spy(2));
+      }
+      // teardown
+      result.clear();
+   }
+
+   // with greater<> the collector keeps the smallest
+   void test_extract_greater()
+   {  // setup
+      custom::top_k <int, 3, std::greater<int>> top;
+      int values[] = { 8, 3, 9, 1, 7, 4, 1, 6 };
+      for (int value : values)
+         top.push(value);
+      // exercise
+      custom::vector <int> result = top.extract();
+      // verify
+      assertUnit(result.size() == 3);
+      if (result.size() == 3)
+      {
+         assertUnit(result[0] == 1);
+         assertUnit(result[1] == 1);
+         assertUnit(result[2] == 3);
+      }
+   }  // teardown
+
+   // a long stream agrees with sorting everything, and never grows
+   void test_stream_random()
+   {  // setup
+      custom::top_k <int, 16> top;
+      const int * buffer = nullptr;
+      std::vector <int> reference;
+      unsigned int seed = 2024;
+      bool fixed = true;
+      // exercise
+      for (int i = 0; i < 20000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         int value = (int)((seed >> 8) % 100000);
+         reference.push_back(value);
+         top.push(value);
+         if (buffer == nullptr)
+            buffer = &top.container[0];
+         fixed = fixed && &top.container[0] == buffer && top.container.capacity() == 16;
+      }
+      custom::vector <int> result = top.extract();
+      // verify
+      std::sort(reference.begin(), reference.end(), std::greater<int>());
+      assertUnit(fixed);
+      assertUnit(result.size() == 16);
+      bool same = result.size() == 16;
+      for (size_t i = 0; same && i < 16; i++)
+         same = result[i] == reference[i];
+      assertUnit(same);
+   }  // teardown
+
+   /*************************************************************
+    * SETUP STANDARD FIXTURE
+    *         2
+    *      +--+--+
+    *      5     3
+    *    +-+
+    *    7
+    *************************************************************/
+   void setupStandardFixture(custom::top_k <Spy, 4> & top)
+   {
+      top.container.push_back(Spy(2));
+      top.container.push_back(Spy(5));
+      top.container.push_back(Spy(3));
+      top.container.push_back(Spy(7));
+   }
+
+   /***************************************************
+    * VERIFY STANDARD FIXTURE
+    ***************************************************/
+   void assertStandardFixtureParameters(const custom::top_k <Spy, 4> & top, int line, const char * function)
+   {
+      assertIndirect(top.container.size() == 4);
+      assertIndirect(top.container.capacity() == 4);
+      if (top.container.size() == 4)
+      {
+         assertIndirect(top.container[0] == Spy(2));
+         assertIndirect(top.container[1] == Spy(5));
+         assertIndirect(top.container[2] == Spy(3));
+         assertIndirect(top.container[3] == Spy(7));
+      }
+   }
+
+   /***************************************************
+    * TEARDOWN STANDARD FIXTURE
+    ***************************************************/
+   void teardownStandardFixture(custom::top_k <Spy, 4> & top)
+   {
+      top.container.clear();
+   }
+};
+
+#endif // DEBUG
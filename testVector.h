@@ -275,8 +275,8 @@ public:
          //    +----+----+----+----+
          custom::vector<Spy> v;
          v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(99));
-         v.alloc.construct(&v.data[1], Spy(99));
+         std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(99));
+         std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(99));
          v.numElements = 2;
          v.numCapacity = 4;
          Spy::reset();
@@ -360,8 +360,8 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
       vSrc.data = vSrc.alloc.allocate(4);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(26));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[1], Spy(49));
       vSrc.numElements = 2;
       vSrc.numCapacity = 4;
       Spy::reset();
@@ -472,8 +472,8 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> vSrc;
       vSrc.data = vSrc.alloc.allocate(4);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(26));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[1], Spy(49));
       vSrc.numElements = 2;
       vSrc.numCapacity = 4;
       Spy::reset();
@@ -1047,10 +1047,10 @@ public:
       //    +----+----+----+----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(6);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
-      v.alloc.construct(&v.data[3], Spy(89));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[2], Spy(67));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[3], Spy(89));
       v.numElements = 4;
       v.numCapacity = 6;
       Spy::reset();
@@ -1267,8 +1267,8 @@ public:
       //    +----+----+
       custom::vector<Spy> vDest;
       vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vDest.alloc, &vDest.data[0], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vDest.alloc, &vDest.data[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
@@ -1316,8 +1316,8 @@ public:
       //    +----+----+
       custom::vector<Spy> vSrc;
       vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[0], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1452,8 +1452,8 @@ public:
       //    +----+----+
       custom::vector<Spy> vDest;
       vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vDest.alloc, &vDest.data[0], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vDest.alloc, &vDest.data[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
@@ -1494,8 +1494,8 @@ public:
       //    +----+----+
       custom::vector<Spy> vSrc;
       vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[0], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1628,8 +1628,8 @@ public:
       //    +----+----+
       custom::vector<Spy> vDest;
       vDest.data = vDest.alloc.allocate(2);
-      vDest.alloc.construct(&vDest.data[0], Spy(99));
-      vDest.alloc.construct(&vDest.data[1], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vDest.alloc, &vDest.data[0], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vDest.alloc, &vDest.data[1], Spy(99));
       vDest.numElements = 2;
       vDest.numCapacity = 2;
       Spy::reset();
@@ -1666,8 +1666,8 @@ public:
       //    +----+----+
       custom::vector<Spy> vSrc;
       vSrc.data = vSrc.alloc.allocate(2);
-      vSrc.alloc.construct(&vSrc.data[0], Spy(99));
-      vSrc.alloc.construct(&vSrc.data[1], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[0], Spy(99));
+      std::allocator_traits<std::allocator<Spy>>::construct(vSrc.alloc, &vSrc.data[1], Spy(99));
       vSrc.numElements = 2;
       vSrc.numCapacity = 2;
       //      0    1    2    3
@@ -1983,8 +1983,8 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
       v.numElements = 2;
       v.numCapacity = 4;
       Spy::reset();
@@ -2080,8 +2080,8 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
       v.numElements = 2;
       v.numCapacity = 4;
       Spy::reset();
@@ -2153,9 +2153,9 @@ public:
       //    +----+----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 4;
       Spy s(89);
@@ -2190,9 +2190,9 @@ public:
       //    +----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(3);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 3;
       Spy s(99);
@@ -2268,9 +2268,9 @@ public:
      //    +----+----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(4);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 4;
       Spy s(89);
@@ -2305,9 +2305,9 @@ public:
       //    +----+----+----+
       custom::vector<Spy> v;
       v.data = v.alloc.allocate(3);
-      v.alloc.construct(&v.data[0], Spy(26));
-      v.alloc.construct(&v.data[1], Spy(49));
-      v.alloc.construct(&v.data[2], Spy(67));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
+      std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[2], Spy(67));
       v.numElements = 3;
       v.numCapacity = 3;
       Spy s(99);
@@ -2582,10 +2582,10 @@ public:
       try
       {
          v.data = v.alloc.allocate(4);
-         v.alloc.construct(&v.data[0], Spy(26));
-         v.alloc.construct(&v.data[1], Spy(49));
-         v.alloc.construct(&v.data[2], Spy(67));
-         v.alloc.construct(&v.data[3], Spy(89));
+         std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[0], Spy(26));
+         std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[1], Spy(49));
+         std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[2], Spy(67));
+         std::allocator_traits<std::allocator<Spy>>::construct(v.alloc, &v.data[3], Spy(89));
          v.numElements = 4;
          v.numCapacity = 4;
       }
@@ -2635,7 +2635,7 @@ public:
       if (v.data != nullptr && false)
       {
          for (size_t i = 0; i < v.numElements; i++)
-            v.alloc.destroy(&v.data[i]);
+            std::allocator_traits<std::allocator<Spy>>::destroy(v.alloc, &v.data[i]);
          v.alloc.deallocate(v.data, v.numCapacity);
 
       }
@@ -0,0 +1,391 @@
+/***********************************************************************
+ * Header:
+ *    TEST VECTOR VIEW
+ * Summary:
+ *    Unit tests for saving and loading vectors, and for viewing the
+ *    saved files through a read-only mapping
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "vector_view.h"   // class under test
+#include "vector.h"
+#include "unitTest.h"      // unit test baseclass
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+/***********************************************
+ * TEST VECTOR VIEW
+ * Unit tests for save_vector, load_vector and
+ * the vector_view class
+ ***********************************************/
+class TestVectorView : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Save and load
+      test_save_header();
+      test_save_replaces();
+      test_load_roundTrip();
+      test_load_empty();
+      test_load_missing();
+      test_load_notAVector();
+      test_load_wrongVersion();
+      test_load_wrongElementSize();
+      test_load_truncated();
+
+#ifdef __linux__
+      // View
+      test_view_roundTrip();
+      test_view_empty();
+      test_view_iterate();
+      test_view_move();
+      test_view_truncated();
+      test_view_outlivesReplace();
+#endif // __linux__
+
+      report("VectorView");
+   }
+
+   // a record like the ones passed between stages
+   struct record
+   {
+      uint64_t key;
+      double   value;
+      int32_t  id;
+      int32_t  flags;
+   };
+
+   static custom::vector<record> records(size_t count)
+   {
+      custom::vector<record> v;
+      v.reserve(count);
+      for (size_t i = 0; i < count; i++)
+         v.push_back(record{ i * 7919, (double)i / 4.0, (int32_t)i, (int32_t)(i % 3) });
+      return v;
+   }
+
+   static bool same(const record & lhs, const record & rhs)
+   {
+      return lhs.key == rhs.key && lhs.value == rhs.value &&
+             lhs.id == rhs.id && lhs.flags == rhs.flags;
+   }
+
+   // overwrite some bytes of a file in place
+   static void poke(const std::string & path, size_t offset, const void * bytes, size_t size)
+   {
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(offset);
+      file.write(static_cast<const char *>(bytes), size);
+   }
+
+   /***************************************
+    * SAVE
+    ***************************************/
+
+   // a 64-byte header, then the items byte for byte
+   void test_save_header()
+   {  // setup
+      std::string path = scratchPath("vector", "header");
+      custom::vector<int> v{ 3, 1, 4, 1, 5 };
+      // exercise
+      custom::save_vector(v, path);
+      // verify
+      assertUnit(std::filesystem::file_size(path) == 64 + 5 * sizeof(int));
+      custom::vector_file::header head;
+      int items[5];
+      {
+         std::ifstream file(path, std::ios::binary);
+         file.read(reinterpret_cast<char *>(&head), sizeof(head));
+         file.seekg(64);
+         file.read(reinterpret_cast<char *>(items), sizeof(items));
+      }
+      assertUnit(std::string(head.magic) == "CVECTOR");
+      assertUnit(head.version == 1);
+      assertUnit(head.elementSize == sizeof(int));
+      assertUnit(head.count == 5);
+      assertUnit(items[0] == 3 && items[2] == 4 && items[4] == 5);
+      assertUnit(!std::filesystem::exists(path + ".tmp"));
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // saving again replaces the file whole
+   void test_save_replaces()
+   {  // setup
+      std::string path = scratchPath("vector", "replace");
+      custom::save_vector(records(100), path);
+      // exercise
+      custom::save_vector(records(10), path);
+      // verify
+      assertUnit(std::filesystem::file_size(path) == 64 + 10 * sizeof(record));
+      assertUnit(custom::load_vector<record>(path).size() == 10);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   /***************************************
+    * LOAD
+    ***************************************/
+
+   // what was saved comes back
+   void test_load_roundTrip()
+   {  // setup
+      std::string path = scratchPath("vector", "roundtrip");
+      custom::vector<record> saved = records(1000);
+      custom::save_vector(saved, path);
+      // exercise
+      custom::vector<record> loaded = custom::load_vector<record>(path);
+      // verify
+      bool equal = loaded.size() == saved.size();
+      for (size_t i = 0; equal && i < saved.size(); i++)
+         equal = same(loaded[i], saved[i]);
+      assertUnit(equal);
+      assertUnit(loaded.capacity() == 1000);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // an empty vector is a header and nothing else
+   void test_load_empty()
+   {  // setup
+      std::string path = scratchPath("vector", "empty");
+      custom::save_vector(custom::vector<int>(), path);
+      // exercise
+      custom::vector<int> loaded = custom::load_vector<int>(path);
+      // verify
+      assertUnit(std::filesystem::file_size(path) == 64);
+      assertUnit(loaded.empty());
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // no file is a system error
+   void test_load_missing()
+   {  // setup
+      std::string path = scratchPath("vector", "missing");
+      // exercise
+      bool thrown = false;
+      try
+      {
+         custom::load_vector<int>(path);
+      }
+      catch (const std::system_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+   }
+
+   // some other file is refused
+   void test_load_notAVector()
+   {  // setup
+      std::string path = scratchPath("vector", "notavector");
+      {
+         std::ofstream file(path, std::ios::binary);
+         file << "this is just some text that is not a vector file at all, honestly.";
+      }
+      // exercise
+      bool thrown = throwsFormat<int>(path);
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a file from a later version is refused
+   void test_load_wrongVersion()
+   {  // setup
+      std::string path = scratchPath("vector", "version");
+      custom::save_vector(custom::vector<int>{ 1, 2 }, path);
+      uint32_t version = 2;
+      poke(path, 8, &version, sizeof(version));
+      // exercise
+      bool thrown = throwsFormat<int>(path);
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a file of ints is not a file of doubles
+   void test_load_wrongElementSize()
+   {  // setup
+      std::string path = scratchPath("vector", "elementsize");
+      custom::save_vector(custom::vector<int>{ 1, 2 }, path);
+      // exercise
+      bool thrown = throwsFormat<double>(path);
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a file cut short is refused, not read past its end
+   void test_load_truncated()
+   {  // setup
+      std::string path = scratchPath("vector", "truncated");
+      custom::save_vector(records(20), path);
+      std::filesystem::resize_file(path, 64 + 19 * sizeof(record) + 5);
+      // exercise
+      bool thrown = throwsFormat<record>(path);
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+#ifdef __linux__
+   /***************************************
+    * VIEW
+    ***************************************/
+
+   // the view sees what was saved, without reading it
+   void test_view_roundTrip()
+   {  // setup
+      std::string path = scratchPath("vector", "viewroundtrip");
+      custom::vector<record> saved = records(1000);
+      custom::save_vector(saved, path);
+      // exercise
+      custom::vector_view<record> view(path);
+      // verify
+      bool equal = view.size() == saved.size();
+      for (size_t i = 0; equal && i < saved.size(); i++)
+         equal = same(view[i], saved[i]);
+      assertUnit(equal);
+      assertUnit(view.front().id == 0);
+      assertUnit(view.back().id == 999);
+      assertUnit((uintptr_t)view.data() % alignof(record) == 0);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // an empty file views as an empty vector
+   void test_view_empty()
+   {  // setup
+      std::string path = scratchPath("vector", "viewempty");
+      custom::save_vector(custom::vector<int>(), path);
+      // exercise
+      custom::vector_view<int> view(path);
+      // verify
+      assertUnit(view.empty());
+      assertUnit(view.begin() == view.end());
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // range-for walks the items in order
+   void test_view_iterate()
+   {  // setup
+      std::string path = scratchPath("vector", "viewiterate");
+      custom::save_vector(custom::vector<int>{ 2, 7, 1, 8, 2, 8 }, path);
+      custom::vector_view<int> view(path);
+      // exercise
+      int sum = 0;
+      int count = 0;
+      for (int item : view)
+      {
+         sum += item;
+         count++;
+      }
+      // verify
+      assertUnit(sum == 28);
+      assertUnit(count == 6);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // moving hands the mapping over; the source is left empty
+   void test_view_move()
+   {  // setup
+      std::string path = scratchPath("vector", "viewmove");
+      custom::save_vector(custom::vector<int>{ 5, 6, 7 }, path);
+      custom::vector_view<int> source(path);
+      // exercise
+      custom::vector_view<int> destination(std::move(source));
+      // verify
+      assertUnit(source.base == nullptr);
+      assertUnit(source.empty());
+      assertUnit(destination.size() == 3);
+      assertUnit(destination[2] == 7);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a file cut short is refused, not faulted on
+   void test_view_truncated()
+   {  // setup
+      std::string path = scratchPath("vector", "viewtruncated");
+      custom::save_vector(records(20), path);
+      std::filesystem::resize_file(path, 64 + 10 * sizeof(record));
+      // exercise
+      bool thrown = false;
+      try
+      {
+         custom::vector_view<record> view(path);
+      }
+      catch (const std::runtime_error &)
+      {
+         thrown = true;
+      }
+      // verify
+      assertUnit(thrown);
+      // teardown
+      std::remove(path.c_str());
+   }
+
+   // a view keeps the old items while a new file is saved over them
+   void test_view_outlivesReplace()
+   {  // setup
+      std::string path = scratchPath("vector", "viewreplace");
+      custom::save_vector(custom::vector<int>{ 1, 2, 3 }, path);
+      custom::vector_view<int> before(path);
+      // exercise
+      custom::save_vector(custom::vector<int>{ 9, 9 }, path);
+      custom::vector_view<int> after(path);
+      // verify
+      assertUnit(before.size() == 3);
+      assertUnit(before[0] == 1 && before[2] == 3);
+      assertUnit(after.size() == 2);
+      assertUnit(after[0] == 9);
+      // teardown
+      std::remove(path.c_str());
+   }
+#endif // __linux__
+
+private:
+   // does loading this file as T throw a format error?
+   template <class T>
+   static bool throwsFormat(const std::string & path)
+   {
+      try
+      {
+         custom::load_vector<T>(path);
+      }
+      catch (const std::system_error &)
+      {
+         return false;
+      }
+      catch (const std::runtime_error &)
+      {
+         return true;
+      }
+      return false;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,374 @@
+/***********************************************************************
+ * Header:
+ *    TEST WEAK HEAP
+ * Summary:
+ *    Unit tests for the weak heap and weak-heapsort, including how
+ *    many comparisons they make next to the binary heap
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "weak_heap.h"        // class under test
+#include "heap.h"             // the binary heap, for comparison
+#include "priority_queue.h"
+#include "unitTest.h"         // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/***********************************************
+ * TEST WEAK HEAP
+ * Unit tests for the weak_heap class
+ ***********************************************/
+class TestWeakHeap : public UnitTest
+{
+public:
+   void run()
+   {
+      reset();
+
+      // Bits
+      test_reverseBits_standard();
+
+      // Construct
+      test_construct_default();
+      test_construct_range();
+      test_constructMove_comparisons();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_standard();
+      test_push_ascending();
+
+      // Remove
+      test_pop_sorted();
+      test_pop_comparisons();
+
+      // Sort
+      test_sort_standard();
+      test_sort_greater();
+      test_sort_comparisons();
+      test_sort_random();
+
+      report("WeakHeap");
+   }
+
+   /***************************************
+    * REVERSE BITS
+    ***************************************/
+
+   // bits across a word boundary flip and clear on their own
+   void test_reverseBits_standard()
+   {  // setup
+      custom::reverse_bits r;
+      r.resize(130);
+      // exercise
+      r.flip(0);
+      r.flip(63);
+      r.flip(64);
+      r.flip(129);
+      r.reset(63);
+      // verify
+      assertUnit(r[0]);
+      assertUnit(!r[63]);
+      assertUnit(r[64]);
+      assertUnit(!r[65]);
+      assertUnit(r[129]);
+      r.clear();
+      assertUnit(!r[0] && !r[64] && !r[129]);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // nothing in it
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::weak_heap<int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+   }  // teardown
+
+   // building from a range takes n - 1 comparisons
+   void test_construct_range()
+   {  // setup
+      std::vector<Spy> values;
+      for (int i = 0; i < 100; i++)
+         values.push_back(Spy((i * 37) % 100));
+      Spy::reset();
+      // exercise
+      custom::weak_heap<Spy> heap(values.begin(), values.end());
+      // verify
+      assertUnit(Spy::numLessthan() == 99);
+      assertUnit(heap.size() == 100);
+      assertUnit(heap.top().get() == 99);
+      assertUnit(isWeakHeap(heap));
+   }  // teardown
+
+   // building in place takes fewer comparisons than the binary heap
+   void test_constructMove_comparisons()
+   {  // setup
+      custom::vector<Spy> forWeak;
+      custom::vector<Spy> forBinary;
+      unsigned int seed = 17;
+      for (int i = 0; i < 1000; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         forWeak.push_back(Spy((int)((seed >> 8) % 10000)));
+         forBinary.push_back(forWeak.back());
+      }
+      // exercise
+      Spy::reset();
+      custom::weak_heap<Spy> weak(std::move(forWeak));
+      int weakCompares = Spy::numLessthan();
+      Spy::reset();
+      custom::priority_queue<Spy> binary(std::move(forBinary));
+      int binaryCompares = Spy::numLessthan();
+      // verify
+      assertUnit(weakCompares == 999);
+      assertUnit(weakCompares < binaryCompares);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(isWeakHeap(weak));
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // no top in an empty heap
+   void test_top_empty()
+   {  // setup
+      custom::weak_heap<int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const std::out_of_range & error)
+      {
+         assertUnit(error.what() == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // the largest is on top and the order holds
+   void test_push_standard()
+   {  // setup
+      custom::weak_heap<int> heap;
+      int values[] = { 4, 9, 2, 7, 7, 1, 8 };
+      // exercise
+      for (int value : values)
+         heap.push(value);
+      // verify
+      assertUnit(heap.top() == 9);
+      assertUnit(heap.size() == 7);
+      assertUnit(isWeakHeap(heap));
+   }  // teardown
+
+   // every new item is the largest: at most log2 n comparisons each
+   void test_push_ascending()
+   {  // setup
+      custom::weak_heap<Spy> heap;
+      bool bounded = true;
+      // exercise
+      for (int i = 0; i < 512; i++)
+      {
+         Spy item(i);
+         Spy::reset();
+         heap.push(std::move(item));
+         bounded = bounded && Spy::numLessthan() <= ceilLog2(heap.size());
+      }
+      // verify
+      assertUnit(bounded);
+      assertUnit(heap.top().get() == 511);
+      assertUnit(isWeakHeap(heap));
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // everything comes out largest first
+   void test_pop_sorted()
+   {  // setup
+      custom::weak_heap<int> heap;
+      std::vector<int> values;
+      unsigned int seed = 41;
+      for (int i = 0; i < 700; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         values.push_back((int)((seed >> 8) % 300));
+         heap.push(values.back());
+      }
+      std::sort(values.begin(), values.end(), std::greater<int>());
+      // exercise
+      std::vector<int> output;
+      while (!heap.empty())
+      {
+         output.push_back(heap.top());
+         heap.pop();
+      }
+      // verify
+      assertUnit(output == values);
+   }  // teardown
+
+   // a pop costs at most log2 n comparisons, about half the binary heap
+   void test_pop_comparisons()
+   {  // setup
+      custom::vector<Spy> forWeak;
+      custom::vector<Spy> forBinary;
+      unsigned int seed = 23;
+      for (int i = 0; i < 1023; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         forWeak.push_back(Spy((int)((seed >> 8) % 100000)));
+         forBinary.push_back(forWeak.back());
+      }
+      custom::weak_heap<Spy> weak(std::move(forWeak));
+      custom::priority_queue<Spy> binary(std::move(forBinary));
+      bool bounded = true;
+      int weakCompares = 0;
+      int binaryCompares = 0;
+      // exercise
+      while (!weak.empty())
+      {
+         size_t size = weak.size();
+         Spy::reset();
+         weak.pop();
+         weakCompares += Spy::numLessthan();
+         bounded = bounded && Spy::numLessthan() <= ceilLog2(size);
+         Spy::reset();
+         binary.pop();
+         binaryCompares += Spy::numLessthan();
+      }
+      // verify
+      assertUnit(bounded);
+      assertUnit(weakCompares * 3 < binaryCompares * 2);
+   }  // teardown
+
+   /***************************************
+    * WEAK HEAPSORT
+    ***************************************/
+
+   // a custom::vector sorted in place
+   void test_sort_standard()
+   {  // setup
+      custom::vector<int> v{ 5, 3, 9, 1, 7, 3, 8, 2 };
+      // exercise
+      custom::weak_heapsort(v.begin(), v.end());
+      // verify
+      int expected[] = { 1, 2, 3, 3, 5, 7, 8, 9 };
+      bool same = true;
+      for (int i = 0; i < 8; i++)
+         same = same && v[i] == expected[i];
+      assertUnit(same);
+   }  // teardown
+
+   // greater<> sorts descending
+   void test_sort_greater()
+   {  // setup
+      int v[] = { 5, 3, 9, 1, 7 };
+      // exercise
+      custom::weak_heapsort(v, v + 5, std::greater<int>());
+      // verify
+      assertUnit(v[0] == 9 && v[1] == 7 && v[2] == 5 && v[3] == 3 && v[4] == 1);
+   }  // teardown
+
+   // within n log2 n - 0.9n comparisons, well under the binary heap
+   void test_sort_comparisons()
+   {  // setup
+      const int n = 1000;
+      custom::vector<Spy> forWeak;
+      custom::vector<Spy> forBinary;
+      unsigned int seed = 29;
+      for (int i = 0; i < n; i++)
+      {
+         seed = seed * 1103515245 + 12345;
+         forWeak.push_back(Spy((int)((seed >> 8) % 100000)));
+         forBinary.push_back(forWeak.back());
+      }
+      // exercise
+      Spy::reset();
+      custom::weak_heapsort(forWeak.begin(), forWeak.end());
+      int weakCompares = Spy::numLessthan();
+      int weakAllocs = Spy::numAlloc();
+      Spy::reset();
+      custom::make_heap(forBinary.begin(), forBinary.end());
+      custom::sort_heap(forBinary.begin(), forBinary.end());
+      int binaryCompares = Spy::numLessthan();
+      // verify
+      //    n ceil(log2 n) - 2^ceil(log2 n) + n - 1 = 10000 - 1024 + 999
+      assertUnit(weakCompares <= 9975);
+      assertUnit(weakCompares * 3 < binaryCompares * 2);
+      assertUnit(weakAllocs == 0);
+      bool same = true;
+      for (int i = 0; i < n; i++)
+         same = same && forWeak[i] == forBinary[i];
+      assertUnit(same);
+   }  // teardown
+
+   // every size agrees with std::sort, duplicates and all
+   void test_sort_random()
+   {  // setup
+      unsigned int seed = 31;
+      bool same = true;
+      // exercise
+      for (size_t n = 0; n < 200 && same; n++)
+      {
+         std::vector<int> v;
+         for (size_t i = 0; i < n; i++)
+         {
+            seed = seed * 1103515245 + 12345;
+            v.push_back((int)((seed >> 8) % 50));
+         }
+         std::vector<int> expected(v);
+         std::sort(expected.begin(), expected.end());
+         custom::weak_heapsort(v.begin(), v.end());
+         same = v == expected;
+      }
+      // verify
+      assertUnit(same);
+   }  // teardown
+
+private:
+   static int ceilLog2(size_t n)
+   {
+      int log = 0;
+      while (((size_t)1 << log) < n)
+         log++;
+      return log;
+   }
+
+   // nothing beats its distinguished ancestor
+   template <class T, class C>
+   static bool isWeakHeap(const custom::weak_heap<T, C> & heap)
+   {
+      for (size_t j = 1; j < heap.container.size(); j++)
+      {
+         size_t i = custom::weakAncestor(j, heap.bits);
+         if (heap.compare(heap.container[i], heap.container[j]))
+            return false;
+      }
+      return true;
+   }
+};
+
+#endif // DEBUG
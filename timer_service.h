@@ -0,0 +1,217 @@
+/***********************************************************************
+ * Header:
+ *    TIMER SERVICE
+ * Summary:
+ *    A Linux deadline event loop. All the pending deadlines live in a
+ *    timer engine (a heap_timer by default) and a single timerfd is
+ *    armed for the earliest one, so nothing polls or sleeps in a loop.
+ *    When the timerfd fires, every expired timer is dispatched in one
+ *    batch and the timerfd is re-armed for the next deadline.
+ *
+ *    The service is meant to be driven from one thread: either call
+ *    wait(), or add fd() to an existing epoll set and call dispatch()
+ *    when it becomes readable.
+ *
+ *    This will contain the class definition of:
+ *        timer_service           : Deadlines driven by a timerfd
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#ifdef __linux__
+
+#include <cassert>
+#include <cerrno>          // for errno
+#include <chrono>          // for std::chrono::steady_clock
+#include <cstdint>         // for uint64_t
+#include <system_error>    // for std::system_error
+#include <poll.h>          // for poll
+#include <sys/timerfd.h>   // for timerfd_create and timerfd_settime
+#include <unistd.h>        // for read and close
+#include "heap_timer.h"
+
+class TestTimerService;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * TIMER SERVICE
+ * Engine must offer the heap_timer interface:
+ * schedule, cancel, expire, earliest, empty, size
+ *************************************************/
+template <class Engine = heap_timer>
+class timer_service
+{
+   friend class ::TestTimerService; // give the unit test class access to the privates
+public:
+   typedef std::chrono::steady_clock clock;   // CLOCK_MONOTONIC, same as the timerfd
+   typedef typename Engine::handle   handle;
+   typedef typename Engine::callback callback;
+
+   //
+   // construct
+   //
+   timer_service();
+   timer_service(const timer_service & rhs) = delete;
+   timer_service & operator = (const timer_service & rhs) = delete;
+  ~timer_service();
+
+   //
+   // Insert
+   //
+   handle schedule(clock::time_point deadline, callback fn);
+   handle schedule(clock::duration delay, callback fn)
+   {
+      return schedule(clock::now() + delay, std::move(fn));
+   }
+
+   //
+   // Remove
+   //
+   bool cancel(handle h);
+
+   //
+   // Run
+   //
+   size_t dispatch();
+   size_t wait(int timeoutMs = -1);
+
+   //
+   // Status
+   //
+   int    fd()    const { return timerFd;        }
+   size_t size()  const { return engine.size();  }
+   bool   empty() const { return engine.empty(); }
+
+private:
+   void rearm();
+
+   Engine engine;
+   int timerFd;
+   bool armed;                     // is the timerfd set?
+   clock::time_point armedFor;     // ... and for when
+};
+
+/************************************************
+ * TIMER SERVICE :: CONSTRUCTOR
+ ***********************************************/
+template <class Engine>
+timer_service<Engine>::timer_service() : armed(false)
+{
+   timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+   if (timerFd < 0)
+      throw std::system_error(errno, std::system_category(), "timerfd_create");
+}
+
+/************************************************
+ * TIMER SERVICE :: DESTRUCTOR
+ ***********************************************/
+template <class Engine>
+timer_service<Engine>::~timer_service()
+{
+   close(timerFd);
+}
+
+/************************************************
+ * TIMER SERVICE :: SCHEDULE
+ * Only touch the timerfd if this is the new earliest
+ ***********************************************/
+template <class Engine>
+typename timer_service<Engine>::handle
+timer_service<Engine>::schedule(clock::time_point deadline, callback fn)
+{
+   handle h = engine.schedule(deadline, std::move(fn));
+   if (!armed || deadline < armedFor)
+      rearm();
+   return h;
+}
+
+/************************************************
+ * TIMER SERVICE :: CANCEL
+ * Amortized O(1) in the heap; the timerfd is re-armed only
+ * when the earliest deadline went away
+ ***********************************************/
+template <class Engine>
+bool timer_service<Engine>::cancel(handle h)
+{
+   if (!engine.cancel(h))
+      return false;
+   if (engine.empty() || engine.earliest() != armedFor)
+      rearm();
+   return true;
+}
+
+/************************************************
+ * TIMER SERVICE :: DISPATCH
+ * Drain the timerfd, fire everything that is due,
+ * and arm for the next deadline. Returns the number
+ * of timers fired.
+ ***********************************************/
+template <class Engine>
+size_t timer_service<Engine>::dispatch()
+{
+   uint64_t numExpirations;
+   while (read(timerFd, &numExpirations, sizeof(numExpirations)) < 0 && errno == EINTR)
+      ;
+
+   armed = false;
+   size_t numFired = engine.expire(clock::now());
+   rearm();
+   return numFired;
+}
+
+/************************************************
+ * TIMER SERVICE :: WAIT
+ * Block until the earliest deadline (or timeoutMs,
+ * -1 for forever) and dispatch. Returns the number
+ * of timers fired.
+ ***********************************************/
+template <class Engine>
+size_t timer_service<Engine>::wait(int timeoutMs)
+{
+   pollfd descriptor;
+   descriptor.fd = timerFd;
+   descriptor.events = POLLIN;
+   descriptor.revents = 0;
+
+   int result = poll(&descriptor, 1, timeoutMs);
+   if (result < 0 && errno != EINTR)
+      throw std::system_error(errno, std::system_category(), "poll");
+   if (result <= 0)
+      return 0;
+   return dispatch();
+}
+
+/************************************************
+ * TIMER SERVICE :: REARM
+ * Point the timerfd at the earliest deadline, or
+ * disarm it when nothing is pending
+ ***********************************************/
+template <class Engine>
+void timer_service<Engine>::rearm()
+{
+   itimerspec spec = {};
+   if (!engine.empty())
+   {
+      armedFor = engine.earliest();
+      auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+         armedFor.time_since_epoch()).count();
+
+      // zero would disarm; anything already due fires right away
+      if (nanoseconds <= 0)
+         nanoseconds = 1;
+      spec.it_value.tv_sec  = nanoseconds / 1000000000;
+      spec.it_value.tv_nsec = nanoseconds % 1000000000;
+   }
+   armed = !engine.empty();
+
+   if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+      throw std::system_error(errno, std::system_category(), "timerfd_settime");
+}
+
+} // namespace custom
+
+#endif // __linux__
@@ -0,0 +1,366 @@
+/***********************************************************************
+ * Header:
+ *    TIMING WHEEL
+ * Summary:
+ *    A hierarchical timing wheel: four levels of 256 slots. Level 0
+ *    holds the timers due in the next 256 ticks, level 1 those due
+ *    within 256^2 ticks, and so on. When level 0 wraps, the next
+ *    level-1 slot is cascaded down, and likewise further up.
+ *    Schedule and cancel are O(1); a timer fires within one tick
+ *    after its deadline, never before.
+ *
+ *    Timers live in one pooled node array linked by index, so slot
+ *    lists never allocate once the pool has grown to the working set.
+ *    The interface matches heap_timer, so either can drive a
+ *    timer_service or be benchmarked on the same trace.
+ *
+ *    This will contain the class definition of:
+ *        timing_wheel            : Deadlines in a hierarchical wheel
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <chrono>      // for std::chrono::steady_clock
+#include <cstdint>     // for uint64_t
+#include <functional>  // for std::function
+#include <stdexcept>   // for std::out_of_range
+#include "vector.h"
+
+class TestTimingWheel;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * TIMING WHEEL
+ * Schedule callbacks for deadlines, rounded up to
+ * whole ticks, and fire every one due in a batch.
+ *************************************************/
+class timing_wheel
+{
+   friend class ::TestTimingWheel; // give the unit test class access to the privates
+public:
+   typedef std::chrono::steady_clock clock;
+   typedef std::function<void()> callback;
+
+   // identifies one scheduled timer; stale once it fires or is cancelled
+   struct handle
+   {
+      size_t slot;
+      size_t generation;
+   };
+
+   //
+   // construct
+   //
+   explicit timing_wheel(clock::duration tick = std::chrono::milliseconds(1),
+                         clock::time_point origin = clock::now());
+
+   //
+   // Insert
+   //
+   handle schedule(clock::time_point deadline, callback fn);
+
+   //
+   // Remove
+   //
+   bool   cancel(handle h);
+   size_t expire(clock::time_point now);
+
+   //
+   // Access
+   //
+   clock::time_point earliest() const;
+
+   //
+   // Status
+   //
+   size_t size()  const { return numTimers;      }
+   bool   empty() const { return numTimers == 0; }
+
+private:
+   enum { LEVEL_BITS = 8,
+          NUM_SLOTS  = 1 << LEVEL_BITS,     // slots per level
+          SLOT_MASK  = NUM_SLOTS - 1,
+          NUM_LEVELS = 4 };
+   static const size_t NIL = (size_t)-1;
+
+   // one pooled timer, linked into a bucket or into the free list
+   struct Node
+   {
+      uint64_t expires;        // in ticks since origin
+      callback fn;
+      size_t   next;
+      size_t   prev;
+      size_t   bucket;         // level * NUM_SLOTS + slot, or NIL when free
+      size_t   generation;     // bumped every time the node is reused
+   };
+
+   uint64_t toTicks(clock::time_point t) const;
+   clock::time_point fromTicks(uint64_t ticks) const;
+   void place(size_t index);
+   void link(size_t index, size_t bucket);
+   void unlink(size_t index);
+   void cascade(size_t level);
+   void release(size_t index);
+
+   clock::duration tick;
+   clock::time_point origin;
+   uint64_t current;                    // the next tick to be processed
+   size_t   numTimers;
+   size_t   freeList;
+   custom::vector<Node>     nodes;
+   custom::vector<size_t>   buckets;    // NUM_LEVELS * NUM_SLOTS list heads
+   custom::vector<callback> batch;      // reused by expire()
+};
+
+/************************************************
+ * TIMING WHEEL :: CONSTRUCTOR
+ ***********************************************/
+inline timing_wheel::timing_wheel(clock::duration tick, clock::time_point origin) :
+   tick(tick), origin(origin), current(0), numTimers(0), freeList(NIL),
+   buckets(NUM_LEVELS * NUM_SLOTS, (size_t)NIL)
+{
+   assert(tick.count() > 0);
+}
+
+/************************************************
+ * TIMING WHEEL :: SCHEDULE
+ * Take a node from the pool and drop it in its slot
+ ***********************************************/
+inline timing_wheel::handle timing_wheel::schedule(clock::time_point deadline, callback fn)
+{
+   size_t index;
+   if (freeList != NIL)
+   {
+      index = freeList;
+      freeList = nodes[index].next;
+   }
+   else
+   {
+      index = nodes.size();
+      nodes.push_back(Node{ 0, callback(), NIL, NIL, NIL, 0 });
+   }
+
+   nodes[index].expires = toTicks(deadline);
+   nodes[index].fn = std::move(fn);
+   place(index);
+   numTimers++;
+
+   return handle{ index, nodes[index].generation };
+}
+
+/************************************************
+ * TIMING WHEEL :: CANCEL
+ * Unlink from the slot list. Returns false if the
+ * handle is stale.
+ ***********************************************/
+inline bool timing_wheel::cancel(handle h)
+{
+   if (h.slot >= nodes.size() ||
+       nodes[h.slot].bucket == NIL ||
+       nodes[h.slot].generation != h.generation)
+      return false;
+
+   unlink(h.slot);
+   release(h.slot);
+   numTimers--;
+   return true;
+}
+
+/************************************************
+ * TIMING WHEEL :: EXPIRE
+ * Advance the wheel to now, cascading as each level
+ * wraps, then run the callbacks of everything that
+ * came due. Returns the number fired.
+ ***********************************************/
+inline size_t timing_wheel::expire(clock::time_point now)
+{
+   if (now < origin)
+      return 0;
+   uint64_t target = (uint64_t)((now - origin) / tick);
+
+   batch.clear();
+   while (current <= target)
+   {
+      // nothing pending: no reason to walk the empty slots
+      if (numTimers == 0)
+      {
+         current = target + 1;
+         break;
+      }
+
+      size_t slot = (size_t)(current & SLOT_MASK);
+      if (slot == 0)
+         cascade(1);
+
+      // detach the whole level-0 list
+      size_t index = buckets[slot];
+      buckets[slot] = NIL;
+      while (index != NIL)
+      {
+         size_t next = nodes[index].next;
+         batch.push_back(std::move(nodes[index].fn));
+         release(index);
+         numTimers--;
+         index = next;
+      }
+      current++;
+   }
+
+   // the batch is moved aside in case a callback calls expire() again
+   custom::vector<callback> due(std::move(batch));
+   for (size_t i = 0; i < due.size(); i++)
+      due[i]();
+   size_t numFired = due.size();
+   due.clear();
+   batch = std::move(due);    // keep the capacity for next time
+   return numFired;
+}
+
+/************************************************
+ * TIMING WHEEL :: EARLIEST
+ * A lower bound on the next deadline: the earlier of
+ * the first busy level-0 tick and the first time a
+ * busy higher slot cascades. Waking then is never late.
+ ***********************************************/
+inline timing_wheel::clock::time_point timing_wheel::earliest() const
+{
+   if (numTimers == 0)
+      throw std::out_of_range("std:out_of_range");
+
+   uint64_t soonest = (uint64_t)-1;
+   for (size_t level = 0; level < NUM_LEVELS; level++)
+   {
+      size_t shift = level * LEVEL_BITS;
+      uint64_t position = current >> shift;
+
+      // once the ticks below this level have moved on, this slot has cascaded
+      if (current & (((uint64_t)1 << shift) - 1))
+         position++;
+
+      for (size_t i = 0; i < NUM_SLOTS; i++)
+      {
+         uint64_t when = position + i;
+         if (buckets[level * NUM_SLOTS + (size_t)(when & SLOT_MASK)] != NIL)
+         {
+            if ((when << shift) < soonest)
+               soonest = when << shift;
+            break;
+         }
+      }
+   }
+   return fromTicks(soonest);
+}
+
+/************************************************
+ * TIMING WHEEL :: TO TICKS
+ * Round up, so a timer never fires early
+ ***********************************************/
+inline uint64_t timing_wheel::toTicks(clock::time_point t) const
+{
+   if (t <= origin)
+      return 0;
+   clock::duration elapsed = t - origin;
+   return (uint64_t)((elapsed + tick - clock::duration(1)) / tick);
+}
+
+inline timing_wheel::clock::time_point timing_wheel::fromTicks(uint64_t ticks) const
+{
+   return origin + tick * (clock::rep)ticks;
+}
+
+/************************************************
+ * TIMING WHEEL :: PLACE
+ * Pick the level by how far away the timer is and
+ * the slot by the matching bits of its expiry
+ ***********************************************/
+inline void timing_wheel::place(size_t index)
+{
+   uint64_t expires = nodes[index].expires;
+   if (expires < current)
+      expires = current;                 // overdue: fire on the next tick
+   uint64_t delta = expires - current;
+
+   size_t level = 0;
+   while (level + 1 < NUM_LEVELS && delta >= ((uint64_t)1 << ((level + 1) * LEVEL_BITS)))
+      level++;
+
+   // beyond the top level: park in its furthest slot and re-place on cascade
+   uint64_t range = (uint64_t)1 << (NUM_LEVELS * LEVEL_BITS);
+   if (delta >= range)
+      expires = current + range - 1;
+
+   size_t slot = (size_t)((expires >> (level * LEVEL_BITS)) & SLOT_MASK);
+   link(index, level * NUM_SLOTS + slot);
+}
+
+/************************************************
+ * TIMING WHEEL :: LINK and UNLINK
+ * Doubly-linked slot lists, threaded through the pool
+ ***********************************************/
+inline void timing_wheel::link(size_t index, size_t bucket)
+{
+   nodes[index].bucket = bucket;
+   nodes[index].prev = NIL;
+   nodes[index].next = buckets[bucket];
+   if (buckets[bucket] != NIL)
+      nodes[buckets[bucket]].prev = index;
+   buckets[bucket] = index;
+}
+
+inline void timing_wheel::unlink(size_t index)
+{
+   Node & node = nodes[index];
+   if (node.prev != NIL)
+      nodes[node.prev].next = node.next;
+   else
+      buckets[node.bucket] = node.next;
+   if (node.next != NIL)
+      nodes[node.next].prev = node.prev;
+   node.bucket = NIL;
+}
+
+/************************************************
+ * TIMING WHEEL :: CASCADE
+ * Level 0 just wrapped: redistribute the next slot
+ * of this level, first cascading the level above if
+ * it wrapped too
+ ***********************************************/
+inline void timing_wheel::cascade(size_t level)
+{
+   if (level >= NUM_LEVELS)
+      return;
+
+   size_t slot = (size_t)((current >> (level * LEVEL_BITS)) & SLOT_MASK);
+   if (slot == 0)
+      cascade(level + 1);
+
+   size_t index = buckets[level * NUM_SLOTS + slot];
+   buckets[level * NUM_SLOTS + slot] = NIL;
+   while (index != NIL)
+   {
+      size_t next = nodes[index].next;
+      place(index);
+      index = next;
+   }
+}
+
+/************************************************
+ * TIMING WHEEL :: RELEASE
+ * Invalidate outstanding handles and return the
+ * node to the pool
+ ***********************************************/
+inline void timing_wheel::release(size_t index)
+{
+   nodes[index].fn = nullptr;
+   nodes[index].bucket = NIL;
+   nodes[index].generation++;
+   nodes[index].next = freeList;
+   freeList = index;
+}
+
+} // namespace custom
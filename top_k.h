@@ -0,0 +1,237 @@
+/***********************************************************************
+ * Header:
+ *    TOP K
+ * Summary:
+ *    Keep the best K items of a stream. The K survivors sit in a
+ *    min-ordered heap, so the weakest of them, the threshold, is at
+ *    the root. A newcomer that does not beat the threshold is turned
+ *    away after a single comparison; one that does replaces the root.
+ *
+ *    All the storage is reserved when the collector is built, so
+ *    nothing allocates while the stream is running. push_batch() takes
+ *    a whole array of keys; for float, int32 and int64 the losers are
+ *    skipped with SIMD compares (see simd_filter.h).
+ *
+ *    This will contain the class definition of:
+ *        top_k                   : A bounded best-K collector
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <functional>  // for std::less
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::swap
+#include "vector.h"
+#include "simd_filter.h"
+
+class TestTopK;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * TOP K
+ * The K largest items under Compare. Ties with the
+ * threshold are rejected.
+ *************************************************/
+template <class T, size_t K, class Compare = std::less<T>>
+class top_k
+{
+   static_assert(K > 0, "top_k needs room for at least one item");
+   friend class ::TestTopK; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   top_k(const Compare & compare = Compare()) : compare(compare)
+   {
+      container.reserve(K);
+   }
+
+   //
+   // Insert
+   //
+   bool push(const T & t);
+   bool push(T && t);
+   size_t push_batch(const T * keys, size_t n);
+
+   //
+   // Access
+   //
+   const T & threshold() const;
+   custom::vector<T> extract();
+
+   //
+   // Status
+   //
+   size_t size()     const { return container.size();      }
+   bool   empty()    const { return container.empty();     }
+   bool   full()     const { return container.size() == K; }
+   static size_t capacity() { return K; }
+
+private:
+
+   // is lhs weaker than rhs? The weakest is the root.
+   bool weaker(const T & lhs, const T & rhs) const { return compare(lhs, rhs); }
+
+   void percolateUp(size_t index);
+   void percolateDown(size_t index, size_t size);
+
+   void swapElements(size_t lhs, size_t rhs)
+   {
+      using std::swap;
+      swap(container[lhs], container[rhs]);
+   }
+
+   custom::vector<T> container;   // 0-based min-heap, capacity K
+   Compare compare;
+};
+
+/************************************************
+ * TOP K :: PUSH
+ * Fill up to K, then only admit items that beat
+ * the threshold. Returns TRUE if t was kept.
+ ***********************************************/
+template <class T, size_t K, class Compare>
+bool top_k <T, K, Compare> :: push(const T & t)
+{
+   if (container.size() < K)
+   {
+      container.push_back(t);
+      percolateUp(container.size() - 1);
+      return true;
+   }
+
+   // the one comparison almost every item in a long stream pays
+   if (!weaker(container[0], t))
+      return false;
+
+   container[0] = t;
+   percolateDown(0, container.size());
+   return true;
+}
+
+template <class T, size_t K, class Compare>
+bool top_k <T, K, Compare> :: push(T && t)
+{
+   if (container.size() < K)
+   {
+      container.push_back(std::move(t));
+      percolateUp(container.size() - 1);
+      return true;
+   }
+
+   if (!weaker(container[0], t))
+      return false;
+
+   container[0] = std::move(t);
+   percolateDown(0, container.size());
+   return true;
+}
+
+/************************************************
+ * TOP K :: PUSH BATCH
+ * Fill up to K one at a time, then let the filter
+ * skip every key that cannot beat the threshold and
+ * stop only on those that do. Returns the number kept.
+ ***********************************************/
+template <class T, size_t K, class Compare>
+size_t top_k <T, K, Compare> :: push_batch(const T * keys, size_t n)
+{
+   size_t i = 0;
+   for (; i < n && container.size() < K; i++)
+      push(keys[i]);
+   size_t numKept = i;
+
+   while (i < n)
+   {
+      i += filter<T, Compare>::skip(keys + i, n - i, container[0], compare);
+      if (i == n)
+         break;
+
+      // the filter already compared it: straight to the root
+      container[0] = keys[i++];
+      percolateDown(0, container.size());
+      numKept++;
+   }
+   return numKept;
+}
+
+/************************************************
+ * TOP K :: THRESHOLD
+ * The weakest survivor; only a better item gets in
+ ***********************************************/
+template <class T, size_t K, class Compare>
+const T & top_k <T, K, Compare> :: threshold() const
+{
+   if (container.empty())
+      throw std::out_of_range("std:out_of_range");
+   return container.front();
+}
+
+/************************************************
+ * TOP K :: EXTRACT
+ * Heap-sort in place, best first, and hand over the
+ * storage itself. The collector is empty afterward.
+ ***********************************************/
+template <class T, size_t K, class Compare>
+custom::vector<T> top_k <T, K, Compare> :: extract()
+{
+   for (size_t size = container.size(); size > 1; size--)
+   {
+      swapElements(0, size - 1);
+      percolateDown(0, size - 1);
+   }
+
+   custom::vector<T> result(std::move(container));
+   return result;
+}
+
+/************************************************
+ * TOP K :: PERCOLATE UP
+ * Move a weak item toward the root
+ ***********************************************/
+template <class T, size_t K, class Compare>
+void top_k <T, K, Compare> :: percolateUp(size_t index)
+{
+   while (index > 0)
+   {
+      size_t parent = (index - 1) / 2;
+      if (!weaker(container[index], container[parent]))
+         break;
+      swapElements(index, parent);
+      index = parent;
+   }
+}
+
+/************************************************
+ * TOP K :: PERCOLATE DOWN
+ * Move a strong item toward the leaves, looking only
+ * at the first size items
+ ***********************************************/
+template <class T, size_t K, class Compare>
+void top_k <T, K, Compare> :: percolateDown(size_t index, size_t size)
+{
+   for (;;)
+   {
+      size_t left    = 2 * index + 1;
+      size_t right   = 2 * index + 2;
+      size_t weakest = index;
+
+      if (left < size && weaker(container[left], container[weakest]))
+         weakest = left;
+      if (right < size && weaker(container[right], container[weakest]))
+         weakest = right;
+
+      if (weakest == index)
+         return;
+      swapElements(index, weakest);
+      index = weakest;
+   }
+}
+
+} // namespace custom
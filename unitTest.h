@@ -23,10 +23,17 @@
 #define assertStandardFixture(x)  assertStandardFixtureParameters(x, __LINE__, __FUNCTION__)
 #define assertEmptyFixture(x)     assertEmptyFixtureParameters(   x, __LINE__, __FUNCTION__)
 
-#include <iostream>  // for std::cerr
-#include <string>    // for std::string
-#include <vector>    // for std::vector
-#include <map>       // for std::map
+#include <cstdio>      // for std::remove
+#include <filesystem>  // for std::filesystem::temp_directory_path
+#include <iostream>    // for std::cerr
+#include <string>      // for std::string
+#include <vector>      // for std::vector
+#include <map>         // for std::map
+#ifdef _WIN32
+#include <process.h>   // for _getpid
+#else
+#include <unistd.h>    // for getpid
+#endif
 
 
 class UnitTest
@@ -97,6 +104,32 @@ protected:
 
    }
    
+   /*************************************************************
+    * SCRATCH NAME
+    * prefix-pid-name, so two runs at once never share a file
+    *************************************************************/
+   static std::string scratchName(const std::string & prefix, const std::string & name)
+   {
+#ifdef _WIN32
+      long pid = (long)_getpid();
+#else
+      long pid = (long)getpid();
+#endif
+      return prefix + "-" + std::to_string(pid) + "-" + name;
+   }
+
+   /*************************************************************
+    * SCRATCH PATH
+    * A scratch name in the temp directory, with nothing there
+    *************************************************************/
+   static std::string scratchPath(const std::string & prefix, const std::string & name)
+   {
+      std::string path = (std::filesystem::temp_directory_path() /
+                          scratchName(prefix, name)).string();
+      std::remove(path.c_str());
+      return path;
+   }
+
    /*************************************************************
     * ASSERT UNIT PARAMETERS
     * Custom assert code so we can see all the errors at once
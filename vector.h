@@ -23,6 +23,8 @@
 #include <new>               // std::bad_alloc
 #include <memory>            // for std::allocator
 #include <initializer_list>  // for the initializer list, of course!
+#include <cstddef>           // for std::ptrdiff_t
+#include <iterator>          // for std::random_access_iterator_tag
 
 class TestVector; // forward declaration for unit tests
 class TestStack;
@@ -110,14 +112,14 @@ public:
    void clear()
    {
       for (size_t i = 0; i < numElements; i++)
-         alloc.destroy(&data[i]);
+         std::allocator_traits<A>::destroy(alloc, &data[i]);
       numElements = 0;
    }
    void pop_back()
    {
       if (numElements > 0)
       {
-         alloc.destroy(&data[numElements - 1]);
+         std::allocator_traits<A>::destroy(alloc, &data[numElements - 1]);
          numElements--;
       }
    }
@@ -148,6 +150,8 @@ private:
  *   4. Dereference
  * This particular iterator is a bi-directional meaning
  * that ++ and -- both work.  Not all iterators are that way.
+ * It is also random access, so the heap algorithms and
+ * the std ones can jump around the vector in place.
  *************************************************/
 template <typename T, typename A>
 class vector <T, A> ::iterator
@@ -157,6 +161,12 @@ class vector <T, A> ::iterator
    friend class ::TestPQueue;
    friend class ::TestHash;
 public:
+   typedef std::random_access_iterator_tag iterator_category;
+   typedef T                               value_type;
+   typedef std::ptrdiff_t                  difference_type;
+   typedef T *                             pointer;
+   typedef T &                             reference;
+
    // constructors, destructors, and assignment operator
    iterator() { p = 0; }
    iterator(T* p) { this->p = p; }
@@ -185,7 +195,7 @@ public:
    }
 
    // dereference operator
-   T& operator * ()
+   T& operator * () const
    {
       return *(p);
    }
@@ -224,6 +234,22 @@ public:
       return temp;
    }
 
+   // random access
+   T& operator [] (difference_type offset) const { return p[offset]; }
+   T* operator -> () const { return p; }
+   iterator& operator += (difference_type offset) { p += offset; return *this; }
+   iterator& operator -= (difference_type offset) { p -= offset; return *this; }
+   iterator operator + (difference_type offset) const { return iterator(p + offset); }
+   iterator operator - (difference_type offset) const { return iterator(p - offset); }
+   friend iterator operator + (difference_type offset, const iterator& it) { return it + offset; }
+   difference_type operator - (const iterator& rhs) const { return p - rhs.p; }
+
+   // ordering
+   bool operator <  (const iterator& rhs) const { return p <  rhs.p; }
+   bool operator >  (const iterator& rhs) const { return p >  rhs.p; }
+   bool operator <= (const iterator& rhs) const { return p <= rhs.p; }
+   bool operator >= (const iterator& rhs) const { return p >= rhs.p; }
+
 private:
    T* p;
 };
@@ -255,7 +281,7 @@ vector <T, A> :: vector(size_t num, const T & t, const A & a)
    alloc = a;
    data = alloc.allocate(num);
    for (size_t i = 0; i < num; i++)
-      alloc.construct(&data[i], t);
+      std::allocator_traits<A>::construct(alloc, &data[i], t);
    numElements = num;
    numCapacity = num;
 }
@@ -270,7 +296,7 @@ vector <T, A> :: vector(const std::initializer_list<T> & l, const A & a)
    alloc = a;
    data = alloc.allocate(l.size());
    for (size_t i = 0; i < l.size(); i++)
-      alloc.construct(&data[i], *(l.begin() + i));
+      std::allocator_traits<A>::construct(alloc, &data[i], *(l.begin() + i));
    numElements = l.size();
    numCapacity = l.size();
 }
@@ -286,7 +312,7 @@ vector <T, A> :: vector(size_t num, const A & a)
    alloc = a;
    data = alloc.allocate(num);  // Allocate raw memory
    for (size_t i = 0; i < num; i++)
-      alloc.construct(&data[i]); // Construct each element
+      std::allocator_traits<A>::construct(alloc, &data[i]); // Construct each element
    numElements = num;
    numCapacity = num;
 }
@@ -302,7 +328,7 @@ vector <T, A> :: vector (const vector & rhs)
    alloc = rhs.alloc;
    data = alloc.allocate(rhs.numElements);
    for (size_t i = 0; i < rhs.numElements; i++)
-      alloc.construct(&data[i], rhs.data[i]);
+      std::allocator_traits<A>::construct(alloc, &data[i], rhs.data[i]);
    numElements = rhs.numElements;
    numCapacity = rhs.numElements;
 }
@@ -333,7 +359,7 @@ template <typename T, typename A>
 vector <T, A> :: ~vector()
 {
    for (size_t i = 0; i < numElements; i++)
-      alloc.destroy(&data[i]);
+      std::allocator_traits<A>::destroy(alloc, &data[i]);
    alloc.deallocate(data, numCapacity);
    data = nullptr;
    numElements = 0;
@@ -353,14 +379,14 @@ void vector <T, A> :: resize(size_t newElements)
    if (newElements < numElements)
    {
       for (size_t i = newElements; i < numElements; i++)
-         alloc.destroy(&data[i]);
+         std::allocator_traits<A>::destroy(alloc, &data[i]);
    }
    else if (newElements > numElements)
    {
       if (newElements > numCapacity)
          reserve(newElements);
       for (size_t i = numElements; i < newElements; i++)
-         alloc.construct(&data[i]);
+         std::allocator_traits<A>::construct(alloc, &data[i]);
    }
    numElements = newElements;
 }
@@ -371,14 +397,14 @@ void vector <T, A> :: resize(size_t newElements, const T & t)
    if (newElements < numElements)
    {
       for (size_t i = newElements; i < numElements; i++)
-         alloc.destroy(&data[i]);
+         std::allocator_traits<A>::destroy(alloc, &data[i]);
    }
    else if (newElements > numElements)
    {
       if (newElements > numCapacity)
          reserve(newElements);
       for (size_t i = numElements; i < newElements; i++)
-         alloc.construct(&data[i], t);
+         std::allocator_traits<A>::construct(alloc, &data[i], t);
    }
    numElements = newElements;
 }
@@ -400,7 +426,7 @@ void vector <T, A> :: reserve(size_t newCapacity)
    for (size_t i = 0; i < numElements; i++)
       new ((void*)(newData + i)) T(std::move(data[i]));
    for (size_t i = 0; i < numElements; i++)
-      alloc.destroy(&data[i]);
+      std::allocator_traits<A>::destroy(alloc, &data[i]);
    alloc.deallocate(data, numCapacity);
    data = newData;
    numCapacity = newCapacity;
@@ -508,7 +534,7 @@ void vector <T, A> :: push_back(const T & t)
       size_t newCapacity = (numCapacity == 0) ? 1 : numCapacity * 2;
       reserve(newCapacity);
    }
-   alloc.construct(&data[numElements], t);
+   std::allocator_traits<A>::construct(alloc, &data[numElements], t);
    ++numElements;
 }
 
@@ -520,7 +546,7 @@ void vector <T, A> ::push_back(T && t)
       size_t newCapacity = (numCapacity == 0) ? 1 : numCapacity * 2;
       reserve(newCapacity);
    }
-   alloc.construct(&data[numElements], std::move(t));
+   std::allocator_traits<A>::construct(alloc, &data[numElements], std::move(t));
    ++numElements;
 }
 
@@ -549,26 +575,26 @@ vector<T, A>& vector<T, A>::operator=(const vector& rhs)
          // Construct new elements if rhs is longer
          for (; i < rhs.numElements; ++i)
          {
-            alloc.construct(&data[i], rhs.data[i]); // triggers Spy::numCopy()
+            std::allocator_traits<A>::construct(alloc, &data[i], rhs.data[i]); // triggers Spy::numCopy()
          }
 
          // Destroy extra elements if current is longer
          for (; i < numElements; ++i)
          {
-            alloc.destroy(&data[i]); // triggers Spy::numDestructor()
+            std::allocator_traits<A>::destroy(alloc, &data[i]); // triggers Spy::numDestructor()
          }
       }
       else
       {
          // Need more capacity: full destruction and reallocation
          for (size_t i = 0; i < numElements; ++i)
-            alloc.destroy(&data[i]);
+            std::allocator_traits<A>::destroy(alloc, &data[i]);
          if (data)
             alloc.deallocate(data, numCapacity);
 
          data = alloc.allocate(rhs.numCapacity);
          for (size_t i = 0; i < rhs.numElements; ++i)
-            alloc.construct(&data[i], rhs.data[i]);
+            std::allocator_traits<A>::construct(alloc, &data[i], rhs.data[i]);
          numCapacity = rhs.numCapacity;
       }
 
@@ -584,7 +610,7 @@ vector <T, A>& vector <T, A> :: operator = (vector&& rhs)
        {
           // Destroy current contents
           for (size_t i = 0; i < numElements; ++i)
-             alloc.destroy(&data[i]);
+             std::allocator_traits<A>::destroy(alloc, &data[i]);
 
           if (data)
              alloc.deallocate(data, numCapacity);
@@ -0,0 +1,335 @@
+/***********************************************************************
+ * Header:
+ *    VECTOR VIEW
+ * Summary:
+ *    Binary files of custom::vector, for handing large buffers of
+ *    records from one stage of a pipeline to the next. The file is:
+ *        header   magic, version, element size, element alignment and
+ *                 count; padded to 64 bytes
+ *        items    count items of T, byte for byte
+ *
+ *    save_vector() writes the items with one write and load_vector()
+ *    reads them back with one read: no element is written or pushed
+ *    one at a time. save_vector() writes to a temporary file and
+ *    renames it over the old one, so a reader never sees half a file,
+ *    and a reader who still has the old file mapped keeps the old
+ *    items.
+ *
+ *    vector_view maps the file read-only instead of reading it. Opening
+ *    one costs the same for ten items or ten million; pages are read
+ *    when they are first touched, and every process viewing the same
+ *    file shares the one copy in the page cache.
+ *
+ *    A file is only readable by the same T on the same platform.
+ *
+ *    This will contain the definitions of:
+ *        save_vector            : Write a vector to a file
+ *        load_vector            : Read a vector from a file
+ *        vector_view            : A read-only vector mapped from a file
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cerrno>          // for errno
+#include <cstddef>         // for size_t
+#include <cstdint>         // for uint64_t and uint32_t
+#include <cstdio>          // for std::fopen, std::fwrite and std::rename
+#include <cstring>         // for std::memcpy and std::memcmp
+#include <filesystem>      // for std::filesystem::file_size
+#include <memory>          // for std::allocator
+#include <stdexcept>       // for std::runtime_error
+#include <string>
+#include <system_error>    // for std::system_error
+#include <type_traits>     // for std::is_trivially_copyable
+#include "vector.h"
+
+#ifdef __linux__
+#include <fcntl.h>         // for open
+#include <sys/mman.h>      // for mmap and munmap
+#include <sys/stat.h>      // for fstat
+#include <unistd.h>        // for close
+#endif // __linux__
+
+class TestVectorView;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * VECTOR FILE
+ * The header every vector file starts with
+ *************************************************/
+struct vector_file
+{
+   static constexpr uint32_t VERSION = 1;
+   static constexpr size_t   HEADER_BYTES = 64;
+
+   struct header
+   {
+      char     magic[8];      // "CVECTOR" and a zero
+      uint32_t version;
+      uint32_t elementSize;
+      uint32_t elementAlign;
+      uint32_t reserved;
+      uint64_t count;
+   };
+   static_assert(sizeof(header) <= HEADER_BYTES, "the header fits its padding");
+
+   template <class T>
+   static header headerFor(size_t count)
+   {
+      header head = {};
+      std::memcpy(head.magic, "CVECTOR", 8);
+      head.version      = VERSION;
+      head.elementSize  = (uint32_t)sizeof(T);
+      head.elementAlign = (uint32_t)alignof(T);
+      head.count        = count;
+      return head;
+   }
+
+   // is this a file of T, and is all of it there?
+   template <class T>
+   static void validate(const header & head, uint64_t fileBytes, const std::string & path)
+   {
+      if (fileBytes < HEADER_BYTES || std::memcmp(head.magic, "CVECTOR", 8) != 0)
+         throw std::runtime_error(path + " is not a vector file");
+      if (head.version != VERSION)
+         throw std::runtime_error(path + " has version " + std::to_string(head.version));
+      if (head.elementSize != sizeof(T) || head.elementAlign != alignof(T))
+         throw std::runtime_error(path + " holds items of " + std::to_string(head.elementSize) + " bytes");
+      if (head.count > (fileBytes - HEADER_BYTES) / sizeof(T))
+         throw std::runtime_error(path + " is truncated");
+   }
+};
+
+/************************************************
+ * SAVE VECTOR
+ * Write the header and the items to a temporary
+ * file, then rename it into place
+ ***********************************************/
+template <class T, class A>
+void save_vector(const custom::vector<T, A> & v, const std::string & path)
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "save_vector writes T as raw bytes");
+
+   std::string temporary = path + ".tmp";
+   std::FILE * file = std::fopen(temporary.c_str(), "wb");
+   if (file == nullptr)
+      throw std::system_error(errno, std::system_category(), "open " + temporary);
+
+   char head[vector_file::HEADER_BYTES] = {};
+   vector_file::header fields = vector_file::headerFor<T>(v.size());
+   std::memcpy(head, &fields, sizeof(fields));
+
+   bool written = std::fwrite(head, 1, sizeof(head), file) == sizeof(head);
+   if (written && !v.empty())
+      written = std::fwrite(&v.front(), sizeof(T), v.size(), file) == v.size();
+   int error = errno;
+   if (std::fclose(file) != 0 && written)
+   {
+      written = false;
+      error = errno;
+   }
+   if (!written)
+   {
+      std::remove(temporary.c_str());
+      throw std::system_error(error, std::system_category(), "write " + temporary);
+   }
+
+   if (std::rename(temporary.c_str(), path.c_str()) != 0)
+   {
+      error = errno;
+      std::remove(temporary.c_str());
+      throw std::system_error(error, std::system_category(), "rename " + temporary);
+   }
+}
+
+/************************************************
+ * LOAD VECTOR
+ * Read the header, size the vector once, and read
+ * the items straight into it
+ ***********************************************/
+template <class T, class A = std::allocator<T>>
+custom::vector<T, A> load_vector(const std::string & path, const A & a = A())
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "load_vector reads T as raw bytes");
+
+   std::FILE * file = std::fopen(path.c_str(), "rb");
+   if (file == nullptr)
+      throw std::system_error(errno, std::system_category(), "open " + path);
+
+   std::error_code sizeError;
+   uint64_t fileBytes = (uint64_t)std::filesystem::file_size(path, sizeError);
+   if (sizeError)
+   {
+      std::fclose(file);
+      throw std::system_error(sizeError, "stat " + path);
+   }
+
+   char head[vector_file::HEADER_BYTES] = {};
+   vector_file::header fields;
+   if (fileBytes >= sizeof(head) && std::fread(head, 1, sizeof(head), file) != sizeof(head))
+   {
+      int error = errno;
+      std::fclose(file);
+      throw std::system_error(error, std::system_category(), "read " + path);
+   }
+   std::memcpy(&fields, head, sizeof(fields));
+
+   try
+   {
+      vector_file::validate<T>(fields, fileBytes, path);
+   }
+   catch (...)
+   {
+      std::fclose(file);
+      throw;
+   }
+
+   custom::vector<T, A> v((size_t)fields.count, a);
+   if (!v.empty() && std::fread(&v.front(), sizeof(T), v.size(), file) != v.size())
+   {
+      std::fclose(file);
+      throw std::runtime_error(path + " is truncated");
+   }
+   std::fclose(file);
+   return v;
+}
+
+#ifdef __linux__
+
+/*************************************************
+ * VECTOR VIEW
+ * The items of a vector file, mapped read-only
+ *************************************************/
+template <class T>
+class vector_view
+{
+   static_assert(std::is_trivially_copyable<T>::value,
+                 "vector_view reads T as raw bytes");
+   static_assert(alignof(T) <= vector_file::HEADER_BYTES,
+                 "vector_view aligns items to 64 bytes at most");
+   friend class ::TestVectorView; // give the unit test class access to the privates
+public:
+   typedef const T * iterator;
+
+   //
+   // Construct: map the whole file
+   //
+   explicit vector_view(const std::string & path);
+   vector_view(vector_view && rhs) : base(rhs.base), mappedBytes(rhs.mappedBytes), numElements(rhs.numElements)
+   {
+      rhs.base = nullptr;
+      rhs.mappedBytes = 0;
+      rhs.numElements = 0;
+   }
+   vector_view & operator = (vector_view && rhs)
+   {
+      if (this != &rhs)
+      {
+         unmap();
+         base = rhs.base;
+         mappedBytes = rhs.mappedBytes;
+         numElements = rhs.numElements;
+         rhs.base = nullptr;
+         rhs.mappedBytes = 0;
+         rhs.numElements = 0;
+      }
+      return *this;
+   }
+   vector_view(const vector_view &) = delete;
+   vector_view & operator = (const vector_view &) = delete;
+  ~vector_view() { unmap(); }
+
+   //
+   // Iterator
+   //
+   iterator begin() const { return data(); }
+   iterator end()   const { return data() + numElements; }
+
+   //
+   // Access
+   //
+   const T & operator [] (size_t index) const
+   {
+      assert(index < numElements);
+      return data()[index];
+   }
+   const T & front() const { return data()[0]; }
+   const T & back()  const { return data()[numElements - 1]; }
+   const T * data()  const { return reinterpret_cast<const T *>(base + vector_file::HEADER_BYTES); }
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements; }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   void unmap()
+   {
+      if (base != nullptr)
+         munmap(const_cast<char *>(base), mappedBytes);
+      base = nullptr;
+   }
+
+   const char * base;          // the whole file, mapped
+   size_t       mappedBytes;
+   size_t       numElements;
+};
+
+/************************************************
+ * VECTOR VIEW :: CONSTRUCTOR
+ * The mapping outlives the descriptor, so close it
+ * right away. Nothing is read but the header.
+ ***********************************************/
+template <class T>
+vector_view <T> :: vector_view(const std::string & path) :
+   base(nullptr), mappedBytes(0), numElements(0)
+{
+   int fd = ::open(path.c_str(), O_RDONLY);
+   if (fd < 0)
+      throw std::system_error(errno, std::system_category(), "open " + path);
+
+   struct stat status;
+   if (fstat(fd, &status) != 0)
+   {
+      int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::system_category(), "fstat " + path);
+   }
+   if ((size_t)status.st_size < vector_file::HEADER_BYTES)
+   {
+      ::close(fd);
+      throw std::runtime_error(path + " is not a vector file");
+   }
+
+   mappedBytes = (size_t)status.st_size;
+   void * p = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+   int error = errno;
+   ::close(fd);
+   if (p == MAP_FAILED)
+      throw std::system_error(error, std::system_category(), "mmap " + path);
+   base = static_cast<const char *>(p);
+
+   const vector_file::header * head = reinterpret_cast<const vector_file::header *>(base);
+   try
+   {
+      vector_file::validate<T>(*head, mappedBytes, path);
+   }
+   catch (...)
+   {
+      unmap();
+      throw;
+   }
+   numElements = (size_t)head->count;
+}
+
+#endif // __linux__
+
+} // namespace custom
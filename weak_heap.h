@@ -0,0 +1,328 @@
+/***********************************************************************
+ * Header:
+ *    WEAK HEAP
+ * Summary:
+ *    A priority queue for keys that are expensive to compare. A weak
+ *    heap relaxes the binary heap: each node only has to be no larger
+ *    than its distinguished ancestor, and a reverse bit per node says
+ *    which of its two children counts as the left one. Flipping a bit
+ *    swaps two whole subtrees for free, so restoring order costs one
+ *    comparison per level instead of two:
+ *        build          n - 1 comparisons
+ *        pop            about log2 n
+ *        push           O(1) on average, log2 n at worst
+ *        weak-heapsort  at most n log2 n - 0.9n
+ *    A binary heap needs about 1.5n to build, 2 log2 n to pop, and
+ *    2n log2 n to sort.
+ *
+ *    The layout, for node i > 0:
+ *        left child   2i + r[i]
+ *        right child  2i + 1 - r[i]
+ *    The root, 0, has only a right child, 1. The distinguished
+ *    ancestor of j is the parent of the first node on the way up
+ *    that is a right child.
+ *
+ *    This will contain the definitions of:
+ *        reverse_bits            : A packed bit array
+ *        weak_heap               : A priority queue on a weak heap
+ *        weak_heapsort           : Sort a range in place
+ * Author
+ *    Jenna Ray, Savanna Whittaker, Isabel Weaver
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <functional>  // for std::less
+#include <iterator>    // for std::iterator_traits
+#include <stdexcept>   // for std::out_of_range
+#include <utility>     // for std::swap and std::move
+#include "vector.h"
+
+class TestWeakHeap;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * REVERSE BITS
+ * One bit per heap node, 64 to a word
+ *************************************************/
+class reverse_bits
+{
+public:
+   // make room for bits [0, n), new ones clear
+   void resize(size_t n)
+   {
+      size_t numWords = (n + 63) / 64;
+      while (words.size() < numWords)
+         words.push_back(0);
+   }
+   bool operator [] (size_t i) const { return (words[i / 64] >> (i % 64)) & 1; }
+   void flip(size_t i)  { words[i / 64] ^=  ((uint64_t)1 << (i % 64)); }
+   void reset(size_t i) { words[i / 64] &= ~((uint64_t)1 << (i % 64)); }
+   void clear()
+   {
+      for (size_t w = 0; w < words.size(); w++)
+         words[w] = 0;
+   }
+
+private:
+   custom::vector<uint64_t> words;
+};
+
+/************************************************
+ * WEAK ANCESTOR
+ * The distinguished ancestor of node j > 0: climb
+ * while j is a left child, then take the parent
+ ***********************************************/
+inline size_t weakAncestor(size_t j, const reverse_bits & r)
+{
+   while ((j & 1) == (size_t)r[j >> 1])
+      j >>= 1;
+   return j >> 1;
+}
+
+/************************************************
+ * WEAK JOIN
+ * i is the distinguished ancestor of j. If j is
+ * larger, swap them and flip j's bit so its old
+ * subtrees stay under the same values. One
+ * comparison. Return TRUE if they swapped.
+ ***********************************************/
+template <class RandomIt, class Compare>
+bool weakJoin(RandomIt a, reverse_bits & r, size_t i, size_t j, Compare & compare)
+{
+   if (!compare(a[i], a[j]))
+      return false;
+
+   using std::swap;
+   swap(a[i], a[j]);
+   r.flip(j);
+   return true;
+}
+
+/************************************************
+ * WEAK SIFT DOWN
+ * The root of the weak heap [0, n) may be out of
+ * place. Walk to the bottom of the left spine under
+ * node 1, then join each node on the way back up
+ * with the root: one comparison per level.
+ ***********************************************/
+template <class RandomIt, class Compare>
+void weakSiftDown(RandomIt a, reverse_bits & r, size_t n, Compare & compare)
+{
+   if (n < 2)
+      return;
+
+   size_t x = 1;
+   while (2 * x + r[x] < n)
+      x = 2 * x + r[x];
+   for (; x > 0; x >>= 1)
+      weakJoin(a, r, 0, x, compare);
+}
+
+/************************************************
+ * WEAK SIFT UP
+ * Node j may be larger than its distinguished
+ * ancestor. Join upward until it is not.
+ ***********************************************/
+template <class RandomIt, class Compare>
+void weakSiftUp(RandomIt a, reverse_bits & r, size_t j, Compare & compare)
+{
+   while (j != 0)
+   {
+      size_t i = weakAncestor(j, r);
+      if (!weakJoin(a, r, i, j, compare))
+         return;
+      j = i;
+   }
+}
+
+/************************************************
+ * WEAK HEAPIFY
+ * Join every node with its distinguished ancestor,
+ * last first: exactly n - 1 comparisons
+ ***********************************************/
+template <class RandomIt, class Compare>
+void weakHeapify(RandomIt a, reverse_bits & r, size_t n, Compare & compare)
+{
+   r.resize(n);
+   r.clear();
+   for (size_t j = n; j-- > 1; )
+      weakJoin(a, r, weakAncestor(j, r), j, compare);
+}
+
+/************************************************
+ * WEAK HEAPSORT
+ * Sort [first, last) ascending under Compare with
+ * at most n log2 n - 0.9n comparisons. Needs n bits
+ * of scratch for the reverse bits.
+ ***********************************************/
+template <class RandomIt, class Compare>
+void weak_heapsort(RandomIt first, RandomIt last, Compare compare)
+{
+   size_t n = (size_t)(last - first);
+   if (n < 2)
+      return;
+
+   reverse_bits r;
+   weakHeapify(first, r, n, compare);
+   for (size_t size = n - 1; size >= 1; size--)
+   {
+      using std::swap;
+      swap(first[0], first[size]);
+      weakSiftDown(first, r, size, compare);
+   }
+}
+
+template <class RandomIt>
+void weak_heapsort(RandomIt first, RandomIt last)
+{
+   custom::weak_heapsort(first, last, std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+/*************************************************
+ * WEAK HEAP
+ * A drop-in for priority_queue when comparisons
+ * are what cost: the top is the largest item
+ * under Compare.
+ *************************************************/
+template <class T, class Compare = std::less<T>>
+class weak_heap
+{
+   friend class ::TestWeakHeap; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   explicit weak_heap(const Compare & compare = Compare()) : compare(compare)
+   {
+   }
+   template <class Iterator>
+   weak_heap(Iterator first, Iterator last, const Compare & compare = Compare()) :
+      compare(compare)
+   {
+      for (Iterator it = first; it != last; ++it)
+         container.push_back(*it);
+      heapify();
+   }
+   explicit weak_heap(custom::vector<T> && rhs, const Compare & compare = Compare()) :
+      container(std::move(rhs)), compare(compare)
+   {
+      heapify();
+   }
+
+   //
+   // Access
+   //
+   const T & top() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+   void reserve(size_t n)
+   {
+      container.reserve(n);
+      bits.resize(n);
+   }
+
+   //
+   // Remove
+   //
+   void pop();
+
+   //
+   // Status
+   //
+   size_t size()  const { return container.size(); }
+   bool   empty() const { return container.empty(); }
+
+private:
+   void heapify()
+   {
+      if (!container.empty())
+         weakHeapify(&container[0], bits, container.size(), compare);
+   }
+   void siftUpLast();
+
+   custom::vector<T> container;
+   reverse_bits      bits;
+   Compare           compare;
+};
+
+/************************************************
+ * WEAK HEAP :: TOP
+ * The root is the largest
+ ***********************************************/
+template <class T, class Compare>
+const T & weak_heap <T, Compare> :: top() const
+{
+   if (container.empty())
+      throw std::out_of_range("std:out_of_range");
+   return container.front();
+}
+
+/************************************************
+ * WEAK HEAP :: PUSH
+ * Add a leaf and join it upward
+ ***********************************************/
+template <class T, class Compare>
+void weak_heap <T, Compare> :: push(const T & t)
+{
+   container.push_back(t);
+   siftUpLast();
+}
+
+template <class T, class Compare>
+void weak_heap <T, Compare> :: push(T && t)
+{
+   container.push_back(std::move(t));
+   siftUpLast();
+}
+
+/************************************************
+ * WEAK HEAP :: SIFT UP LAST
+ * The new leaf starts with a clear bit. If it is
+ * the first child of its parent, the parent had no
+ * subtrees to speak of, so its bit is cleared too
+ * to make the leaf the left child.
+ ***********************************************/
+template <class T, class Compare>
+void weak_heap <T, Compare> :: siftUpLast()
+{
+   size_t j = container.size() - 1;
+   bits.resize(j + 1);
+   bits.reset(j);
+   if (j > 0 && (j & 1) == 0)
+      bits.reset(j >> 1);
+   weakSiftUp(&container[0], bits, j, compare);
+}
+
+/************************************************
+ * WEAK HEAP :: POP
+ * Move the last leaf to the root and sift it down
+ ***********************************************/
+template <class T, class Compare>
+void weak_heap <T, Compare> :: pop()
+{
+   if (container.empty())
+      return;
+
+   size_t last = container.size() - 1;
+   if (last > 0)
+   {
+      using std::swap;
+      swap(container[0], container[last]);
+   }
+   container.pop_back();
+   if (container.size() > 1)
+      weakSiftDown(&container[0], bits, container.size(), compare);
+}
+
+} // namespace custom